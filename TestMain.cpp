@@ -0,0 +1,122 @@
+/*! \file TestMain.cpp
+ * \brief Testprogramm: fuehrt die selbstpruefenden Tests aus Tests.h aus.
+ * Ohne Argumente werden alle Tests ausgefuehrt, sonst die angegebenen
+ * (--list gibt alle Namen aus). Muss aus einem Ordner gestartet werden, in
+ * dem die Ordner Saves, Plots, Checkpoints, Patterns und
+ * myCode/plot/font/font.bmp liegen (siehe CMakeLists.txt)
+ * \author Thai Nguyen, Dung Tran
+ * \date 2021
+ */
+
+#include "Tests.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+/*! \brief Ein Test aus Tests.h
+ */
+struct TestCase
+{
+	const char *name_;  /**< Name (wie in Tests.h) */
+	bool (*test_)();    /**< Testfunktion, true = bestanden */
+};
+
+static const TestCase TESTS[] =
+{
+	{ "DemuxConsistent", Test::DemuxConsistent },
+	{ "InputNamesDuplicationDetected", Test::InputNamesDuplicationDetected },
+	{ "Input2TimeConnectedDetected", Test::Input2TimeConnectedDetected },
+	{ "negativePropagationsDelayDetected", Test::negativePropagationsDelayDetected },
+	{ "missingInputDetected", Test::missingInputDetected },
+	{ "missingOutputDetected", Test::missingOutputDetected },
+	{ "missingGateDetected", Test::missingGateDetected },
+	{ "missingInputConnectionDetected", Test::missingInputConnectionDetected },
+	{ "missingOutputConnectionDetected", Test::missingOutputConnectionDetected },
+	{ "InputwithNonExitGateConnectionDetected", Test::InputwithNonExitGateConnectionDetected },
+	{ "OutputwithNonExitGateConnectionDetected", Test::OutputwithNonExitGateConnectionDetected },
+	{ "Output2TimeConnectedDetected", Test::Output2TimeConnectedDetected },
+	{ "missingGatesConnectionDetected", Test::missingGatesConnectionDetected },
+	{ "Gates2TimesConnectionDetected", Test::Gates2TimesConnectionDetected },
+	{ "GateWithNoneExitedGateConnectionDetected", Test::GateWithNoneExitedGateConnectionDetected },
+	{ "EmptyNetworkDetected", Test::EmptyNetworkDetected },
+	{ "SameGateNameDetected", Test::SameGateNameDetected },
+	{ "ZustandsautomatenCheck", Test::ZustandsautomatenCheck },
+	{ "networkConsistentC0", Test::networkConsistentC0 },
+	{ "PrbsSourcePeriodCheck", Test::PrbsSourcePeriodCheck },
+	{ "PatternFileSourceCheck", Test::PatternFileSourceCheck },
+	{ "PiecewiseLinearPulseCheck", Test::PiecewiseLinearPulseCheck },
+	{ "CompiledNetworkMatchesNetwork", Test::CompiledNetworkMatchesNetwork },
+	{ "TestbedStopsEarly", Test::TestbedStopsEarly },
+	{ "TestbedCheckpointRestore", Test::TestbedCheckpointRestore },
+	{ "TestbedMonitorsCheck", Test::TestbedMonitorsCheck },
+	{ "BatchRunnerScenarios", Test::BatchRunnerScenarios },
+	{ "EnvelopeMinMaxCheck", Test::EnvelopeMinMaxCheck },
+	{ "TiledPlotPagesCheck", Test::TiledPlotPagesCheck },
+	{ "SimpleBMPWriterRoundTrip", Test::SimpleBMPWriterRoundTrip },
+	{ "PlotBatchUniqueNames", Test::PlotBatchUniqueNames },
+	{ "PngBackendEncode", Test::PngBackendEncode },
+	{ "SvgBackendWrite", Test::SvgBackendWrite },
+	{ "WaveformPyramidMatchesEnvelope", Test::WaveformPyramidMatchesEnvelope },
+	{ "LogicTraceAndBus", Test::LogicTraceAndBus },
+	{ "TextPlotRows", Test::TextPlotRows },
+	{ "ProfilerCountsPhases", Test::ProfilerCountsPhases },
+	{ "ActivityTogglesCount", Test::ActivityTogglesCount },
+	{ "AllocationsPerStep", Test::AllocationsPerStep },
+	{ "RunReportJson", Test::RunReportJson },
+	{ "LogSinkCollects", Test::LogSinkCollects },
+	{ "TraceChromeExport", Test::TraceChromeExport }
+};
+
+static const int N_TESTS = sizeof(TESTS) / sizeof(TESTS[0]);  /**< Anzahl der Tests */
+
+/*! \brief Fuehrt einen Test aus und gibt das Ergebnis aus
+ *  \param a_test Test
+ *  \return true, falls bestanden
+ */
+static bool run(const TestCase &a_test)
+{
+	std::cout << "[ TEST ] " << a_test.name_ << std::endl;
+	bool passed = a_test.test_();
+	std::cout << std::endl << (passed ? "[  OK  ] " : "[FEHLER] ")
+			<< a_test.name_ << std::endl;
+	return passed;
+}
+
+/*! \brief Testprogramm
+ */
+int main(int argc, char *argv[])
+{
+	if (argc == 2 && std::strcmp(argv[1], "--list") == 0)
+	{
+		for (int t = 0; t < N_TESTS; t++)
+		{
+			std::cout << TESTS[t].name_ << std::endl;
+		}
+		return 0;
+	}
+
+	int nFailed = 0;
+	int nRun = 0;
+	for (int t = 0; t < N_TESTS; t++)
+	{
+		bool selected = (argc == 1);
+		for (int a = 1; a < argc; a++)
+		{
+			selected = selected || std::strcmp(argv[a], TESTS[t].name_) == 0;
+		}
+		if (selected)
+		{
+			nRun++;
+			nFailed += run(TESTS[t]) ? 0 : 1;
+		}
+	}
+	if (nRun < argc - 1)
+	{
+		std::cerr << "Unknown test name (see --list)." << std::endl;
+		return 1;
+	}
+	std::cout << nRun - nFailed << " von " << nRun << " Tests bestanden"
+			<< std::endl;
+	return (nFailed == 0) ? 0 : 1;
+}
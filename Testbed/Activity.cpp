@@ -0,0 +1,156 @@
+/*! \file Activity.cpp
+ *  \brief Implementierung der Klasse Activity
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "Activity.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+Activity::Activity(const std::vector<NetActivity> &a_nets,
+		sgnl::Nanoseconds a_duration, int a_nGates) :
+		nets_(a_nets), duration_(a_duration), nGates_(a_nGates)
+{
+
+}
+
+const std::vector<NetActivity>& Activity::nets() const
+{
+	return nets_;
+}
+
+sgnl::Nanoseconds Activity::duration() const
+{
+	return duration_;
+}
+
+long long Activity::totalToggles() const
+{
+	long long sum = 0;
+	for (int n = 0; n < static_cast<int>(nets_.size()); n++)
+	{
+		if (nets_[n].kind_ != NetKind::OUTPUT)
+		{
+			sum += nets_[n].toggles_;
+		}
+	}
+	return sum;
+}
+
+double Activity::activityFactor() const
+{
+	int nNets = 0;
+	for (int n = 0; n < static_cast<int>(nets_.size()); n++)
+	{
+		nNets += (nets_[n].kind_ != NetKind::OUTPUT) ? 1 : 0;
+	}
+	if (nNets == 0 || duration_ <= 0)
+	{
+		return 0;
+	}
+	return static_cast<double>(totalToggles()) / nNets / duration_;
+}
+
+double Activity::eventDrivenRatio() const
+{
+	if (nGates_ == 0 || duration_ <= 0)
+	{
+		return 0;
+	}
+	double events = 0;
+	for (int n = 0; n < static_cast<int>(nets_.size()); n++)
+	{
+		events += static_cast<double>(nets_[n].toggles_) * nets_[n].fanout_;
+	}
+	return events / nGates_ / duration_;
+}
+
+std::vector<NetActivity> Activity::hottest(int a_n) const
+{
+	vector<NetActivity> ret;
+	for (int n = 0; n < static_cast<int>(nets_.size()); n++)
+	{
+		if (nets_[n].kind_ != NetKind::OUTPUT)
+		{
+			ret.push_back(nets_[n]);
+		}
+	}
+	a_n = max(0, min(a_n, static_cast<int>(ret.size())));
+	partial_sort(ret.begin(), ret.begin() + a_n, ret.end(),
+			[](const NetActivity &a_a, const NetActivity &a_b)
+			{
+				return a_a.toggles_ > a_b.toggles_;
+			});
+	ret.resize(a_n);
+	return ret;
+}
+
+std::vector<int> Activity::histogram() const
+{
+	vector<int> ret;
+	for (int n = 0; n < static_cast<int>(nets_.size()); n++)
+	{
+		if (nets_[n].kind_ == NetKind::OUTPUT)
+		{
+			continue;
+		}
+		int bin = 0;
+		for (int t = nets_[n].toggles_; t > 0; t >>= 1)
+		{
+			bin++;
+		}
+		if (bin >= static_cast<int>(ret.size()))
+		{
+			ret.resize(bin + 1, 0);
+		}
+		ret[bin]++;
+	}
+	return ret;
+}
+
+void Activity::report(std::ostream &a_os, int a_topN) const
+{
+	ios_base::fmtflags flags = a_os.flags();
+	streamsize precision = a_os.precision();
+	a_os << "Activity over " << duration_ << " ns: " << totalToggles()
+			<< " toggles, activity factor " << setprecision(4)
+			<< activityFactor() << ", event-driven evaluations "
+			<< fixed << setprecision(1) << 100 * eventDrivenRatio()
+			<< " % of cycle-based" << endl;
+
+	vector<int> bins = histogram();
+	int maxCount = 1;
+	for (int b = 0; b < static_cast<int>(bins.size()); b++)
+	{
+		maxCount = max(maxCount, bins[b]);
+	}
+	a_os << "toggles per net:" << endl;
+	for (int b = 0; b < static_cast<int>(bins.size()); b++)
+	{
+		string range = to_string(b);
+		if (b > 1)
+		{
+			range = to_string(1LL << (b - 1)) + "-" + to_string((1LL << b) - 1);
+		}
+		a_os << setw(24) << range << setw(10) << bins[b] << " "
+				<< string((bins[b] * 40 + maxCount - 1) / maxCount, '#')
+				<< endl;
+	}
+
+	vector<NetActivity> top = hottest(a_topN);
+	a_os << "hottest nets:" << endl;
+	for (int n = 0; n < static_cast<int>(top.size()); n++)
+	{
+		const char *kind = (top[n].kind_ == NetKind::INPUT) ? "in" : "gate";
+		a_os << setw(24) << top[n].name_ << setw(6) << kind << setw(10)
+				<< top[n].toggles_ << setw(8) << top[n].fanout_ << endl;
+	}
+	a_os.flags(flags);
+	a_os.precision(precision);
+}
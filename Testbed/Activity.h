@@ -0,0 +1,109 @@
+/*! \file Activity.h
+ *  \brief Definition der Klasse Activity (Schaltaktivitaet je Netz)
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef TESTBED_ACTIVITY_H_
+#define TESTBED_ACTIVITY_H_
+
+#include "../signal/Signal.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/*! \brief Art eines Netzes
+ */
+enum class NetKind
+{
+	INPUT,       /**< Network-Input */
+	GATE_OUTPUT, /**< Gate-Output-Pin */
+	OUTPUT       /**< Network-Output (derselbe Draht wie ein Gate-Output) */
+};
+
+/*! \brief Schaltaktivitaet eines Netzes
+ */
+struct NetActivity
+{
+	NetKind kind_;     /**< Art des Netzes */
+	std::string name_; /**< Name des Network-Inputs/-Outputs bzw. "<Gate>:<Index>" */
+	int toggles_;      /**< Anzahl der Logiklevel-Wechsel */
+	int fanout_;       /**< Anzahl getriebener Gate-Inputs (Network-Outputs: 0) */
+};
+
+/*! \class Activity
+ *  \brief Anzahl der Logiklevel-Wechsel je Netz ueber eine Simulation
+ *  (siehe Testbed::activity()). Grundlage fuer Verlustleistungsabschaetzungen
+ *  und fuer die Frage, wo sich die Ereignisse konzentrieren
+ */
+class Activity
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_nets Aktivitaet je Netz
+	 *  \param a_duration Simulierte Zeit / ns
+	 *  \param a_nGates Anzahl der Gates des Networks
+	 */
+	Activity(const std::vector<NetActivity> &a_nets,
+			sgnl::Nanoseconds a_duration, int a_nGates);
+
+	/*! \brief Gibt die Aktivitaet aller Netze zurueck (Network-Inputs,
+	 *  Gate-Outputs, Network-Outputs)
+	 *  \return Netze
+	 */
+	const std::vector<NetActivity>& nets() const;
+
+	/*! \brief Gibt die simulierte Zeit zurueck
+	 *  \return Zeit / ns
+	 */
+	sgnl::Nanoseconds duration() const;
+
+	/*! \brief Summe der Wechsel aller Network-Inputs und Gate-Outputs
+	 *  (Network-Outputs werden nicht doppelt gezaehlt)
+	 *  \return Anzahl der Wechsel
+	 */
+	long long totalToggles() const;
+
+	/*! \brief Mittlere Schaltaktivitaet: Wechsel je Netz und ns (ohne
+	 *  Network-Outputs)
+	 *  \return Aktivitaetsfaktor (0 = keine Wechsel, 1 = jedes Netz wechselt
+	 *  in jeder ns)
+	 */
+	double activityFactor() const;
+
+	/*! \brief Geschaetzter Anteil der Gate-Auswertungen, die ein
+	 *  ereignisgesteuerter Simulator braeuchte: je Wechsel eine Auswertung
+	 *  jedes getriebenen Gate-Inputs, bezogen auf nGates Auswertungen je ns.
+	 *  Werte deutlich unter 1 sprechen fuer eine ereignisgesteuerte Engine
+	 *  \return Verhaeltnis, 0 bei leerer Simulation
+	 */
+	double eventDrivenRatio() const;
+
+	/*! \brief Gibt die Network-Inputs und Gate-Outputs mit den meisten
+	 *  Wechseln zurueck
+	 *  \param a_n Hoechstzahl der Netze
+	 *  \return Netze, nach Wechseln absteigend sortiert
+	 */
+	std::vector<NetActivity> hottest(int a_n) const;
+
+	/*! \brief Histogramm der Wechsel je Netz (ohne Network-Outputs) in
+	 *  Zweierpotenz-Klassen: Eintrag 0 zaehlt die Netze ohne Wechsel,
+	 *  Eintrag k >= 1 die Netze mit 2^(k-1) bis 2^k - 1 Wechseln
+	 *  \return Anzahl der Netze je Klasse (letzte Klasse nicht leer)
+	 */
+	std::vector<int> histogram() const;
+
+	/*! \brief Schreibt Kennzahlen, Histogramm und die aktivsten Netze
+	 *  \param a_os Ausgabe
+	 *  \param a_topN Anzahl der ausgegebenen Netze
+	 */
+	void report(std::ostream &a_os, int a_topN = 10) const;
+
+private:
+	std::vector<NetActivity> nets_; /**< Aktivitaet je Netz */
+	sgnl::Nanoseconds duration_;    /**< Simulierte Zeit */
+	int nGates_;                    /**< Anzahl der Gates */
+};
+
+#endif /* TESTBED_ACTIVITY_H_ */
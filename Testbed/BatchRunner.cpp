@@ -0,0 +1,181 @@
+/*! \file BatchRunner.cpp
+ *  \brief Implementierung der Klassen Scenario und BatchRunner
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "BatchRunner.h"
+#include "../util/ThreadPool.h"
+#include "../diag/Log.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+using namespace sgnl;
+
+Scenario::Scenario(const std::string &a_id, sgnl::Nanoseconds a_duration,
+		unsigned int a_seed) :
+		id_(a_id), duration_(a_duration), seed_(a_seed), stableFor_(0), stopOnFailure_(
+				false)
+{
+
+}
+
+void Scenario::addSource(const std::string &a_inputName,
+		const Source &a_source)
+{
+	sources_.push_back(
+			pair<string, shared_ptr<const Source> >(a_inputName,
+					shared_ptr<const Source>(a_source.clone())));
+}
+
+void Scenario::setStopWhenStable(sgnl::Nanoseconds a_stableFor)
+{
+	stableFor_ = a_stableFor;
+}
+
+void Scenario::setStopPredicate(const StopPredicate &a_predicate)
+{
+	stopPredicate_ = a_predicate;
+}
+
+void Scenario::addMonitor(const Monitor &a_monitor)
+{
+	monitors_.push_back(shared_ptr<const Monitor>(a_monitor.clone()));
+}
+
+void Scenario::setStopOnFailure(bool a_stop)
+{
+	stopOnFailure_ = a_stop;
+}
+
+std::string Scenario::id() const
+{
+	return id_;
+}
+
+sgnl::Nanoseconds Scenario::duration() const
+{
+	return duration_;
+}
+
+unsigned int Scenario::seed() const
+{
+	return seed_;
+}
+
+const std::vector<std::pair<std::string, std::shared_ptr<const Source> > >&
+Scenario::sources() const
+{
+	return sources_;
+}
+
+sgnl::Nanoseconds Scenario::stopWhenStable() const
+{
+	return stableFor_;
+}
+
+const StopPredicate& Scenario::stopPredicate() const
+{
+	return stopPredicate_;
+}
+
+const std::vector<std::shared_ptr<const Monitor> >& Scenario::monitors() const
+{
+	return monitors_;
+}
+
+bool Scenario::stopOnFailure() const
+{
+	return stopOnFailure_;
+}
+
+BatchRunner::BatchRunner(const Network &a_network, int a_nThreads) :
+		network_(new CompiledNetwork(a_network)), nThreads_(a_nThreads)
+{
+	if (!network_->valid())
+	{
+		DFSM_LOG_ERROR("BatchRunner", "Network is not consistent.");
+	}
+}
+
+void BatchRunner::addScenario(const Scenario &a_scenario)
+{
+	scenarios_.push_back(a_scenario);
+}
+
+std::vector<ScenarioResult> BatchRunner::run() const
+{
+	vector<ScenarioResult> results(scenarios_.size());
+	ThreadPool pool(nThreads_);
+	for (int s = 0; s < static_cast<int>(scenarios_.size()); s++)
+	{
+		pool.submit([this, s, &results]()
+		{
+			results[s] = runScenario(scenarios_[s]);
+		});
+	}
+	pool.wait();
+	return results;
+}
+
+std::shared_ptr<const CompiledNetwork> BatchRunner::network() const
+{
+	return network_;
+}
+
+ScenarioResult BatchRunner::runScenario(const Scenario &a_scenario) const
+{
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	ScenarioResult result;
+	result.id_ = a_scenario.id();
+	result.ok_ = true;
+
+	Testbed testbed(network_, a_scenario.seed());
+	testbed.setRecording(false);
+	testbed.setPlotting(false);
+	for (int i = 0; i < static_cast<int>(a_scenario.sources().size()); i++)
+	{
+		if (!testbed.addSource(a_scenario.sources()[i].first,
+				*a_scenario.sources()[i].second))
+		{
+			result.ok_ = false;
+		}
+	}
+	for (int m = 0; m < static_cast<int>(a_scenario.monitors().size()); m++)
+	{
+		if (!testbed.addMonitor(*a_scenario.monitors()[m]))
+		{
+			result.ok_ = false;
+		}
+	}
+	testbed.setStopOnFailure(a_scenario.stopOnFailure());
+	testbed.setStopWhenStable(a_scenario.stopWhenStable());
+	testbed.setStopPredicate(a_scenario.stopPredicate());
+	result.stopReason_ = testbed.simulationstep(a_scenario.duration());
+	result.simulatedTime_ = testbed.time();
+	if (result.stopReason_ == StopReason::ERROR)
+	{
+		result.ok_ = false;
+	}
+
+	for (int o = 0; o < network_->nOutputs(); o++)
+	{
+		string outName = network_->outputNames()[o];
+		result.finalOutputs_[outName] = testbed.output(o);
+		result.outputTransitions_[outName] = testbed.outputTransitions(o);
+	}
+	for (int m = 0; m < testbed.nMonitors(); m++)
+	{
+		const Monitor &monitor = testbed.monitor(m);
+		if (monitor.nFailures() > 0)
+		{
+			result.monitorFailures_[monitor.name()] = monitor.failures();
+		}
+	}
+	result.report_ = testbed.runReport();
+	result.wallSeconds_ = chrono::duration<double>(
+			chrono::steady_clock::now() - start).count();
+	return result;
+}
@@ -0,0 +1,181 @@
+/*! \file BatchRunner.h
+ *  \brief Definition der Klassen Scenario, ScenarioResult und BatchRunner
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef TESTBED_BATCHRUNNER_H_
+#define TESTBED_BATCHRUNNER_H_
+
+#include "Testbed.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*! \class Scenario
+ *  \brief Beschreibt einen Simulationslauf des BatchRunner: welche
+ *  Signalquelle an welchem Network-Input anliegt, wie lange simuliert wird
+ *  und mit welchem Startwert das Rauschen erzeugt wird
+ */
+class Scenario
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_id Bezeichnung des Szenarios (z. B. fuer Ergebnisdateien)
+	 *  \param a_duration Simulationsdauer / ns
+	 *  \param a_seed Startwert des Zufallsgenerators fuer das Rauschen
+	 */
+	Scenario(const std::string &a_id, sgnl::Nanoseconds a_duration,
+			unsigned int a_seed = 0);
+
+	/*! \brief Legt die Signalquelle fuer einen Network-Input fest. Es wird
+	 *  eine Kopie der Quelle gespeichert
+	 *  \param a_inputName Name des Network-Inputs
+	 *  \param a_source Signalquelle
+	 */
+	void addSource(const std::string &a_inputName, const Source &a_source);
+
+	/*! \brief Lauf beenden, sobald sich kein Network-Output mehr fuer die
+	 *  angegebene Dauer geaendert hat (siehe Testbed::setStopWhenStable(...))
+	 *  \param a_stableFor geforderte Dauer ohne Wechsel / ns, 0 = aus
+	 */
+	void setStopWhenStable(sgnl::Nanoseconds a_stableFor);
+
+	/*! \brief Lauf beenden, sobald die Bedingung erfuellt ist (siehe
+	 *  Testbed::setStopPredicate(...)). Die Bedingung wird von mehreren
+	 *  Threads gleichzeitig aufgerufen und darf keinen gemeinsamen Zustand
+	 *  veraendern
+	 *  \param a_predicate Abbruchbedingung, leere Funktion = aus
+	 */
+	void setStopPredicate(const StopPredicate &a_predicate);
+
+	/*! \brief Fuegt einen Monitor hinzu, der in jedem Lauf ausgewertet wird.
+	 *  Es wird eine Kopie gespeichert
+	 *  \param a_monitor Monitor
+	 */
+	void addMonitor(const Monitor &a_monitor);
+
+	/*! \brief Lauf beim ersten Monitor-Fehler beenden
+	 *  \param a_stop true = abbrechen
+	 */
+	void setStopOnFailure(bool a_stop);
+
+	/*! \brief Gibt die Bezeichnung des Szenarios zurueck
+	 *  \return Bezeichnung
+	 */
+	std::string id() const;
+
+	/*! \brief Gibt die Simulationsdauer zurueck
+	 *  \return Simulationsdauer / ns
+	 */
+	sgnl::Nanoseconds duration() const;
+
+	/*! \brief Gibt den Startwert des Zufallsgenerators zurueck
+	 *  \return Startwert
+	 */
+	unsigned int seed() const;
+
+	/*! \brief Gibt die Signalquellen nach Network-Input-Namen zurueck
+	 *  \return Signalquellen (Vorlagen, werden pro Lauf kopiert)
+	 */
+	const std::vector<std::pair<std::string, std::shared_ptr<const Source> > >&
+	sources() const;
+
+	/*! \brief Gibt die geforderte stabile Dauer zurueck
+	 *  \return Dauer / ns, 0 = aus
+	 */
+	sgnl::Nanoseconds stopWhenStable() const;
+
+	/*! \brief Gibt die Abbruchbedingung zurueck
+	 *  \return Abbruchbedingung, leer = aus
+	 */
+	const StopPredicate& stopPredicate() const;
+
+	/*! \brief Gibt die Monitore zurueck
+	 *  \return Monitore (Vorlagen, werden pro Lauf kopiert)
+	 */
+	const std::vector<std::shared_ptr<const Monitor> >& monitors() const;
+
+	/*! \brief Gibt zurueck, ob beim ersten Monitor-Fehler abgebrochen wird
+	 *  \return true = abbrechen
+	 */
+	bool stopOnFailure() const;
+
+private:
+	std::string id_;              /**< Bezeichnung */
+	sgnl::Nanoseconds duration_;  /**< Simulationsdauer / ns */
+	unsigned int seed_;           /**< Startwert fuer das Rauschen */
+	sgnl::Nanoseconds stableFor_; /**< Abbruch bei stabilen Outputs / ns */
+	StopPredicate stopPredicate_; /**< Benutzerdefinierte Abbruchbedingung */
+	std::vector<std::shared_ptr<const Monitor> > monitors_;  /**< Monitore */
+	bool stopOnFailure_;          /**< Abbruch beim ersten Monitor-Fehler */
+	std::vector<std::pair<std::string, std::shared_ptr<const Source> > >
+	sources_;  /**< Signalquellen je Network-Input */
+};
+
+/*! \brief Zusammenfassung eines Simulationslaufs des BatchRunner
+ */
+struct ScenarioResult
+{
+	std::string id_;                   /**< Bezeichnung des Szenarios */
+	bool ok_;                          /**< Lauf erfolgreich durchgefuehrt */
+	sgnl::Nanoseconds simulatedTime_;  /**< Simulierte Zeit / ns */
+	StopReason stopReason_;            /**< Grund fuer das Ende des Laufs */
+	double wallSeconds_;               /**< Benoetigte Rechenzeit / s */
+	std::map<std::string, sgnl::Volt> finalOutputs_;  /**< Outputspannungen
+		am Ende des Laufs */
+	std::map<std::string, int> outputTransitions_;    /**< Anzahl der
+		Logiklevel-Wechsel je Network-Output */
+	std::map<std::string, std::vector<MonitorFailure> > monitorFailures_;
+		/**< Gespeicherte Fehler je Monitor (nur Monitore mit Fehlern) */
+	RunReport report_;                 /**< Testbed::runReport() am Ende des
+		Laufs (Speicherbedarf und Phasen prozessweit) */
+};
+
+/*! \class BatchRunner
+ *  \brief Simuliert dasselbe Network unter vielen Szenarien. Das Network wird
+ *  nur einmal uebersetzt und auf Konsistenz geprueft; jedes Szenario erhaelt
+ *  nur seinen eigenen Simulationszustand und seine eigenen Quellen. Die
+ *  Szenarien werden auf einen Thread-Pool verteilt
+ */
+class BatchRunner
+{
+public:
+	/*! \brief Konstruktor. Uebersetzt das Network
+	 *  \param a_network Zu simulierendes Network
+	 *  \param a_nThreads Anzahl der Threads, 0 = Anzahl der Prozessorkerne
+	 */
+	BatchRunner(const Network &a_network, int a_nThreads = 0);
+
+	/*! \brief Fuegt ein Szenario hinzu
+	 *  \param a_scenario Szenario
+	 */
+	void addScenario(const Scenario &a_scenario);
+
+	/*! \brief Fuehrt alle Szenarien aus
+	 *  \return Ergebnisse in der Reihenfolge der hinzugefuegten Szenarien
+	 */
+	std::vector<ScenarioResult> run() const;
+
+	/*! \brief Gibt das uebersetzte Network zurueck
+	 *  \return Geteiltes, uebersetztes Network
+	 */
+	std::shared_ptr<const CompiledNetwork> network() const;
+
+private:
+	/*! \brief Fuehrt ein einzelnes Szenario aus
+	 *  \param a_scenario Szenario
+	 *  \return Ergebnis des Szenarios
+	 */
+	ScenarioResult runScenario(const Scenario &a_scenario) const;
+
+	std::shared_ptr<const CompiledNetwork> network_;  /**< Uebersetztes
+		Network, von allen Szenarien geteilt */
+	std::vector<Scenario> scenarios_;  /**< Auszufuehrende Szenarien */
+	int nThreads_;                     /**< Anzahl der Threads */
+};
+
+#endif /* TESTBED_BATCHRUNNER_H_ */
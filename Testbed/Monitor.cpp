@@ -0,0 +1,377 @@
+/*! \file Monitor.cpp
+ *  \brief Implementierung der Klassen Probe, Monitor, EdgeEquality,
+ *  SetupHold und EdgeCounter
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "Monitor.h"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace std;
+using namespace sgnl;
+
+const int Monitor::MAX_RECORDED_FAILURES;
+const int EdgeEquality::MAX_DELAY_EDGES;
+
+Probe::Probe(const std::string &a_name) :
+		name_(a_name), output_(false), idx_(-1), level_(false), primed_(false)
+{
+
+}
+
+bool Probe::bind(const CompiledNetwork &a_network)
+{
+	idx_ = a_network.inputIndex(name_);
+	output_ = false;
+	if (idx_ < 0)
+	{
+		idx_ = a_network.outputIndex(name_);
+		output_ = true;
+	}
+	return idx_ >= 0;
+}
+
+bool Probe::update(const sgnl::Volt *a_inputs, const sgnl::Volt *a_outputs)
+{
+	Volt voltage = output_ ? a_outputs[idx_] : a_inputs[idx_];
+	bool level = level_;
+	if (voltage >= HIGH_THRESH_VOLT + DEADBAND_VOLT / 2)
+	{
+		level = true;
+	}
+	else if (voltage <= HIGH_THRESH_VOLT - DEADBAND_VOLT / 2)
+	{
+		level = false;
+	}
+	if (!primed_)
+	{
+		primed_ = true;
+		level_ = level;
+		return false;
+	}
+	bool changed = level != level_;
+	level_ = level;
+	return changed;
+}
+
+bool Probe::isEdge(Edge a_edge) const
+{
+	return a_edge == Edge::BOTH || (a_edge == Edge::RISING) == level_;
+}
+
+bool Probe::level() const
+{
+	return level_;
+}
+
+const std::string& Probe::name() const
+{
+	return name_;
+}
+
+void Probe::saveState(Checkpoint &a_checkpoint) const
+{
+	a_checkpoint.writeInt((level_ ? 1 : 0) | (primed_ ? 2 : 0));
+}
+
+bool Probe::restoreState(Checkpoint &a_checkpoint)
+{
+	int32_t flags = 0;
+	if (!a_checkpoint.readInt(flags))
+	{
+		return false;
+	}
+	level_ = (flags & 1) != 0;
+	primed_ = (flags & 2) != 0;
+	return true;
+}
+
+Monitor::Monitor(const std::string &a_name) :
+		name_(a_name), nFailures_(0)
+{
+
+}
+
+Monitor::~Monitor()
+{
+
+}
+
+const std::string& Monitor::name() const
+{
+	return name_;
+}
+
+int Monitor::nFailures() const
+{
+	return nFailures_;
+}
+
+const std::vector<MonitorFailure>& Monitor::failures() const
+{
+	return failures_;
+}
+
+void Monitor::saveState(Checkpoint &a_checkpoint) const
+{
+	a_checkpoint.writeInt(nFailures_);
+	a_checkpoint.writeInt(static_cast<int>(failures_.size()));
+	for (int i = 0; i < static_cast<int>(failures_.size()); i++)
+	{
+		a_checkpoint.writeInt(failures_[i].time_);
+		a_checkpoint.writeString(failures_[i].message_);
+	}
+	writeState(a_checkpoint);
+}
+
+bool Monitor::restoreState(Checkpoint &a_checkpoint)
+{
+	int32_t nFailures = 0;
+	int32_t nRecorded = 0;
+	if (!a_checkpoint.readInt(nFailures) || !a_checkpoint.readInt(nRecorded)
+			|| nRecorded < 0 || nRecorded > MAX_RECORDED_FAILURES)
+	{
+		return false;
+	}
+	vector<MonitorFailure> failures(nRecorded);
+	for (int i = 0; i < nRecorded; i++)
+	{
+		int32_t time = 0;
+		if (!a_checkpoint.readInt(time)
+				|| !a_checkpoint.readString(failures[i].message_))
+		{
+			return false;
+		}
+		failures[i].time_ = time;
+	}
+	if (!readState(a_checkpoint))
+	{
+		return false;
+	}
+	nFailures_ = nFailures;
+	failures_.swap(failures);
+	return true;
+}
+
+void Monitor::fail(sgnl::Nanoseconds a_time, const std::string &a_message)
+{
+	nFailures_++;
+	if (static_cast<int>(failures_.size()) < MAX_RECORDED_FAILURES)
+	{
+		MonitorFailure failure;
+		failure.time_ = a_time;
+		failure.message_ = a_message;
+		failures_.push_back(failure);
+	}
+}
+
+EdgeEquality::EdgeEquality(const std::string &a_name,
+		const std::string &a_clock, const std::string &a_expected,
+		const std::string &a_actual, int a_delayEdges, Edge a_edge) :
+		Monitor(a_name), clock_(a_clock), expected_(a_expected), actual_(
+				a_actual), delayEdges_(
+				max(1, min(MAX_DELAY_EDGES, a_delayEdges))), edge_(a_edge), history_(
+				0), nHistory_(0)
+{
+
+}
+
+Monitor* EdgeEquality::clone() const
+{
+	return new EdgeEquality(*this);
+}
+
+bool EdgeEquality::bind(const CompiledNetwork &a_network)
+{
+	return clock_.bind(a_network) && expected_.bind(a_network)
+			&& actual_.bind(a_network);
+}
+
+void EdgeEquality::step(sgnl::Nanoseconds a_time, const sgnl::Volt *a_inputs,
+		const sgnl::Volt *a_outputs)
+{
+	bool clockChanged = clock_.update(a_inputs, a_outputs);
+	expected_.update(a_inputs, a_outputs);
+	actual_.update(a_inputs, a_outputs);
+	if (!clockChanged || !clock_.isEdge(edge_))
+	{
+		return;
+	}
+	if (nHistory_ >= delayEdges_)
+	{
+		bool expected = ((history_ >> (delayEdges_ - 1)) & 1) != 0;
+		if (actual_.level() != expected)
+		{
+			ostringstream message;
+			message << actual_.name() << " is " << (actual_.level() ? 1 : 0)
+					<< ", expected " << expected_.name() << " from "
+					<< delayEdges_ << " " << clock_.name()
+					<< " edge(s) before (" << (expected ? 1 : 0) << ")";
+			fail(a_time, message.str());
+		}
+	}
+	history_ = (history_ << 1) | (expected_.level() ? 1 : 0);
+	nHistory_ = min(nHistory_ + 1, delayEdges_);
+}
+
+void EdgeEquality::writeState(Checkpoint &a_checkpoint) const
+{
+	clock_.saveState(a_checkpoint);
+	expected_.saveState(a_checkpoint);
+	actual_.saveState(a_checkpoint);
+	a_checkpoint.writeInt64(static_cast<int64_t>(history_));
+	a_checkpoint.writeInt(nHistory_);
+}
+
+bool EdgeEquality::readState(Checkpoint &a_checkpoint)
+{
+	int64_t history = 0;
+	int32_t nHistory = 0;
+	if (!clock_.restoreState(a_checkpoint)
+			|| !expected_.restoreState(a_checkpoint)
+			|| !actual_.restoreState(a_checkpoint)
+			|| !a_checkpoint.readInt64(history)
+			|| !a_checkpoint.readInt(nHistory))
+	{
+		return false;
+	}
+	history_ = static_cast<uint64_t>(history);
+	nHistory_ = nHistory;
+	return true;
+}
+
+SetupHold::SetupHold(const std::string &a_name, const std::string &a_clock,
+		const std::string &a_data, sgnl::Nanoseconds a_setup,
+		sgnl::Nanoseconds a_hold, Edge a_edge) :
+		Monitor(a_name), clock_(a_clock), data_(a_data), setup_(a_setup), hold_(
+				a_hold), edge_(a_edge), lastClockEdge_(-1), lastDataChange_(-1)
+{
+
+}
+
+Monitor* SetupHold::clone() const
+{
+	return new SetupHold(*this);
+}
+
+bool SetupHold::bind(const CompiledNetwork &a_network)
+{
+	return clock_.bind(a_network) && data_.bind(a_network);
+}
+
+void SetupHold::step(sgnl::Nanoseconds a_time, const sgnl::Volt *a_inputs,
+		const sgnl::Volt *a_outputs)
+{
+	bool clockEdge = clock_.update(a_inputs, a_outputs) && clock_.isEdge(edge_);
+	bool dataChanged = data_.update(a_inputs, a_outputs);
+
+	// Hold gegen die vorherige Flanke pruefen, eine gleichzeitige Aenderung
+	// zaehlt als Setup-Verletzung der aktuellen Flanke
+	if (dataChanged)
+	{
+		if (lastClockEdge_ >= 0 && a_time - lastClockEdge_ < hold_)
+		{
+			ostringstream message;
+			message << data_.name() << " changed " << a_time - lastClockEdge_
+					<< " ns after " << clock_.name() << " edge (hold "
+					<< hold_ << " ns)";
+			fail(a_time, message.str());
+		}
+		lastDataChange_ = a_time;
+	}
+	if (clockEdge)
+	{
+		if (lastDataChange_ >= 0 && a_time - lastDataChange_ < setup_)
+		{
+			ostringstream message;
+			message << data_.name() << " changed " << a_time - lastDataChange_
+					<< " ns before " << clock_.name() << " edge (setup "
+					<< setup_ << " ns)";
+			fail(a_time, message.str());
+		}
+		lastClockEdge_ = a_time;
+	}
+}
+
+void SetupHold::writeState(Checkpoint &a_checkpoint) const
+{
+	clock_.saveState(a_checkpoint);
+	data_.saveState(a_checkpoint);
+	a_checkpoint.writeInt(lastClockEdge_);
+	a_checkpoint.writeInt(lastDataChange_);
+}
+
+bool SetupHold::readState(Checkpoint &a_checkpoint)
+{
+	int32_t lastClockEdge = 0;
+	int32_t lastDataChange = 0;
+	if (!clock_.restoreState(a_checkpoint) || !data_.restoreState(a_checkpoint)
+			|| !a_checkpoint.readInt(lastClockEdge)
+			|| !a_checkpoint.readInt(lastDataChange))
+	{
+		return false;
+	}
+	lastClockEdge_ = lastClockEdge;
+	lastDataChange_ = lastDataChange;
+	return true;
+}
+
+EdgeCounter::EdgeCounter(const std::string &a_name,
+		const std::string &a_signal, Edge a_edge, int a_maxCount) :
+		Monitor(a_name), signal_(a_signal), edge_(a_edge), maxCount_(
+				a_maxCount), count_(0)
+{
+
+}
+
+Monitor* EdgeCounter::clone() const
+{
+	return new EdgeCounter(*this);
+}
+
+bool EdgeCounter::bind(const CompiledNetwork &a_network)
+{
+	return signal_.bind(a_network);
+}
+
+void EdgeCounter::step(sgnl::Nanoseconds a_time, const sgnl::Volt *a_inputs,
+		const sgnl::Volt *a_outputs)
+{
+	if (!signal_.update(a_inputs, a_outputs) || !signal_.isEdge(edge_))
+	{
+		return;
+	}
+	count_++;
+	if (maxCount_ >= 0 && count_ > maxCount_)
+	{
+		ostringstream message;
+		message << signal_.name() << ": edge " << count_ << " exceeds limit of "
+				<< maxCount_;
+		fail(a_time, message.str());
+	}
+}
+
+int EdgeCounter::count() const
+{
+	return count_;
+}
+
+void EdgeCounter::writeState(Checkpoint &a_checkpoint) const
+{
+	signal_.saveState(a_checkpoint);
+	a_checkpoint.writeInt(count_);
+}
+
+bool EdgeCounter::readState(Checkpoint &a_checkpoint)
+{
+	int32_t count = 0;
+	if (!signal_.restoreState(a_checkpoint) || !a_checkpoint.readInt(count))
+	{
+		return false;
+	}
+	count_ = count;
+	return true;
+}
@@ -0,0 +1,316 @@
+/*! \file Monitor.h
+ *  \brief Definition der Klassen Probe, Monitor, EdgeEquality, SetupHold und
+ *  EdgeCounter
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef TESTBED_MONITOR_H_
+#define TESTBED_MONITOR_H_
+
+#include "../network/CompiledNetwork.h"
+#include "../fileIO/Checkpoint.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*! \brief Auszuwertende Flanke eines Signals
+ */
+enum class Edge
+{
+	RISING,   /**< LOW -> HIGH */
+	FALLING,  /**< HIGH -> LOW */
+	BOTH      /**< Beide Flanken */
+};
+
+/*! \brief Ein von einem Monitor erkannter Fehler
+ */
+struct MonitorFailure
+{
+	sgnl::Nanoseconds time_;  /**< Zeitpunkt des Fehlers / ns */
+	std::string message_;     /**< Beschreibung des Fehlers */
+};
+
+/*! \class Probe
+ *  \brief Beobachtet einen Network-Input oder -Output und verfolgt dessen
+ *  Logiklevel (mit Totband wie die Gates). Konstanter Speicherbedarf
+ */
+class Probe
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_name Name des Network-Inputs oder -Outputs
+	 */
+	Probe(const std::string &a_name);
+
+	/*! \brief Loest den Namen im Network auf. Inputs haben Vorrang
+	 *  \param a_network Network
+	 *  \return true, falls das Signal existiert, false sonst
+	 */
+	bool bind(const CompiledNetwork &a_network);
+
+	/*! \brief Liest die aktuelle Spannung und aktualisiert das Logiklevel.
+	 *  Der erste Aufruf legt nur das Anfangslevel fest
+	 *  \param a_inputs Spannungen der Network-Inputs
+	 *  \param a_outputs Spannungen der Network-Outputs
+	 *  \return true, falls sich das Logiklevel geaendert hat, false sonst
+	 */
+	bool update(const sgnl::Volt *a_inputs, const sgnl::Volt *a_outputs);
+
+	/*! \brief Gibt zurueck, ob die letzte Aenderung eine Flanke der
+	 *  angegebenen Art war
+	 *  \param a_edge Flankenart
+	 *  \return true, falls ja, false sonst
+	 */
+	bool isEdge(Edge a_edge) const;
+
+	/*! \brief Gibt das aktuelle Logiklevel zurueck
+	 *  \return Logiklevel
+	 */
+	bool level() const;
+
+	/*! \brief Gibt den Namen des Signals zurueck
+	 *  \return Name
+	 */
+	const std::string& name() const;
+
+	/*! \brief Haengt den Zustand an einen Checkpoint an
+	 *  \param a_checkpoint Checkpoint
+	 */
+	void saveState(Checkpoint &a_checkpoint) const;
+
+	/*! \brief Liest den mit saveState(...) gespeicherten Zustand
+	 *  \param a_checkpoint Checkpoint
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool restoreState(Checkpoint &a_checkpoint);
+
+private:
+	std::string name_;  /**< Name des Signals */
+	bool output_;       /**< Network-Output (true) oder -Input (false) */
+	int idx_;           /**< Index des Signals, -1 = nicht aufgeloest */
+	bool level_;        /**< Aktuelles Logiklevel */
+	bool primed_;       /**< Anfangslevel bereits festgelegt */
+};
+
+/*! \class Monitor
+ *  \brief Basisklasse aller Pruefungen, die waehrend der Simulation jede
+ *  Nanosekunde mit den aktuellen Input- und Outputspannungen ausgewertet
+ *  werden. Ein Monitor haelt nur konstant viel Zustand, so dass auch lange
+ *  Simulationen ohne Aufzeichnung geprueft werden koennen
+ */
+class Monitor
+{
+public:
+	static const int MAX_RECORDED_FAILURES = 16;  /**< Anzahl der Fehler, die
+		mit Zeitpunkt gespeichert werden, weitere werden nur gezaehlt */
+
+	/*! \brief Konstruktor
+	 *  \param a_name Bezeichnung des Monitors
+	 */
+	Monitor(const std::string &a_name);
+
+	/*! \brief Destruktor
+	 */
+	virtual ~Monitor();
+
+	/*! \brief Erzeugt eine Kopie des Monitors inklusive Zustand. Der Aufrufer
+	 *  uebernimmt den Besitz
+	 *  \return Kopie des Monitors
+	 */
+	virtual Monitor* clone() const = 0;
+
+	/*! \brief Loest die beobachteten Signale im Network auf
+	 *  \param a_network Network
+	 *  \return true, falls alle Signale existieren, false sonst
+	 */
+	virtual bool bind(const CompiledNetwork &a_network) = 0;
+
+	/*! \brief Wertet den Monitor fuer eine Nanosekunde aus
+	 *  \param a_time Aktuelle Simulationszeit
+	 *  \param a_inputs Spannungen der Network-Inputs
+	 *  \param a_outputs Spannungen der Network-Outputs
+	 */
+	virtual void step(sgnl::Nanoseconds a_time, const sgnl::Volt *a_inputs,
+			const sgnl::Volt *a_outputs) = 0;
+
+	/*! \brief Gibt die Bezeichnung des Monitors zurueck
+	 *  \return Bezeichnung
+	 */
+	const std::string& name() const;
+
+	/*! \brief Gibt die Anzahl aller bisher erkannten Fehler zurueck
+	 *  \return Anzahl der Fehler
+	 */
+	int nFailures() const;
+
+	/*! \brief Gibt die ersten MAX_RECORDED_FAILURES Fehler zurueck
+	 *  \return Fehler mit Zeitpunkt
+	 */
+	const std::vector<MonitorFailure>& failures() const;
+
+	/*! \brief Haengt den Zustand an einen Checkpoint an
+	 *  \param a_checkpoint Checkpoint
+	 */
+	void saveState(Checkpoint &a_checkpoint) const;
+
+	/*! \brief Liest den mit saveState(...) gespeicherten Zustand
+	 *  \param a_checkpoint Checkpoint
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool restoreState(Checkpoint &a_checkpoint);
+
+protected:
+	/*! \brief Meldet einen Fehler
+	 *  \param a_time Zeitpunkt des Fehlers
+	 *  \param a_message Beschreibung
+	 */
+	void fail(sgnl::Nanoseconds a_time, const std::string &a_message);
+
+	/*! \brief Haengt den Zustand der abgeleiteten Klasse an einen Checkpoint an
+	 *  \param a_checkpoint Checkpoint
+	 */
+	virtual void writeState(Checkpoint &a_checkpoint) const = 0;
+
+	/*! \brief Liest den mit writeState(...) gespeicherten Zustand
+	 *  \param a_checkpoint Checkpoint
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	virtual bool readState(Checkpoint &a_checkpoint) = 0;
+
+private:
+	std::string name_;                      /**< Bezeichnung */
+	int nFailures_;                         /**< Anzahl aller Fehler */
+	std::vector<MonitorFailure> failures_;  /**< Gespeicherte Fehler */
+};
+
+/*! \class EdgeEquality
+ *  \brief Prueft an jeder Taktflanke, ob ein Signal den Wert hat, den ein
+ *  anderes Signal a_delayEdges Taktflanken vorher hatte (z. B. "Q0 gleich D,
+ *  um eine CLK-Flanke verzoegert")
+ */
+class EdgeEquality: public Monitor
+{
+public:
+	static const int MAX_DELAY_EDGES = 63;  /**< Maximale Verzoegerung */
+
+	/*! \brief Konstruktor
+	 *  \param a_name Bezeichnung des Monitors
+	 *  \param a_clock Taktsignal
+	 *  \param a_expected Signal, dessen verzoegerter Wert erwartet wird
+	 *  \param a_actual Zu pruefendes Signal
+	 *  \param a_delayEdges Verzoegerung in Taktflanken (1..MAX_DELAY_EDGES)
+	 *  \param a_edge Auszuwertende Taktflanke
+	 */
+	EdgeEquality(const std::string &a_name, const std::string &a_clock,
+			const std::string &a_expected, const std::string &a_actual,
+			int a_delayEdges = 1, Edge a_edge = Edge::RISING);
+
+	Monitor* clone() const;
+
+	bool bind(const CompiledNetwork &a_network);
+
+	void step(sgnl::Nanoseconds a_time, const sgnl::Volt *a_inputs,
+			const sgnl::Volt *a_outputs);
+
+protected:
+	void writeState(Checkpoint &a_checkpoint) const;
+
+	bool readState(Checkpoint &a_checkpoint);
+
+private:
+	Probe clock_;       /**< Taktsignal */
+	Probe expected_;    /**< Erwartetes Signal */
+	Probe actual_;      /**< Zu pruefendes Signal */
+	int delayEdges_;    /**< Verzoegerung in Taktflanken */
+	Edge edge_;         /**< Auszuwertende Taktflanke */
+	std::uint64_t history_;  /**< Abgetastete Werte von a_expected, Bit 0 =
+		letzte Flanke */
+	int nHistory_;      /**< Anzahl gueltiger Bits in history_ */
+};
+
+/*! \class SetupHold
+ *  \brief Prueft, dass sich ein Datensignal nicht innerhalb von a_setup ns
+ *  vor bis a_hold ns nach einer Taktflanke aendert
+ */
+class SetupHold: public Monitor
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_name Bezeichnung des Monitors
+	 *  \param a_clock Taktsignal
+	 *  \param a_data Datensignal
+	 *  \param a_setup Setup-Zeit / ns
+	 *  \param a_hold Hold-Zeit / ns
+	 *  \param a_edge Auszuwertende Taktflanke
+	 */
+	SetupHold(const std::string &a_name, const std::string &a_clock,
+			const std::string &a_data, sgnl::Nanoseconds a_setup,
+			sgnl::Nanoseconds a_hold, Edge a_edge = Edge::RISING);
+
+	Monitor* clone() const;
+
+	bool bind(const CompiledNetwork &a_network);
+
+	void step(sgnl::Nanoseconds a_time, const sgnl::Volt *a_inputs,
+			const sgnl::Volt *a_outputs);
+
+protected:
+	void writeState(Checkpoint &a_checkpoint) const;
+
+	bool readState(Checkpoint &a_checkpoint);
+
+private:
+	Probe clock_;                       /**< Taktsignal */
+	Probe data_;                        /**< Datensignal */
+	sgnl::Nanoseconds setup_;           /**< Setup-Zeit */
+	sgnl::Nanoseconds hold_;            /**< Hold-Zeit */
+	Edge edge_;                         /**< Auszuwertende Taktflanke */
+	sgnl::Nanoseconds lastClockEdge_;   /**< Zeitpunkt der letzten Taktflanke,
+		-1 = noch keine */
+	sgnl::Nanoseconds lastDataChange_;  /**< Zeitpunkt der letzten Aenderung
+		des Datensignals, -1 = noch keine */
+};
+
+/*! \class EdgeCounter
+ *  \brief Zaehlt die Flanken eines Signals und meldet einen Fehler, sobald
+ *  eine Hoechstzahl ueberschritten wird
+ */
+class EdgeCounter: public Monitor
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_name Bezeichnung des Monitors
+	 *  \param a_signal Zu zaehlendes Signal
+	 *  \param a_edge Zu zaehlende Flanken
+	 *  \param a_maxCount Hoechstzahl, -1 = unbegrenzt
+	 */
+	EdgeCounter(const std::string &a_name, const std::string &a_signal,
+			Edge a_edge = Edge::RISING, int a_maxCount = -1);
+
+	Monitor* clone() const;
+
+	bool bind(const CompiledNetwork &a_network);
+
+	void step(sgnl::Nanoseconds a_time, const sgnl::Volt *a_inputs,
+			const sgnl::Volt *a_outputs);
+
+	/*! \brief Gibt die Anzahl der bisher gezaehlten Flanken zurueck
+	 *  \return Anzahl der Flanken
+	 */
+	int count() const;
+
+protected:
+	void writeState(Checkpoint &a_checkpoint) const;
+
+	bool readState(Checkpoint &a_checkpoint);
+
+private:
+	Probe signal_;   /**< Zu zaehlendes Signal */
+	Edge edge_;      /**< Zu zaehlende Flanken */
+	int maxCount_;   /**< Hoechstzahl, -1 = unbegrenzt */
+	int count_;      /**< Bisher gezaehlte Flanken */
+};
+
+#endif /* TESTBED_MONITOR_H_ */
@@ -0,0 +1,109 @@
+/*! \file RunReport.cpp
+ *  \brief Implementierung der Struktur RunReport
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "RunReport.h"
+#include "../diag/Json.h"
+#include "../diag/Log.h"
+
+#include <ctime>
+#include <fstream>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+double RunReport::wallSeconds() const
+{
+	return simulationSeconds_ + plottingSeconds_;
+}
+
+double RunReport::nsPerSecond() const
+{
+	if (simulationSeconds_ <= 0)
+	{
+		return 0;
+	}
+	return simulatedNs_ / simulationSeconds_;
+}
+
+double RunReport::evalsPerSecond() const
+{
+	return nsPerSecond() * nGates_;
+}
+
+void RunReport::write(std::ostream &a_os) const
+{
+	char timestamp[32];
+	time_t now = time(nullptr);
+	strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+	streamsize precision = a_os.precision(9);
+	a_os << "{\n  \"report\": \"run\",\n  \"version\": 1,\n"
+			<< "  \"timestamp\": \"" << timestamp << "\",\n  \"network\": ";
+	diag::writeJsonString(a_os, network_);
+	a_os << ",\n  \"gates\": " << nGates_ << ",\n  \"stop_reason\": ";
+	diag::writeJsonString(a_os, stopReason_);
+	a_os << ",\n  \"simulated_ns\": " << simulatedNs_
+			<< ",\n  \"wall_s\": " << wallSeconds() << ",\n  \"simulation_s\": "
+			<< simulationSeconds_ << ",\n  \"plotting_s\": " << plottingSeconds_
+			<< ",\n  \"ns_per_s\": " << nsPerSecond() << ",\n  \"evals_per_s\": "
+			<< evalsPerSecond() << ",\n  \"peak_rss_bytes\": ";
+	if (peakRssBytes_ < 0)
+	{
+		a_os << "null";
+	}
+	else
+	{
+		a_os << peakRssBytes_;
+	}
+	a_os << ",\n  \"waveform_bytes\": " << waveformBytes_
+			<< ",\n  \"profiling\": " << (profiling_ ? "true" : "false")
+			<< ",\n  \"phases\": [";
+	for (int p = 0; p < static_cast<int>(phases_.size()); p++)
+	{
+		a_os << (p == 0 ? "\n" : ",\n") << "    {\"name\": ";
+		diag::writeJsonString(a_os, phases_[p].name_);
+		a_os << ", \"seconds\": " << phases_[p].seconds_ << ", \"calls\": "
+				<< phases_[p].calls_ << "}";
+	}
+	a_os << (phases_.empty() ? "]\n}\n" : "\n  ]\n}\n");
+	a_os.precision(precision);
+	return;
+}
+
+bool RunReport::save(const std::string &a_fileName) const
+{
+	string path = "./Plots/" + a_fileName + ".json";
+	ofstream file(path.c_str());
+	if (!file.is_open())
+	{
+		DFSM_LOG_ERROR("RunReport", "Cannot open run report at \"" << path << "\".");
+		return false;
+	}
+	write(file);
+	return file.good();
+}
+
+long long RunReport::peakRssBytes()
+{
+#if defined(__unix__) || defined(__APPLE__)
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+	{
+		return -1;
+	}
+#ifdef __APPLE__
+	return static_cast<long long>(usage.ru_maxrss);
+#else
+	// Linux und BSD: KiB
+	return static_cast<long long>(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return -1;
+#endif
+}
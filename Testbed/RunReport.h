@@ -0,0 +1,80 @@
+/*! \file RunReport.h
+ *  \brief Definition der Struktur RunReport (Laufzeit- und Speicherbericht
+ *  eines Testbed als JSON)
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef TESTBED_RUNREPORT_H_
+#define TESTBED_RUNREPORT_H_
+
+#include "../signal/Signal.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/*! \brief Laufzeit der Simulation oder des Plottens im Testbed bzw. mit
+ *  DFSM_PROFILING einer Simulationsphase aus diag::Profiler
+ */
+struct PhaseTiming
+{
+	std::string name_;  /**< Name der Phase */
+	double seconds_;    /**< Summierte Laufzeit / s */
+	long long calls_;   /**< Anzahl der Messungen */
+};
+
+/*! \brief Bericht ueber alle bisherigen Aufrufe von
+ *  Testbed::simulationstep(...) (siehe Testbed::runReport()), damit
+ *  Auftraege ueber viele Laeufe hinweg geplant werden koennen
+ */
+struct RunReport
+{
+	std::string network_;        /**< Name des Network */
+	int nGates_;                 /**< Anzahl der Gates */
+	sgnl::Nanoseconds simulatedNs_; /**< Simulierte Zeit / ns */
+	double simulationSeconds_;   /**< Wanduhrzeit der Simulation ohne Plotten / s */
+	double plottingSeconds_;     /**< Wanduhrzeit des Plottens / s */
+	long long waveformBytes_;    /**< Aufgezeichnete Signalverlaeufe / Bytes */
+	long long peakRssBytes_;     /**< Hoechster Arbeitsspeicherbedarf des Prozesses / Bytes, -1 = unbekannt */
+	std::string stopReason_;     /**< Abbruchgrund des letzten simulationstep(...) */
+	bool profiling_;             /**< Mit DFSM_PROFILING gebaut, phases_ enthaelt auch die Phasen aus diag::Profiler */
+	std::vector<PhaseTiming> phases_; /**< Laufzeit je Phase dieses Testbed: immer zuerst "testbed: simulation"
+		und "testbed: plotting", mit DFSM_PROFILING danach jede gemessene Phase aus diag::Profiler (nur die
+		Zaehler des Threads, der simulationstep(...) aufrief) */
+
+	/*! \brief Gesamte Wanduhrzeit
+	 *  \return Simulation und Plotten / s
+	 */
+	double wallSeconds() const;
+
+	/*! \brief Simulationsgeschwindigkeit (ohne Plotten)
+	 *  \return Simulierte ns je Sekunde, 0 falls nichts simuliert wurde
+	 */
+	double nsPerSecond() const;
+
+	/*! \brief Gate-Auswertungen je Sekunde (jedes Gate wird jede ns
+	 *  ausgewertet)
+	 *  \return Auswertungen je Sekunde
+	 */
+	double evalsPerSecond() const;
+
+	/*! \brief Schreibt den Bericht als JSON
+	 *  \param a_os Ausgabe
+	 */
+	void write(std::ostream &a_os) const;
+
+	/*! \brief Speichert den Bericht im Ordner ./Plots neben den Plots
+	 *  \param a_fileName Dateiname OHNE Endung .json
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool save(const std::string &a_fileName) const;
+
+	/*! \brief Hoechster Arbeitsspeicherbedarf (Resident Set Size) des
+	 *  Prozesses bisher
+	 *  \return Bytes, -1 falls auf dieser Plattform nicht verfuegbar
+	 */
+	static long long peakRssBytes();
+};
+
+#endif /* TESTBED_RUNREPORT_H_ */
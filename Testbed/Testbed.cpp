@@ -10,149 +10,877 @@
  *  \date 2021
  */
 #include "Testbed.h"
+#include "../diag/AllocTracker.h"
+#include "../diag/Profiler.h"
+#include "../diag/Trace.h"
+#include "../diag/Log.h"
 #include <iostream>
 #include <utility>
 #include <algorithm>
+#include <chrono>
 using namespace std;
 using namespace sgnl;
+
+/*! \brief Addiert die Wanduhrzeit vom Konstruktor bis stop() bzw. zum Destruktor auf einen Zaehler
+ */
+class WallClock
+{
+public:
+	/*! \brief Konstruktor, startet die Messung
+	 * \param a_seconds Zaehler in s
+	 */
+	explicit WallClock(double &a_seconds) :
+			seconds_(a_seconds), start_(chrono::steady_clock::now()), running_(true)
+	{
+
+	}
+	/*! \brief Destruktor, ruft stop() auf
+	 */
+	~WallClock()
+	{
+		stop();
+	}
+	/*! \brief Beendet die Messung vorzeitig
+	 */
+	void stop()
+	{
+		if (running_)
+		{
+			seconds_ += chrono::duration<double>(chrono::steady_clock::now() - start_).count();
+			running_ = false;
+		}
+	}
+private:
+	double &seconds_; /**< Zaehler in s*/
+	chrono::steady_clock::time_point start_; /**< Beginn der Messung*/
+	bool running_; /**< Messung laeuft*/
+};
+
+/*! \brief Addiert die Zaehler aus diag::Profiler, die der aufrufende Thread vom Konstruktor bis zum Destruktor
+ * erfasst, auf Zaehler je Phase. Andere Threads und fruehere Laeufe zaehlen nicht mit
+ */
+class ThreadProfile
+{
+public:
+	/*! \brief Konstruktor, merkt sich die Zaehler des aufrufenden Threads
+	 * \param a_stats Zaehler je Phase (Groesse diag::Phase::COUNT)
+	 */
+	explicit ThreadProfile(vector<diag::PhaseStats> &a_stats) :
+			stats_(a_stats), start_(a_stats.size())
+	{
+		for (int p = 0; p < static_cast<int>(start_.size()); p++)
+		{
+			start_[p] = diag::Profiler::threadPhase(static_cast<diag::Phase>(p));
+		}
+	}
+	/*! \brief Destruktor, addiert die Differenz zu den gemerkten Zaehlern
+	 */
+	~ThreadProfile()
+	{
+		for (int p = 0; p < static_cast<int>(start_.size()); p++)
+		{
+			diag::PhaseStats end = diag::Profiler::threadPhase(static_cast<diag::Phase>(p));
+			stats_[p].ticks_ += end.ticks_ - start_[p].ticks_;
+			stats_[p].calls_ += end.calls_ - start_[p].calls_;
+			stats_[p].events_ += end.events_ - start_[p].events_;
+		}
+	}
+private:
+	vector<diag::PhaseStats> &stats_; /**< Zaehler je Phase*/
+	vector<diag::PhaseStats> start_; /**< Zaehler des Threads bei Beginn*/
+};
+
+/*! \brief Gibt den Namen eines Abbruchgrunds zurueck
+ * \param a_reason Abbruchgrund
+ * \return z. B. "duration"
+ */
+static const char* stopReasonName(StopReason a_reason)
+{
+	switch (a_reason)
+	{
+	case StopReason::DURATION:
+		return "duration";
+	case StopReason::STABLE:
+		return "stable";
+	case StopReason::PREDICATE:
+		return "predicate";
+	case StopReason::MAX_DURATION:
+		return "max_duration";
+	case StopReason::ERROR:
+		return "error";
+	case StopReason::MONITOR_FAILURE:
+		return "monitor_failure";
+	default:
+		return "?";
+	}
+}
+
+/*! \brief Kennung am Anfang jedes Testbed-Checkpoints (mit Formatversion) */
+static const char *const CHECKPOINT_MAGIC = "DFSM-Testbed-4";
 Testbed::Testbed(const Network &a_network) :
-		network_(a_network)
+		network_(new CompiledNetwork(a_network))
 {
-	if (!network_.consistent())
+	if (!network_->valid())
 	{
-		cerr << "Das Network ist nicht konsistent" << endl;
+		DFSM_LOG_ERROR("Testbed", "Das Network ist nicht konsistent");
 	}
+	init(rd_());
 }
 
-bool Testbed::addConstantSource(const string &a_inputName,
-		const sgnl::Volt a_voltage)
+Testbed::Testbed(std::shared_ptr<const CompiledNetwork> a_network,
+		unsigned int a_seed) :
+		network_(a_network)
 {
-	if (!assert_InputValid(a_inputName))
+	init(a_seed);
+}
+
+Testbed::Testbed(const Testbed &a_other) :
+		network_(a_other.network_), state_(a_other.state_), time_(
+				a_other.time_), recording_(a_other.recording_), plotting_(
+				a_other.plotting_), inputTrace_(a_other.inputTrace_), outputTrace_(
+				a_other.outputTrace_), inputLevels_(a_other.inputLevels_), inputTransitions_(
+				a_other.inputTransitions_), outputLevels_(a_other.outputLevels_), outputTransitions_(
+				a_other.outputTransitions_), outputs_(a_other.outputs_), sourceBlocks_(
+				a_other.sourceBlocks_), blockPos_(a_other.blockPos_), blockLength_(
+				a_other.blockLength_), lastOutputChange_(a_other.lastOutputChange_), stableFor_(
+				a_other.stableFor_), maxDuration_(a_other.maxDuration_), stopPredicate_(
+				a_other.stopPredicate_), stopReason_(a_other.stopReason_), stopOnFailure_(
+				a_other.stopOnFailure_), simulatedNs_(a_other.simulatedNs_), simulationSeconds_(
+				a_other.simulationSeconds_), plottingSeconds_(a_other.plottingSeconds_), simulationCalls_(
+				a_other.simulationCalls_), plottingCalls_(a_other.plottingCalls_), waveformBytes_(
+				a_other.waveformBytes_), phaseStats_(a_other.phaseStats_)
+{
+	sources_.resize(a_other.sources_.size());
+	for (int i = 0; i < static_cast<int>(sources_.size()); i++)
 	{
-		return false;
+		if (a_other.sources_[i])
+		{
+			sources_[i].reset(a_other.sources_[i]->clone());
+		}
 	}
-	else
+	for (int m = 0; m < static_cast<int>(a_other.monitors_.size()); m++)
+	{
+		monitors_.push_back(unique_ptr<Monitor>(a_other.monitors_[m]->clone()));
+	}
+}
+
+Testbed& Testbed::operator=(const Testbed &a_other)
+{
+	if (this != &a_other)
 	{
-		constant_.insert(
-				pair<string, Constant>(a_inputName, Constant(a_voltage)));
-		return true;
+		Testbed copy(a_other);
+		network_.swap(copy.network_);
+		swap(state_, copy.state_);
+		sources_.swap(copy.sources_);
+		time_ = copy.time_;
+		recording_ = copy.recording_;
+		plotting_ = copy.plotting_;
+		inputTrace_.swap(copy.inputTrace_);
+		outputTrace_.swap(copy.outputTrace_);
+		inputLevels_.swap(copy.inputLevels_);
+		inputTransitions_.swap(copy.inputTransitions_);
+		outputLevels_.swap(copy.outputLevels_);
+		outputTransitions_.swap(copy.outputTransitions_);
+		outputs_.swap(copy.outputs_);
+		sourceBlocks_.swap(copy.sourceBlocks_);
+		blockPos_ = copy.blockPos_;
+		blockLength_ = copy.blockLength_;
+		lastOutputChange_ = copy.lastOutputChange_;
+		stableFor_ = copy.stableFor_;
+		maxDuration_ = copy.maxDuration_;
+		stopPredicate_.swap(copy.stopPredicate_);
+		stopReason_ = copy.stopReason_;
+		monitors_.swap(copy.monitors_);
+		stopOnFailure_ = copy.stopOnFailure_;
+		simulatedNs_ = copy.simulatedNs_;
+		simulationSeconds_ = copy.simulationSeconds_;
+		plottingSeconds_ = copy.plottingSeconds_;
+		simulationCalls_ = copy.simulationCalls_;
+		plottingCalls_ = copy.plottingCalls_;
+		waveformBytes_ = copy.waveformBytes_;
+		phaseStats_.swap(copy.phaseStats_);
 	}
+	return *this;
+}
 
+void Testbed::init(unsigned int a_seed)
+{
+	state_ = network_->createState(a_seed);
+	sources_.resize(network_->nInputs());
+	time_ = 0;
+	recording_ = true;
+	plotting_ = true;
+	inputTrace_.resize(network_->nInputs());
+	outputTrace_.resize(network_->nOutputs());
+	inputLevels_.assign(network_->nInputs(), 0);
+	inputTransitions_.assign(network_->nInputs(), 0);
+	outputLevels_.assign(network_->nOutputs(), 0);
+	outputTransitions_.assign(network_->nOutputs(), 0);
+	outputs_.assign(network_->nOutputs(), LOW_LEVEL_VOLT);
+	sourceBlocks_.assign(network_->nInputs(), vector<Volt>(BLOCK_SIZE));
+	blockPos_ = 0;
+	blockLength_ = 0;
+	lastOutputChange_ = 0;
+	stableFor_ = 0;
+	maxDuration_ = 0;
+	stopReason_ = StopReason::DURATION;
+	stopOnFailure_ = false;
+	simulatedNs_ = 0;
+	simulationSeconds_ = 0;
+	plottingSeconds_ = 0;
+	simulationCalls_ = 0;
+	plottingCalls_ = 0;
+	waveformBytes_ = 0;
+	phaseStats_.assign(static_cast<int>(diag::Phase::COUNT), diag::PhaseStats());
 }
 
-bool Testbed::addClockSource(const string &a_inputName,
-		const sgnl::Nanoseconds a_period, const sgnl::Nanoseconds a_phase)
+bool Testbed::addSource(const std::string &a_inputName,
+		const Source &a_source)
 {
 	if (!assert_InputValid(a_inputName))
 	{
 		return false;
 	}
-	else
+	sources_[network_->inputIndex(a_inputName)].reset(a_source.clone());
+	return true;
+}
+
+bool Testbed::replaceSource(const std::string &a_inputName,
+		const Source &a_source)
+{
+	int idx = network_->inputIndex(a_inputName);
+	if (idx < 0)
+	{
+		DFSM_LOG_ERROR("Network", "Input with name " << a_inputName << " does not exist.");
+		return false;
+	}
+	unique_ptr<Source> source(a_source.clone());
+	source->reset();
+	source->skip(time_);
+	// Bereits erzeugte, noch nicht verbrauchte Werte durch die der neuen Quelle ersetzen
+	if (blockPos_ < blockLength_)
 	{
-		clock_.insert(
-				pair<string, Clock>(a_inputName, Clock(a_period, a_phase)));
-		return true;
+		source->generate(&sourceBlocks_[idx][blockPos_], blockLength_ - blockPos_);
 	}
+	sources_[idx].swap(source);
+	return true;
 }
 
-void Testbed::simulationstep(const sgnl::Nanoseconds a_duration)
+bool Testbed::addConstantSource(const string &a_inputName,
+		const sgnl::Volt a_voltage)
 {
-	unsigned int duration = a_duration;
-	map<string, vector<Volt>> inputTestResults;
-	for (map<string, vector<Volt>>::iterator it = inputTestResults.begin();
-			it != inputTestResults.end(); it++)
+	return addSource(a_inputName, Constant(a_voltage));
+}
+
+bool Testbed::addClockSource(const string &a_inputName,
+		const sgnl::Nanoseconds a_period, const sgnl::Nanoseconds a_phase)
+{
+	return addSource(a_inputName, Clock(a_period, a_phase));
+}
+
+bool Testbed::addPrbsSource(const std::string &a_inputName, PrbsOrder a_order,
+		const sgnl::Nanoseconds a_bitPeriod, std::uint32_t a_seed)
+{
+	return addSource(a_inputName, Prbs(a_order, a_bitPeriod, a_seed));
+}
+
+bool Testbed::addPiecewiseLinearSource(const std::string &a_inputName,
+		const std::vector<std::pair<sgnl::Nanoseconds, sgnl::Volt> > &a_points)
+{
+	return addSource(a_inputName, PiecewiseLinear(a_points));
+}
+
+bool Testbed::addPulseSource(const std::string &a_inputName,
+		const sgnl::Nanoseconds a_start, const sgnl::Nanoseconds a_width)
+{
+	return addSource(a_inputName, Pulse(a_start, a_width));
+}
+
+bool Testbed::addPatternFileSource(const std::string &a_inputName,
+		const std::string &a_fileName, bool a_repeat)
+{
+	return addSource(a_inputName, PatternFile(a_fileName, a_repeat));
+}
+
+StopReason Testbed::simulationstep(const sgnl::Nanoseconds a_duration)
+{
+	DFSM_ALLOC_SCOPE(allocScope, diag::AllocSubsystem::TESTBED);
+	DFSM_TRACE_SPAN(simulationSpan, "simulationstep", "testbed");
+#ifdef DFSM_PROFILING
+	ThreadProfile threadProfile(phaseStats_);
+#endif
+	WallClock simulationClock(simulationSeconds_);
+	simulationCalls_++;
+	int duration = a_duration;
+	int nInputs = network_->nInputs();
+	int nOutputs = network_->nOutputs();
+	for (int i = 0; i < nInputs; i++)
 	{
-		it->second.resize(duration);
+		if (!sources_[i])
+		{
+			DFSM_LOG_ERROR("Testbed", "Input " << network_->inputNames()[i]
+					<< " has no source connected.");
+			stopReason_ = StopReason::ERROR;
+			return stopReason_;
+		}
 	}
 
-	map<string, vector<Volt>> outputTestResults;
-	for (map<string, vector<Volt>>::iterator it = outputTestResults.begin();
-			it != outputTestResults.end(); it++)
+	// Bei gesetzter Maximaldauer nur so viel reservieren, wie hoechstens simuliert wird
+	int expected = duration;
+	if (maxDuration_ > 0)
 	{
-		it->second.resize(duration);
+		expected = max(0, min(duration, maxDuration_ - time_));
+	}
+	for (int i = 0; i < nInputs; i++)
+	{
+		inputTrace_[i].clear();
+		if (recording_)
+		{
+			inputTrace_[i].reserve(expected);
+		}
+	}
+	for (int o = 0; o < nOutputs; o++)
+	{
+		outputTrace_[o].clear();
+		if (recording_)
+		{
+			outputTrace_[o].reserve(expected);
+		}
 	}
 
-	for (unsigned int t = 0; t < duration; t++)
+	const Volt upperThresh = HIGH_THRESH_VOLT + DEADBAND_VOLT / 2;
+	const Volt lowerThresh = HIGH_THRESH_VOLT - DEADBAND_VOLT / 2;
+
+	vector<Volt> input(nInputs);
+	int nMonitors = static_cast<int>(monitors_.size());
+	int failures = monitorFailures();
+	Nanoseconds startTime = time_;
+	stopReason_ = StopReason::DURATION;
+	for (int k = 0; k < duration; k++)
 	{
-		map<string, Volt> outputs = network_.outputs();
-		for (map<string, Volt>::iterator it = outputs.begin();
-				it != outputs.end(); it++)
+		if (maxDuration_ > 0 && time_ >= maxDuration_)
 		{
-			string outName = it->first;
-			Volt a_outVoltage = outputs.at(outName);
-			outputTestResults[outName].push_back(a_outVoltage);
+			stopReason_ = StopReason::MAX_DURATION;
+			break;
 		}
 
-		for (map<string, Clock>::iterator it = clock_.begin();
-				it != clock_.end(); it++)
+		DFSM_PROFILE_TICKS(outputsStart);
+		DFSM_TRACE_PHASE(outputsSpan, diag::Phase::TESTBED_OUTPUTS);
+		for (int o = 0; o < nOutputs; o++)
 		{
-			it->second.simulationStep();
-			string inName = it->first;
-			Volt a_inVoltage = clock_.at(inName).output();
-			inputTestResults[inName].push_back(a_inVoltage);
+			Volt outVoltage = network_->output(state_, o);
+			outputs_[o] = outVoltage;
+			char level = outputLevels_[o];
+			if (outVoltage >= upperThresh)
+			{
+				level = 1;
+			}
+			else if (outVoltage <= lowerThresh)
+			{
+				level = 0;
+			}
+			if (level != outputLevels_[o])
+			{
+				outputLevels_[o] = level;
+				outputTransitions_[o]++;
+				lastOutputChange_ = time_;
+			}
 		}
+		DFSM_PROFILE_RECORD(diag::Phase::TESTBED_OUTPUTS, outputsStart, nOutputs);
+		DFSM_TRACE_END(outputsSpan);
 
-		for (map<string, Constant>::iterator it = constant_.begin();
-				it != constant_.end(); it++)
+		// Abbruchbedingungen vor dem Aufzeichnen pruefen, damit Input- und Outputverlauf gleich lang bleiben
+		if (stableFor_ > 0 && time_ - lastOutputChange_ >= stableFor_)
+		{
+			stopReason_ = StopReason::STABLE;
+			break;
+		}
+		if (stopPredicate_ && stopPredicate_(time_, outputs_))
 		{
-			it->second.simulationStep();
-			string inName = it->first;
-			Volt a_inVoltage = constant_.at(inName).output();
-			inputTestResults[inName].push_back(a_inVoltage);
+			stopReason_ = StopReason::PREDICATE;
+			break;
 		}
 
-		map<string, Volt> input;
-		for (map<string, vector<Volt>>::iterator it = inputTestResults.begin();
-				it != inputTestResults.end(); it++)
+		// Die Quellen erzeugen ihre Werte blockweise, nicht pro Nanosekunde. Nicht verbrauchte Werte bleiben fuer den
+		// naechsten Aufruf erhalten, so dass ein vorzeitiger Abbruch die Quellen nicht aus dem Takt bringt
+		if (blockPos_ == blockLength_)
 		{
-			string inname = it->first;
-			vector<Volt> inVoltages = it->second;
-			input[inname] = inVoltages[t];
+			DFSM_PROFILE_TICKS(sourcesStart);
+			DFSM_TRACE_PHASE(sourcesSpan, diag::Phase::TESTBED_SOURCES);
+			for (int i = 0; i < nInputs; i++)
+			{
+				sources_[i]->generate(&sourceBlocks_[i][0], BLOCK_SIZE);
+			}
+			blockPos_ = 0;
+			blockLength_ = BLOCK_SIZE;
+			DFSM_PROFILE_RECORD(diag::Phase::TESTBED_SOURCES, sourcesStart,
+					nInputs * BLOCK_SIZE);
+			DFSM_TRACE_END(sourcesSpan);
+		}
 
+		DFSM_PROFILE_TICKS(recordingStart);
+		DFSM_TRACE_PHASE(recordingSpan, diag::Phase::TESTBED_RECORDING);
+		if (recording_)
+		{
+			for (int o = 0; o < nOutputs; o++)
+			{
+				outputTrace_[o].push_back(outputs_[o]);
+			}
+		}
+		for (int i = 0; i < nInputs; i++)
+		{
+			input[i] = sourceBlocks_[i][blockPos_];
+			char level = inputLevels_[i];
+			if (input[i] >= upperThresh)
+			{
+				level = 1;
+			}
+			else if (input[i] <= lowerThresh)
+			{
+				level = 0;
+			}
+			if (level != inputLevels_[i])
+			{
+				inputLevels_[i] = level;
+				inputTransitions_[i]++;
+			}
+			if (recording_)
+			{
+				inputTrace_[i].push_back(input[i]);
+			}
 		}
-		network_.simulationStep(input);
+		blockPos_++;
+		DFSM_PROFILE_RECORD(diag::Phase::TESTBED_RECORDING, recordingStart,
+				recording_ ? nInputs + nOutputs : 0);
+		DFSM_TRACE_END(recordingSpan);
 
+		DFSM_PROFILE_TICKS(monitorsStart);
+		DFSM_TRACE_PHASE(monitorsSpan, diag::Phase::TESTBED_MONITORS);
+		for (int m = 0; m < nMonitors; m++)
+		{
+			monitors_[m]->step(time_, input.data(), outputs_.data());
+		}
+		DFSM_PROFILE_RECORD(diag::Phase::TESTBED_MONITORS, monitorsStart,
+				nMonitors);
+		DFSM_TRACE_END(monitorsSpan);
+
+		DFSM_PROFILE_TICKS(networkStart);
+		DFSM_TRACE_PHASE(networkSpan, diag::Phase::TESTBED_NETWORK);
+		network_->simulationStep(state_, &input[0]);
+		DFSM_PROFILE_RECORD(diag::Phase::TESTBED_NETWORK, networkStart, 1);
+		DFSM_TRACE_END(networkSpan);
+		time_++;
+
+		if (stopOnFailure_ && nMonitors > 0 && monitorFailures() != failures)
+		{
+			stopReason_ = StopReason::MONITOR_FAILURE;
+			break;
+		}
 	}
-    BMPPlot bmpPlot_(network_.name());
-	bmpPlot_.setTimeTicks(duration / 10);
 
-	for (map<string, vector<Volt>>::const_iterator it =
-			inputTestResults.begin(); it != inputTestResults.end(); it++)
+	simulatedNs_ += time_ - startTime;
+	if (recording_)
 	{
-		bmpPlot_.add(it->first, it->second);
+		waveformBytes_ += static_cast<long long>(nInputs + nOutputs) * (time_ - startTime) * sizeof(Volt);
 	}
+	simulationClock.stop();
 
-	for (map<string, vector<Volt>>::const_iterator it =
-			outputTestResults.begin(); it != outputTestResults.end(); it++)
+	if (!recording_ || !plotting_)
+	{
+		return stopReason_;
+	}
+	WallClock plottingClock(plottingSeconds_);
+	plottingCalls_++;
+	DFSM_PROFILE_TICKS(plottingStart);
+	DFSM_TRACE_PHASE(plottingSpan, diag::Phase::TESTBED_PLOTTING);
+	DFSM_ALLOC_SCOPE(plotAllocScope, diag::AllocSubsystem::PLOT);
+	int recorded = 0;
+	if (nInputs > 0)
 	{
-		bmpPlot_.add(it->first, it->second);
+		recorded = static_cast<int>(inputTrace_[0].size());
 	}
+	else if (nOutputs > 0)
+	{
+		recorded = static_cast<int>(outputTrace_[0].size());
+	}
+	if (recorded == 0)
+	{
+		return stopReason_;
+	}
+	// Lange Verlaeufe werden auf die Breite des Plots gestaucht (Min/Max je Pixelspalte)
+	BMPPlot bmpPlot_(network_->name());
+	bmpPlot_.setTimeRange(0, recorded);
+	bmpPlot_.setTimeTicks(max(1, recorded / 10));
+
+	vector<string> names;
+	vector<const vector<Volt>*> traces;
+	for (int i = 0; i < nInputs; i++)
+	{
+		names.push_back(network_->inputNames()[i]);
+		traces.push_back(&inputTrace_[i]);
+	}
+
+	for (int o = 0; o < nOutputs; o++)
+	{
+		names.push_back(network_->outputNames()[o]);
+		traces.push_back(&outputTrace_[o]);
+	}
+	bmpPlot_.add(names, traces);
 	bmpPlot_.save();
+	DFSM_PROFILE_RECORD(diag::Phase::TESTBED_PLOTTING, plottingStart, recorded);
+	DFSM_TRACE_END(plottingSpan);
+	return stopReason_;
 }
 
-bool Testbed::assert_InputValid(const std::string &a_inputName) const
+void Testbed::setStopWhenStable(sgnl::Nanoseconds a_stableFor)
+{
+	stableFor_ = max(0, a_stableFor);
+}
+
+void Testbed::setStopPredicate(const StopPredicate &a_predicate)
 {
-	std::vector<std::string> it = network_.inputNames();
-	if (std::find(it.begin(), it.end(), a_inputName) == it.end())
+	stopPredicate_ = a_predicate;
+}
+
+void Testbed::setMaxDuration(sgnl::Nanoseconds a_maxDuration)
+{
+	maxDuration_ = max(0, a_maxDuration);
+}
+
+bool Testbed::addMonitor(const Monitor &a_monitor)
+{
+	unique_ptr<Monitor> monitor(a_monitor.clone());
+	if (!monitor->bind(*network_))
 	{
-		cerr << "Network: Input with name " << a_inputName << " does not exist."
-				<< endl;
+		DFSM_LOG_ERROR("Testbed", "Monitor " << monitor->name()
+				<< " refers to a signal that does not exist.");
 		return false;
 	}
+	monitors_.push_back(move(monitor));
+	return true;
+}
+
+void Testbed::setStopOnFailure(bool a_stop)
+{
+	stopOnFailure_ = a_stop;
+}
+
+int Testbed::nMonitors() const
+{
+	return static_cast<int>(monitors_.size());
+}
+
+const Monitor& Testbed::monitor(int a_idx) const
+{
+	return *monitors_[a_idx];
+}
+
+int Testbed::monitorFailures() const
+{
+	int failures = 0;
+	for (int m = 0; m < static_cast<int>(monitors_.size()); m++)
+	{
+		failures += monitors_[m]->nFailures();
+	}
+	return failures;
+}
+
+StopReason Testbed::stopReason() const
+{
+	return stopReason_;
+}
+
+std::string Testbed::checkpoint() const
+{
+	Checkpoint checkpoint;
+	checkpoint.writeString(CHECKPOINT_MAGIC);
+	checkpoint.writeString(network_->name());
+	checkpoint.writeInt(network_->nInputs());
+	checkpoint.writeInt(network_->nOutputs());
+	checkpoint.writeInt(time_);
+	checkpoint.writeInt(lastOutputChange_);
+	checkpoint.writeInt(static_cast<int>(stopReason_));
+	checkpoint.writeChars(inputLevels_);
+	checkpoint.writeInts(inputTransitions_);
+	checkpoint.writeChars(outputLevels_);
+	checkpoint.writeInts(outputTransitions_);
+	checkpoint.writeDoubles(outputs_);
+	checkpoint.writeInt(blockPos_);
+	checkpoint.writeInt(blockLength_);
+	for (int i = 0; i < network_->nInputs(); i++)
+	{
+		// Nur die noch nicht verbrauchten Werte des aktuellen Blocks speichern
+		checkpoint.writeDoubles(
+				vector<Volt>(sourceBlocks_[i].begin() + blockPos_,
+						sourceBlocks_[i].begin() + blockLength_));
+		checkpoint.writeInt(sources_[i] ? 1 : 0);
+		if (sources_[i])
+		{
+			sources_[i]->saveState(checkpoint);
+		}
+	}
+	checkpoint.writeInt(static_cast<int>(monitors_.size()));
+	for (int m = 0; m < static_cast<int>(monitors_.size()); m++)
+	{
+		monitors_[m]->saveState(checkpoint);
+	}
+	state_.saveState(checkpoint);
+	return checkpoint.data();
+}
 
-	if (clock_.count(a_inputName) != 0)
+bool Testbed::restore(const std::string &a_checkpoint)
+{
+	Checkpoint checkpoint(a_checkpoint);
+	string magic;
+	string name;
+	int32_t nInputs = 0;
+	int32_t nOutputs = 0;
+	if (!checkpoint.readString(magic) || magic != CHECKPOINT_MAGIC
+			|| !checkpoint.readString(name) || name != network_->name()
+			|| !checkpoint.readInt(nInputs) || nInputs != network_->nInputs()
+			|| !checkpoint.readInt(nOutputs)
+			|| nOutputs != network_->nOutputs())
 	{
-		cerr << "Network: Input with name " << a_inputName
-				<< " has already been connected in Clock." << endl;
+		DFSM_LOG_ERROR("Testbed", "Checkpoint does not belong to network "
+				<< network_->name() << ".");
 		return false;
 	}
 
-	if (constant_.count(a_inputName) != 0)
+	// Alles zunaechst in Kopien lesen, damit ein fehlerhafter Checkpoint den Zustand nicht veraendert
+	int32_t time = 0;
+	int32_t lastOutputChange = 0;
+	int32_t stopReason = 0;
+	vector<char> inputLevels;
+	vector<int> inputTransitions;
+	vector<char> outputLevels;
+	vector<int> outputTransitions;
+	vector<Volt> outputs;
+	int32_t blockPos = 0;
+	int32_t blockLength = 0;
+	checkpoint.readInt(time);
+	checkpoint.readInt(lastOutputChange);
+	checkpoint.readInt(stopReason);
+	checkpoint.readChars(inputLevels);
+	checkpoint.readInts(inputTransitions);
+	checkpoint.readChars(outputLevels);
+	checkpoint.readInts(outputTransitions);
+	checkpoint.readDoubles(outputs);
+	checkpoint.readInt(blockPos);
+	checkpoint.readInt(blockLength);
+	bool ok = checkpoint.ok()
+			&& static_cast<int>(inputLevels.size()) == nInputs
+			&& static_cast<int>(inputTransitions.size()) == nInputs
+			&& static_cast<int>(outputLevels.size()) == nOutputs
+			&& static_cast<int>(outputTransitions.size()) == nOutputs
+			&& static_cast<int>(outputs.size()) == nOutputs && blockPos >= 0
+			&& blockPos <= blockLength && blockLength <= BLOCK_SIZE;
+
+	vector<vector<Volt> > sourceBlocks(nInputs, vector<Volt>(BLOCK_SIZE));
+	vector<unique_ptr<Source> > sources(nInputs);
+	for (int i = 0; ok && i < nInputs; i++)
 	{
-		cerr << "Network: Input with name " << a_inputName
-				<< " has already been connected in Constant." << endl;
+		int32_t bound = 0;
+		vector<Volt> pending;
+		ok = checkpoint.readDoubles(pending)
+				&& static_cast<int>(pending.size()) == blockLength - blockPos
+				&& checkpoint.readInt(bound)
+				&& (bound != 0) == static_cast<bool>(sources_[i]);
+		if (ok)
+		{
+			copy(pending.begin(), pending.end(),
+					sourceBlocks[i].begin() + blockPos);
+		}
+		if (ok && bound)
+		{
+			sources[i].reset(sources_[i]->clone());
+			ok = sources[i]->restoreState(checkpoint);
+		}
+	}
+	int32_t nMonitors = 0;
+	ok = ok && checkpoint.readInt(nMonitors)
+			&& nMonitors == static_cast<int>(monitors_.size());
+	vector<unique_ptr<Monitor> > monitors(monitors_.size());
+	for (int m = 0; ok && m < nMonitors; m++)
+	{
+		monitors[m].reset(monitors_[m]->clone());
+		ok = monitors[m]->restoreState(checkpoint);
+	}
+	NetworkState state(state_);
+	ok = ok && state.restoreState(checkpoint) && checkpoint.atEnd();
+	if (!ok)
+	{
+		DFSM_LOG_ERROR("Testbed", "Checkpoint is corrupt or does not match the sources.");
 		return false;
 	}
+
+	swap(state_, state);
+	sources_.swap(sources);
+	monitors_.swap(monitors);
+	sourceBlocks_.swap(sourceBlocks);
+	time_ = time;
+	lastOutputChange_ = lastOutputChange;
+	stopReason_ = static_cast<StopReason>(stopReason);
+	inputLevels_.swap(inputLevels);
+	inputTransitions_.swap(inputTransitions);
+	outputLevels_.swap(outputLevels);
+	outputTransitions_.swap(outputTransitions);
+	outputs_.swap(outputs);
+	blockPos_ = blockPos;
+	blockLength_ = blockLength;
+	for (int i = 0; i < nInputs; i++)
+	{
+		inputTrace_[i].clear();
+	}
+	for (int o = 0; o < nOutputs; o++)
+	{
+		outputTrace_[o].clear();
+	}
 	return true;
+}
+
+bool Testbed::saveCheckpoint(const std::string &a_fileName) const
+{
+	return Checkpoint(checkpoint()).save(a_fileName);
+}
 
+bool Testbed::loadCheckpoint(const std::string &a_fileName)
+{
+	Checkpoint checkpoint;
+	if (!checkpoint.load(a_fileName))
+	{
+		return false;
+	}
+	return restore(checkpoint.data());
+}
+
+bool Testbed::assert_InputValid(const std::string &a_inputName) const
+{
+	int idx = network_->inputIndex(a_inputName);
+	if (idx < 0)
+	{
+		DFSM_LOG_ERROR("Network", "Input with name " << a_inputName << " does not exist.");
+		return false;
+	}
+
+	if (sources_[idx])
+	{
+		DFSM_LOG_ERROR("Network", "Input with name " << a_inputName
+				<< " has already been connected to a source.");
+		return false;
+	}
+	return true;
+
+}
+
+void Testbed::setRecording(bool a_recording)
+{
+	recording_ = a_recording;
+}
+
+void Testbed::setPlotting(bool a_plotting)
+{
+	plotting_ = a_plotting;
+}
+
+void Testbed::seed(unsigned int a_seed)
+{
+	state_.seed(a_seed);
+}
+
+const CompiledNetwork& Testbed::network() const
+{
+	return *network_;
+}
+
+sgnl::Nanoseconds Testbed::time() const
+{
+	return time_;
+}
+
+sgnl::Volt Testbed::output(int a_idx) const
+{
+	return network_->output(state_, a_idx);
+}
+
+int Testbed::outputTransitions(int a_idx) const
+{
+	return outputTransitions_[a_idx];
+}
+
+int Testbed::inputTransitions(int a_idx) const
+{
+	return inputTransitions_[a_idx];
+}
+
+Activity Testbed::activity() const
+{
+	vector<NetActivity> nets;
+	for (int i = 0; i < network_->nInputs(); i++)
+	{
+		NetActivity net = { NetKind::INPUT, network_->inputNames()[i],
+				inputTransitions_[i], network_->inputFanout(i) };
+		nets.push_back(net);
+	}
+	for (int p = 0; p < network_->nOutputPins(); p++)
+	{
+		NetActivity net = { NetKind::GATE_OUTPUT, network_->outputPinName(p),
+				network_->outputToggles(state_, p),
+				network_->outputPinFanout(p) };
+		nets.push_back(net);
+	}
+	for (int o = 0; o < network_->nOutputs(); o++)
+	{
+		NetActivity net = { NetKind::OUTPUT, network_->outputNames()[o],
+				outputTransitions_[o], 0 };
+		nets.push_back(net);
+	}
+	return Activity(nets, time_, network_->nGates());
+}
+
+RunReport Testbed::runReport() const
+{
+	RunReport report;
+	report.network_ = network_->name();
+	report.nGates_ = network_->nGates();
+	report.simulatedNs_ = simulatedNs_;
+	report.simulationSeconds_ = simulationSeconds_;
+	report.plottingSeconds_ = plottingSeconds_;
+	report.waveformBytes_ = waveformBytes_;
+	report.peakRssBytes_ = RunReport::peakRssBytes();
+	report.stopReason_ = stopReasonName(stopReason_);
+	report.profiling_ = diag::Profiler::enabled();
+	// Die Wanduhrzeiten je Aufruf gibt es in jedem Build
+	PhaseTiming simulation = { "testbed: simulation", simulationSeconds_, simulationCalls_ };
+	PhaseTiming plotting = { "testbed: plotting", plottingSeconds_, plottingCalls_ };
+	report.phases_.push_back(simulation);
+	report.phases_.push_back(plotting);
+	if (report.profiling_)
+	{
+		double ticksPerSecond = diag::Profiler::ticksPerSecond();
+		for (int p = 0; p < static_cast<int>(phaseStats_.size()); p++)
+		{
+			if (phaseStats_[p].calls_ > 0)
+			{
+				PhaseTiming timing = { diag::Profiler::phaseName(static_cast<diag::Phase>(p)),
+						phaseStats_[p].ticks_ / ticksPerSecond, static_cast<long long>(phaseStats_[p].calls_) };
+				report.phases_.push_back(timing);
+			}
+		}
+	}
+	return report;
+}
+
+bool Testbed::saveRunReport(const std::string &a_fileName) const
+{
+	return runReport().save(a_fileName);
+}
+
+const std::vector<sgnl::Volt>& Testbed::inputTrace(int a_idx) const
+{
+	return inputTrace_[a_idx];
+}
+
+const std::vector<sgnl::Volt>& Testbed::outputTrace(int a_idx) const
+{
+	return outputTrace_[a_idx];
 }
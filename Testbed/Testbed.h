@@ -9,28 +9,122 @@
  *  \author Thai Nguyen, Dung Tran
  *  \date 2020
  */
+#include "../source/Source.h"
 #include "../source/Clock.h"
 #include "../source/Constant.h"
+#include "../source/Prbs.h"
+#include "../source/PiecewiseLinear.h"
+#include "../source/Pulse.h"
+#include "../source/PatternFile.h"
 #include "../network/Network.h"
+#include "../network/CompiledNetwork.h"
+#include "../fileIO/Checkpoint.h"
+#include "Monitor.h"
+#include "Activity.h"
+#include "RunReport.h"
 #include "../plot/BMPPlot.h"
 #include "../plot/simplebmp/simplebmp.h"
+#include "../diag/Profiler.h"
+#include <functional>
+#include <memory>
 #ifndef TESTBED_TESTBED_H_
 #define TESTBED_TESTBED_H_
+/*! \brief Grund, aus dem Testbed::simulationstep(...) beendet wurde
+ */
+enum class StopReason
+{
+	DURATION = 0,     /**< Angeforderte Simulationsdauer erreicht */
+	STABLE = 1,       /**< Alle Outputs lange genug stabil */
+	PREDICATE = 2,    /**< Benutzerdefinierte Abbruchbedingung erfuellt */
+	MAX_DURATION = 3, /**< Maximale Gesamtsimulationsdauer erreicht */
+	ERROR = 4,        /**< Simulation nicht moeglich (z. B. fehlende Quelle) */
+	MONITOR_FAILURE = 5 /**< Ein Monitor hat einen Fehler gemeldet (setStopOnFailure(...)) */
+};
+/*! \brief Benutzerdefinierte Abbruchbedingung: erhaelt die aktuelle Simulationszeit und die aktuellen
+ * Outputspannungen (Index wie CompiledNetwork::outputNames()) und gibt true zurueck, wenn abgebrochen werden soll
+ */
+typedef std::function<bool(sgnl::Nanoseconds, const std::vector<sgnl::Volt>&)> StopPredicate;
 /*! \class Testbed
  * \brief Modelliert ein Pruefstand. Diese Stellt Signalquellen, Taktsignale zur Verfuegung. Testbed uebernimmt die Simulation
+ * \details Das Network wird beim Erzeugen einmal in ein CompiledNetwork uebersetzt. Das Testbed haelt davon nur einen
+ * geteilten Zeiger und seinen eigenen NetworkState, so dass beliebig viele Testbeds dasselbe Network simulieren koennen
  */
 class Testbed
 {
 private:
-	Network network_; /**< Network*/
-	std::map<std::string, Clock> clock_;/**< Rechecktquelle des Networks*/
-	std::map<std::string, Constant> constant_; /**< Konstantquelle des Networks*/
+	std::shared_ptr<const CompiledNetwork> network_; /**< Uebersetztes Network, wird mit anderen Testbeds geteilt*/
+	NetworkState state_; /**< Simulationszustand des Networks*/
+	std::vector<std::unique_ptr<Source> > sources_; /**< Signalquelle je Network-Input (per Index), nullptr falls keine*/
+	sgnl::Nanoseconds time_; /**< Bisher simulierte Zeit*/
+	bool recording_; /**< Signalverlaeufe aufzeichnen*/
+	bool plotting_; /**< Signalverlaeufe nach jedem simulationstep(...) als Bitmap speichern*/
+	std::vector<std::vector<sgnl::Volt> > inputTrace_; /**< Aufgezeichnete Inputspannungen des letzten simulationstep(...)*/
+	std::vector<std::vector<sgnl::Volt> > outputTrace_; /**< Aufgezeichnete Outputspannungen des letzten simulationstep(...)*/
+	std::vector<char> inputLevels_; /**< Aktuelle Logiklevel der Network-Inputs*/
+	std::vector<int> inputTransitions_; /**< Anzahl der Logiklevel-Wechsel je Network-Input*/
+	std::vector<char> outputLevels_; /**< Aktuelle Logiklevel der Network-Outputs*/
+	std::vector<int> outputTransitions_; /**< Anzahl der Logiklevel-Wechsel je Network-Output*/
+	std::vector<sgnl::Volt> outputs_; /**< Outputspannungen im aktuellen Simulationsschritt*/
+	std::vector<std::vector<sgnl::Volt> > sourceBlocks_; /**< Von den Quellen erzeugter, noch nicht verbrauchter Block*/
+	int blockPos_; /**< Naechster zu verbrauchender Wert in sourceBlocks_*/
+	int blockLength_; /**< Anzahl gueltiger Werte in sourceBlocks_*/
+	sgnl::Nanoseconds lastOutputChange_; /**< Zeitpunkt des letzten Logiklevel-Wechsels eines Outputs*/
+	sgnl::Nanoseconds stableFor_; /**< Abbruch, wenn alle Outputs so lange stabil sind, 0 = aus*/
+	sgnl::Nanoseconds maxDuration_; /**< Maximale Gesamtsimulationsdauer, 0 = unbegrenzt*/
+	StopPredicate stopPredicate_; /**< Benutzerdefinierte Abbruchbedingung, leer = aus*/
+	StopReason stopReason_; /**< Abbruchgrund des letzten simulationstep(...)*/
+	std::vector<std::unique_ptr<Monitor> > monitors_; /**< Waehrend der Simulation ausgewertete Monitore*/
+	bool stopOnFailure_; /**< Abbruch beim ersten Monitor-Fehler*/
+	sgnl::Nanoseconds simulatedNs_; /**< In allen simulationstep(...) simulierte Zeit (ohne restore(...))*/
+	double simulationSeconds_; /**< Wanduhrzeit aller simulationstep(...) ohne Plotten*/
+	double plottingSeconds_; /**< Wanduhrzeit des Plottens*/
+	long long simulationCalls_; /**< Anzahl der Aufrufe von simulationstep(...)*/
+	long long plottingCalls_; /**< Anzahl der Plots in simulationstep(...)*/
+	long long waveformBytes_; /**< In allen simulationstep(...) aufgezeichnete Signalverlaeufe in Bytes*/
+	std::vector<diag::PhaseStats> phaseStats_; /**< Zaehler aus diag::Profiler je Phase, nur aus den simulationstep(...) dieses Testbed*/
+
+	/*! \brief Initialisiert die vom Network abhaengigen Member
+	 *  \param a_seed Startwert des Zufallsgenerators fuer das Rauschen
+	 */
+	void init(unsigned int a_seed);
 
 public:
-	/*! \brief Konstruktor des Testbed
+	static const int BLOCK_SIZE = 1024; /**< Anzahl der Nanosekunden, die die Quellen pro Aufruf erzeugen*/
+
+	/*! \brief Konstruktor des Testbed, uebersetzt das Network
 	 *  \param a_network Ein Network
 	 */
 	Testbed(const Network &a_network);
+	/*! \brief Konstruktor des Testbed fuer ein bereits uebersetztes Network. Das Network wird weder kopiert noch
+	 * erneut auf Konsistenz geprueft
+	 *  \param a_network Uebersetztes Network
+	 *  \param a_seed Startwert des Zufallsgenerators fuer das Rauschen
+	 */
+	Testbed(std::shared_ptr<const CompiledNetwork> a_network, unsigned int a_seed);
+	/*! \brief Kopierkonstruktor, Simulationszustand und Signalquellen werden samt Zustand kopiert, das uebersetzte
+	 * Network wird geteilt
+	 *  \param a_other zu kopierendes Testbed
+	 */
+	Testbed(const Testbed &a_other);
+	/*! \brief Zuweisungsoperator, die Signalquellen werden samt Zustand kopiert
+	 *  \param a_other zu kopierendes Testbed
+	 *  \return dieses Testbed
+	 */
+	Testbed& operator=(const Testbed &a_other);
+	/*! \brief Hinzufuegen einer beliebigen Signalquelle. Das Testbed speichert
+	 * eine Kopie der Quelle und bindet sie an den Index des Network-Inputs
+	 * \param a_inputName Network Input
+	 * \param a_source Signalquelle
+	 *  \return false wenn Input nicht existiert oder schon verbunden ist, sonst true
+	 */
+	bool addSource(const std::string &a_inputName, const Source &a_source);
+	/*! \brief Ersetzt die Signalquelle eines Network-Inputs waehrend einer laufenden Simulation (z. B. nach restore(...)).
+	 * Die Kopie der neuen Quelle wird zurueckgesetzt und auf die bisher simulierte Zeit vorgespult
+	 * \param a_inputName Network Input
+	 * \param a_source neue Signalquelle
+	 *  \return false wenn Input nicht existiert, sonst true
+	 */
+	bool replaceSource(const std::string &a_inputName, const Source &a_source);
 	/*! \brief Hinzufuegen die Konstantquelle des Networks
 	 * \param a_inputName Network Input
 	 * \param a_voltage gewuenschte Spannung
@@ -46,14 +140,174 @@ public:
 	 */
 	bool addClockSource(const std::string &a_inputName,
 			const sgnl::Nanoseconds a_period, const sgnl::Nanoseconds a_phase);
-	/*! \brief  Das Network muss einen Simulationsschritt durchfuehren koennen.
+	/*! \brief Hinzufuegen einer Pseudozufalls-Bitfolge (PRBS7/15/31)
+	 * \param a_inputName Network Input
+	 * \param a_order Grad der Pseudozufallsfolge
+	 * \param a_bitPeriod Dauer eines Bits in ns
+	 * \param a_seed Startwert des LFSR-Registers
+	 *  \return false wenn Input nicht existiert oder schon verbunden ist, sonst true
+	 */
+	bool addPrbsSource(const std::string &a_inputName, PrbsOrder a_order,
+			const sgnl::Nanoseconds a_bitPeriod, std::uint32_t a_seed = 1);
+	/*! \brief Hinzufuegen einer stueckweise linearen Quelle (Spannungsrampen)
+	 * \param a_inputName Network Input
+	 * \param a_points Stuetzstellen (Zeitpunkt in ns, Spannung)
+	 *  \return false wenn Input nicht existiert oder schon verbunden ist, sonst true
+	 */
+	bool addPiecewiseLinearSource(const std::string &a_inputName,
+			const std::vector<std::pair<sgnl::Nanoseconds, sgnl::Volt> > &a_points);
+	/*! \brief Hinzufuegen eines Einzelimpulses
+	 * \param a_inputName Network Input
+	 * \param a_start Beginn des Impulses in ns
+	 * \param a_width Dauer des Impulses in ns
+	 *  \return false wenn Input nicht existiert oder schon verbunden ist, sonst true
+	 */
+	bool addPulseSource(const std::string &a_inputName,
+			const sgnl::Nanoseconds a_start, const sgnl::Nanoseconds a_width);
+	/*! \brief Hinzufuegen einer Musterdatei-Quelle (Patterns/<a_fileName>.pat)
+	 * \param a_inputName Network Input
+	 * \param a_fileName Dateiname ohne Ordner und ohne Endung
+	 * \param a_repeat Muster am Dateiende wiederholen
+	 *  \return false wenn Input nicht existiert oder schon verbunden ist, sonst true
+	 */
+	bool addPatternFileSource(const std::string &a_inputName,
+			const std::string &a_fileName, bool a_repeat = false);
+	/*! \brief  Das Network muss einen Simulationsschritt durchfuehren koennen. Ein weiterer Aufruf setzt die Simulation
+	 * ab der bisher simulierten Zeit fort. Die Simulation endet vorzeitig, sobald eine der gesetzten Abbruchbedingungen
+	 * (setStopWhenStable(...), setStopPredicate(...), setMaxDuration(...)) erfuellt ist
 	 *  \param a_duration Simulationsdauer
+	 *  \return Grund fuer das Ende der Simulation
+	 */
+	StopReason simulationstep(const sgnl::Nanoseconds a_duration);
+	/*! \brief Simulation beenden, sobald sich kein Network-Output (Logiklevel) mehr fuer die angegebene Dauer
+	 * geaendert hat
+	 * \param a_stableFor geforderte Dauer ohne Wechsel in ns, 0 = Bedingung aus
+	 */
+	void setStopWhenStable(sgnl::Nanoseconds a_stableFor);
+	/*! \brief Simulation beenden, sobald die uebergebene Bedingung erfuellt ist. Sie wird jede Nanosekunde mit den
+	 * aktuellen Outputspannungen aufgerufen
+	 * \param a_predicate Abbruchbedingung, leere Funktion = Bedingung aus
 	 */
-	void simulationstep(const sgnl::Nanoseconds a_duration);
+	void setStopPredicate(const StopPredicate &a_predicate);
+	/*! \brief Simulation beenden, sobald insgesamt (ueber alle Aufrufe von simulationstep(...)) die angegebene Zeit
+	 * simuliert wurde
+	 * \param a_maxDuration maximale Gesamtdauer in ns, 0 = unbegrenzt
+	 */
+	void setMaxDuration(sgnl::Nanoseconds a_maxDuration);
+	/*! \brief Fuegt einen Monitor hinzu, der ab sofort jede Nanosekunde mit den Input- und Outputspannungen
+	 * ausgewertet wird (auch ohne Aufzeichnung). Das Testbed speichert eine Kopie
+	 * \param a_monitor Monitor
+	 * \return false wenn ein beobachtetes Signal nicht existiert, sonst true
+	 */
+	bool addMonitor(const Monitor &a_monitor);
+	/*! \brief Simulation nach der Nanosekunde beenden, in der ein Monitor einen Fehler meldet
+	 * \param a_stop true = abbrechen
+	 */
+	void setStopOnFailure(bool a_stop);
+	/*! \brief Gibt die Anzahl der Monitore zurueck
+	 * \return Anzahl der Monitore
+	 */
+	int nMonitors() const;
+	/*! \brief Gibt den Monitor mit dem angegebenen Index (Reihenfolge von addMonitor(...)) zurueck
+	 * \param a_idx Index
+	 * \return Monitor
+	 */
+	const Monitor& monitor(int a_idx) const;
+	/*! \brief Gibt die Anzahl aller von den Monitoren gemeldeten Fehler zurueck
+	 * \return Anzahl der Fehler
+	 */
+	int monitorFailures() const;
+	/*! \brief Gibt den Abbruchgrund des letzten simulationstep(...) zurueck
+	 * \return Abbruchgrund
+	 */
+	StopReason stopReason() const;
+	/*! \brief Erzeugt einen Checkpoint des vollstaendigen Simulationszustands: Zustand des Networks inklusive
+	 * Zufallsgenerator, Zustand aller Signalquellen, Simulationszeit und Logiklevel-Zaehler. Einstellungen (Aufzeichnung,
+	 * Abbruchbedingungen) und aufgezeichnete Verlaeufe gehoeren nicht dazu
+	 * \return Binaerdaten des Checkpoints
+	 */
+	std::string checkpoint() const;
+	/*! \brief Stellt einen mit checkpoint() erzeugten Zustand wieder her. Das Testbed muss dasselbe Network simulieren
+	 * und an denselben Inputs Quellen desselben Typs besitzen (z. B. eine Kopie des urspruenglichen Testbed)
+	 * \param a_checkpoint Binaerdaten des Checkpoints
+	 * \return true, falls erfolgreich, false sonst (Zustand unveraendert)
+	 */
+	bool restore(const std::string &a_checkpoint);
+	/*! \brief Speichert checkpoint() im Ordner ./Checkpoints
+	 * \param a_fileName Dateiname OHNE Endung .ckpt
+	 * \return true, falls erfolgreich, false sonst
+	 */
+	bool saveCheckpoint(const std::string &a_fileName) const;
+	/*! \brief Laedt einen Checkpoint aus dem Ordner ./Checkpoints und stellt ihn mit restore(...) wieder her
+	 * \param a_fileName Dateiname OHNE Endung .ckpt
+	 * \return true, falls erfolgreich, false sonst
+	 */
+	bool loadCheckpoint(const std::string &a_fileName);
 	/*! \brief Check ob Input Name gueltig ist
 	 * \return bool true wenn Name gueltig, sonst false
 	 */
 	bool assert_InputValid(const std::string &a_inputName) const;
+	/*! \brief Schaltet die Aufzeichnung der Signalverlaeufe ein oder aus. Ohne Aufzeichnung wird auch nicht geplottet
+	 * \param a_recording true = aufzeichnen (Standard)
+	 */
+	void setRecording(bool a_recording);
+	/*! \brief Schaltet das Speichern des Plots nach jedem simulationstep(...) ein oder aus
+	 * \param a_plotting true = plotten (Standard)
+	 */
+	void setPlotting(bool a_plotting);
+	/*! \brief Setzt den Startwert des Zufallsgenerators fuer das Rauschen
+	 * \param a_seed Startwert
+	 */
+	void seed(unsigned int a_seed);
+	/*! \brief Gibt das uebersetzte Network zurueck
+	 * \return uebersetztes Network
+	 */
+	const CompiledNetwork& network() const;
+	/*! \brief Gibt die bisher simulierte Zeit zurueck
+	 * \return simulierte Zeit in ns
+	 */
+	sgnl::Nanoseconds time() const;
+	/*! \brief Gibt die aktuelle Spannung am Network-Output mit dem angegebenen Index zurueck
+	 * \param a_idx Index des Network-Outputs
+	 * \return Outputspannung
+	 */
+	sgnl::Volt output(int a_idx) const;
+	/*! \brief Gibt die Anzahl der Logiklevel-Wechsel am Network-Output mit dem angegebenen Index zurueck
+	 * \param a_idx Index des Network-Outputs
+	 * \return Anzahl der Wechsel seit Simulationsbeginn
+	 */
+	int outputTransitions(int a_idx) const;
+	/*! \brief Gibt die Anzahl der Logiklevel-Wechsel am Network-Input mit dem angegebenen Index zurueck
+	 * \param a_idx Index des Network-Inputs
+	 * \return Anzahl der Wechsel seit Simulationsbeginn
+	 */
+	int inputTransitions(int a_idx) const;
+	/*! \brief Gibt die Schaltaktivitaet aller Netze (Network-Inputs, Gate-Outputs, Network-Outputs) seit
+	 * Simulationsbeginn zurueck. Gezaehlt wird ohnehin bei jedem Wechsel, die Abfrage kostet nur das Zusammenstellen
+	 * \return Aktivitaet je Netz
+	 */
+	Activity activity() const;
+	/*! \brief Gibt Laufzeit, Durchsatz, Speicherbedarf und aufgezeichnete Datenmenge aller bisherigen
+	 * simulationstep(...) zurueck. Immer mit den Wanduhrzeiten von Simulation und Plotten, mit DFSM_PROFILING
+	 * zusaetzlich mit den Phasen, die diese simulationstep(...) im jeweils aufrufenden Thread gemessen haben
+	 * \return Bericht
+	 */
+	RunReport runReport() const;
+	/*! \brief Speichert runReport() als JSON im Ordner ./Plots
+	 * \param a_fileName Dateiname OHNE Endung .json
+	 * \return true, falls erfolgreich, false sonst
+	 */
+	bool saveRunReport(const std::string &a_fileName) const;
+	/*! \brief Gibt die im letzten simulationstep(...) aufgezeichneten Spannungen eines Network-Inputs zurueck
+	 * \param a_idx Index des Network-Inputs
+	 * \return Spannungsverlauf, leer falls nicht aufgezeichnet
+	 */
+	const std::vector<sgnl::Volt>& inputTrace(int a_idx) const;
+	/*! \brief Gibt die im letzten simulationstep(...) aufgezeichneten Spannungen eines Network-Outputs zurueck
+	 * \param a_idx Index des Network-Outputs
+	 * \return Spannungsverlauf, leer falls nicht aufgezeichnet
+	 */
+	const std::vector<sgnl::Volt>& outputTrace(int a_idx) const;
 
 };
 
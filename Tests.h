@@ -8,6 +8,32 @@
 #ifndef TESTS_H_
 #define TESTS_H_
 #include"network/Network.h"
+#include"source/Prbs.h"
+#include"network/CompiledNetwork.h"
+#include"Testbed/Testbed.h"
+#include"Testbed/BatchRunner.h"
+#include"plot/Envelope.h"
+#include"plot/TiledPlot.h"
+#include"plot/simplebmp/simplebmp.h"
+#include"plot/PlotBatch.h"
+#include"plot/PngBackend.h"
+#include"plot/SvgBackend.h"
+#include"util/Deflate.h"
+#include"plot/WaveformPyramid.h"
+#include"plot/LogicTrace.h"
+#include"plot/TextPlot.h"
+#include"diag/Profiler.h"
+#include"diag/AllocTracker.h"
+#include"diag/Log.h"
+#include"diag/Trace.h"
+#include"util/ThreadPool.h"
+#include"fileIO/FileInput.h"
+#include"fileIO/FileOutput.h"
+#include<algorithm>
+#include<fstream>
+#include<functional>
+#include<iostream>
+#include<sstream>
 namespace Test
 {
 
@@ -573,6 +599,1869 @@ bool networkConsistentC0()
 	return true;
 }
 
+/*! \brief Prueft die PRBS7-Quelle: Die Bitfolge muss sich nach 127 Bits
+ * wiederholen und pro Periode genau 64 Einsen enthalten
+ */
+bool PrbsSourcePeriodCheck()
+{
+	const int period = 127;
+	Prbs prbs(PrbsOrder::PRBS7, 1);
+	std::vector<sgnl::Volt> values(2 * period);
+	prbs.generate(&values[0], period);
+	prbs.generate(&values[period], period);
+	int nOnes = 0;
+	for (int i = 0; i < period; i++)
+	{
+		if (values[i] != values[i + period])
+		{
+			std::cout << "=> PRBS7 wiederholt sich nicht nach 127 Bits";
+			return false;
+		}
+		if (values[i] == HIGH_LEVEL_VOLT)
+		{
+			nOnes++;
+		}
+	}
+	if (nOnes != 64)
+	{
+		std::cout << "=> PRBS7 enthaelt " << nOnes << " statt 64 Einsen";
+		return false;
+	}
+	std::cout << "=> PRBS7-Quelle liefert die richtige Bitfolge";
+	return true;
+}
+
+/*! \brief Vergleicht einen aufgezeichneten Inputverlauf mit erwarteten Werten
+ * \param a_trace Aufgezeichneter Verlauf
+ * \param a_start Zeitpunkt des ersten Werts
+ * \param a_expected Erwarteter Wert je Zeitpunkt
+ * \param a_what Bezeichnung fuer die Ausgabe
+ * \return true, falls alle Werte uebereinstimmen
+ */
+bool compareTrace(const std::vector<sgnl::Volt> &a_trace, sgnl::Nanoseconds a_start,
+		const std::function<sgnl::Volt(sgnl::Nanoseconds)> &a_expected,
+		const std::string &a_what)
+{
+	for (int i = 0; i < static_cast<int>(a_trace.size()); i++)
+	{
+		if (a_trace[i] != a_expected(a_start + i))
+		{
+			std::cout << "=> " << a_what << ": bei t=" << a_start + i << " "
+					<< a_trace[i] << " V statt " << a_expected(a_start + i) << " V";
+			return false;
+		}
+	}
+	return true;
+}
+
+/*! \brief Prueft die Musterdatei-Quelle im Testbed: Segmente ueber
+ * Blockgrenzen (Testbed::BLOCK_SIZE), Kommentare, letzte Zeile ohne
+ * Zeilenumbruch, Wiederholen und Halten am Dateiende, Fortsetzen nach
+ * Kopie und nach Wiederherstellen eines Checkpoints mitten im Segment sowie
+ * die Fehlermeldung bei einer ungueltigen Zeile
+ * \return true, falls alle Verlaeufe stimmen
+ */
+bool PatternFileSourceCheck()
+{
+	// Segmente (Dauer, Spannung), das zweite und dritte ueberqueren die
+	// Blockgrenzen bei 1024, 2048 und 3072 ns
+	const int N_SEGMENTS = 4;
+	const int durations[N_SEGMENTS] = { 1000, 50, 2000, 10 };
+	const sgnl::Volt voltages[N_SEGMENTS] = { 5, 0, 3.3, 1.1 };
+	const sgnl::Nanoseconds total = 3060;
+	{
+		std::ofstream file("Patterns/PatternFileSourceCheck.pat", std::ios::binary);
+		file << "# Testmuster\n1000 5\n\n50 0\n  # Kommentar\n0 4\n2000 3.3\n10 1.1";
+	}
+	std::function<sgnl::Volt(sgnl::Nanoseconds, bool)> pattern =
+			[&](sgnl::Nanoseconds a_t, bool a_repeat)
+			{
+				if (a_repeat)
+				{
+					a_t %= total;
+				}
+				for (int s = 0; s < N_SEGMENTS; s++)
+				{
+					if (a_t < durations[s])
+					{
+						return voltages[s];
+					}
+					a_t -= durations[s];
+				}
+				return voltages[N_SEGMENTS - 1];
+			};
+	std::function<sgnl::Volt(sgnl::Nanoseconds)> repeated =
+			std::bind(pattern, std::placeholders::_1, true);
+	std::function<sgnl::Volt(sgnl::Nanoseconds)> held =
+			std::bind(pattern, std::placeholders::_1, false);
+
+	// Wiederholen: bis 7000 ns laeuft das Muster zweimal ueber das Dateiende
+	Testbed testbed(Test::make4BitShiftRegister());
+	testbed.setPlotting(false);
+	testbed.addPatternFileSource("D", "PatternFileSourceCheck", true);
+	testbed.addConstantSource("CLK", LOW_LEVEL_VOLT);
+	// Reihenfolge der Inputs wie im Network
+	const int d = (testbed.network().inputNames()[0] == "D") ? 0 : 1;
+	testbed.simulationstep(1500);
+	if (!compareTrace(testbed.inputTrace(d), 0, repeated, "Wiederholtes Muster"))
+	{
+		return false;
+	}
+	std::string midSegment = testbed.checkpoint();
+	Testbed copy(testbed);
+	testbed.simulationstep(5500);
+	std::vector<sgnl::Volt> rest = testbed.inputTrace(d);
+	if (!compareTrace(rest, 1500, repeated, "Wiederholtes Muster"))
+	{
+		return false;
+	}
+	// Die Kopie oeffnet die Datei selbst, der wiederhergestellte Testbed
+	// erst beim naechsten Lesen an der gespeicherten Position
+	Testbed restored(Test::make4BitShiftRegister());
+	restored.setPlotting(false);
+	restored.addPatternFileSource("D", "PatternFileSourceCheck", true);
+	restored.addConstantSource("CLK", LOW_LEVEL_VOLT);
+	copy.simulationstep(5500);
+	if (!restored.restore(midSegment))
+	{
+		std::cout << "=> Checkpoint laesst sich nicht wiederherstellen";
+		return false;
+	}
+	restored.simulationstep(5500);
+	if (copy.inputTrace(d) != rest || restored.inputTrace(d) != rest)
+	{
+		std::cout << "=> Verlauf nach Kopie oder Wiederherstellen weicht ab";
+		return false;
+	}
+
+	// Halten: nach dem Dateiende bleibt die letzte Spannung
+	Testbed hold(Test::make4BitShiftRegister());
+	hold.setPlotting(false);
+	hold.addPatternFileSource("D", "PatternFileSourceCheck");
+	hold.addConstantSource("CLK", LOW_LEVEL_VOLT);
+	hold.simulationstep(5000);
+	if (!compareTrace(hold.inputTrace(d), 0, held, "Gehaltenes Muster"))
+	{
+		return false;
+	}
+
+	// Ungueltige Zeile: Fehlermeldung mit Zeilennummer, die letzte gueltige
+	// Spannung wird gehalten
+	{
+		std::ofstream file("Patterns/PatternFileSourceCheck.pat", std::ios::binary);
+		file << "100 5\r\n200 fuenf\r\n300 0\r\n";
+	}
+	std::shared_ptr<diag::CollectingSink> sink =
+			std::make_shared<diag::CollectingSink>();
+	diag::Log::setSink(sink);
+	Testbed broken(Test::make4BitShiftRegister());
+	broken.setPlotting(false);
+	broken.addPatternFileSource("D", "PatternFileSourceCheck");
+	broken.addConstantSource("CLK", LOW_LEVEL_VOLT);
+	broken.simulationstep(500);
+	diag::Log::setSink(nullptr);
+	std::remove("Patterns/PatternFileSourceCheck.pat");
+	std::vector<diag::LogRecord> records = sink->records();
+	bool reported = false;
+	for (int r = 0; r < static_cast<int>(records.size()); r++)
+	{
+		reported = reported || (records[r].level_ == diag::LogLevel::ERROR
+				&& records[r].component_ == "PatternFile"
+				&& records[r].message_.find("line 2") != std::string::npos);
+	}
+	std::vector<sgnl::Volt> brokenTrace = broken.inputTrace(d);
+	if (!reported || std::count(brokenTrace.begin(), brokenTrace.end(),
+			sgnl::Volt(5)) != 500)
+	{
+		std::cout << "=> Ungueltige Zeile nicht gemeldet oder Spannung nicht gehalten";
+		return false;
+	}
+	std::cout << "=> Musterdatei ueber Blockgrenzen, Kopie und Checkpoint korrekt";
+	return true;
+}
+
+/*! \brief Prueft die stueckweise lineare Quelle und den Einzelimpuls im
+ * Testbed: Interpolation und Impuls ueber eine Blockgrenze
+ * (Testbed::BLOCK_SIZE) sowie Fortsetzen nach Wiederherstellen eines
+ * Checkpoints mitten in einem Segment
+ * \return true, falls alle Verlaeufe stimmen
+ */
+bool PiecewiseLinearPulseCheck()
+{
+	std::vector<std::pair<sgnl::Nanoseconds, sgnl::Volt> > points;
+	points.push_back(std::make_pair(100, 0.0));
+	points.push_back(std::make_pair(1000, 5.0));
+	points.push_back(std::make_pair(1100, 0.0));
+	points.push_back(std::make_pair(3000, 3.0));
+	std::function<sgnl::Volt(sgnl::Nanoseconds)> ramp =
+			[&](sgnl::Nanoseconds a_t)
+			{
+				if (a_t <= points.front().first)
+				{
+					return points.front().second;
+				}
+				for (int p = 0; p + 1 < static_cast<int>(points.size()); p++)
+				{
+					if (a_t < points[p + 1].first)
+					{
+						return points[p].second + (points[p + 1].second - points[p].second)
+								* (a_t - points[p].first)
+								/ static_cast<double>(points[p + 1].first - points[p].first);
+					}
+				}
+				return points.back().second;
+			};
+	// Impuls von 1000 bis 1100 ns ueber die Blockgrenze bei 1024 ns
+	std::function<sgnl::Volt(sgnl::Nanoseconds)> pulse =
+			[](sgnl::Nanoseconds a_t)
+			{
+				return (a_t >= 1000 && a_t < 1100) ? HIGH_LEVEL_VOLT : LOW_LEVEL_VOLT;
+			};
+	Testbed testbed(Test::make4BitShiftRegister());
+	testbed.setPlotting(false);
+	testbed.addPiecewiseLinearSource("D", points);
+	testbed.addPulseSource("CLK", 1000, 100);
+	// Reihenfolge der Inputs wie im Network
+	const int d = (testbed.network().inputNames()[0] == "D") ? 0 : 1;
+	const int clk = 1 - d;
+	// Checkpoint nach 1050 ns, die Quellen stehen dann bei 2048 ns mitten
+	// in der Rampe von 1100 bis 3000 ns
+	testbed.simulationstep(1050);
+	if (!compareTrace(testbed.inputTrace(d), 0, ramp, "Rampe")
+			|| !compareTrace(testbed.inputTrace(clk), 0, pulse, "Impuls"))
+	{
+		return false;
+	}
+	std::string midSegment = testbed.checkpoint();
+	testbed.simulationstep(3000);
+	if (!compareTrace(testbed.inputTrace(d), 1050, ramp, "Rampe")
+			|| !compareTrace(testbed.inputTrace(clk), 1050, pulse, "Impuls"))
+	{
+		return false;
+	}
+	Testbed restored(Test::make4BitShiftRegister());
+	restored.setPlotting(false);
+	restored.addPiecewiseLinearSource("D", points);
+	restored.addPulseSource("CLK", 1000, 100);
+	if (!restored.restore(midSegment))
+	{
+		std::cout << "=> Checkpoint laesst sich nicht wiederherstellen";
+		return false;
+	}
+	restored.simulationstep(3000);
+	if (restored.inputTrace(d) != testbed.inputTrace(d)
+			|| restored.inputTrace(clk) != testbed.inputTrace(clk))
+	{
+		std::cout << "=> Verlauf nach dem Wiederherstellen weicht ab";
+		return false;
+	}
+	std::cout << "=> Rampe und Impuls ueber Blockgrenzen und Checkpoint korrekt";
+	return true;
+}
+
+/*! \brief Prueft, ob das CompiledNetwork bei gleichem Startwert des
+ * Zufallsgenerators exakt dieselben Outputspannungen liefert wie das Network
+ */
+bool CompiledNetworkMatchesNetwork()
+{
+	Network shiftRegister = Test::make4BitShiftRegister();
+	CompiledNetwork compiled(shiftRegister);
+	NetworkState state = compiled.createState(42);
+	sgnl::gen_.seed(42);
+	std::vector<sgnl::Volt> inputs(2);
+	for (sgnl::Nanoseconds i = 0; i <= 1000; i++)
+	{
+		inputs[0] = (i % 100 < 50) ? 0 : 5; // CLK
+		inputs[1] = (i % 133 < 67) ? 0 : 5; // D
+		shiftRegister.simulationStep(inputs);
+		compiled.simulationStep(state, &inputs[0]);
+		std::vector<sgnl::Volt> outputs = shiftRegister.outputVoltages();
+		for (int o = 0; o < compiled.nOutputs(); o++)
+		{
+			if (outputs[o] != compiled.output(state, o))
+			{
+				std::cout << "=> CompiledNetwork weicht bei t=" << i
+						<< " ab";
+				return false;
+			}
+		}
+	}
+	std::cout << "=> CompiledNetwork liefert dieselben Ergebnisse";
+	return true;
+}
+
+/*! \brief Prueft die vorzeitigen Abbruchbedingungen des Testbed: Bei
+ * konstantem D muessen die Outputs des Schieberegisters nach wenigen Takten
+ * stabil sein, eine Abbruchbedingung auf Q3 muss frueher greifen
+ */
+bool TestbedStopsEarly()
+{
+	Testbed testbed(Test::make4BitShiftRegister());
+	testbed.setPlotting(false);
+	testbed.addClockSource("CLK", 100, 0);
+	testbed.addConstantSource("D", HIGH_LEVEL_VOLT);
+	int q3 = testbed.network().outputIndex("Q3");
+	testbed.setStopPredicate([q3](sgnl::Nanoseconds, const std::vector<sgnl::Volt> &a_outputs)
+	{
+		return a_outputs[q3] >= HIGH_THRESH_VOLT;
+	});
+	if (testbed.simulationstep(100000) != StopReason::PREDICATE)
+	{
+		std::cout << "=> Abbruchbedingung auf Q3 greift nicht";
+		return false;
+	}
+	sgnl::Nanoseconds q3High = testbed.time();
+	testbed.setStopPredicate(StopPredicate());
+	testbed.setStopWhenStable(1000);
+	if (testbed.simulationstep(100000) != StopReason::STABLE
+			|| testbed.time() - q3High > 2000)
+	{
+		std::cout << "=> Stabile Outputs werden nicht erkannt";
+		return false;
+	}
+	std::cout << "=> Testbed bricht bei t=" << q3High << " bzw. t="
+			<< testbed.time() << " ab";
+	return true;
+}
+
+/*! \brief Prueft Checkpoint und Wiederherstellung des Testbed: Nach dem
+ * Wiederherstellen muss die Simulation (inklusive Rauschen und Quellen)
+ * exakt denselben Verlauf liefern wie beim ersten Mal
+ */
+bool TestbedCheckpointRestore()
+{
+	Testbed testbed(Test::make4BitShiftRegister());
+	testbed.setPlotting(false);
+	testbed.addClockSource("CLK", 100, 0);
+	testbed.addPrbsSource("D", PrbsOrder::PRBS7, 100);
+	testbed.simulationstep(1500);
+	std::string warm = testbed.checkpoint();
+
+	testbed.simulationstep(2000);
+	std::vector<sgnl::Volt> first = testbed.outputTrace(0);
+	Testbed fork(testbed);
+	if (!fork.restore(warm))
+	{
+		std::cout << "=> Checkpoint laesst sich nicht wiederherstellen";
+		return false;
+	}
+	fork.simulationstep(2000);
+	if (fork.time() != testbed.time() || fork.outputTrace(0) != first)
+	{
+		std::cout << "=> Verlauf nach dem Wiederherstellen weicht ab";
+		return false;
+	}
+	if (fork.restore(warm.substr(0, warm.size() / 2)))
+	{
+		std::cout << "=> Unvollstaendiger Checkpoint wird nicht erkannt";
+		return false;
+	}
+	Testbed other(Test::make4BitShiftRegister());
+	other.setPlotting(false);
+	other.addClockSource("CLK", 100, 0);
+	other.addClockSource("D", 300, 0);
+	if (other.restore(warm))
+	{
+		std::cout << "=> Checkpoint einer anderen Quelle wird nicht erkannt";
+		return false;
+	}
+	std::cout << "=> Checkpoint mit " << warm.size()
+			<< " Byte reproduziert die Simulation";
+	return true;
+}
+
+/*! \brief Prueft die Monitore am Schieberegister: Q0 bzw. Q3 muessen D um
+ * eine bzw. vier CLK-Flanken verzoegert folgen, Setup/Hold muss eingehalten
+ * sein. Eine zu lange Setup-Zeit muss zum Abbruch fuehren
+ */
+bool TestbedMonitorsCheck()
+{
+	Testbed testbed(Test::make4BitShiftRegister());
+	testbed.setPlotting(false);
+	testbed.setRecording(false);
+	testbed.addClockSource("CLK", 100, 0);
+	testbed.addPrbsSource("D", PrbsOrder::PRBS7, 100);
+	testbed.addMonitor(EdgeEquality("Q0=D", "CLK", "D", "Q0", 1));
+	testbed.addMonitor(EdgeEquality("Q3=D", "CLK", "D", "Q3", 4));
+	testbed.addMonitor(SetupHold("D-Setup/Hold", "CLK", "D", 20, 20));
+	testbed.addMonitor(EdgeCounter("CLK-Flanken", "CLK"));
+	testbed.simulationstep(20000);
+	if (testbed.monitorFailures() != 0)
+	{
+		for (int m = 0; m < testbed.nMonitors(); m++)
+		{
+			if (!testbed.monitor(m).failures().empty())
+			{
+				const MonitorFailure &failure = testbed.monitor(m).failures()[0];
+				std::cout << "=> Unerwarteter Fehler bei t=" << failure.time_
+						<< ": " << failure.message_;
+				break;
+			}
+		}
+		return false;
+	}
+	if (static_cast<const EdgeCounter&>(testbed.monitor(3)).count() != 200)
+	{
+		std::cout << "=> Falsche Anzahl von CLK-Flanken";
+		return false;
+	}
+
+	testbed.addMonitor(SetupHold("Setup zu lang", "CLK", "D", 60, 0));
+	testbed.setStopOnFailure(true);
+	if (testbed.simulationstep(20000) != StopReason::MONITOR_FAILURE
+			|| testbed.monitor(4).failures().empty()
+			|| testbed.monitor(4).failures()[0].time_ + 1 != testbed.time())
+	{
+		std::cout << "=> Setup-Verletzung fuehrt nicht zum Abbruch";
+		return false;
+	}
+	std::cout << "=> Monitore melden Setup-Verletzung bei t="
+			<< testbed.monitor(4).failures()[0].time_;
+	return true;
+}
+
+/*! \brief Prueft den BatchRunner: mehrere Szenarien mit eigenem Startwert
+ * auf mehreren Threads mit einem gemeinsamen CompiledNetwork. Jedes
+ * Ergebnis muss an seiner Stelle stehen und mit einem einzelnen Testbed
+ * mit denselben Quellen und demselben Startwert uebereinstimmen, auch bei
+ * einem Monitor-Fehler und einem unbekannten Input; ein zweiter Lauf muss
+ * dieselben Ergebnisse liefern
+ * \return true, falls alle Ergebnisse uebereinstimmen
+ */
+bool BatchRunnerScenarios()
+{
+	const int N_SCENARIOS = 12;
+	const int FAILING = 5;  // Setup-Verletzung, Abbruch beim ersten Fehler
+	const int UNKNOWN = 8;  // Quelle an einem nicht vorhandenen Input
+	Network shiftRegister = Test::make4BitShiftRegister();
+	BatchRunner runner(shiftRegister, 4);
+	std::vector<Scenario> scenarios;
+	for (int s = 0; s < N_SCENARIOS; s++)
+	{
+		Scenario scenario("Szenario_" + std::to_string(s), 2000 + 250 * s, 100 + s);
+		scenario.addSource("CLK", Clock(100, 10 * s));
+		scenario.addSource("D", Prbs(PrbsOrder::PRBS7, 100, s + 1));
+		scenario.addMonitor(EdgeCounter("CLK-Flanken", "CLK"));
+		if (s == FAILING)
+		{
+			scenario.addMonitor(SetupHold("Setup zu lang", "CLK", "D", 60, 0));
+			scenario.setStopOnFailure(true);
+		}
+		if (s == UNKNOWN)
+		{
+			scenario.addSource("X", Clock(100, 0));
+		}
+		scenarios.push_back(scenario);
+		runner.addScenario(scenario);
+	}
+	std::vector<ScenarioResult> results = runner.run();
+	std::vector<ScenarioResult> again = runner.run();
+	if (static_cast<int>(results.size()) != N_SCENARIOS
+			|| static_cast<int>(again.size()) != N_SCENARIOS)
+	{
+		std::cout << "=> Falsche Anzahl von Ergebnissen";
+		return false;
+	}
+	std::shared_ptr<const CompiledNetwork> compiled =
+			std::make_shared<CompiledNetwork>(shiftRegister);
+	for (int s = 0; s < N_SCENARIOS; s++)
+	{
+		// Einzelner Lauf mit eigenem CompiledNetwork als Referenz
+		const Scenario &scenario = scenarios[s];
+		Testbed testbed(compiled, scenario.seed());
+		testbed.setRecording(false);
+		testbed.setPlotting(false);
+		bool ok = true;
+		for (int i = 0; i < static_cast<int>(scenario.sources().size()); i++)
+		{
+			ok = testbed.addSource(scenario.sources()[i].first,
+					*scenario.sources()[i].second) && ok;
+		}
+		for (int m = 0; m < static_cast<int>(scenario.monitors().size()); m++)
+		{
+			ok = testbed.addMonitor(*scenario.monitors()[m]) && ok;
+		}
+		testbed.setStopOnFailure(scenario.stopOnFailure());
+		StopReason reason = testbed.simulationstep(scenario.duration());
+
+		const ScenarioResult &result = results[s];
+		bool same = result.id_ == scenario.id() && result.ok_ == ok
+				&& result.ok_ == (s != UNKNOWN)
+				&& result.stopReason_ == reason
+				&& result.simulatedTime_ == testbed.time()
+				&& result.report_.simulatedNs_ == testbed.time()
+				&& result.report_.stopReason_ == testbed.runReport().stopReason_;
+		for (int o = 0; same && o < compiled->nOutputs(); o++)
+		{
+			std::string name = compiled->outputNames()[o];
+			same = result.finalOutputs_.count(name) == 1
+					&& result.finalOutputs_.at(name) == testbed.output(o)
+					&& result.outputTransitions_.count(name) == 1
+					&& result.outputTransitions_.at(name)
+							== testbed.outputTransitions(o);
+		}
+		int failingMonitors = 0;
+		for (int m = 0; same && m < testbed.nMonitors(); m++)
+		{
+			const Monitor &monitor = testbed.monitor(m);
+			if (monitor.failures().empty())
+			{
+				continue;
+			}
+			failingMonitors++;
+			std::map<std::string, std::vector<MonitorFailure> >::const_iterator it =
+					result.monitorFailures_.find(monitor.name());
+			same = it != result.monitorFailures_.end()
+					&& it->second.size() == monitor.failures().size();
+			for (int f = 0; same && f < static_cast<int>(it->second.size()); f++)
+			{
+				same = it->second[f].time_ == monitor.failures()[f].time_
+						&& it->second[f].message_ == monitor.failures()[f].message_;
+			}
+		}
+		same = same
+				&& static_cast<int>(result.monitorFailures_.size()) == failingMonitors
+				&& (s != FAILING || (failingMonitors == 1
+						&& result.stopReason_ == StopReason::MONITOR_FAILURE));
+		if (!same)
+		{
+			std::cout << "=> " << scenario.id()
+					<< " weicht vom einzelnen Testbed ab";
+			return false;
+		}
+		const ScenarioResult &second = again[s];
+		if (second.id_ != result.id_ || second.ok_ != result.ok_
+				|| second.stopReason_ != result.stopReason_
+				|| second.simulatedTime_ != result.simulatedTime_
+				|| second.finalOutputs_ != result.finalOutputs_
+				|| second.outputTransitions_ != result.outputTransitions_
+				|| second.monitorFailures_.size() != result.monitorFailures_.size())
+		{
+			std::cout << "=> Zweiter Lauf von " << scenario.id() << " weicht ab";
+			return false;
+		}
+	}
+	std::cout << "=> " << N_SCENARIOS
+			<< " Szenarien auf 4 Threads wie einzelne Testbeds";
+	return true;
+}
+
+/*! \brief Prueft die Min/Max-Huellkurve: Jede Spalte muss genau die
+ * Extremwerte ihrer Werte enthalten, auch ein einzelner kurzer Impuls
+ */
+bool EnvelopeMinMaxCheck()
+{
+	std::vector<sgnl::Volt> values(100000, LOW_LEVEL_VOLT);
+	values[54321] = HIGH_LEVEL_VOLT;
+	Envelope envelope(values, 0, 100000, 1000);
+	if (envelope.nColumns() != 1000)
+	{
+		std::cout << "=> Falsche Spaltenanzahl";
+		return false;
+	}
+	for (int c = 0; c < envelope.nColumns(); c++)
+	{
+		sgnl::Volt expected = (c == 543) ? HIGH_LEVEL_VOLT : LOW_LEVEL_VOLT;
+		if (envelope.max(c) != expected || envelope.min(c) != LOW_LEVEL_VOLT)
+		{
+			std::cout << "=> Huellkurve in Spalte " << c << " falsch";
+			return false;
+		}
+	}
+	std::cout << "=> Huellkurve enthaelt den 1-ns-Impuls";
+	return true;
+}
+
+/*! \brief Backend fuer Tests: Schreibt keine Datei, sondern sammelt die
+ * Vektorbeschreibung jedes gespeicherten Plots
+ */
+class SceneCapture: public PlotBackend
+{
+public:
+	SceneCapture() :
+			scenes_(new std::vector<PlotScene>())
+	{
+	}
+
+	std::string extension() const
+	{
+		return ".scene";
+	}
+
+	bool needsScene() const
+	{
+		return true;
+	}
+
+	bool write(const SimpleBMP&, const PlotScene &a_scene,
+			const std::string&) const
+	{
+		scenes_->push_back(a_scene);
+		return true;
+	}
+
+	std::shared_ptr<std::vector<PlotScene> > scenes_; /**< Gesammelte Plots */
+};
+
+/*! \brief Prueft die Aufteilung eines TiledPlot: Anzahl der Kacheln,
+ * Signale und Zeitfenster je Kachel, sowie dass ein Signal genau an den
+ * Kachelgrenzen geteilt wird (ein HIGH-Abschnitt, der genau eine Zeitkachel
+ * fuellt, darf in den Nachbarkacheln nicht erscheinen)
+ * \return true, falls die Kacheln stimmen
+ */
+bool TiledPlotPagesCheck()
+{
+	std::vector<sgnl::Volt> low(10000, LOW_LEVEL_VOLT);
+	std::vector<sgnl::Volt> pulse(low);
+	std::fill(pulse.begin() + 3500, pulse.begin() + 4500, HIGH_LEVEL_VOLT);
+	TiledPlot plot("Kacheln", 4, 1000);
+	for (int s = 0; s < 9; s++)
+	{
+		plot.add("s" + std::to_string(s), s == 5 ? pulse : low);
+	}
+	plot.setTimeRange(2500, 6000);
+	if (plot.nSignalPages() != 3 || plot.nTimePages() != 4)
+	{
+		std::cout << "=> Falsche Kachelanzahl " << plot.nSignalPages() << "x"
+				<< plot.nTimePages();
+		return false;
+	}
+	const int firstSignal[] = { 0, 4, 8, 9 };
+	for (int sp = 0; sp < 3; sp++)
+	{
+		int first = 0;
+		int last = 0;
+		plot.signalPage(sp, first, last);
+		if (first != firstSignal[sp] || last != firstSignal[sp + 1])
+		{
+			std::cout << "=> Signalkachel " << sp << " enthaelt " << first
+					<< " bis " << last;
+			return false;
+		}
+	}
+	const sgnl::Nanoseconds pageBegin[] = { 2500, 3500, 4500, 5500, 6000 };
+	for (int tp = 0; tp < 4; tp++)
+	{
+		sgnl::Nanoseconds begin = 0;
+		sgnl::Nanoseconds end = 0;
+		plot.timePage(tp, begin, end);
+		if (begin != pageBegin[tp] || end != pageBegin[tp + 1])
+		{
+			std::cout << "=> Zeitkachel " << tp << " umfasst " << begin
+					<< " bis " << end << " ns";
+			return false;
+		}
+	}
+
+	// Jede Polylinie muss waagrecht sein: HIGH nur in Kachel (1, 1) bei Signal 5
+	std::shared_ptr<SceneCapture> capture = std::make_shared<SceneCapture>();
+	plot.setBackend(capture);
+	if (!plot.save("TiledPlotPagesCheck")
+			|| capture->scenes_->size() != 12)
+	{
+		std::cout << "=> " << capture->scenes_->size() << " Kacheln gespeichert";
+		return false;
+	}
+	int lowY = 0;
+	int highY = 0;
+	bool haveLow = false;
+	bool haveHigh = false;
+	for (int sp = 0; sp < 3; sp++)
+	{
+		for (int tp = 0; tp < 4; tp++)
+		{
+			const PlotScene &scene = (*capture->scenes_)[sp * 4 + tp];
+			if (static_cast<int>(scene.traces_.size())
+					!= firstSignal[sp + 1] - firstSignal[sp])
+			{
+				std::cout << "=> Kachel " << sp << "/" << tp << " hat "
+						<< scene.traces_.size() << " Verlaeufe";
+				return false;
+			}
+			for (int t = 0; t < static_cast<int>(scene.traces_.size()); t++)
+			{
+				const std::vector<PlotScene::Point> &points =
+						scene.traces_[t].points_;
+				if (points.empty())
+				{
+					std::cout << "=> Leerer Verlauf";
+					return false;
+				}
+				int y0 = points.front().y_;
+				bool high = (sp == 1 && tp == 1 && t == 1);
+				for (int p = 0; p < static_cast<int>(points.size()); p++)
+				{
+					if (points[p].y_ != y0)
+					{
+						std::cout << "=> Verlauf " << firstSignal[sp] + t
+								<< " in Zeitkachel " << tp
+								<< " wechselt den Pegel";
+						return false;
+					}
+				}
+				// Pegel relativ zur HIGH-Grenze des Verlaufs
+				int rel = y0 - scene.traces_[t].highY_;
+				int &expected = high ? highY : lowY;
+				bool &have = high ? haveHigh : haveLow;
+				if (!have)
+				{
+					expected = rel;
+					have = true;
+				}
+				if (rel != expected)
+				{
+					std::cout << "=> Verlauf " << firstSignal[sp] + t
+							<< " in Zeitkachel " << tp << " auf falschem Pegel";
+					return false;
+				}
+			}
+		}
+	}
+	if (!haveHigh || !haveLow || highY >= lowY)
+	{
+		std::cout << "=> HIGH-Abschnitt nicht gefunden";
+		return false;
+	}
+	std::cout << "=> 9 Signale und 3500 ns auf 3x4 Kacheln verteilt, Grenzen"
+			<< " bei 3500 und 4500 ns exakt";
+	return true;
+}
+
+/*! \brief Prueft SimpleBMPWriter: Zwei nacheinander gestreamte Baender
+ * mit Fuellbytes je Zeile muessen sich mit SimpleBMP::load(...) wieder
+ * pixelgenau lesen lassen
+ * \return true, falls das Bild identisch gelesen wird
+ */
+bool SimpleBMPWriterRoundTrip()
+{
+	// Breite 37: Zeilen mit Fuellbytes
+	SimpleBMP band(37, 11);
+	for (int i = 0; i < 37 * 11 * 3; i++)
+	{
+		band.getPixels()[i] = static_cast<unsigned char>(i * 7);
+	}
+	SimpleBMPWriter writer;
+	if (writer.open("SimpleBMPWriterTest.bmp", 37, 22) != SIMPLEBMP_NO_ERROR)
+	{
+		std::cout << "=> Datei konnte nicht geoeffnet werden";
+		return false;
+	}
+	writer.writeBand(band);
+	writer.writeBand(band);
+	bool closed = (writer.close() == SIMPLEBMP_NO_ERROR);
+	SimpleBMP image;
+	bool loaded = (image.load("SimpleBMPWriterTest.bmp") == SIMPLEBMP_NO_ERROR);
+	std::remove("SimpleBMPWriterTest.bmp");
+	if (!closed || !loaded || image.getWidth() != 37 || image.getHeight() != 22)
+	{
+		std::cout << "=> Bild nicht vollstaendig geschrieben";
+		return false;
+	}
+	for (int y = 0; y < 22; y++)
+	{
+		for (int x = 0; x < 37; x++)
+		{
+			if (image.getRGB(x, y) != band.getRGB(x, y % 11))
+			{
+				std::cout << "=> Pixel (" << x << ", " << y << ") falsch";
+				return false;
+			}
+		}
+	}
+	std::cout << "=> Zwei Baender gestreamt und identisch gelesen";
+	return true;
+}
+
+/*! \brief Prueft PlotBatch: Vier parallel gespeicherte Plots mit gleicher
+ * Id muessen unter eindeutigen, gueltigen Dateinamen als lesbare Bilder
+ * abgelegt werden
+ * \return true, falls alle Dateinamen eindeutig sind
+ */
+bool PlotBatchUniqueNames()
+{
+	// Vier Plots mit gleicher Id in derselben Sekunde
+	PlotBatch batch(".", 4);
+	for (int p = 0; p < 4; p++)
+	{
+		std::vector<std::vector<sgnl::Volt> > signals(1,
+				std::vector<sgnl::Volt>(500, p % 2 ? HIGH_LEVEL_VOLT : LOW_LEVEL_VOLT));
+		batch.add("Szenario/1", "Batch", std::vector<std::string>(1, "x"),
+				std::move(signals));
+	}
+	std::vector<std::string> paths = batch.run();
+	bool ok = (paths.size() == 4);
+	for (int p = 0; ok && p < 4; p++)
+	{
+		SimpleBMP image;
+		ok = !paths[p].empty() && paths[p].find("Szenario_1_") != std::string::npos
+				&& image.load(paths[p].c_str()) == SIMPLEBMP_NO_ERROR;
+		for (int q = 0; ok && q < p; q++)
+		{
+			ok = (paths[p] != paths[q]);
+		}
+	}
+	for (int p = 0; p < static_cast<int>(paths.size()); p++)
+	{
+		std::remove(paths[p].c_str());
+	}
+	if (!ok)
+	{
+		std::cout << "=> Dateinamen nicht eindeutig oder Bild fehlt";
+		return false;
+	}
+	std::cout << "=> 4 Plots parallel unter eindeutigen Namen gespeichert";
+	return true;
+}
+
+/*! \brief Liest einen Deflate-Datenstrom bitweise (niederwertigstes Bit
+ * zuerst) und dekodiert kanonische Huffman-Codes, fuer inflateZlib(...)
+ */
+class InflateReader
+{
+public:
+	InflateReader(const std::vector<unsigned char> &a_data, std::size_t a_pos) :
+			data_(a_data), pos_(a_pos), bit_(0), failed_(false)
+	{
+	}
+
+	/*! \brief Liest a_n Bits, hinter dem Ende wird failed() gesetzt */
+	unsigned bits(int a_n)
+	{
+		unsigned value = 0;
+		for (int k = 0; k < a_n; k++)
+		{
+			if (pos_ >= data_.size())
+			{
+				failed_ = true;
+				return 0;
+			}
+			value |= ((data_[pos_] >> bit_) & 1u) << k;
+			if (++bit_ == 8)
+			{
+				bit_ = 0;
+				pos_++;
+			}
+		}
+		return value;
+	}
+
+	/*! \brief Ueberspringt die Bits bis zur naechsten Bytegrenze */
+	void align()
+	{
+		if (bit_ != 0)
+		{
+			bit_ = 0;
+			pos_++;
+		}
+	}
+
+	/*! \brief Dekodiert ein Symbol
+	 * \param a_count Anzahl Codes je Laenge 0..15
+	 * \param a_symbols Symbole nach Codelaenge und Wert sortiert
+	 * \return Symbol, -1 bei ungueltigem Code
+	 */
+	int decode(const std::vector<int> &a_count, const std::vector<int> &a_symbols)
+	{
+		int code = 0;
+		int first = 0;
+		int index = 0;
+		for (int length = 1; length < 16 && !failed_; length++)
+		{
+			code |= bits(1);
+			if (code - a_count[length] < first)
+			{
+				return a_symbols[index + code - first];
+			}
+			index += a_count[length];
+			first = (first + a_count[length]) << 1;
+			code <<= 1;
+		}
+		return -1;
+	}
+
+	std::size_t position() const
+	{
+		return pos_;
+	}
+
+	bool failed() const
+	{
+		return failed_;
+	}
+
+private:
+	const std::vector<unsigned char> &data_;  /**< Datenstrom */
+	std::size_t pos_;                         /**< Aktuelles Byte */
+	int bit_;                                 /**< Aktuelles Bit im Byte */
+	bool failed_;                             /**< Ueber das Ende gelesen */
+};
+
+/*! \brief Bildet aus Codelaengen die Tabellen fuer InflateReader::decode(...)
+ * \param a_lengths Codelaenge je Symbol, 0 = nicht verwendet
+ * \param a_count Ausgabe: Anzahl Codes je Laenge
+ * \param a_symbols Ausgabe: Symbole nach Codelaenge sortiert
+ */
+void inflateTable(const std::vector<int> &a_lengths, std::vector<int> &a_count,
+		std::vector<int> &a_symbols)
+{
+	a_count.assign(16, 0);
+	a_symbols.clear();
+	for (int length = 1; length < 16; length++)
+	{
+		for (int s = 0; s < static_cast<int>(a_lengths.size()); s++)
+		{
+			if (a_lengths[s] == length)
+			{
+				a_count[length]++;
+				a_symbols.push_back(s);
+			}
+		}
+	}
+}
+
+/*! \brief Einfacher zlib-Dekoder (RFC 1950/1951) mit unkomprimierten, festen
+ * und dynamischen Bloecken, prueft die Adler-32-Pruefsumme
+ * \param a_in zlib-Datenstrom
+ * \param a_out Ausgabe: dekomprimierte Daten
+ * \return true, falls der Datenstrom gueltig und vollstaendig ist
+ */
+bool inflateZlib(const std::vector<unsigned char> &a_in,
+		std::vector<unsigned char> &a_out)
+{
+	static const int LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15,
+			17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195,
+			227, 258 };
+	static const int LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1,
+			2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	static const int DIST_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49,
+			65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+			6145, 8193, 12289, 16385, 24577 };
+	static const int DIST_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5,
+			5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+	static const int CLEN_ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4,
+			12, 3, 13, 2, 14, 1, 15 };
+	a_out.clear();
+	if (a_in.size() < 6 || (a_in[0] & 0x0F) != 8
+			|| ((a_in[0] << 8) | a_in[1]) % 31 != 0)
+	{
+		return false;
+	}
+	InflateReader in(a_in, 2);
+	bool last = false;
+	while (!last && !in.failed())
+	{
+		last = (in.bits(1) == 1);
+		unsigned type = in.bits(2);
+		if (type == 0)
+		{
+			in.align();
+			unsigned length = in.bits(16);
+			if ((length ^ 0xFFFF) != in.bits(16))
+			{
+				return false;
+			}
+			for (unsigned k = 0; k < length && !in.failed(); k++)
+			{
+				a_out.push_back(static_cast<unsigned char>(in.bits(8)));
+			}
+			continue;
+		}
+		std::vector<int> litLengths;
+		std::vector<int> distLengths;
+		if (type == 1)
+		{
+			litLengths.assign(288, 8);
+			std::fill(litLengths.begin() + 144, litLengths.begin() + 256, 9);
+			std::fill(litLengths.begin() + 256, litLengths.begin() + 280, 7);
+			distLengths.assign(30, 5);
+		}
+		else if (type == 2)
+		{
+			int nLit = in.bits(5) + 257;
+			int nDist = in.bits(5) + 1;
+			int nClen = in.bits(4) + 4;
+			std::vector<int> clenLengths(19, 0);
+			for (int k = 0; k < nClen; k++)
+			{
+				clenLengths[CLEN_ORDER[k]] = in.bits(3);
+			}
+			std::vector<int> clenCount;
+			std::vector<int> clenSymbols;
+			inflateTable(clenLengths, clenCount, clenSymbols);
+			std::vector<int> lengths;
+			while (static_cast<int>(lengths.size()) < nLit + nDist && !in.failed())
+			{
+				int symbol = in.decode(clenCount, clenSymbols);
+				if (symbol < 0 || (symbol == 16 && lengths.empty()))
+				{
+					return false;
+				}
+				if (symbol < 16)
+				{
+					lengths.push_back(symbol);
+					continue;
+				}
+				int value = (symbol == 16) ? lengths.back() : 0;
+				int repeat = (symbol == 16) ? 3 + in.bits(2) :
+								(symbol == 17) ? 3 + in.bits(3) : 11 + in.bits(7);
+				lengths.insert(lengths.end(), repeat, value);
+			}
+			if (static_cast<int>(lengths.size()) != nLit + nDist)
+			{
+				return false;
+			}
+			litLengths.assign(lengths.begin(), lengths.begin() + nLit);
+			distLengths.assign(lengths.begin() + nLit, lengths.end());
+		}
+		else
+		{
+			return false;
+		}
+		std::vector<int> litCount;
+		std::vector<int> litSymbols;
+		std::vector<int> distCount;
+		std::vector<int> distSymbols;
+		inflateTable(litLengths, litCount, litSymbols);
+		inflateTable(distLengths, distCount, distSymbols);
+		for (;;)
+		{
+			int symbol = in.decode(litCount, litSymbols);
+			if (symbol < 0 || symbol > 285)
+			{
+				return false;
+			}
+			if (symbol < 256)
+			{
+				a_out.push_back(static_cast<unsigned char>(symbol));
+				continue;
+			}
+			if (symbol == 256)
+			{
+				break;
+			}
+			int l = symbol - 257;
+			int length = LENGTH_BASE[l] + in.bits(LENGTH_EXTRA[l]);
+			int d = in.decode(distCount, distSymbols);
+			if (d < 0 || d > 29)
+			{
+				return false;
+			}
+			std::size_t dist = DIST_BASE[d] + in.bits(DIST_EXTRA[d]);
+			if (dist > a_out.size())
+			{
+				return false;
+			}
+			for (int k = 0; k < length; k++)
+			{
+				a_out.push_back(a_out[a_out.size() - dist]);
+			}
+		}
+	}
+	in.align();
+	std::size_t pos = in.position();
+	if (in.failed() || pos + 4 != a_in.size())
+	{
+		return false;
+	}
+	std::uint32_t adler = (static_cast<std::uint32_t>(a_in[pos]) << 24)
+			| (a_in[pos + 1] << 16) | (a_in[pos + 2] << 8) | a_in[pos + 3];
+	return adler == Deflate::adler32(a_out.data(), a_out.size());
+}
+
+/*! \brief Prueft PngBackend und Deflate: CRC-32/Adler-32, Chunks und ihre
+ * Pruefsummen, Pixel nach Dekomprimieren und Rueckgaengigmachen der Filter
+ * sowie unkomprimierte Bloecke fuer nicht komprimierbare Daten
+ * \return true, falls PNG und Deflate-Datenstroeme gueltig sind
+ */
+bool PngBackendEncode()
+{
+	// Pruefsummen gegen bekannte Werte
+	const char *check = "123456789";
+	if (PngBackend::crc32(reinterpret_cast<const unsigned char*>(check), 9)
+			!= 0xCBF43926u
+			|| Deflate::adler32(reinterpret_cast<const unsigned char*>(check), 9)
+					!= 0x091E01DEu)
+	{
+		std::cout << "=> CRC-32 oder Adler-32 falsch";
+		return false;
+	}
+	SimpleBMP image(37, 11);
+	for (int y = 0; y < 11; y++)
+	{
+		for (int x = 0; x < 37; x++)
+		{
+			image.setPixel(x, y, x < 20 ? 255 : 0, y * 20, (x * y * 7) % 256);
+		}
+	}
+	std::vector<unsigned char> png = PngBackend().encode(image);
+	const unsigned char signature[8] = { 137, 'P', 'N', 'G', 13, 10, 26, 10 };
+	if (png.size() < 8 || !std::equal(signature, signature + 8, png.begin()))
+	{
+		std::cout << "=> PNG-Signatur fehlt";
+		return false;
+	}
+	// Alle Chunks pruefen: Laenge, CRC, Reihenfolge IHDR ... IEND
+	std::string chunks;
+	std::vector<unsigned char> idat;
+	std::size_t pos = 8;
+	while (pos + 12 <= png.size())
+	{
+		std::uint32_t length = (png[pos] << 24) | (png[pos + 1] << 16)
+				| (png[pos + 2] << 8) | png[pos + 3];
+		if (pos + 12 + length > png.size())
+		{
+			break;
+		}
+		std::size_t crcPos = pos + 8 + length;
+		std::uint32_t crc = (png[crcPos] << 24) | (png[crcPos + 1] << 16)
+				| (png[crcPos + 2] << 8) | png[crcPos + 3];
+		if (PngBackend::crc32(&png[pos + 4], length + 4) != crc)
+		{
+			std::cout << "=> CRC eines Chunks falsch";
+			return false;
+		}
+		chunks += std::string(png.begin() + pos + 4, png.begin() + pos + 8) + " ";
+		if (std::string(png.begin() + pos + 4, png.begin() + pos + 8) == "IDAT")
+		{
+			idat.insert(idat.end(), png.begin() + pos + 8, png.begin() + crcPos);
+		}
+		pos = crcPos + 4;
+	}
+	if (pos != png.size() || chunks != "IHDR IDAT IEND "
+			|| png[19] != 37 || png[23] != 11)
+	{
+		std::cout << "=> Chunks falsch: " << chunks;
+		return false;
+	}
+	// Dekomprimieren, Filter je Zeile rueckgaengig machen, Pixel vergleichen
+	const int rowBytes = 37 * 3;
+	std::vector<unsigned char> raw;
+	if (!inflateZlib(idat, raw) || raw.size() != static_cast<std::size_t>((rowBytes + 1) * 11))
+	{
+		std::cout << "=> IDAT laesst sich nicht dekomprimieren";
+		return false;
+	}
+	std::vector<unsigned char> prior(rowBytes, 0);
+	for (int y = 0; y < 11; y++)
+	{
+		unsigned char filter = raw[(rowBytes + 1) * y];
+		unsigned char *row = &raw[(rowBytes + 1) * y + 1];
+		for (int i = 0; i < rowBytes; i++)
+		{
+			int a = (i >= 3) ? row[i - 3] : 0;
+			int b = prior[i];
+			int c = (i >= 3) ? prior[i - 3] : 0;
+			int p = a + b - c;
+			int pa = std::abs(p - a);
+			int pb = std::abs(p - b);
+			int pc = std::abs(p - c);
+			int predictor[5] = { 0, a, b, (a + b) / 2,
+					(pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c };
+			if (filter > 4)
+			{
+				std::cout << "=> Unbekannter Filter " << static_cast<int>(filter);
+				return false;
+			}
+			row[i] = static_cast<unsigned char>(row[i] + predictor[filter]);
+		}
+		for (int x = 0; x < 37; x++)
+		{
+			unsigned char r, g, b;
+			image.getPixel(x, y, &r, &g, &b);
+			if (row[3 * x] != r || row[3 * x + 1] != g || row[3 * x + 2] != b)
+			{
+				std::cout << "=> Pixel (" << x << ", " << y << ") falsch";
+				return false;
+			}
+		}
+		prior.assign(row, row + rowBytes);
+	}
+	// Gleichfoermige Daten muessen stark komprimiert werden, Zufallsdaten
+	// duerfen als unkomprimierte Bloecke kaum wachsen; ueber mehrere Bloecke
+	// muss alles wieder herauskommen
+	std::mt19937 gen(37);
+	std::vector<unsigned char> zeros(100000, 0);
+	std::vector<unsigned char> noise(70000);
+	std::vector<unsigned char> text;
+	for (int i = 0; i < static_cast<int>(noise.size()); i++)
+	{
+		noise[i] = static_cast<unsigned char>(gen());
+	}
+	while (text.size() < 300000)
+	{
+		std::string word = "t" + std::to_string(gen() % 500) + " ";
+		text.insert(text.end(), word.begin(), word.end());
+	}
+	std::vector<unsigned char> packedZeros = Deflate::zlibCompress(&zeros[0], zeros.size());
+	std::vector<unsigned char> packedNoise = Deflate::zlibCompress(&noise[0], noise.size());
+	std::vector<unsigned char> packedText = Deflate::zlibCompress(&text[0], text.size());
+	std::vector<unsigned char> unpacked;
+	if (packedZeros.size() > 1000 || packedText.size() > text.size() / 2)
+	{
+		std::cout << "=> Deflate komprimiert nicht";
+		return false;
+	}
+	// zlib-Kopf und Adler-32, je Block (hoechstens 32768 Symbole) 5 Bytes
+	if (packedNoise.size() > noise.size() + 2 + 4 + 3 * 5)
+	{
+		std::cout << "=> Nicht komprimierbare Daten wachsen auf "
+				<< packedNoise.size() << " Bytes";
+		return false;
+	}
+	if (!inflateZlib(packedZeros, unpacked) || unpacked != zeros
+			|| !inflateZlib(packedNoise, unpacked) || unpacked != noise
+			|| !inflateZlib(packedText, unpacked) || unpacked != text)
+	{
+		std::cout << "=> Deflate-Datenstrom laesst sich nicht dekomprimieren";
+		return false;
+	}
+	std::cout << "=> PNG mit gueltigen Chunks und identischen Pixeln erzeugt";
+	return true;
+}
+
+/*! \brief Prueft SvgBackend an einer kleinen Szene: Wurzelelement mit
+ * Groesse, Eckpunkte der Polylinie in Pixelmitten und Texte mit maskierten
+ * Sonderzeichen
+ * \return true, falls alle Elemente wie erwartet geschrieben werden
+ */
+bool SvgBackendWrite()
+{
+	PlotScene scene;
+	scene.width_ = 120;
+	scene.height_ = 40;
+	scene.glyphWidth_ = 6;
+	scene.glyphHeight_ = 10;
+	PlotScene::Color white = { 255, 255, 255 };
+	PlotScene::Color red = { 255, 0, 0 };
+	PlotScene::Line axis = { { 0, 39 }, { 119, 39 }, white };
+	scene.lines_.push_back(axis);
+	PlotScene::Text label = { { 2, 3 }, "Q0 <&>" };
+	scene.texts_.push_back(label);
+	PlotScene::Trace trace;
+	const int points[4][2] = { { 10, 30 }, { 50, 30 }, { 50, 5 }, { 119, 5 } };
+	for (int p = 0; p < 4; p++)
+	{
+		PlotScene::Point point = { points[p][0], points[p][1] };
+		trace.points_.push_back(point);
+	}
+	trace.highY_ = 10;
+	trace.deadbandY_ = 20;
+	trace.high_ = red;
+	trace.deadband_ = white;
+	trace.low_ = white;
+	scene.traces_.push_back(trace);
+
+	std::ostringstream out;
+	SvgBackend().writeSvg(scene, out);
+	std::string svg = out.str();
+	const char *expected[4] = {
+			"<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"120\" height=\"40\"",
+			"points=\"10.5,30.5 50.5,30.5 50.5,5.5 119.5,5.5\"",
+			"M0.5 39.5L119.5 39.5",
+			">Q0 &lt;&amp;&gt;</text>" };
+	for (int e = 0; e < 4; e++)
+	{
+		if (svg.find(expected[e]) == std::string::npos)
+		{
+			std::cout << "=> Fehlt im SVG: " << expected[e];
+			return false;
+		}
+	}
+	std::size_t root = svg.find("<svg ");
+	if (root == std::string::npos || svg.find("<polyline") < root
+			|| svg.compare(svg.size() - 7, 7, "</svg>\n") != 0
+			|| svg.find("<polyline", svg.find("<polyline") + 1) != std::string::npos)
+	{
+		std::cout << "=> SVG-Struktur falsch";
+		return false;
+	}
+	std::cout << "=> SVG mit Wurzelelement, Polylinie und Texten geschrieben";
+	return true;
+}
+
+/*! \brief Prueft WaveformPyramid: Huellkurven zufaelliger Zeitfenster muessen
+ * mit Envelope uebereinstimmen, eine gespeicherte Pyramide muss wieder
+ * geladen und nach Aenderung der Werte verworfen werden
+ * \return true, falls Huellkurven und Pyramidendatei stimmen
+ */
+bool WaveformPyramidMatchesEnvelope()
+{
+	// Auch sehr kurze Signale und Laengen, die keine Zweierpotenz sind
+	const int lengths[4] = { 1, 17, 1000, 100003 };
+	std::mt19937 gen(7);
+	for (int l = 0; l < 4; l++)
+	{
+		std::vector<sgnl::Volt> values(lengths[l]);
+		for (int i = 0; i < lengths[l]; i++)
+		{
+			values[i] = (gen() % 330) / 100.0;
+		}
+		WaveformPyramid pyramid(values);
+		for (int trial = 0; trial < 50; trial++)
+		{
+			int begin = gen() % lengths[l];
+			int end = begin + 1 + gen() % (lengths[l] - begin);
+			int columns = 1 + gen() % 1200;
+			Envelope direct(values, begin, end, columns);
+			Envelope fromPyramid = pyramid.envelope(begin, end, columns);
+			bool same = (direct.nColumns() == fromPyramid.nColumns());
+			for (int c = 0; same && c < direct.nColumns(); c++)
+			{
+				same = direct.min(c) == fromPyramid.min(c)
+						&& direct.max(c) == fromPyramid.max(c)
+						&& direct.last(c) == fromPyramid.last(c);
+			}
+			if (!same)
+			{
+				std::cout << "=> Huellkurve weicht ab (Laenge " << lengths[l]
+						<< ", " << begin << "-" << end << ", " << columns
+						<< " Spalten)";
+				return false;
+			}
+		}
+		if (l < 3)
+		{
+			continue;
+		}
+		// Speichern, wieder laden und veraenderte Werte erkennen
+		bool saved = pyramid.save("pyramidtest");
+		WaveformPyramid loaded;
+		bool ok = saved && loaded.load("pyramidtest", values)
+				&& loaded.nLevels() == pyramid.nLevels();
+		values[5] += 1.0;
+		bool stale = loaded.load("pyramidtest", values);
+		std::remove(WaveformPyramid::pathFor("pyramidtest").c_str());
+		if (!ok || stale)
+		{
+			std::cout << "=> Pyramidendatei falsch geladen";
+			return false;
+		}
+	}
+	std::cout << "=> Huellkurven aus der Pyramide identisch, Datei geladen";
+	return true;
+}
+
+/*! \brief Prueft LogicTrace und die Busdarstellung: Flanken mit Totzone
+ * und die Buswerte eines Zweibit-Zaehlers im BMPPlot
+ * \return true, falls Flanken und Buswerte stimmen
+ */
+bool LogicTraceAndBus()
+{
+	// Totzone: 3.3 V und 3.25 V behalten das vorherige Logiklevel
+	const double volts[7] = { 0.0, 3.3, 3.5, 3.3, 3.25, 0.0, 0.0 };
+	LogicTrace trace(std::vector<sgnl::Volt>(volts, volts + 7));
+	if (trace.edges().size() != 2 || trace.edges()[0] != 2
+			|| trace.edges()[1] != 5 || trace.levelAt(1) || !trace.levelAt(4)
+			|| trace.levelAt(5) || trace.levelAt(100))
+	{
+		std::cout << "=> Flanken falsch erkannt";
+		return false;
+	}
+	// Zweibit-Bus zaehlt in Schritten von 100 ns von 0 bis 3
+	std::vector<bool> bit0(400);
+	std::vector<bool> bit1(400);
+	for (int t = 0; t < 400; t++)
+	{
+		bit0[t] = (t / 100) % 2 == 1;
+		bit1[t] = (t / 200) % 2 == 1;
+	}
+	LogicTrace q0(bit0);
+	LogicTrace q1(bit1);
+	std::vector<const LogicTrace*> bits;
+	bits.push_back(&q0);
+	bits.push_back(&q1);
+	BMPPlot plot("Bus");
+	plot.setTimeRange(0, 400);
+	plot.addBus("Q1:0", bits);
+	std::string values;
+	const std::vector<PlotScene::Text> &texts = plot.scene().texts_;
+	for (int t = 0; t < static_cast<int>(texts.size()); t++)
+	{
+		values += texts[t].text_ + " ";
+	}
+	if (values != "Bus Q1:0 0 1 2 3 ")
+	{
+		std::cout << "=> Buswerte falsch: " << values;
+		return false;
+	}
+	std::cout << "=> Flanken und Buswerte korrekt";
+	return true;
+}
+
+/*! \brief Prueft TextPlot: Logikzeile mit Flanken, Buszeile mit Werten
+ * und Wechseln sowie eine Spannungszeile, in der mehrere Flanken je Spalte
+ * als # erscheinen
+ * \return true, falls die Textausgabe stimmt
+ */
+bool TextPlotRows()
+{
+	LogicTrace a(std::vector<bool>{ 0, 0, 1, 1, 1, 0, 0, 0, 1, 1 });
+	LogicTrace b(std::vector<bool>{ 1, 1, 1, 0, 0, 0, 0, 1, 1, 1 });
+	std::vector<const LogicTrace*> bits;
+	bits.push_back(&a);
+	bits.push_back(&b);
+	TextPlot plot("Text", 20, 4);
+	plot.addLogic("a", a);
+	plot.addBus("ab", bits);
+	// 20 Spalten fuer 40 ns: ab der zweiten Spalte zwei Flanken je Spalte
+	std::vector<sgnl::Volt> fast(40);
+	for (int t = 0; t < 40; t++)
+	{
+		fast[t] = (t % 2 == 1) ? HIGH_LEVEL_VOLT : 0.0;
+	}
+	plot.setTimeRange(0, 40);
+	plot.add("f", fast);
+	std::stringstream out;
+	plot.write(out);
+	std::string expected = "Text\n\n"
+			"a   __/--\\__/-\n"
+			"ab  2=XX1X0XX3\n"
+			"f   /###################\n";
+	if (out.str() != expected)
+	{
+		std::cout << "=> Textausgabe falsch:\n" << out.str();
+		return false;
+	}
+	std::cout << "=> Textzeilen korrekt";
+	return true;
+}
+
+/*! \brief Prueft die Profiling-Zaehler: Testbed und Network zaehlen jeden
+ * Simulationsschritt und jede Gate-Auswertung (je GateLogic). Ohne
+ * DFSM_PROFILING muessen alle Zaehler 0 bleiben
+ */
+bool ProfilerCountsPhases()
+{
+	diag::Profiler::reset();
+	Testbed testbed(Test::make12Demux());
+	testbed.setPlotting(false);
+	testbed.addClockSource("S", 100, 0);
+	testbed.addConstantSource("E", HIGH_LEVEL_VOLT);
+	testbed.simulationstep(1000);
+	Network demux = Test::make12Demux();
+	std::vector<sgnl::Volt> inputs(2, HIGH_LEVEL_VOLT);
+	for (int t = 0; t < 100; t++)
+	{
+		demux.simulationStep(inputs);
+	}
+
+	std::stringstream report;
+	diag::Profiler::report(report);
+	diag::PhaseStats testbedNetwork =
+			diag::Profiler::phase(diag::Phase::TESTBED_NETWORK);
+	diag::PhaseStats gates = diag::Profiler::phase(diag::Phase::NETWORK_GATES);
+	diag::PhaseStats logic = diag::Profiler::phase(diag::Phase::GATE_LOGIC);
+	std::vector<diag::LogicStats> logics = diag::Profiler::logics();
+	if (!diag::Profiler::enabled())
+	{
+		if (testbedNetwork.calls_ != 0 || gates.calls_ != 0 || !logics.empty())
+		{
+			std::cout << "=> Zaehler ohne DFSM_PROFILING nicht 0";
+			return false;
+		}
+		std::cout << "=> Profiling nicht uebersetzt, alle Zaehler 0";
+		return true;
+	}
+
+	std::uint64_t evaluations = 0;
+	for (int i = 0; i < static_cast<int>(logics.size()); i++)
+	{
+		evaluations += logics[i].evaluations_;
+	}
+	if (testbedNetwork.calls_ != 1000 || gates.calls_ != 1100
+			|| gates.events_ != 3300 || logic.events_ != 3300)
+	{
+		std::cout << "=> Falsche Anzahl Schritte/Auswertungen: "
+				<< testbedNetwork.calls_ << " " << gates.calls_ << " "
+				<< gates.events_ << " " << logic.events_;
+		return false;
+	}
+	if (logics.size() != 2 || evaluations != 3300)
+	{
+		std::cout << "=> Falsche Zaehler je GateLogic";
+		return false;
+	}
+	if (report.str().find("network: gate evaluation") == std::string::npos)
+	{
+		std::cout << "=> Bericht unvollstaendig:" << std::endl << report.str();
+		return false;
+	}
+	std::cout << "=> Zaehler stimmen:" << std::endl << report.str();
+	return true;
+}
+
+/*! \brief Prueft die Schaltaktivitaet: Im Schieberegister mit konstantem D
+ * wechselt jeder DFF-Output genau einmal, CLK zweimal je Periode. CLK muss
+ * das aktivste Netz sein
+ */
+bool ActivityTogglesCount()
+{
+	Testbed testbed(Test::make4BitShiftRegister());
+	testbed.setPlotting(false);
+	testbed.addClockSource("CLK", 100, 0);
+	testbed.addConstantSource("D", HIGH_LEVEL_VOLT);
+	testbed.simulationstep(1000);
+	Activity activity = testbed.activity();
+	int clk = testbed.network().inputIndex("CLK");
+	int d = testbed.network().inputIndex("D");
+	if (testbed.inputTransitions(clk) < 19 || testbed.inputTransitions(clk) > 20
+			|| testbed.inputTransitions(d) != 1)
+	{
+		std::cout << "=> Falsche Anzahl Input-Wechsel: CLK "
+				<< testbed.inputTransitions(clk) << ", D "
+				<< testbed.inputTransitions(d);
+		return false;
+	}
+	for (int n = 0; n < static_cast<int>(activity.nets().size()); n++)
+	{
+		const NetActivity &net = activity.nets()[n];
+		if (net.kind_ != NetKind::INPUT && net.toggles_ != 1)
+		{
+			std::cout << "=> " << net.name_ << " wechselt nicht genau einmal";
+			return false;
+		}
+	}
+	std::vector<int> histogram = activity.histogram();
+	std::vector<NetActivity> hottest = activity.hottest(1);
+	if (activity.nets().size() != 2 + 4 + 4 || histogram.size() != 6
+			|| histogram[1] != 5 || histogram[5] != 1 || hottest.empty()
+			|| hottest[0].name_ != "CLK" || hottest[0].fanout_ != 4)
+	{
+		std::cout << "=> Histogramm oder aktivste Netze falsch";
+		return false;
+	}
+	if (activity.eventDrivenRatio() <= 0 || activity.eventDrivenRatio() > 0.05)
+	{
+		std::cout << "=> Geschaetzter Anteil Auswertungen falsch: "
+				<< activity.eventDrivenRatio();
+		return false;
+	}
+	std::stringstream report;
+	activity.report(report, 3);
+	std::cout << "=> Aktivitaet stimmt:" << std::endl << report.str();
+	return true;
+}
+
+/*! \brief Zaehlt die Speicheranforderungen je Simulationsschritt im
+ *  Testbed (CompiledNetwork) und je Teilsystem im Network. Solange
+ *  GateLogic::outputsFor(...) einen Vektor zurueckgibt, ist das Budget
+ *  eine Anforderung je Gate und Schritt; Ziel ist 0
+ *  \return true, falls das Budget eingehalten wird
+ */
+bool AllocationsPerStep()
+{
+	const double BUDGET_PER_GATE = 1.0;
+	// Puffer je Aufruf von simulationstep(...), unabhaengig von der Dauer
+	const int BUDGET_PER_CALL = 4;
+	const int STEPS = 10000;
+	if (!diag::AllocTracker::enabled())
+	{
+		std::cout << "=> Uebersprungen (ohne DFSM_ALLOC_TRACKING gebaut)";
+		return true;
+	}
+	Testbed testbed(Test::make4BitShiftRegister());
+	testbed.setPlotting(false);
+	testbed.setRecording(false);
+	testbed.addClockSource("CLK", 100, 0);
+	testbed.addConstantSource("D", HIGH_LEVEL_VOLT);
+	// Erste Schritte legen Puffer an
+	testbed.simulationstep(100);
+	diag::AllocTracker tracker;
+	testbed.simulationstep(STEPS);
+	tracker.stop();
+	diag::AllocStats total = tracker.total();
+	std::vector<int> notCounted(100);
+	std::stringstream report;
+	tracker.report(report, STEPS);
+	if (tracker.total().allocations_ != total.allocations_
+			|| tracker.subsystem(diag::AllocSubsystem::OTHER).allocations_ != 0
+			|| tracker.subsystem(diag::AllocSubsystem::NETWORK).allocations_ == 0)
+	{
+		std::cout << "=> Zuordnung oder Zaehlung falsch:" << std::endl
+				<< report.str();
+		return false;
+	}
+	double perStep = static_cast<double>(total.allocations_) / STEPS;
+	if (total.allocations_ > BUDGET_PER_GATE * testbed.network().nGates() * STEPS
+			+ BUDGET_PER_CALL)
+	{
+		std::cout << "=> " << perStep << " Anforderungen je Schritt (Budget "
+				<< BUDGET_PER_GATE * testbed.network().nGates() << "):"
+				<< std::endl << report.str();
+		return false;
+	}
+
+	// Interpretierter Pfad: Anforderungen je Teilsystem
+	Network shiftRegister = Test::make4BitShiftRegister();
+	std::vector<sgnl::Volt> inputs(2, HIGH_LEVEL_VOLT);
+	diag::AllocTracker networkTracker;
+	shiftRegister.simulationStep(inputs);
+	networkTracker.stop();
+	std::stringstream networkReport;
+	networkTracker.report(networkReport, 1);
+	if (networkTracker.subsystem(diag::AllocSubsystem::GATE_LOGIC).allocations_
+			== 0
+			|| networkTracker.subsystem(diag::AllocSubsystem::SIGNAL).allocations_
+					== 0
+			|| networkTracker.subsystem(diag::AllocSubsystem::GATE).allocations_
+					== 0)
+	{
+		std::cout << "=> Teilsysteme im Network nicht erfasst:" << std::endl
+				<< networkReport.str();
+		return false;
+	}
+	std::cout << "=> Anforderungen je Schritt im Budget:" << std::endl
+			<< report.str() << networkReport.str();
+	return true;
+}
+
+/*! \brief Prueft den Laufbericht des Testbed: simulierte Zeit,
+ *  aufgezeichnete Datenmenge, Durchsatz, Laufzeiten je Phase, maskierte
+ *  Zeichenketten und JSON-Datei in ./Plots
+ *  \return true, falls der Bericht stimmt
+ */
+bool RunReportJson()
+{
+	// Ein anderes Testbed vorher darf im Bericht nicht mitzaehlen
+	Testbed other(Test::make4BitShiftRegister());
+	other.setPlotting(false);
+	other.addClockSource("CLK", 100, 0);
+	other.addConstantSource("D", HIGH_LEVEL_VOLT);
+	other.simulationstep(700);
+	Testbed testbed(Test::make4BitShiftRegister());
+	testbed.setPlotting(false);
+	testbed.addClockSource("CLK", 100, 0);
+	testbed.addConstantSource("D", HIGH_LEVEL_VOLT);
+	testbed.simulationstep(1000);
+	testbed.setRecording(false);
+	testbed.simulationstep(500);
+	RunReport report = testbed.runReport();
+	long long expectedBytes = static_cast<long long>(testbed.network().nInputs()
+			+ testbed.network().nOutputs()) * 1000 * sizeof(sgnl::Volt);
+	if (report.simulatedNs_ != 1500 || report.waveformBytes_ != expectedBytes
+			|| report.nGates_ != 4 || report.stopReason_ != "duration")
+	{
+		std::cout << "=> Falscher Bericht: " << report.simulatedNs_ << " ns, "
+				<< report.waveformBytes_ << " Bytes (erwartet " << expectedBytes
+				<< ")";
+		return false;
+	}
+	if (report.simulationSeconds_ <= 0 || report.nsPerSecond() <= 0
+			|| report.evalsPerSecond() != report.nsPerSecond() * 4
+			|| report.peakRssBytes_ == 0
+			|| report.profiling_ != diag::Profiler::enabled())
+	{
+		std::cout << "=> Laufzeit oder Speicherbedarf fehlt";
+		return false;
+	}
+	// In jedem Build zuerst die Wanduhrzeiten je Aufruf
+	if (report.phases_.size() < 2
+			|| report.phases_[0].name_ != "testbed: simulation"
+			|| report.phases_[0].calls_ != 2
+			|| report.phases_[0].seconds_ != report.simulationSeconds_
+			|| report.phases_[1].name_ != "testbed: plotting"
+			|| report.phases_[1].calls_ != 0)
+	{
+		std::cout << "=> Laufzeiten je Aufruf fehlen";
+		return false;
+	}
+	// Mit DFSM_PROFILING die Phasen nur dieses Testbed: ein Network-Schritt je ns
+	long long networkSteps = 0;
+	for (int p = 2; p < static_cast<int>(report.phases_.size()); p++)
+	{
+		if (report.phases_[p].name_ == "testbed: network step")
+		{
+			networkSteps = report.phases_[p].calls_;
+		}
+	}
+	if (report.profiling_ ? networkSteps != 1500 : report.phases_.size() != 2)
+	{
+		std::cout << "=> Falsche Phasen: " << report.phases_.size()
+				<< " Phasen, " << networkSteps << " Network-Schritte";
+		return false;
+	}
+	// Steuerzeichen und Anfuehrungszeichen im Namen muessen maskiert werden
+	RunReport escaped = report;
+	escaped.network_ = "a\"b\\c\nd\te\x01";
+	std::stringstream escapedJson;
+	escaped.write(escapedJson);
+	if (escapedJson.str().find("\"network\": \"a\\\"b\\\\c\\u000ad\\u0009e\\u0001\",")
+			== std::string::npos)
+	{
+		std::cout << "=> Name falsch maskiert:" << std::endl << escapedJson.str();
+		return false;
+	}
+	if (!testbed.saveRunReport("RunReportJson"))
+	{
+		std::cout << "=> Bericht nicht gespeichert";
+		return false;
+	}
+	std::ifstream file("./Plots/RunReportJson.json");
+	std::stringstream json;
+	json << file.rdbuf();
+	if (json.str().find("\"simulated_ns\": 1500") == std::string::npos
+			|| json.str().find("\"waveform_bytes\": "
+					+ std::to_string(expectedBytes)) == std::string::npos)
+	{
+		std::cout << "=> JSON unvollstaendig:" << std::endl << json.str();
+		return false;
+	}
+	std::cout << "=> Bericht stimmt:" << std::endl << json.str();
+	return true;
+}
+
+/*! \brief Prueft die Meldungen ueber diag::Log: Stufenfilter, Abschalten
+ *  und Sammeln als Datensaetze, sowie die Netlist-Ausgabe von
+ *  FileInput::load(...) nur auf Stufe DEBUG
+ *  \return true, falls die Meldungen stimmen
+ */
+bool LogSinkCollects()
+{
+	std::shared_ptr<diag::CollectingSink> sink =
+			std::make_shared<diag::CollectingSink>();
+	diag::Log::setSink(sink);
+	diag::Log::setLevel(diag::LogLevel::WARNING);
+	Network empty("EmptyNetwork", 7);
+	Network demux = Test::make12Demux();
+	bool emptyConsistent = empty.consistent();
+	bool demuxConsistent = demux.consistent();
+	std::vector<diag::LogRecord> warnings = sink->records();
+
+	sink->clear();
+	diag::Log::setLevel(diag::LogLevel::OFF);
+	empty.consistent();
+	size_t nOff = sink->records().size();
+
+	diag::Log::setLevel(diag::LogLevel::DEBUG);
+	FileOutput::save(demux, "LogSinkCollects");
+	FileInput input;
+	input.load("LogSinkCollects");
+	std::vector<diag::LogRecord> debug = sink->records();
+	diag::Log::setLevel(diag::LogLevel::INFO);
+	diag::Log::setSink(nullptr);
+
+	if (emptyConsistent || !demuxConsistent || warnings.empty() || nOff != 0)
+	{
+		std::cout << "=> Falsche Anzahl Meldungen: " << warnings.size()
+				<< " bzw. " << nOff;
+		return false;
+	}
+	for (int r = 0; r < static_cast<int>(warnings.size()); r++)
+	{
+		if (warnings[r].level_ != diag::LogLevel::ERROR
+				|| warnings[r].component_ != "Network")
+		{
+			std::cout << "=> Unerwartete Meldung: " << warnings[r].message_;
+			return false;
+		}
+	}
+	bool printout = false;
+	for (int r = 0; r < static_cast<int>(debug.size()); r++)
+	{
+		printout = printout || (debug[r].level_ == diag::LogLevel::DEBUG
+				&& debug[r].component_ == "FileInput"
+				&& debug[r].message_.find("Block data printout")
+						!= std::string::npos);
+	}
+	if (!printout)
+	{
+		std::cout << "=> Netlist-Ausgabe auf Stufe DEBUG fehlt";
+		return false;
+	}
+	std::cout << "=> " << warnings.size() << " Fehlermeldungen gesammelt, "
+			<< debug.size() << " Meldungen auf Stufe DEBUG";
+	return true;
+}
+
+/*! \brief Zeichnet Zeitspannen beim Laden, Kompilieren, Simulieren und in
+ *  einem ThreadPool auf und prueft den Export als Chrome-Trace-Event-JSON
+ *  sowie das Ueberschreiben bei vollem Ringpuffer
+ *  \return true, falls alle Zeitspannen im Export stehen
+ */
+bool TraceChromeExport()
+{
+	if (!diag::Tracer::enabled())
+	{
+		std::cout << "=> Uebersprungen (ohne DFSM_TRACING gebaut)";
+		return true;
+	}
+	Network demux = Test::make12Demux();
+	FileOutput::save(demux, "TraceChromeExport");
+
+	diag::Tracer::start();
+	FileInput input;
+	Testbed testbed(input.load("TraceChromeExport"));
+	testbed.setPlotting(false);
+	testbed.addClockSource("S", 10, 0);
+	testbed.addConstantSource("E", HIGH_LEVEL_VOLT);
+	testbed.simulationstep(100);
+	{
+		ThreadPool pool(2);
+		for (int t = 0; t < 4; t++)
+		{
+			pool.submit([]()
+			{
+				DFSM_TRACE_SPAN(workSpan, "work", "test");
+			});
+		}
+		pool.wait();
+	}
+	diag::Tracer::stop();
+	size_t nEvents = diag::Tracer::eventCount();
+	std::ostringstream json;
+	diag::Tracer::write(json);
+
+	// Nach stop() wird nichts mehr aufgezeichnet
+	{
+		DFSM_TRACE_SPAN(ignoredSpan, "ignored", "test");
+	}
+	size_t nAfterStop = diag::Tracer::eventCount();
+
+	// Kleiner Ringpuffer: nur die letzten Eintraege bleiben erhalten
+	diag::Tracer::start(16);
+	testbed.simulationstep(100);
+	diag::Tracer::stop();
+	size_t nRing = diag::Tracer::eventCount();
+	size_t nDropped = diag::Tracer::droppedCount();
+	diag::Tracer::clear();
+
+	std::string text = json.str();
+	const char *expected[] = { "\"load\"", "\"compile\"",
+			"\"simulationstep\"", "\"testbed: network step\"",
+			"\"network: gate evaluation\"", "\"task\"", "\"work\"",
+			"\"pool worker\"", "\"ph\": \"X\"" };
+	for (int e = 0; e < static_cast<int>(sizeof(expected) / sizeof(expected[0])); e++)
+	{
+		if (text.find(expected[e]) == std::string::npos)
+		{
+			std::cout << "=> " << expected[e] << " fehlt:" << std::endl << text;
+			return false;
+		}
+	}
+	int nGateSpans = 0;
+	for (size_t pos = text.find("\"network: gate evaluation\"");
+			pos != std::string::npos;
+			pos = text.find("\"network: gate evaluation\"", pos + 1))
+	{
+		nGateSpans++;
+	}
+	if (nGateSpans != 100 || nAfterStop != nEvents || text[0] != '{'
+			|| text.substr(text.size() - 4) != "\n]}\n")
+	{
+		std::cout << "=> " << nGateSpans << " Gate-Phasen statt 100, "
+				<< nAfterStop - nEvents << " Eintraege nach stop()";
+		return false;
+	}
+	if (nRing != 16 || nDropped == 0)
+	{
+		std::cout << "=> Ringpuffer: " << nRing << " Eintraege, " << nDropped
+				<< " ueberschrieben";
+		return false;
+	}
+	std::cout << "=> " << nEvents << " Zeitspannen exportiert, Ringpuffer hielt "
+			<< nRing << " von " << nRing + nDropped;
+	return true;
+}
 }
 
 #endif /* TESTS_H_ */
@@ -0,0 +1,359 @@
+/*! \file GateLogicBenchmark.cpp
+ *  \brief Microbenchmarks der Gate-Auswertung: GateLogic::outputsFor(...)
+ *  aller vordefinierten Gatelogiken (Durchsatz und Latenz), eine
+ *  Wahrheitstabelle als alternative Auswertung, die Umrechnungen aus sgnl
+ *  und Gate::applyPropagationDelay(...). Hardwarezaehler werden ueber
+ *  perf_event gemessen, falls verfuegbar.
+ *
+ *  Aufruf: GateLogicBenchmark [--quick] [--reps N] [--filter Text]
+ *  [--json Datei]
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "MicroBench.h"
+#include "../gate/Gate.h"
+#include "../gate/PredefinedGateLogics.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sgnl;
+
+/*! \brief Laenge der zufaelligen Indexfolgen (Zweierpotenz). Zufaellige
+ *  statt fortlaufender Reihenfolge, damit die Sprungvorhersage die Eingaben
+ *  nicht auswendig lernt
+ */
+static const int SEQUENCE_LENGTH = 4096;
+
+/*! \class GateBenchmark
+ *  \brief Zugriff auf die privaten Methoden von Gate
+ */
+class GateBenchmark
+{
+public:
+	/*! \brief Ruft Gate::applyPropagationDelay(...) auf
+	 *  \param a_gate Gate
+	 *  \param a_outputs Ausgangsspannungen
+	 *  \return Verzoegerte Ausgangsspannungen
+	 */
+	static vector<Volt> applyPropagationDelay(Gate &a_gate,
+			const vector<Volt> &a_outputs)
+	{
+		return a_gate.applyPropagationDelay(a_outputs);
+	}
+};
+
+/*! \brief Eine Eingabe von GateLogic::outputsFor(...)
+ */
+struct Combination
+{
+	vector<bool> inputs_;       /**< Input-Logiklevel */
+	vector<bool> prevInputs_;   /**< Vorherige Input-Logiklevel */
+	vector<bool> prevOutputs_;  /**< Vorherige Output-Logiklevel */
+};
+
+/*! \brief Erzeugt alle Eingaben einer Gatelogik
+ *  \param a_logic Gatelogik
+ *  \return 2^(2*nInputs+nOutputs) Eingaben, Bit i des Index = i-tes Level
+ *  (erst Inputs, dann vorherige Inputs, dann vorherige Outputs)
+ */
+static vector<Combination> combinations(const GateLogic &a_logic)
+{
+	int nIn = a_logic.nInputs();
+	int nOut = a_logic.nOutputs();
+	int nBits = 2 * nIn + nOut;
+	vector<Combination> ret(1 << nBits);
+	for (int c = 0; c < static_cast<int>(ret.size()); c++)
+	{
+		for (int b = 0; b < nBits; b++)
+		{
+			bool level = ((c >> b) & 1) != 0;
+			if (b < nIn)
+			{
+				ret[c].inputs_.push_back(level);
+			}
+			else if (b < 2 * nIn)
+			{
+				ret[c].prevInputs_.push_back(level);
+			}
+			else
+			{
+				ret[c].prevOutputs_.push_back(level);
+			}
+		}
+	}
+	return ret;
+}
+
+/*! \brief Erzeugt eine zufaellige Indexfolge
+ *  \param a_n Anzahl der moeglichen Indizes
+ *  \return SEQUENCE_LENGTH Indizes aus [0, a_n)
+ */
+static vector<int> sequence(int a_n)
+{
+	mt19937 gen(1);
+	uniform_int_distribution<> distr(0, a_n - 1);
+	vector<int> ret(SEQUENCE_LENGTH);
+	for (int i = 0; i < SEQUENCE_LENGTH; i++)
+	{
+		ret[i] = distr(gen);
+	}
+	return ret;
+}
+
+/*! \class TruthTable
+ *  \brief Alternative Auswertung: Die Gatelogik wird einmal fuer alle
+ *  Eingaben ausgewertet, danach ist jede Auswertung ein Tabellenzugriff
+ *  ohne virtuellen Aufruf und ohne Speicheranforderung
+ */
+class TruthTable
+{
+public:
+	/*! \brief Konstruktor. Wertet die Gatelogik fuer alle Eingaben aus
+	 *  \param a_logic Gatelogik
+	 */
+	TruthTable(const GateLogic &a_logic)
+	{
+		vector<Combination> all = combinations(a_logic);
+		for (int c = 0; c < static_cast<int>(all.size()); c++)
+		{
+			vector<bool> out = a_logic.outputsFor(all[c].inputs_,
+					all[c].prevInputs_, all[c].prevOutputs_);
+			unsigned int bits = 0;
+			for (int o = 0; o < static_cast<int>(out.size()); o++)
+			{
+				bits |= (out[o] ? 1u : 0u) << o;
+			}
+			table_.push_back(bits);
+		}
+	}
+
+	/*! \brief Wertet die Tabelle aus
+	 *  \param a_inputs Input-Logiklevel
+	 *  \param a_prevInputs Vorherige Input-Logiklevel
+	 *  \param a_prevOutputs Vorherige Output-Logiklevel
+	 *  \return Output-Logiklevel, Bit o = Output o
+	 */
+	unsigned int outputsFor(const vector<bool> &a_inputs,
+			const vector<bool> &a_prevInputs,
+			const vector<bool> &a_prevOutputs) const
+	{
+		int nIn = static_cast<int>(a_inputs.size());
+		unsigned int idx = 0;
+		for (int i = 0; i < nIn; i++)
+		{
+			idx |= (a_inputs[i] ? 1u : 0u) << i;
+			idx |= (a_prevInputs[i] ? 1u : 0u) << (nIn + i);
+		}
+		for (int o = 0; o < static_cast<int>(a_prevOutputs.size()); o++)
+		{
+			idx |= (a_prevOutputs[o] ? 1u : 0u) << (2 * nIn + o);
+		}
+		return table_[idx];
+	}
+
+private:
+	vector<unsigned int> table_;  /**< Output-Bits je Eingabe-Index */
+};
+
+/*! \brief Prueft, ob ein Name zum Filter passt
+ *  \param a_name Name
+ *  \param a_filter Filter (Teilstring), leer = alle
+ *  \return true, falls gemessen werden soll
+ */
+static bool selected(const string &a_name, const string &a_filter)
+{
+	return a_filter.empty() || a_name.find(a_filter) != string::npos;
+}
+
+int main(int argc, char *argv[])
+{
+	int reps = 15;
+	double minRepMs = 10;
+	double warmupMs = 100;
+	string filter;
+	string jsonFile;
+	for (int a = 1; a < argc; a++)
+	{
+		if (strcmp(argv[a], "--quick") == 0)
+		{
+			reps = 5;
+			minRepMs = 2;
+			warmupMs = 10;
+		}
+		else if (strcmp(argv[a], "--reps") == 0 && a + 1 < argc)
+		{
+			reps = atoi(argv[++a]);
+		}
+		else if (strcmp(argv[a], "--filter") == 0 && a + 1 < argc)
+		{
+			filter = argv[++a];
+		}
+		else if (strcmp(argv[a], "--json") == 0 && a + 1 < argc)
+		{
+			jsonFile = argv[++a];
+		}
+		else
+		{
+			cerr << "Usage: " << argv[0]
+					<< " [--quick] [--reps N] [--filter text] [--json file]"
+					<< endl;
+			return 2;
+		}
+	}
+
+	mbench::MicroBench bench(reps, minRepMs, warmupMs);
+	if (!bench.countersAvailable())
+	{
+		cout << "Hardwarezaehler nicht verfuegbar (perf_event_open fehlgeschlagen,"
+				<< " siehe /proc/sys/kernel/perf_event_paranoid)" << endl;
+	}
+	mbench::MicroBench::printHeader(cout);
+	vector<mbench::Stats> results;
+	int pos = 0;
+
+	const GateLogic *logics[] = { &pgl::buf1, &pgl::not1, &pgl::and2, &pgl::or2,
+			&pgl::dff, &pgl::tff };
+	for (int l = 0; l < static_cast<int>(sizeof(logics) / sizeof(logics[0])); l++)
+	{
+		const GateLogic &logic = *logics[l];
+		const vector<Combination> all = combinations(logic);
+		const vector<int> seq = sequence(static_cast<int>(all.size()));
+
+		// Durchsatz: unabhaengige Aufrufe
+		string name = logic.name() + "/outputsFor";
+		if (selected(name, filter))
+		{
+			results.push_back(bench.run(name, [&]()
+			{
+				const Combination &c = all[seq[pos++ & (SEQUENCE_LENGTH - 1)]];
+				vector<bool> out = logic.outputsFor(c.inputs_, c.prevInputs_,
+						c.prevOutputs_);
+				mbench::doNotOptimize(out);
+			}));
+			mbench::MicroBench::print(cout, results.back());
+		}
+
+		// Latenz: Input 0 haengt vom vorherigen Ergebnis ab
+		name = logic.name() + "/outputsFor latency";
+		if (selected(name, filter))
+		{
+			vector<bool> inputs;
+			bool carry = false;
+			results.push_back(bench.run(name, [&]()
+			{
+				const Combination &c = all[seq[pos++ & (SEQUENCE_LENGTH - 1)]];
+				inputs = c.inputs_;
+				inputs[0] = inputs[0] != carry;
+				carry = logic.outputsFor(inputs, c.prevInputs_, c.prevOutputs_)[0];
+			}));
+			mbench::doNotOptimize(carry);
+			mbench::MicroBench::print(cout, results.back());
+		}
+
+		name = logic.name() + "/truth table";
+		if (selected(name, filter))
+		{
+			TruthTable table(logic);
+			results.push_back(bench.run(name, [&]()
+			{
+				const Combination &c = all[seq[pos++ & (SEQUENCE_LENGTH - 1)]];
+				unsigned int out = table.outputsFor(c.inputs_, c.prevInputs_,
+						c.prevOutputs_);
+				mbench::doNotOptimize(out);
+			}));
+			mbench::MicroBench::print(cout, results.back());
+		}
+	}
+
+	// Spannungen um die Schaltschwellen, damit alle Zweige vorkommen
+	mt19937 gen(2);
+	uniform_real_distribution<> voltDistr(LOW_LEVEL_VOLT, HIGH_LEVEL_VOLT);
+	vector<vector<Volt> > voltages(SEQUENCE_LENGTH, vector<Volt>(2));
+	vector<vector<bool> > levels(SEQUENCE_LENGTH, vector<bool>(2));
+	for (int i = 0; i < SEQUENCE_LENGTH; i++)
+	{
+		voltages[i][0] = voltDistr(gen);
+		voltages[i][1] = voltDistr(gen);
+		levels[i][0] = (i & 1) != 0;
+		levels[i][1] = (i & 2) != 0;
+	}
+	if (selected("sgnl/voltageToLogical", filter))
+	{
+		results.push_back(bench.run("sgnl/voltageToLogical", [&]()
+		{
+			int i = pos++ & (SEQUENCE_LENGTH - 1);
+			vector<bool> out = voltageToLogical(voltages[i], levels[i]);
+			mbench::doNotOptimize(out);
+		}));
+		mbench::MicroBench::print(cout, results.back());
+	}
+	if (selected("sgnl/logicalToVolt", filter))
+	{
+		results.push_back(bench.run("sgnl/logicalToVolt", [&]()
+		{
+			vector<Volt> out = logicalToVolt(
+					levels[pos++ & (SEQUENCE_LENGTH - 1)]);
+			mbench::doNotOptimize(out);
+		}));
+		mbench::MicroBench::print(cout, results.back());
+	}
+	if (selected("sgnl/applyNoise (scalar)", filter))
+	{
+		mt19937 noiseGen(3);
+		results.push_back(bench.run("sgnl/applyNoise (scalar)", [&]()
+		{
+			Volt out = applyNoise(
+					voltages[pos++ & (SEQUENCE_LENGTH - 1)][0], noiseGen);
+			mbench::doNotOptimize(out);
+		}));
+		mbench::MicroBench::print(cout, results.back());
+	}
+	if (selected("sgnl/applyNoise (vector)", filter))
+	{
+		results.push_back(bench.run("sgnl/applyNoise (vector)", [&]()
+		{
+			vector<Volt> out = applyNoise(voltages[pos++ & (SEQUENCE_LENGTH - 1)]);
+			mbench::doNotOptimize(out);
+		}));
+		mbench::MicroBench::print(cout, results.back());
+	}
+
+	if (selected("Gate/applyPropagationDelay", filter))
+	{
+		// Je Output des Gates eine Spannung
+		Gate gate("bench", &pgl::and2, 5);
+		vector<vector<Volt> > outputs(SEQUENCE_LENGTH,
+				vector<Volt>(gate.nOutputs()));
+		for (int i = 0; i < SEQUENCE_LENGTH; i++)
+		{
+			outputs[i][0] = voltages[i][0];
+		}
+		results.push_back(bench.run("Gate/applyPropagationDelay", [&]()
+		{
+			vector<Volt> out = GateBenchmark::applyPropagationDelay(gate,
+					outputs[pos++ & (SEQUENCE_LENGTH - 1)]);
+			mbench::doNotOptimize(out);
+		}));
+		mbench::MicroBench::print(cout, results.back());
+	}
+
+	if (!jsonFile.empty())
+	{
+		ofstream file(jsonFile.c_str());
+		if (!file.is_open())
+		{
+			cerr << "Cannot open JSON file at \"" << jsonFile << "\"." << endl;
+			return 1;
+		}
+		mbench::MicroBench::writeJson(file, "gatelogic", results);
+	}
+	return 0;
+}
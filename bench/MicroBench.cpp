@@ -0,0 +1,307 @@
+/*! \file MicroBench.cpp
+ *  \brief Implementierung der Klassen PerfCounters und MicroBench
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "MicroBench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace mbench
+{
+
+#ifdef __linux__
+/*! \brief Oeffnet einen Hardwarezaehler
+ *  \param a_config PERF_COUNT_HW_...
+ *  \param a_groupFd Gruppenfuehrer, -1 = neue Gruppe
+ *  \return Dateideskriptor, -1 bei Fehler
+ */
+static int openCounter(uint64_t a_config, int a_groupFd)
+{
+	perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = a_config;
+	attr.disabled = (a_groupFd == -1) ? 1 : 0;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP;
+	return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1,
+			a_groupFd, 0));
+}
+#endif
+
+PerfCounters::PerfCounters() :
+		nOpen_(0)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		fds_[i] = -1;
+	}
+#ifdef __linux__
+	const uint64_t configs[4] = { PERF_COUNT_HW_CPU_CYCLES,
+			PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES,
+			PERF_COUNT_HW_CACHE_MISSES };
+	fds_[0] = openCounter(configs[0], -1);
+	if (fds_[0] < 0)
+	{
+		return;
+	}
+	nOpen_ = 1;
+	for (int i = 1; i < 4; i++)
+	{
+		// Nicht jede (virtuelle) CPU bietet alle Zaehler an
+		fds_[i] = openCounter(configs[i], fds_[0]);
+		nOpen_ += (fds_[i] >= 0) ? 1 : 0;
+	}
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+	for (int i = 0; i < 4; i++)
+	{
+		if (fds_[i] >= 0)
+		{
+			close(fds_[i]);
+		}
+	}
+#endif
+}
+
+bool PerfCounters::available() const
+{
+	return nOpen_ > 0;
+}
+
+void PerfCounters::start()
+{
+#ifdef __linux__
+	if (available())
+	{
+		ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+#endif
+}
+
+Counters PerfCounters::stop()
+{
+	Counters counters = { -1, -1, -1, -1 };
+#ifdef __linux__
+	if (!available())
+	{
+		return counters;
+	}
+	ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+	// PERF_FORMAT_GROUP: Anzahl, dann die Werte in Oeffnungsreihenfolge
+	uint64_t values[1 + 4];
+	if (read(fds_[0], values, sizeof(values)) < static_cast<ssize_t>(
+			sizeof(uint64_t) * (1 + nOpen_)))
+	{
+		return counters;
+	}
+	double *fields[4] = { &counters.cycles_, &counters.instructions_,
+			&counters.branchMisses_, &counters.cacheMisses_ };
+	int v = 1;
+	for (int i = 0; i < 4; i++)
+	{
+		if (fds_[i] >= 0)
+		{
+			*fields[i] = static_cast<double>(values[v++]);
+		}
+	}
+#endif
+	return counters;
+}
+
+MicroBench::MicroBench(int a_reps, double a_minRepMs, double a_warmupMs) :
+		reps_(max(1, a_reps)), minRepMs_(a_minRepMs), warmupMs_(a_warmupMs)
+{
+
+}
+
+bool MicroBench::countersAvailable() const
+{
+	return perf_.available();
+}
+
+/*! \brief Median
+ *  \param a_values Werte (nicht leer)
+ *  \return Median
+ */
+static double median(vector<double> a_values)
+{
+	sort(a_values.begin(), a_values.end());
+	int n = static_cast<int>(a_values.size());
+	return (n % 2 == 1) ? a_values[n / 2] :
+			(a_values[n / 2 - 1] + a_values[n / 2]) / 2;
+}
+
+Stats MicroBench::summarize(const std::string &a_name, long long a_calls,
+		const std::vector<double> &a_ns,
+		const std::vector<Counters> &a_counters) const
+{
+	int n = static_cast<int>(a_ns.size());
+	vector<double> perCall(n);
+	double sum = 0;
+	for (int r = 0; r < n; r++)
+	{
+		perCall[r] = a_ns[r] / a_calls;
+		sum += perCall[r];
+	}
+	double mean = sum / n;
+	double squares = 0;
+	for (int r = 0; r < n; r++)
+	{
+		squares += (perCall[r] - mean) * (perCall[r] - mean);
+	}
+
+	Stats stats;
+	stats.name_ = a_name;
+	stats.callsPerRep_ = a_calls;
+	stats.reps_ = n;
+	stats.medianNs_ = median(perCall);
+	stats.minNs_ = *min_element(perCall.begin(), perCall.end());
+	stats.meanNs_ = mean;
+	stats.stddevNs_ = (n > 1) ? sqrt(squares / (n - 1)) : 0;
+	stats.callsPerSecond_ = (stats.medianNs_ > 0) ? 1e9 / stats.medianNs_ : 0;
+
+	// Zaehler je Aufruf als Median ueber die Wiederholungen
+	double Counters::*fields[4] = { &Counters::cycles_, &Counters::instructions_,
+			&Counters::branchMisses_, &Counters::cacheMisses_ };
+	for (int f = 0; f < 4; f++)
+	{
+		vector<double> values;
+		for (int r = 0; r < n; r++)
+		{
+			if (a_counters[r].*fields[f] >= 0)
+			{
+				values.push_back(a_counters[r].*fields[f] / a_calls);
+			}
+		}
+		stats.counters_.*fields[f] = values.empty() ? -1 : median(values);
+	}
+	return stats;
+}
+
+void MicroBench::printHeader(std::ostream &a_os)
+{
+	a_os << left << setw(36) << "benchmark" << right << setw(10) << "ns/call"
+			<< setw(8) << "+-%" << setw(10) << "min ns" << setw(10)
+			<< "Mcalls/s" << setw(10) << "cycles" << setw(8) << "IPC"
+			<< setw(10) << "br-miss" << setw(10) << "llc-miss" << endl;
+	return;
+}
+
+/*! \brief Schreibt einen Zaehlerwert oder "-", falls nicht verfuegbar
+ *  \param a_os Ausgabe
+ *  \param a_width Feldbreite
+ *  \param a_value Wert
+ *  \param a_precision Nachkommastellen
+ */
+static void printCounter(ostream &a_os, int a_width, double a_value,
+		int a_precision)
+{
+	if (a_value < 0)
+	{
+		a_os << setw(a_width) << "-";
+	}
+	else
+	{
+		a_os << setw(a_width) << setprecision(a_precision) << a_value;
+	}
+	return;
+}
+
+void MicroBench::print(std::ostream &a_os, const Stats &a_stats)
+{
+	ios_base::fmtflags flags = a_os.flags();
+	streamsize precision = a_os.precision();
+	const Counters &c = a_stats.counters_;
+	a_os << left << setw(36) << a_stats.name_ << right << fixed << setw(10)
+			<< setprecision(2) << a_stats.medianNs_ << setw(8)
+			<< setprecision(1)
+			<< (a_stats.meanNs_ > 0 ? 100 * a_stats.stddevNs_ / a_stats.meanNs_ : 0)
+			<< setw(10) << setprecision(2) << a_stats.minNs_ << setw(10)
+			<< setprecision(1) << a_stats.callsPerSecond_ / 1e6;
+	printCounter(a_os, 10, c.cycles_, 1);
+	printCounter(a_os, 8,
+			(c.cycles_ > 0 && c.instructions_ >= 0) ?
+					c.instructions_ / c.cycles_ : -1, 2);
+	printCounter(a_os, 10, c.branchMisses_, 3);
+	printCounter(a_os, 10, c.cacheMisses_, 3);
+	a_os << endl;
+	a_os.flags(flags);
+	a_os.precision(precision);
+	return;
+}
+
+/*! \brief Schreibt eine Zahl als JSON-Wert (null, falls nicht verfuegbar)
+ *  \param a_os Ausgabe
+ *  \param a_value Wert
+ */
+static void writeJsonNumber(ostream &a_os, double a_value)
+{
+	if (a_value < 0 || std::isnan(a_value))
+	{
+		a_os << "null";
+	}
+	else
+	{
+		a_os << a_value;
+	}
+	return;
+}
+
+void MicroBench::writeJson(std::ostream &a_os, const std::string &a_benchmark,
+		const std::vector<Stats> &a_results)
+{
+	char timestamp[32];
+	time_t now = time(nullptr);
+	strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+	a_os.precision(6);
+	a_os << "{\n  \"benchmark\": \"" << a_benchmark << "\",\n  \"version\": 1,\n"
+			<< "  \"timestamp\": \"" << timestamp << "\",\n"
+			<< "  \"results\": [";
+	for (int r = 0; r < static_cast<int>(a_results.size()); r++)
+	{
+		const Stats &stats = a_results[r];
+		a_os << (r == 0 ? "\n" : ",\n") << "    {\"name\": \"" << stats.name_
+				<< "\", \"calls_per_rep\": " << stats.callsPerRep_
+				<< ", \"reps\": " << stats.reps_ << ", \"median_ns\": "
+				<< stats.medianNs_ << ", \"min_ns\": " << stats.minNs_
+				<< ", \"mean_ns\": " << stats.meanNs_ << ", \"stddev_ns\": "
+				<< stats.stddevNs_ << ",\n     \"cycles\": ";
+		writeJsonNumber(a_os, stats.counters_.cycles_);
+		a_os << ", \"instructions\": ";
+		writeJsonNumber(a_os, stats.counters_.instructions_);
+		a_os << ", \"branch_misses\": ";
+		writeJsonNumber(a_os, stats.counters_.branchMisses_);
+		a_os << ", \"cache_misses\": ";
+		writeJsonNumber(a_os, stats.counters_.cacheMisses_);
+		a_os << "}";
+	}
+	a_os << "\n  ]\n}\n";
+	return;
+}
+
+}
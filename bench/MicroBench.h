@@ -0,0 +1,216 @@
+/*! \file MicroBench.h
+ *  \brief Einfaches Microbenchmark-Geruest: Aufwaermen, wiederholte
+ *  Messungen mit Statistik und Hardwarezaehler ueber perf_event (Linux)
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef BENCH_MICROBENCH_H_
+#define BENCH_MICROBENCH_H_
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/*! \namespace mbench
+ *  \brief Microbenchmarks
+ */
+namespace mbench
+{
+
+/*! \brief Verhindert, dass der Compiler die Berechnung eines Wertes
+ *  wegoptimiert
+ *  \param a_value Wert
+ */
+template<class T>
+inline void doNotOptimize(const T &a_value)
+{
+#if defined(__GNUC__)
+	asm volatile("" : : "r,m"(a_value) : "memory");
+#else
+	static volatile const void *sink;
+	sink = &a_value;
+#endif
+}
+
+/*! \brief Hardwarezaehler je Aufruf, < 0 = nicht verfuegbar
+ */
+struct Counters
+{
+	double cycles_;        /**< CPU-Takte */
+	double instructions_;  /**< Ausgefuehrte Befehle */
+	double branchMisses_;  /**< Falsch vorhergesagte Spruenge */
+	double cacheMisses_;   /**< Cache-Misses (letzte Ebene) */
+};
+
+/*! \brief Ergebnis eines Microbenchmarks
+ */
+struct Stats
+{
+	std::string name_;       /**< Bezeichnung */
+	long long callsPerRep_;  /**< Aufrufe je Wiederholung */
+	int reps_;               /**< Anzahl der Wiederholungen */
+	double medianNs_;        /**< Median / ns je Aufruf */
+	double minNs_;           /**< Minimum / ns je Aufruf */
+	double meanNs_;          /**< Mittelwert / ns je Aufruf */
+	double stddevNs_;        /**< Standardabweichung / ns je Aufruf */
+	double callsPerSecond_;  /**< Durchsatz (aus dem Median) */
+	Counters counters_;      /**< Hardwarezaehler je Aufruf (Median) */
+};
+
+/*! \class PerfCounters
+ *  \brief Zaehlergruppe ueber perf_event_open(2) fuer den aufrufenden
+ *  Thread (nur Benutzermodus). Ohne Linux oder ohne Berechtigung
+ *  (perf_event_paranoid) ist sie nicht verfuegbar
+ */
+class PerfCounters
+{
+public:
+	/*! \brief Konstruktor. Oeffnet die Zaehler
+	 */
+	PerfCounters();
+
+	/*! \brief Destruktor. Schliesst die Zaehler
+	 */
+	~PerfCounters();
+
+	/*! \brief Gibt zurueck, ob mindestens der Taktzaehler geoeffnet wurde
+	 *  \return true, falls verfuegbar
+	 */
+	bool available() const;
+
+	/*! \brief Setzt die Zaehler zurueck und startet sie
+	 */
+	void start();
+
+	/*! \brief Haelt die Zaehler an und liest sie aus
+	 *  \return Zaehlerstaende seit start(), < 0 = nicht verfuegbar
+	 */
+	Counters stop();
+
+private:
+	PerfCounters(const PerfCounters&);
+	PerfCounters& operator=(const PerfCounters&);
+
+	int fds_[4];   /**< Dateideskriptoren (Reihenfolge wie Counters), -1 = nicht geoeffnet */
+	int nOpen_;    /**< Anzahl geoeffneter Zaehler */
+};
+
+/*! \class MicroBench
+ *  \brief Misst die Laufzeit kleiner Funktionen. Die Schleifenlaenge wird
+ *  beim Aufwaermen so bestimmt, dass eine Wiederholung mindestens
+ *  minRepMs dauert; anschliessend werden reps Wiederholungen gemessen
+ */
+class MicroBench
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_reps Anzahl der Wiederholungen
+	 *  \param a_minRepMs Mindestdauer einer Wiederholung / ms
+	 *  \param a_warmupMs Mindestdauer des Aufwaermens / ms
+	 */
+	MicroBench(int a_reps = 15, double a_minRepMs = 10,
+			double a_warmupMs = 100);
+
+	/*! \brief Misst eine Funktion
+	 *  \param a_name Bezeichnung
+	 *  \param a_body Zu messende Funktion (ein Aufruf), wird direkt in die
+	 *  Messschleife eingesetzt
+	 *  \return Ergebnis
+	 */
+	template<class F>
+	Stats run(const std::string &a_name, F a_body);
+
+	/*! \brief Gibt zurueck, ob Hardwarezaehler gemessen werden
+	 *  \return true, falls perf_event verfuegbar ist
+	 */
+	bool countersAvailable() const;
+
+	/*! \brief Schreibt die Kopfzeile der Tabelle
+	 *  \param a_os Ausgabe
+	 */
+	static void printHeader(std::ostream &a_os);
+
+	/*! \brief Schreibt ein Ergebnis als Tabellenzeile
+	 *  \param a_os Ausgabe
+	 *  \param a_stats Ergebnis
+	 */
+	static void print(std::ostream &a_os, const Stats &a_stats);
+
+	/*! \brief Schreibt Ergebnisse als JSON
+	 *  \param a_os Ausgabe
+	 *  \param a_benchmark Name des Benchmarks
+	 *  \param a_results Ergebnisse
+	 */
+	static void writeJson(std::ostream &a_os, const std::string &a_benchmark,
+			const std::vector<Stats> &a_results);
+
+private:
+	/*! \brief Wertet die Messungen aus
+	 *  \param a_name Bezeichnung
+	 *  \param a_calls Aufrufe je Wiederholung
+	 *  \param a_ns Dauer je Wiederholung / ns
+	 *  \param a_counters Hardwarezaehler je Wiederholung
+	 *  \return Ergebnis
+	 */
+	Stats summarize(const std::string &a_name, long long a_calls,
+			const std::vector<double> &a_ns,
+			const std::vector<Counters> &a_counters) const;
+
+	int reps_;           /**< Anzahl der Wiederholungen */
+	double minRepMs_;    /**< Mindestdauer einer Wiederholung / ms */
+	double warmupMs_;    /**< Mindestdauer des Aufwaermens / ms */
+	PerfCounters perf_;  /**< Hardwarezaehler */
+};
+
+template<class F>
+Stats MicroBench::run(const std::string &a_name, F a_body)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	// Aufwaermen: Schleifenlaenge verdoppeln, bis eine Wiederholung lang
+	// genug dauert, und mindestens warmupMs lang laufen lassen
+	long long calls = 1;
+	Clock::time_point warmupStart = Clock::now();
+	for (;;)
+	{
+		Clock::time_point start = Clock::now();
+		for (long long c = 0; c < calls; c++)
+		{
+			a_body();
+		}
+		Clock::time_point end = Clock::now();
+		bool longEnough = std::chrono::duration<double, std::milli>(
+				end - start).count() >= minRepMs_;
+		if (longEnough && std::chrono::duration<double, std::milli>(
+				end - warmupStart).count() >= warmupMs_)
+		{
+			break;
+		}
+		if (!longEnough)
+		{
+			calls *= 2;
+		}
+	}
+
+	std::vector<double> ns(reps_);
+	std::vector<Counters> counters(reps_);
+	for (int r = 0; r < reps_; r++)
+	{
+		perf_.start();
+		Clock::time_point start = Clock::now();
+		for (long long c = 0; c < calls; c++)
+		{
+			a_body();
+		}
+		Clock::time_point end = Clock::now();
+		counters[r] = perf_.stop();
+		ns[r] = std::chrono::duration<double, std::nano>(end - start).count();
+	}
+	return summarize(a_name, calls, ns, counters);
+}
+
+}
+
+#endif /* BENCH_MICROBENCH_H_ */
@@ -0,0 +1,251 @@
+/*! \file NetlistGenerators.cpp
+ *  \brief Implementierung der Netlist-Generatoren
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "NetlistGenerators.h"
+#include "../gate/PredefinedGateLogics.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sgnl;
+
+namespace netgen
+{
+
+Network shiftRegister(int a_nBits, sgnl::Nanoseconds a_propagationDelay)
+{
+	int nBits = max(a_nBits, 1);
+	Network shiftRegister("Shift_Register_" + to_string(nBits),
+			a_propagationDelay);
+	shiftRegister.addInput("D");
+	shiftRegister.addInput("CLK");
+	shiftRegister.addOutput("Q");
+	for (int i = 0; i < nBits; i++)
+	{
+		string name = "dff" + to_string(i);
+		shiftRegister.addGate(name, pgl::dff);
+		shiftRegister.connectInput("CLK", name, 1);
+		if (i == 0)
+		{
+			shiftRegister.connectInput("D", name, 0);
+		}
+		else
+		{
+			shiftRegister.connectGates("dff" + to_string(i - 1), 0, name, 0);
+		}
+	}
+	shiftRegister.connectOutput("Q", "dff" + to_string(nBits - 1), 0);
+	return shiftRegister;
+}
+
+Network rippleCarryAdder(int a_nBits, sgnl::Nanoseconds a_propagationDelay)
+{
+	int nBits = max(a_nBits, 1);
+	Network adder("Ripple_Carry_Adder_" + to_string(nBits),
+			a_propagationDelay);
+	adder.addInput("CIN");
+	adder.addOutput("COUT");
+	string carry;  // Gate, das den Uebertrag ins aktuelle Bit treibt
+	for (int i = 0; i < nBits; i++)
+	{
+		string bit = to_string(i);
+		string a = "A" + bit;
+		string b = "B" + bit;
+		string prefix = "fa" + bit + "_";
+		adder.addInput(a);
+		adder.addInput(b);
+		adder.addOutput("S" + bit);
+
+		// x = a XOR b
+		adder.addGate(prefix + "or1", pgl::or2);
+		adder.addGate(prefix + "and1", pgl::and2);
+		adder.addGate(prefix + "not1", pgl::not1);
+		adder.addGate(prefix + "x", pgl::and2);
+		adder.connectInput(a, prefix + "or1", 0);
+		adder.connectInput(b, prefix + "or1", 1);
+		adder.connectInput(a, prefix + "and1", 0);
+		adder.connectInput(b, prefix + "and1", 1);
+		adder.connectGates(prefix + "and1", 0, prefix + "not1", 0);
+		adder.connectGates(prefix + "or1", 0, prefix + "x", 0);
+		adder.connectGates(prefix + "not1", 0, prefix + "x", 1);
+
+		// s = x XOR carry
+		adder.addGate(prefix + "or2", pgl::or2);
+		adder.addGate(prefix + "and2", pgl::and2);
+		adder.addGate(prefix + "not2", pgl::not1);
+		adder.addGate(prefix + "s", pgl::and2);
+		adder.connectGates(prefix + "x", 0, prefix + "or2", 0);
+		adder.connectGates(prefix + "x", 0, prefix + "and2", 0);
+		if (i == 0)
+		{
+			adder.connectInput("CIN", prefix + "or2", 1);
+			adder.connectInput("CIN", prefix + "and2", 1);
+		}
+		else
+		{
+			adder.connectGates(carry, 0, prefix + "or2", 1);
+			adder.connectGates(carry, 0, prefix + "and2", 1);
+		}
+		adder.connectGates(prefix + "and2", 0, prefix + "not2", 0);
+		adder.connectGates(prefix + "or2", 0, prefix + "s", 0);
+		adder.connectGates(prefix + "not2", 0, prefix + "s", 1);
+		adder.connectOutput("S" + bit, prefix + "s", 0);
+
+		// carry' = (a ^ b) v (x ^ carry)
+		adder.addGate(prefix + "cout", pgl::or2);
+		adder.connectGates(prefix + "and1", 0, prefix + "cout", 0);
+		adder.connectGates(prefix + "and2", 0, prefix + "cout", 1);
+		carry = prefix + "cout";
+	}
+	adder.connectOutput("COUT", carry, 0);
+	return adder;
+}
+
+Network counter(int a_nBits, sgnl::Nanoseconds a_propagationDelay)
+{
+	int nBits = max(a_nBits, 1);
+	Network counter("Counter_" + to_string(nBits), a_propagationDelay);
+	counter.addInput("CLK");
+	for (int i = 0; i < nBits; i++)
+	{
+		string bit = to_string(i);
+		counter.addGate("tff" + bit, pgl::tff);
+		counter.addOutput("Q" + bit);
+		counter.connectOutput("Q" + bit, "tff" + bit, 0);
+		if (i == 0)
+		{
+			counter.connectInput("CLK", "tff0", 0);
+		}
+		else
+		{
+			// Fallende Flanke des vorherigen Bits = steigende Flanke am TFF
+			string inverter = "not" + to_string(i - 1);
+			counter.addGate(inverter, pgl::not1);
+			counter.connectGates("tff" + to_string(i - 1), 0, inverter, 0);
+			counter.connectGates(inverter, 0, "tff" + bit, 0);
+		}
+	}
+	return counter;
+}
+
+Network randomDag(int a_nGates, int a_nInputs, int a_depth, int a_maxFanout,
+		unsigned int a_seed, sgnl::Nanoseconds a_propagationDelay)
+{
+	/*! \brief Treiber eines Gate-Inputs
+	 */
+	struct Driver
+	{
+		string name_;  /**< Name des Network-Inputs bzw. Gates */
+		bool input_;   /**< Network-Input (ohne Fan-out-Grenze) */
+		int fanout_;   /**< Anzahl der getriebenen Gate-Inputs */
+	};
+	const GateLogic *logics[4] = { &pgl::and2, &pgl::or2, &pgl::not1,
+			&pgl::buf1 };
+
+	int nGates = max(a_nGates, 1);
+	int depth = min(max(a_depth, 1), nGates);
+	int maxFanout = max(a_maxFanout, 2);
+	// Gate g liegt auf Ebene g * depth / nGates, die erste Ebene ist die
+	// groesste
+	int firstLevelSize = (nGates + depth - 1) / depth;
+	int nInputs = min(max(a_nInputs, 1), firstLevelSize);
+
+	Network dag("Random_DAG_" + to_string(nGates), a_propagationDelay);
+	mt19937 gen(a_seed);
+	uniform_int_distribution<int> logicDist(0, 3);
+	vector<Driver> drivers;
+	for (int i = 0; i < nInputs; i++)
+	{
+		Driver input = { "I" + to_string(i), true, 0 };
+		dag.addInput(input.name_);
+		drivers.push_back(input);
+	}
+
+	int nOutputs = 0;
+	int gate = 0;
+	for (int level = 0; level < depth; level++)
+	{
+		vector<Driver> levelGates;
+		vector<int> unused(drivers.size());
+		for (int d = 0; d < static_cast<int>(unused.size()); d++)
+		{
+			unused[d] = d;
+		}
+		shuffle(unused.begin(), unused.end(), gen);
+		int nextUnused = 0;
+		uniform_int_distribution<int> driverDist(0,
+				static_cast<int>(drivers.size()) - 1);
+
+		for (; gate < nGates
+				&& static_cast<long long>(gate) * depth / nGates == level;
+				gate++)
+		{
+			Driver levelGate = { "g" + to_string(gate), false, 0 };
+			const GateLogic &logic = *logics[logicDist(gen)];
+			dag.addGate(levelGate.name_, logic);
+			for (int pin = 0; pin < logic.nInputs(); pin++)
+			{
+				int d = -1;
+				if (nextUnused < static_cast<int>(unused.size()))
+				{
+					d = unused[nextUnused++];
+				}
+				else
+				{
+					// Zufaelliger Treiber mit freiem Fan-out, sonst der
+					// naechste freie, notfalls ohne Grenze
+					int candidate = driverDist(gen);
+					for (int k = 0; k < static_cast<int>(drivers.size()); k++)
+					{
+						int c = (candidate + k) % drivers.size();
+						if (drivers[c].input_ || drivers[c].fanout_ < maxFanout)
+						{
+							d = c;
+							break;
+						}
+					}
+					if (d < 0)
+					{
+						d = candidate;
+					}
+				}
+				if (drivers[d].input_)
+				{
+					dag.connectInput(drivers[d].name_, levelGate.name_, pin);
+				}
+				else
+				{
+					dag.connectGates(drivers[d].name_, 0, levelGate.name_, pin);
+				}
+				drivers[d].fanout_++;
+			}
+			levelGates.push_back(levelGate);
+		}
+
+		for (int d = 0; d < static_cast<int>(drivers.size()); d++)
+		{
+			if (!drivers[d].input_ && drivers[d].fanout_ == 0)
+			{
+				string output = "O" + to_string(nOutputs++);
+				dag.addOutput(output);
+				dag.connectOutput(output, drivers[d].name_, 0);
+			}
+		}
+		drivers.swap(levelGates);
+	}
+	for (int d = 0; d < static_cast<int>(drivers.size()); d++)
+	{
+		string output = "O" + to_string(nOutputs++);
+		dag.addOutput(output);
+		dag.connectOutput(output, drivers[d].name_, 0);
+	}
+	return dag;
+}
+
+}
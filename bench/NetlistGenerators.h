@@ -0,0 +1,69 @@
+/*! \file NetlistGenerators.h
+ *  \brief Erzeugung synthetischer Networks beliebiger Groesse fuer
+ *  Benchmarks
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef BENCH_NETLISTGENERATORS_H_
+#define BENCH_NETLISTGENERATORS_H_
+
+#include "../network/Network.h"
+
+/*! \namespace netgen
+ *  \brief Parametrisierte Netlist-Generatoren (network generators). Alle
+ *  erzeugten Networks sind konsistent (Network::consistent())
+ */
+namespace netgen
+{
+
+/*! \brief N-Bit-Schieberegister aus einer DFF-Kette.
+ *  Inputs D und CLK, Output Q (letztes Bit). N Gates
+ *  \param a_nBits Anzahl der Bits (>= 1)
+ *  \param a_propagationDelay Gatterlaufzeit / ns
+ *  \return Network
+ */
+Network shiftRegister(int a_nBits, sgnl::Nanoseconds a_propagationDelay = 5);
+
+/*! \brief N-Bit-Ripple-Carry-Addierer nur aus AND2, OR2 und NOT1
+ *  (XOR = (a v b) ^ !(a ^ b)). Inputs A0..A<N-1>, B0..B<N-1> und CIN,
+ *  Outputs S0..S<N-1> und COUT. 9 Gates je Bit
+ *  \param a_nBits Anzahl der Bits (>= 1)
+ *  \param a_propagationDelay Gatterlaufzeit / ns
+ *  \return Network
+ */
+Network rippleCarryAdder(int a_nBits,
+		sgnl::Nanoseconds a_propagationDelay = 5);
+
+/*! \brief N-Bit-Asynchronzaehler (Vorwaerts) aus einer TFF-Kette. Jedes
+ *  TFF schaltet bei der fallenden Flanke des vorherigen Bits (ueber ein
+ *  NOT1). Input CLK, Outputs Q0..Q<N-1>. 2N-1 Gates. Der Startwert ist
+ *  nicht 0, da die NOT1-Outputs im ersten Schritt steigen
+ *  \param a_nBits Anzahl der Bits (>= 1)
+ *  \param a_propagationDelay Gatterlaufzeit / ns
+ *  \return Network
+ */
+Network counter(int a_nBits, sgnl::Nanoseconds a_propagationDelay = 5);
+
+/*! \brief Zufaelliger gerichteter azyklischer Graph aus AND2, OR2, NOT1
+ *  und BUF1. Die Gates werden gleichmaessig auf a_depth Ebenen verteilt,
+ *  jeder Gate-Input wird von einem Gate der vorherigen Ebene (erste Ebene:
+ *  von einem Network-Input) getrieben. Jeder Treiber wird nach Moeglichkeit
+ *  mindestens einmal verwendet, ein Gate-Output treibt hoechstens
+ *  a_maxFanout Gate-Inputs. Gates, deren Output nichts treibt, werden mit
+ *  Network-Outputs O0, O1, ... verbunden. Inputs I0, I1, ...
+ *  \param a_nGates Anzahl der Gates (>= 1)
+ *  \param a_nInputs Anzahl der Network-Inputs (>= 1, hoechstens so viele
+ *  wie Gates auf der ersten Ebene)
+ *  \param a_depth Anzahl der Ebenen (>= 1, hoechstens a_nGates)
+ *  \param a_maxFanout Hoechstzahl getriebener Gate-Inputs je Gate (>= 2)
+ *  \param a_seed Startwert des Zufallsgenerators
+ *  \param a_propagationDelay Gatterlaufzeit / ns
+ *  \return Network
+ */
+Network randomDag(int a_nGates, int a_nInputs, int a_depth, int a_maxFanout,
+		unsigned int a_seed, sgnl::Nanoseconds a_propagationDelay = 5);
+
+}
+
+#endif /* BENCH_NETLISTGENERATORS_H_ */
@@ -0,0 +1,340 @@
+/*! \file NetworkBenchmark.cpp
+ *  \brief Misst Aufbau, Konsistenzpruefung, Speichern/Laden und
+ *  Simulationsdurchsatz synthetischer Networks (siehe NetlistGenerators.h)
+ *  und schreibt die Ergebnisse optional als JSON, damit sie ueber die Zeit
+ *  verglichen werden koennen. Muss aus einem Ordner gestartet werden, in dem
+ *  der Ordner Saves existiert.
+ *
+ *  Aufruf: NetworkBenchmark [--quick] [--max-gates N] [--evals N]
+ *  [--json Datei]
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "NetlistGenerators.h"
+#include "../network/CompiledNetwork.h"
+#include "../fileIO/FileInput.h"
+#include "../fileIO/FileOutput.h"
+#include "../diag/Log.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sgnl;
+
+/*! \brief Ergebnis eines Benchmark-Falls. Zeiten < 0 = nicht gemessen
+ */
+struct Result
+{
+	string generator_;      /**< Name des Generators */
+	int parameter_;         /**< Parameter des Generators (Bits bzw. Gates) */
+	int nGates_;            /**< Anzahl der Gates */
+	int nInputs_;           /**< Anzahl der Network-Inputs */
+	int nOutputs_;          /**< Anzahl der Network-Outputs */
+	bool consistent_;       /**< Ergebnis von Network::consistent() */
+	double buildMs_;        /**< Aufbau durch den Generator / ms */
+	double consistentMs_;   /**< Network::consistent() / ms */
+	double compileMs_;      /**< CompiledNetwork(...) / ms */
+	double saveMs_;         /**< FileOutput::save(...) / ms */
+	double loadMs_;         /**< FileInput::load(...) / ms */
+	long long fileBytes_;   /**< Groesse der gespeicherten Datei */
+	bool loadedMatches_;    /**< Geladenes Network hat gleich viele Gates */
+	int networkSteps_;      /**< Simulationsschritte mit Network */
+	double networkEvalsPerSecond_;   /**< Gate-Auswertungen je Sekunde */
+	int compiledSteps_;     /**< Simulationsschritte mit CompiledNetwork */
+	double compiledEvalsPerSecond_;  /**< Gate-Auswertungen je Sekunde */
+};
+
+/*! \brief Misst die Laufzeit einer Funktion
+ *  \param a_function Zu messende Funktion
+ *  \return Laufzeit / ms
+ */
+static double measure(const function<void()> &a_function)
+{
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	a_function();
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/*! \brief Erzeugt die Inputspannungen eines Simulationsschritts:
+ *  Rechtecksignale mit je Input unterschiedlicher Periode
+ *  \param a_nInputs Anzahl der Network-Inputs
+ *  \param a_time Simulationszeit / ns
+ *  \param a_inputs Inputspannungen
+ */
+static void stimulus(int a_nInputs, Nanoseconds a_time, vector<Volt> &a_inputs)
+{
+	a_inputs.resize(a_nInputs);
+	for (int i = 0; i < a_nInputs; i++)
+	{
+		Nanoseconds halfPeriod = 10 * (1 + i % 7);
+		a_inputs[i] = ((a_time / halfPeriod) % 2 == 1) ? HIGH_LEVEL_VOLT :
+				LOW_LEVEL_VOLT;
+	}
+	return;
+}
+
+/*! \brief Fuehrt alle Messungen fuer ein erzeugtes Network durch
+ *  \param a_generator Name des Generators
+ *  \param a_parameter Parameter des Generators
+ *  \param a_generate Erzeugt das Network
+ *  \param a_evals Angestrebte Gate-Auswertungen je Simulationsmessung
+ *  \return Ergebnis
+ */
+static Result run(const string &a_generator, int a_parameter,
+		const function<Network()> &a_generate, long long a_evals)
+{
+	Result result = { a_generator, a_parameter, 0, 0, 0, false, -1, -1, -1, -1,
+			-1, -1, false, 0, 0, 0, 0 };
+	Network network("", 0);
+	result.buildMs_ = measure([&]()
+	{
+		network = a_generate();
+	});
+	result.consistentMs_ = measure([&]()
+	{
+		result.consistent_ = network.consistent();
+	});
+	shared_ptr<CompiledNetwork> compiled;
+	result.compileMs_ = measure([&]()
+	{
+		compiled = make_shared<CompiledNetwork>(network);
+	});
+	result.nGates_ = compiled->nGates();
+	result.nInputs_ = compiled->nInputs();
+	result.nOutputs_ = compiled->nOutputs();
+
+	// Speichern und Laden
+	string fileName = "bench_" + a_generator + "_" + to_string(a_parameter);
+	bool saved = false;
+	result.saveMs_ = measure([&]()
+	{
+		saved = FileOutput::save(network, fileName);
+	});
+	if (saved)
+	{
+		string path = "Saves/" + fileName + ".nw";
+		ifstream file(path.c_str(), ios::binary | ios::ate);
+		result.fileBytes_ = static_cast<long long>(file.tellg());
+		file.close();
+		Network loaded("", 0);
+		result.loadMs_ = measure([&]()
+		{
+			FileInput input;
+			loaded = input.load(fileName);
+		});
+		result.loadedMatches_ = loaded.getGates_().size()
+				== static_cast<size_t>(result.nGates_);
+		remove(path.c_str());
+	}
+	else
+	{
+		result.saveMs_ = -1;
+	}
+
+	// Simulationsdurchsatz, Anzahl der Schritte nach Groesse des Networks
+	int steps = static_cast<int>(max(1LL, a_evals / max(1, result.nGates_)));
+	vector<Volt> inputs;
+	result.networkSteps_ = steps;
+	double networkMs = measure([&]()
+	{
+		for (int t = 0; t < steps; t++)
+		{
+			stimulus(result.nInputs_, t, inputs);
+			network.simulationStep(inputs);
+		}
+	});
+	result.networkEvalsPerSecond_ = static_cast<double>(result.nGates_)
+			* steps / (networkMs / 1000.0);
+
+	if (compiled->valid())
+	{
+		// CompiledNetwork ist deutlich schneller, daher mehr Schritte
+		int compiledSteps = steps * 10;
+		NetworkState state = compiled->createState(1);
+		result.compiledSteps_ = compiledSteps;
+		double compiledMs = measure([&]()
+		{
+			for (int t = 0; t < compiledSteps; t++)
+			{
+				stimulus(result.nInputs_, t, inputs);
+				compiled->simulationStep(state, inputs.data());
+			}
+		});
+		result.compiledEvalsPerSecond_ = static_cast<double>(result.nGates_)
+				* compiledSteps / (compiledMs / 1000.0);
+	}
+	return result;
+}
+
+/*! \brief Gibt eine Zahl als JSON-Wert aus, negative Zeiten als null
+ *  \param a_out Ausgabe
+ *  \param a_value Wert
+ */
+static void writeJsonNumber(ostream &a_out, double a_value)
+{
+	if (a_value < 0)
+	{
+		a_out << "null";
+	}
+	else
+	{
+		a_out << a_value;
+	}
+	return;
+}
+
+/*! \brief Schreibt alle Ergebnisse als JSON
+ *  \param a_out Ausgabe
+ *  \param a_results Ergebnisse
+ *  \param a_evals Angestrebte Gate-Auswertungen je Simulationsmessung
+ */
+static void writeJson(ostream &a_out, const vector<Result> &a_results,
+		long long a_evals)
+{
+	char timestamp[32];
+	time_t now = time(nullptr);
+	strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+	a_out.precision(6);
+	a_out << "{\n  \"benchmark\": \"network\",\n  \"version\": 1,\n"
+			<< "  \"timestamp\": \"" << timestamp << "\",\n"
+			<< "  \"evals_per_measurement\": " << a_evals << ",\n"
+			<< "  \"results\": [";
+	for (int r = 0; r < static_cast<int>(a_results.size()); r++)
+	{
+		const Result &result = a_results[r];
+		a_out << (r == 0 ? "\n" : ",\n") << "    {\"generator\": \""
+				<< result.generator_ << "\", \"parameter\": "
+				<< result.parameter_ << ", \"gates\": " << result.nGates_
+				<< ", \"inputs\": " << result.nInputs_ << ", \"outputs\": "
+				<< result.nOutputs_ << ", \"consistent\": "
+				<< (result.consistent_ ? "true" : "false")
+				<< ",\n     \"build_ms\": ";
+		writeJsonNumber(a_out, result.buildMs_);
+		a_out << ", \"consistent_ms\": ";
+		writeJsonNumber(a_out, result.consistentMs_);
+		a_out << ", \"compile_ms\": ";
+		writeJsonNumber(a_out, result.compileMs_);
+		a_out << ", \"save_ms\": ";
+		writeJsonNumber(a_out, result.saveMs_);
+		a_out << ", \"load_ms\": ";
+		writeJsonNumber(a_out, result.loadMs_);
+		a_out << ", \"file_bytes\": ";
+		if (result.fileBytes_ < 0)
+		{
+			a_out << "null";
+		}
+		else
+		{
+			a_out << result.fileBytes_;
+		}
+		a_out << ", \"load_matches\": "
+				<< (result.loadedMatches_ ? "true" : "false")
+				<< ",\n     \"network_steps\": " << result.networkSteps_
+				<< ", \"network_evals_per_s\": "
+				<< result.networkEvalsPerSecond_ << ", \"compiled_steps\": "
+				<< result.compiledSteps_ << ", \"compiled_evals_per_s\": "
+				<< result.compiledEvalsPerSecond_ << "}";
+	}
+	a_out << "\n  ]\n}\n";
+	return;
+}
+
+int main(int argc, char *argv[])
+{
+	int maxGates = 1000000;
+	long long evals = 20000000;
+	string jsonFile;
+	for (int a = 1; a < argc; a++)
+	{
+		if (strcmp(argv[a], "--quick") == 0)
+		{
+			maxGates = 10000;
+			evals = 200000;
+		}
+		else if (strcmp(argv[a], "--max-gates") == 0 && a + 1 < argc)
+		{
+			maxGates = atoi(argv[++a]);
+		}
+		else if (strcmp(argv[a], "--evals") == 0 && a + 1 < argc)
+		{
+			evals = atoll(argv[++a]);
+		}
+		else if (strcmp(argv[a], "--json") == 0 && a + 1 < argc)
+		{
+			jsonFile = argv[++a];
+		}
+		else
+		{
+			cerr << "Usage: " << argv[0]
+					<< " [--quick] [--max-gates N] [--evals N] [--json file]"
+					<< endl;
+			return 2;
+		}
+	}
+
+	// Nur Fehler ausgeben, Statusmeldungen wuerden die Tabelle unterbrechen
+	diag::Log::setLevel(diag::LogLevel::WARNING);
+	vector<Result> results;
+	for (int gates = 1000; gates <= maxGates; gates *= 10)
+	{
+		vector<Result> cases;
+		cases.push_back(run("shift_register", gates, [gates]()
+		{
+			return netgen::shiftRegister(gates);
+		}, evals));
+		cases.push_back(run("ripple_carry_adder", gates / 9, [gates]()
+		{
+			return netgen::rippleCarryAdder(gates / 9);
+		}, evals));
+		cases.push_back(run("counter", (gates + 1) / 2, [gates]()
+		{
+			return netgen::counter((gates + 1) / 2);
+		}, evals));
+		cases.push_back(run("random_dag", gates, [gates]()
+		{
+			return netgen::randomDag(gates, 32, 64, 4, 1);
+		}, evals));
+		for (int c = 0; c < static_cast<int>(cases.size()); c++)
+		{
+			const Result &result = cases[c];
+			cout << result.generator_ << " (" << result.nGates_
+					<< " Gates): Aufbau " << result.buildMs_
+					<< " ms, consistent() " << result.consistentMs_
+					<< " ms, Speichern " << result.saveMs_ << " ms, Laden "
+					<< result.loadMs_ << " ms, Network "
+					<< result.networkEvalsPerSecond_ / 1e6
+					<< " M Auswertungen/s, CompiledNetwork "
+					<< result.compiledEvalsPerSecond_ / 1e6
+					<< " M Auswertungen/s" << endl;
+			results.push_back(result);
+		}
+	}
+
+	bool ok = true;
+	for (int r = 0; r < static_cast<int>(results.size()); r++)
+	{
+		ok = ok && results[r].consistent_ && results[r].loadedMatches_;
+	}
+	if (!jsonFile.empty())
+	{
+		ofstream file(jsonFile.c_str());
+		if (!file.is_open())
+		{
+			cerr << "Cannot open JSON file at \"" << jsonFile << "\"." << endl;
+			return 1;
+		}
+		writeJson(file, results, evals);
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,328 @@
+/*! \file PerfRegression.cpp
+ *  \brief Durchsatz-Regressionstest: simuliert Referenz-Workloads mit
+ *  festen Startwerten im Testbed, vergleicht die simulierten Nanosekunden
+ *  je Sekunde mit einer Referenzdatei und endet mit Rueckgabewert 1, wenn
+ *  ein Workload um mehr als die Toleranz langsamer ist. Die Referenzdatei
+ *  enthaelt je Zeile "<Workload> <ns/s>", Zeilen mit # sind Kommentare;
+ *  --update schreibt sie mit den gemessenen Werten neu.
+ *
+ *  Aufruf: PerfRegression [--baseline Datei] [--update] [--tolerance T]
+ *  [--reps N] [--workload Name] [--quick]
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "NetlistGenerators.h"
+#include "../network/CompiledNetwork.h"
+#include "../Testbed/Testbed.h"
+#include "../diag/Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sgnl;
+
+/*! \brief Referenz-Workload: ein Testbed mit festen Startwerten, das fuer
+ *  eine feste Dauer simuliert wird
+ */
+struct Workload
+{
+	string name_;            /**< Name (Schluessel in der Referenzdatei) */
+	Nanoseconds duration_;   /**< Simulierte Dauer / ns */
+	function<shared_ptr<const CompiledNetwork>()> network_; /**< Erzeugt das Network */
+	function<void(Testbed&)> sources_;  /**< Verbindet die Signalquellen */
+};
+
+/*! \brief Messergebnis eines Workloads
+ */
+struct Measurement
+{
+	int nGates_;             /**< Anzahl der Gates */
+	double seconds_;         /**< Beste Laufzeit / s */
+	double nsPerSecond_;     /**< Simulierte ns je Sekunde (beste Wiederholung) */
+	double evalsPerSecond_;  /**< Gate-Auswertungen je Sekunde */
+};
+
+/*! \brief Die Referenz-Workloads. Die Dauern sind so gewaehlt, dass eine
+ *  Wiederholung in einem Release-Build hoechstens einige Sekunden dauert
+ *  (random_dag_10k: 10^8 Gate-Auswertungen)
+ *  \return Workloads
+ */
+static vector<Workload> workloads()
+{
+	vector<Workload> list;
+
+	Workload shiftRegister;
+	shiftRegister.name_ = "shift_register_4";
+	shiftRegister.duration_ = 1000000;
+	shiftRegister.network_ = []()
+	{
+		return make_shared<const CompiledNetwork>(netgen::shiftRegister(4));
+	};
+	shiftRegister.sources_ = [](Testbed &a_testbed)
+	{
+		a_testbed.addClockSource("CLK", 100, 0);
+		a_testbed.addPrbsSource("D", PrbsOrder::PRBS7, 100, 1);
+	};
+	list.push_back(shiftRegister);
+
+	Workload randomDag;
+	randomDag.name_ = "random_dag_10k";
+	randomDag.duration_ = 10000;
+	randomDag.network_ = []()
+	{
+		return make_shared<const CompiledNetwork>(
+				netgen::randomDag(10000, 32, 64, 4, 1));
+	};
+	randomDag.sources_ = [](Testbed &a_testbed)
+	{
+		for (int i = 0; i < 32; i++)
+		{
+			a_testbed.addPrbsSource("I" + to_string(i), PrbsOrder::PRBS15,
+					10 * (1 + i % 7), i + 1);
+		}
+	};
+	list.push_back(randomDag);
+	return list;
+}
+
+/*! \brief Simuliert einen Workload a_reps mal mit einem neuen Testbed und
+ *  gibt die schnellste Wiederholung zurueck
+ *  \param a_workload Workload
+ *  \param a_duration Simulierte Dauer / ns
+ *  \param a_reps Anzahl der Wiederholungen
+ *  \return Messergebnis
+ */
+static Measurement measure(const Workload &a_workload, Nanoseconds a_duration,
+		int a_reps)
+{
+	shared_ptr<const CompiledNetwork> network = a_workload.network_();
+	Measurement measurement = { network->nGates(), 0, 0, 0 };
+	for (int r = 0; r < a_reps; r++)
+	{
+		Testbed testbed(network, 1);
+		testbed.setRecording(false);
+		testbed.setPlotting(false);
+		a_workload.sources_(testbed);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		testbed.simulationstep(a_duration);
+		double seconds = chrono::duration<double>(
+				chrono::steady_clock::now() - start).count();
+		if (r == 0 || seconds < measurement.seconds_)
+		{
+			measurement.seconds_ = seconds;
+		}
+	}
+	measurement.nsPerSecond_ = a_duration / measurement.seconds_;
+	measurement.evalsPerSecond_ = measurement.nsPerSecond_ * measurement.nGates_;
+	return measurement;
+}
+
+/*! \brief Liest die Referenzdatei
+ *  \param a_fileName Dateiname
+ *  \param a_baseline Referenzwerte (Workload -> ns/s)
+ *  \return false, falls die Datei nicht gelesen werden kann
+ */
+static bool readBaseline(const string &a_fileName,
+		map<string, double> &a_baseline)
+{
+	ifstream file(a_fileName.c_str());
+	if (!file.is_open())
+	{
+		return false;
+	}
+	string line;
+	while (getline(file, line))
+	{
+		if (line.empty() || line[0] == '#')
+		{
+			continue;
+		}
+		istringstream fields(line);
+		string name;
+		double nsPerSecond = 0;
+		if (fields >> name >> nsPerSecond)
+		{
+			a_baseline[name] = nsPerSecond;
+		}
+	}
+	return true;
+}
+
+/*! \brief Schreibt die Referenzdatei
+ *  \param a_fileName Dateiname
+ *  \param a_names Workloads
+ *  \param a_results Messergebnisse in derselben Reihenfolge
+ *  \return false, falls die Datei nicht geschrieben werden kann
+ */
+static bool writeBaseline(const string &a_fileName,
+		const vector<string> &a_names, const vector<Measurement> &a_results)
+{
+	ofstream file(a_fileName.c_str());
+	if (!file.is_open())
+	{
+		return false;
+	}
+	file << "# Simulationsdurchsatz der Referenz-Workloads (perf_regression --update)"
+			<< endl << "# <Workload> <simulierte ns je Sekunde>" << endl;
+	for (int w = 0; w < static_cast<int>(a_names.size()); w++)
+	{
+		file << a_names[w] << " " << static_cast<long long>(a_results[w].nsPerSecond_)
+				<< endl;
+	}
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	string baselineFile = "perf_baseline.txt";
+	string only;
+	bool update = false;
+	bool quick = false;
+	double tolerance = 0.25;
+	int reps = 3;
+	for (int a = 1; a < argc; a++)
+	{
+		if (strcmp(argv[a], "--baseline") == 0 && a + 1 < argc)
+		{
+			baselineFile = argv[++a];
+		}
+		else if (strcmp(argv[a], "--update") == 0)
+		{
+			update = true;
+		}
+		else if (strcmp(argv[a], "--tolerance") == 0 && a + 1 < argc)
+		{
+			tolerance = atof(argv[++a]);
+		}
+		else if (strcmp(argv[a], "--reps") == 0 && a + 1 < argc)
+		{
+			reps = max(1, atoi(argv[++a]));
+		}
+		else if (strcmp(argv[a], "--workload") == 0 && a + 1 < argc)
+		{
+			only = argv[++a];
+		}
+		else if (strcmp(argv[a], "--quick") == 0)
+		{
+			quick = true;
+		}
+		else
+		{
+			cerr << "Usage: " << argv[0]
+					<< " [--baseline file] [--update] [--tolerance T] [--reps N]"
+					<< " [--workload name] [--quick]" << endl;
+			return 2;
+		}
+	}
+
+	// Nur Fehler ausgeben, Statusmeldungen wuerden die Tabelle unterbrechen
+	diag::Log::setLevel(diag::LogLevel::WARNING);
+	map<string, double> baseline;
+	if (!update && !readBaseline(baselineFile, baseline))
+	{
+		cerr << "Cannot open baseline at \"" << baselineFile
+				<< "\" (create it with --update)." << endl;
+		return 2;
+	}
+
+	vector<Workload> list = workloads();
+	vector<string> names;
+	vector<Measurement> results;
+	bool ok = true;
+	cout << left << setw(20) << "workload" << right << setw(8) << "gates"
+			<< setw(12) << "sim ns" << setw(10) << "s" << setw(14) << "ns/s"
+			<< setw(14) << "Mevals/s" << setw(14) << "baseline" << setw(9)
+			<< "ratio" << endl;
+	for (int w = 0; w < static_cast<int>(list.size()); w++)
+	{
+		const Workload &workload = list[w];
+		if (!only.empty() && workload.name_ != only)
+		{
+			continue;
+		}
+		// Kurzlauf: ein Zehntel der Dauer, der Durchsatz bleibt vergleichbar
+		Nanoseconds duration = quick ? workload.duration_ / 10 : workload.duration_;
+		Measurement measurement = measure(workload, duration, reps);
+		names.push_back(workload.name_);
+		results.push_back(measurement);
+
+		cout << left << setw(20) << workload.name_ << right << setw(8)
+				<< measurement.nGates_ << setw(12) << duration << fixed
+				<< setprecision(3) << setw(10) << measurement.seconds_
+				<< setprecision(0) << setw(14) << measurement.nsPerSecond_
+				<< setprecision(2) << setw(14)
+				<< measurement.evalsPerSecond_ / 1e6;
+		map<string, double>::const_iterator reference = baseline.find(
+				workload.name_);
+		if (update)
+		{
+			cout << endl;
+			continue;
+		}
+		if (reference == baseline.end() || reference->second <= 0)
+		{
+			cout << setw(14) << "-" << setw(9) << "-" << "  no baseline" << endl;
+			ok = false;
+			continue;
+		}
+		double ratio = measurement.nsPerSecond_ / reference->second;
+		cout << setprecision(0) << setw(14) << reference->second
+				<< setprecision(2) << setw(9) << ratio;
+		if (ratio < 1 - tolerance)
+		{
+			cout << "  REGRESSION";
+			ok = false;
+		}
+		else if (ratio > 1 + tolerance)
+		{
+			cout << "  faster, consider --update";
+		}
+		cout << endl;
+	}
+	if (names.empty())
+	{
+		cerr << "Unknown workload \"" << only << "\"." << endl;
+		return 2;
+	}
+
+	if (update)
+	{
+		if (!only.empty())
+		{
+			// Uebrige Referenzwerte beibehalten
+			map<string, double> previous;
+			readBaseline(baselineFile, previous);
+			for (int w = 0; w < static_cast<int>(list.size()); w++)
+			{
+				map<string, double>::const_iterator reference = previous.find(
+						list[w].name_);
+				if (list[w].name_ != only && reference != previous.end())
+				{
+					Measurement kept = { 0, 0, reference->second, 0 };
+					names.push_back(list[w].name_);
+					results.push_back(kept);
+				}
+			}
+		}
+		if (!writeBaseline(baselineFile, names, results))
+		{
+			cerr << "Cannot write baseline at \"" << baselineFile << "\"." << endl;
+			return 2;
+		}
+		cout << "Baseline written to " << baselineFile << endl;
+	}
+	return ok ? 0 : 1;
+}
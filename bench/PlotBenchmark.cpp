@@ -0,0 +1,107 @@
+/*! \file PlotBenchmark.cpp
+ *  \brief Vergleicht das direkte Zeichenverfahren von BMPPlot mit dem
+ *  bisherigen (Pixelvektor je Linie). Muss wie das Hauptprogramm aus einem
+ *  Ordner gestartet werden, in dem myCode/plot/font/font.bmp liegt
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "../plot/BMPPlot.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sgnl;
+
+/*! \brief Erzeugt ein verrauschtes Rechtecksignal
+ *  \param a_length Anzahl der Werte
+ *  \param a_period Periode / ns
+ *  \param a_seed Startwert des Zufallsgenerators
+ *  \return Signal-Spannungswerte
+ */
+static vector<Volt> makeSignal(int a_length, int a_period, unsigned int a_seed)
+{
+	mt19937 gen(a_seed);
+	uniform_real_distribution<> noise(-0.3, 0.3);
+	vector<Volt> values(a_length);
+	for (int i = 0; i < a_length; i++)
+	{
+		Volt level = (i % a_period < a_period / 2) ? LOW_LEVEL_VOLT : HIGH_LEVEL_VOLT;
+		values[i] = level + noise(gen);
+	}
+	return values;
+}
+
+/*! \brief Rendert alle Signale a_repeat-mal und misst die Zeit je Plot
+ *  \param a_signals Signale
+ *  \param a_direct Direktes Zeichenverfahren verwenden
+ *  \param a_repeat Anzahl der Wiederholungen
+ *  \param a_pixels Pixel des letzten Plots
+ *  \return Mittlere Zeit je Plot / ms
+ */
+static double render(const vector<vector<Volt> > &a_signals, bool a_direct,
+		int a_repeat, vector<unsigned char> &a_pixels)
+{
+	// Gemessen wird nur das Zeichnen, nicht das Laden des Zeichensatzes
+	chrono::steady_clock::duration elapsed(0);
+	for (int r = 0; r < a_repeat; r++)
+	{
+		BMPPlot plot("benchmark");
+		plot.setDirectRendering(a_direct);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		plot.setTimeRange(0, static_cast<Nanoseconds>(a_signals[0].size()));
+		plot.setTimeTicks(static_cast<Nanoseconds>(a_signals[0].size() / 10));
+		for (int s = 0; s < static_cast<int>(a_signals.size()); s++)
+		{
+			plot.add("S" + to_string(s), a_signals[s]);
+		}
+		elapsed += chrono::steady_clock::now() - start;
+		if (r == a_repeat - 1)
+		{
+			const SimpleBMP &bitmap = plot.bitmap();
+			a_pixels.assign(bitmap.getPixels(), bitmap.getPixels()
+					+ bitmap.getWidth() * bitmap.getHeight() * 3);
+		}
+	}
+	return chrono::duration<double, milli>(elapsed).count() / a_repeat;
+}
+
+int main()
+{
+	struct Case
+	{
+		const char *name_;  /**< Bezeichnung */
+		int length_;        /**< Werte je Signal */
+		int period_;        /**< Periode des Rechtecksignals */
+		int repeat_;        /**< Wiederholungen */
+	};
+	const Case cases[] = { { "1 ns/Pixel", 1100, 40, 200 }, { "Huellkurve",
+			200000, 97, 20 } };
+
+	bool identical = true;
+	for (int c = 0; c < 2; c++)
+	{
+		vector<vector<Volt> > signals;
+		for (int s = 0; s < 6; s++)
+		{
+			signals.push_back(makeSignal(cases[c].length_,
+					cases[c].period_ * (s + 1), s));
+		}
+		vector<unsigned char> legacyPixels;
+		vector<unsigned char> directPixels;
+		double legacy = render(signals, false, cases[c].repeat_, legacyPixels);
+		double direct = render(signals, true, cases[c].repeat_, directPixels);
+		bool same = legacyPixels == directPixels;
+		identical = identical && same;
+		cout << cases[c].name_ << ": bisher " << legacy << " ms, direkt "
+				<< direct << " ms, Faktor " << legacy / direct
+				<< (same ? ", Bilder identisch" : ", Bilder UNTERSCHIEDLICH")
+				<< endl;
+	}
+	return identical ? 0 : 1;
+}
@@ -0,0 +1,313 @@
+/*! \file AllocTracker.cpp
+ *  \brief Implementierung der Klassen AllocTracker und AllocScope sowie die
+ *  Ersetzungen der globalen operator new und operator delete. Die
+ *  Ersetzungen werden nur mit DFSM_ALLOC_TRACKING uebersetzt, damit sie
+ *  nicht in jedes Programm gelinkt werden (sie verdecken z.B. Meldungen von
+ *  AddressSanitizer zu new/delete-Paaren)
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "AllocTracker.h"
+#include "Log.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+using namespace std;
+
+namespace diag
+{
+
+static const int N_SUBSYSTEMS = static_cast<int>(AllocSubsystem::COUNT); /**< Anzahl der Teilsysteme */
+
+/*! \brief Zaehler eines Teilsystems. Konstant initialisiert, damit sie auch
+ *  bei Anforderungen waehrend der statischen Initialisierung gueltig sind
+ */
+struct AllocCounters
+{
+	atomic<uint64_t> allocations_; /**< Aufrufe von operator new */
+	atomic<uint64_t> bytes_;       /**< Angeforderte Bytes */
+	atomic<uint64_t> frees_;       /**< Aufrufe von operator delete */
+};
+
+static atomic<bool> tracking(false);  /**< Ein AllocTracker zaehlt */
+static AllocCounters counters[N_SUBSYSTEMS]; /**< Zaehler je Teilsystem */
+static thread_local int currentSubsystem = 0; /**< Teilsystem des Threads (AllocScope) */
+
+/*! \brief Zaehlt eine Anforderung, falls gezaehlt wird
+ *  \param a_size Angeforderte Bytes
+ */
+static inline void countAllocation(size_t a_size)
+{
+	if (tracking.load(memory_order_relaxed))
+	{
+		AllocCounters &c = counters[currentSubsystem];
+		c.allocations_.fetch_add(1, memory_order_relaxed);
+		c.bytes_.fetch_add(a_size, memory_order_relaxed);
+	}
+}
+
+/*! \brief Zaehlt eine Freigabe, falls gezaehlt wird
+ *  \param a_pointer Freigegebener Zeiger
+ */
+static inline void countFree(void *a_pointer)
+{
+	if (a_pointer != nullptr && tracking.load(memory_order_relaxed))
+	{
+		counters[currentSubsystem].frees_.fetch_add(1, memory_order_relaxed);
+	}
+}
+
+#ifdef DFSM_ALLOC_TRACKING
+/*! \brief Fordert Speicher an wie der Standard-operator new
+ *  \param a_size Bytes
+ *  \param a_throw Bei Fehler std::bad_alloc werfen, sonst nullptr zurueckgeben
+ *  \return Speicher
+ */
+static void* allocate(size_t a_size, bool a_throw)
+{
+	countAllocation(a_size);
+	if (a_size == 0)
+	{
+		a_size = 1;
+	}
+	for (;;)
+	{
+		void *pointer = malloc(a_size);
+		if (pointer != nullptr)
+		{
+			return pointer;
+		}
+		new_handler handler = get_new_handler();
+		if (handler == nullptr)
+		{
+			if (a_throw)
+			{
+				throw bad_alloc();
+			}
+			return nullptr;
+		}
+		handler();
+	}
+}
+#endif
+
+bool AllocTracker::enabled()
+{
+#ifdef DFSM_ALLOC_TRACKING
+	return true;
+#else
+	return false;
+#endif
+}
+
+AllocTracker::AllocTracker() :
+		active_(false)
+{
+	for (int s = 0; s < N_SUBSYSTEMS; s++)
+	{
+		stats_[s].allocations_ = 0;
+		stats_[s].bytes_ = 0;
+		stats_[s].frees_ = 0;
+	}
+	if (tracking.load())
+	{
+		DFSM_LOG_ERROR("AllocTracker", "Another tracker is already active.");
+		return;
+	}
+	for (int s = 0; s < N_SUBSYSTEMS; s++)
+	{
+		counters[s].allocations_.store(0, memory_order_relaxed);
+		counters[s].bytes_.store(0, memory_order_relaxed);
+		counters[s].frees_.store(0, memory_order_relaxed);
+	}
+	active_ = true;
+	tracking.store(true);
+}
+
+AllocTracker::~AllocTracker()
+{
+	stop();
+}
+
+void AllocTracker::stop()
+{
+	if (!active_)
+	{
+		return;
+	}
+	tracking.store(false);
+	for (int s = 0; s < N_SUBSYSTEMS; s++)
+	{
+		stats_[s].allocations_ = counters[s].allocations_.load();
+		stats_[s].bytes_ = counters[s].bytes_.load();
+		stats_[s].frees_ = counters[s].frees_.load();
+	}
+	active_ = false;
+}
+
+bool AllocTracker::active() const
+{
+	return active_;
+}
+
+AllocStats AllocTracker::subsystem(AllocSubsystem a_subsystem) const
+{
+	int s = static_cast<int>(a_subsystem);
+	if (!active_)
+	{
+		return stats_[s];
+	}
+	AllocStats stats;
+	stats.allocations_ = counters[s].allocations_.load();
+	stats.bytes_ = counters[s].bytes_.load();
+	stats.frees_ = counters[s].frees_.load();
+	return stats;
+}
+
+AllocStats AllocTracker::total() const
+{
+	AllocStats sum = { 0, 0, 0 };
+	for (int s = 0; s < N_SUBSYSTEMS; s++)
+	{
+		AllocStats stats = subsystem(static_cast<AllocSubsystem>(s));
+		sum.allocations_ += stats.allocations_;
+		sum.bytes_ += stats.bytes_;
+		sum.frees_ += stats.frees_;
+	}
+	return sum;
+}
+
+const char* AllocTracker::subsystemName(AllocSubsystem a_subsystem)
+{
+	switch (a_subsystem)
+	{
+	case AllocSubsystem::OTHER:
+		return "other";
+	case AllocSubsystem::TESTBED:
+		return "testbed";
+	case AllocSubsystem::NETWORK:
+		return "network";
+	case AllocSubsystem::GATE:
+		return "gate";
+	case AllocSubsystem::GATE_LOGIC:
+		return "gate logic";
+	case AllocSubsystem::SIGNAL:
+		return "sgnl";
+	case AllocSubsystem::PLOT:
+		return "plot";
+	default:
+		return "?";
+	}
+}
+
+void AllocTracker::report(std::ostream &a_os, long long a_steps) const
+{
+	ios_base::fmtflags flags = a_os.flags();
+	streamsize precision = a_os.precision();
+	a_os << left << setw(16) << "subsystem" << right << setw(14)
+			<< "allocations" << setw(16) << "bytes" << setw(14) << "frees";
+	if (a_steps > 0)
+	{
+		a_os << setw(14) << "allocs/step" << setw(14) << "bytes/step";
+	}
+	a_os << endl << fixed << setprecision(2);
+	for (int s = 0; s <= N_SUBSYSTEMS; s++)
+	{
+		// Letzte Zeile: Summe
+		AllocStats stats = (s < N_SUBSYSTEMS) ?
+				subsystem(static_cast<AllocSubsystem>(s)) : total();
+		if (s < N_SUBSYSTEMS && stats.allocations_ == 0 && stats.frees_ == 0)
+		{
+			continue;
+		}
+		a_os << left << setw(16)
+				<< ((s < N_SUBSYSTEMS) ?
+						subsystemName(static_cast<AllocSubsystem>(s)) : "total")
+				<< right << setw(14) << stats.allocations_ << setw(16)
+				<< stats.bytes_ << setw(14) << stats.frees_;
+		if (a_steps > 0)
+		{
+			a_os << setw(14)
+					<< static_cast<double>(stats.allocations_) / a_steps
+					<< setw(14) << static_cast<double>(stats.bytes_) / a_steps;
+		}
+		a_os << endl;
+	}
+	a_os.flags(flags);
+	a_os.precision(precision);
+}
+
+AllocScope::AllocScope(AllocSubsystem a_subsystem) :
+		previous_(currentSubsystem)
+{
+	currentSubsystem = static_cast<int>(a_subsystem);
+}
+
+AllocScope::~AllocScope()
+{
+	end();
+}
+
+void AllocScope::end()
+{
+	if (previous_ >= 0)
+	{
+		currentSubsystem = previous_;
+		previous_ = -1;
+	}
+}
+
+}
+
+#ifdef DFSM_ALLOC_TRACKING
+///@cond INTERNAL
+void* operator new(std::size_t a_size)
+{
+	return diag::allocate(a_size, true);
+}
+
+void* operator new[](std::size_t a_size)
+{
+	return diag::allocate(a_size, true);
+}
+
+void* operator new(std::size_t a_size, const std::nothrow_t&) noexcept
+{
+	return diag::allocate(a_size, false);
+}
+
+void* operator new[](std::size_t a_size, const std::nothrow_t&) noexcept
+{
+	return diag::allocate(a_size, false);
+}
+
+void operator delete(void *a_pointer) noexcept
+{
+	diag::countFree(a_pointer);
+	std::free(a_pointer);
+}
+
+void operator delete[](void *a_pointer) noexcept
+{
+	diag::countFree(a_pointer);
+	std::free(a_pointer);
+}
+
+void operator delete(void *a_pointer, const std::nothrow_t&) noexcept
+{
+	diag::countFree(a_pointer);
+	std::free(a_pointer);
+}
+
+void operator delete[](void *a_pointer, const std::nothrow_t&) noexcept
+{
+	diag::countFree(a_pointer);
+	std::free(a_pointer);
+}
+///@endcond
+#endif
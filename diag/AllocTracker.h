@@ -0,0 +1,151 @@
+/*! \file AllocTracker.h
+ *  \brief Definition der Klassen AllocTracker und AllocScope (Zaehlen von
+ *  Speicheranforderungen je Teilsystem)
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef DIAG_ALLOCTRACKER_H_
+#define DIAG_ALLOCTRACKER_H_
+
+#include <cstdint>
+#include <iosfwd>
+
+namespace diag
+{
+
+/*! \brief Teilsysteme, denen Speicheranforderungen zugeordnet werden
+ *  (siehe AllocScope)
+ */
+enum class AllocSubsystem
+{
+	OTHER,      /**< Ausserhalb der Simulation */
+	TESTBED,    /**< Testbed::simulationstep(...) ohne Network und Plot */
+	NETWORK,    /**< Network/CompiledNetwork::simulationStep(...) */
+	GATE,       /**< Gate::simulationStep() ohne Logik und sgnl */
+	GATE_LOGIC, /**< GateLogic::outputsFor(...) (nur Network, CompiledNetwork zaehlt unter NETWORK) */
+	SIGNAL,     /**< Umrechnungen und Rauschen aus sgnl */
+	PLOT,       /**< Plotten im Testbed */
+	COUNT       /**< Anzahl der Teilsysteme */
+};
+
+/*! \brief Gezaehlte Speicheranforderungen
+ */
+struct AllocStats
+{
+	std::uint64_t allocations_; /**< Aufrufe von operator new */
+	std::uint64_t bytes_;       /**< Angeforderte Bytes */
+	std::uint64_t frees_;       /**< Aufrufe von operator delete */
+};
+
+/*! \class AllocTracker
+ *  \brief Zaehlt alle Aufrufe der (ersetzten) globalen operator new und
+ *  operator delete zwischen Konstruktor und stop() bzw. Destruktor, in
+ *  allen Threads. Ausserhalb eines AllocTracker kosten die Ersetzungen nur
+ *  eine Abfrage. Es kann nur ein AllocTracker gleichzeitig zaehlen. Die
+ *  Ersetzungen und die Zuordnung zu Teilsystemen (DFSM_ALLOC_SCOPE) werden
+ *  nur mit DFSM_ALLOC_TRACKING uebersetzt, sonst bleiben alle Zaehler 0
+ */
+class AllocTracker
+{
+public:
+	/*! \brief Gibt zurueck, ob operator new/delete ersetzt und die
+	 *  Teilsysteme in Network, CompiledNetwork, Gate, sgnl und Testbed
+	 *  uebersetzt wurden
+	 *  \return true mit DFSM_ALLOC_TRACKING (CMake-Option DFSM_ALLOC_TRACKING)
+	 */
+	static bool enabled();
+
+	/*! \brief Konstruktor. Setzt die Zaehler zurueck und beginnt zu zaehlen
+	 */
+	AllocTracker();
+
+	/*! \brief Destruktor. Beendet das Zaehlen
+	 */
+	~AllocTracker();
+
+	/*! \brief Beendet das Zaehlen, die Ergebnisse bleiben abfragbar
+	 */
+	void stop();
+
+	/*! \brief Gibt zurueck, ob dieser AllocTracker zaehlt (false, wenn
+	 *  bereits ein anderer zaehlte)
+	 *  \return true, falls aktiv
+	 */
+	bool active() const;
+
+	/*! \brief Summe ueber alle Teilsysteme
+	 *  \return Zaehler
+	 */
+	AllocStats total() const;
+
+	/*! \brief Zaehler eines Teilsystems
+	 *  \param a_subsystem Teilsystem
+	 *  \return Zaehler
+	 */
+	AllocStats subsystem(AllocSubsystem a_subsystem) const;
+
+	/*! \brief Gibt den Namen eines Teilsystems zurueck
+	 *  \param a_subsystem Teilsystem
+	 *  \return z.B. "gate logic"
+	 */
+	static const char* subsystemName(AllocSubsystem a_subsystem);
+
+	/*! \brief Schreibt eine Tabelle je Teilsystem
+	 *  \param a_os Ausgabe
+	 *  \param a_steps Anzahl der Simulationsschritte im gezaehlten Zeitraum,
+	 *  > 0: zusaetzlich Anforderungen und Bytes je Schritt
+	 */
+	void report(std::ostream &a_os, long long a_steps = 0) const;
+
+private:
+	AllocTracker(const AllocTracker&);
+	AllocTracker& operator=(const AllocTracker&);
+
+	bool active_;  /**< Dieser AllocTracker zaehlt */
+	AllocStats stats_[static_cast<int>(AllocSubsystem::COUNT)]; /**< Zaehlerstaende bei stop() */
+};
+
+/*! \class AllocScope
+ *  \brief Ordnet alle Speicheranforderungen des aufrufenden Threads bis zum
+ *  Ende des Gueltigkeitsbereichs (oder end()) einem Teilsystem zu.
+ *  Verschachtelbar, danach gilt wieder das vorherige Teilsystem
+ */
+class AllocScope
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_subsystem Teilsystem
+	 */
+	explicit AllocScope(AllocSubsystem a_subsystem);
+
+	/*! \brief Destruktor. Ruft end() auf
+	 */
+	~AllocScope();
+
+	/*! \brief Stellt das vorherige Teilsystem vorzeitig wieder her
+	 */
+	void end();
+
+private:
+	AllocScope(const AllocScope&);
+	AllocScope& operator=(const AllocScope&);
+
+	int previous_;  /**< Vorheriges Teilsystem, -1 = bereits beendet */
+};
+
+}
+
+#ifdef DFSM_ALLOC_TRACKING
+/*! \brief Ordnet Speicheranforderungen bis zum Ende des Blocks a_subsystem zu */
+#define DFSM_ALLOC_SCOPE(a_var, a_subsystem) \
+	diag::AllocScope a_var(a_subsystem)
+/*! \brief Beendet DFSM_ALLOC_SCOPE(a_var, ...) vor dem Ende des Blocks */
+#define DFSM_ALLOC_SCOPE_END(a_var) \
+	a_var.end()
+#else
+#define DFSM_ALLOC_SCOPE(a_var, a_subsystem)
+#define DFSM_ALLOC_SCOPE_END(a_var)
+#endif
+
+#endif /* DIAG_ALLOCTRACKER_H_ */
@@ -0,0 +1,35 @@
+/*! \file Json.cpp
+ *  \brief Implementierung der JSON-Hilfsfunktionen
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "Json.h"
+
+using namespace std;
+
+namespace diag
+{
+
+void writeJsonString(ostream &a_os, const string &a_text)
+{
+	static const char HEX[] = "0123456789abcdef";
+	a_os << '"';
+	for (int c = 0; c < static_cast<int>(a_text.size()); c++)
+	{
+		unsigned char ch = static_cast<unsigned char>(a_text[c]);
+		if (ch < 0x20)
+		{
+			a_os << "\\u00" << HEX[ch >> 4] << HEX[ch & 0x0F];
+			continue;
+		}
+		if (ch == '"' || ch == '\\')
+		{
+			a_os << '\\';
+		}
+		a_os << a_text[c];
+	}
+	a_os << '"';
+}
+
+} // namespace diag
@@ -0,0 +1,26 @@
+/*! \file Json.h
+ *  \brief Hilfsfunktionen fuer die JSON-Ausgaben der Diagnose (Trace-Export,
+ *  Laufbericht)
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef DIAG_JSON_H_
+#define DIAG_JSON_H_
+
+#include <ostream>
+#include <string>
+
+namespace diag
+{
+
+/*! \brief Schreibt eine Zeichenkette als JSON-String in Anfuehrungszeichen:
+ *  " und \\ werden maskiert, Steuerzeichen als \\u00XX geschrieben
+ *  \param a_os Ausgabe
+ *  \param a_text Zeichenkette
+ */
+void writeJsonString(std::ostream &a_os, const std::string &a_text);
+
+} // namespace diag
+
+#endif /* DIAG_JSON_H_ */
@@ -0,0 +1,109 @@
+/*! \file Log.cpp
+ *  \brief Implementierung der Klassen Log, LogSink, ConsoleSink und
+ *  CollectingSink
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "Log.h"
+
+#include <iostream>
+
+using namespace std;
+
+namespace diag
+{
+
+std::atomic<int> Log::level_(static_cast<int>(LogLevel::INFO));
+
+/*! \brief Ziel der Meldungen
+ */
+struct SinkState
+{
+	mutex mutex_;             /**< Schuetzt sink_ und serialisiert die Ausgabe */
+	shared_ptr<LogSink> sink_; /**< Aktuelles Ziel, nullptr = console_ */
+	ConsoleSink console_;     /**< Standardziel */
+};
+
+/*! \brief Gibt das Ziel zurueck. Es wird nie freigegeben, damit auch
+ *  Destruktoren statischer Objekte am Programmende noch Meldungen ausgeben
+ *  koennen
+ *  \return Ziel
+ */
+static SinkState& sinkState()
+{
+	static SinkState *state = new SinkState();
+	return *state;
+}
+
+LogSink::~LogSink()
+{
+
+}
+
+void ConsoleSink::write(const LogRecord &a_record)
+{
+	ostream &os = (a_record.level_ >= LogLevel::WARNING) ? cerr : cout;
+	if (!a_record.component_.empty())
+	{
+		os << a_record.component_ << ": ";
+	}
+	os << a_record.message_ << endl;
+}
+
+void CollectingSink::write(const LogRecord &a_record)
+{
+	lock_guard<mutex> lock(mutex_);
+	records_.push_back(a_record);
+}
+
+std::vector<LogRecord> CollectingSink::records() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return records_;
+}
+
+void CollectingSink::clear()
+{
+	lock_guard<mutex> lock(mutex_);
+	records_.clear();
+}
+
+void Log::setLevel(LogLevel a_level)
+{
+	level_.store(static_cast<int>(a_level));
+}
+
+LogLevel Log::level()
+{
+	return static_cast<LogLevel>(level_.load());
+}
+
+void Log::setSink(std::shared_ptr<LogSink> a_sink)
+{
+	SinkState &state = sinkState();
+	lock_guard<mutex> lock(state.mutex_);
+	state.sink_ = a_sink;
+}
+
+void Log::write(LogLevel a_level, const std::string &a_component,
+		const std::string &a_message)
+{
+	if (!enabled(a_level) || a_level == LogLevel::OFF)
+	{
+		return;
+	}
+	LogRecord record = { a_level, a_component, a_message };
+	SinkState &state = sinkState();
+	lock_guard<mutex> lock(state.mutex_);
+	if (state.sink_)
+	{
+		state.sink_->write(record);
+	}
+	else
+	{
+		state.console_.write(record);
+	}
+}
+
+}
@@ -0,0 +1,158 @@
+/*! \file Log.h
+ *  \brief Definition der Klassen Log, LogSink, ConsoleSink und
+ *  CollectingSink sowie der Makros DFSM_LOG_...: Meldungen der Bibliothek
+ *  mit Stufe und Teilsystem, abschaltbar ohne Formatierungskosten
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef DIAG_LOG_H_
+#define DIAG_LOG_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace diag
+{
+
+/*! \brief Stufe einer Meldung, aufsteigend nach Wichtigkeit
+ */
+enum class LogLevel
+{
+	DEBUG = 0,    /**< Ausfuehrliche Ausgaben, z.B. geladene Netlist */
+	INFO = 1,     /**< Normale Statusmeldungen */
+	WARNING = 2,  /**< Korrigierte oder ignorierte Fehler */
+	ERROR = 3,    /**< Fehler */
+	OFF = 4       /**< Nur fuer Log::setLevel(...): keine Meldungen */
+};
+
+/*! \brief Eine Meldung
+ */
+struct LogRecord
+{
+	LogLevel level_;         /**< Stufe */
+	std::string component_;  /**< Teilsystem, z.B. "Network" */
+	std::string message_;    /**< Text ohne Zeilenende */
+};
+
+/*! \class LogSink
+ *  \brief Ziel der Meldungen. write(...) kann aus mehreren Threads
+ *  aufgerufen werden, Log serialisiert die Aufrufe
+ */
+class LogSink
+{
+public:
+	virtual ~LogSink();
+
+	/*! \brief Nimmt eine Meldung entgegen
+	 *  \param a_record Meldung
+	 */
+	virtual void write(const LogRecord &a_record) = 0;
+};
+
+/*! \class ConsoleSink
+ *  \brief Standardziel: DEBUG und INFO nach std::cout, WARNING und ERROR
+ *  nach std::cerr, jeweils als "<Teilsystem>: <Text>"
+ */
+class ConsoleSink: public LogSink
+{
+public:
+	void write(const LogRecord &a_record);
+};
+
+/*! \class CollectingSink
+ *  \brief Sammelt alle Meldungen, z.B. fuer Tests oder um sie nach einem
+ *  Lauf strukturiert auszuwerten
+ */
+class CollectingSink: public LogSink
+{
+public:
+	void write(const LogRecord &a_record);
+
+	/*! \brief Gibt alle bisher gesammelten Meldungen zurueck
+	 *  \return Meldungen in Reihenfolge des Eintreffens
+	 */
+	std::vector<LogRecord> records() const;
+
+	/*! \brief Verwirft alle gesammelten Meldungen
+	 */
+	void clear();
+
+private:
+	mutable std::mutex mutex_;         /**< Schuetzt records_ */
+	std::vector<LogRecord> records_;   /**< Gesammelte Meldungen */
+};
+
+/*! \class Log
+ *  \brief Prozessweite Einstellungen und Ausgabe der Meldungen. Meldungen
+ *  unterhalb der eingestellten Stufe kosten nur einen Vergleich, ihr Text
+ *  wird nicht formatiert (siehe DFSM_LOG)
+ */
+class Log
+{
+public:
+	/*! \brief Gibt zurueck, ob Meldungen einer Stufe ausgegeben werden
+	 *  \param a_level Stufe
+	 *  \return true, falls a_level >= level()
+	 */
+	static bool enabled(LogLevel a_level)
+	{
+		return static_cast<int>(a_level) >= level_.load(std::memory_order_relaxed);
+	}
+
+	/*! \brief Setzt die niedrigste ausgegebene Stufe (Standard: INFO)
+	 *  \param a_level Stufe, OFF = keine Meldungen
+	 */
+	static void setLevel(LogLevel a_level);
+
+	/*! \brief Gibt die niedrigste ausgegebene Stufe zurueck
+	 *  \return Stufe
+	 */
+	static LogLevel level();
+
+	/*! \brief Setzt das Ziel der Meldungen
+	 *  \param a_sink Ziel, nullptr = ConsoleSink
+	 */
+	static void setSink(std::shared_ptr<LogSink> a_sink);
+
+	/*! \brief Gibt eine Meldung an das Ziel weiter, falls ihre Stufe
+	 *  ausgegeben wird
+	 *  \param a_level Stufe
+	 *  \param a_component Teilsystem
+	 *  \param a_message Text ohne Zeilenende
+	 */
+	static void write(LogLevel a_level, const std::string &a_component,
+			const std::string &a_message);
+
+private:
+	static std::atomic<int> level_;  /**< Niedrigste ausgegebene Stufe */
+};
+
+}
+
+/*! \brief Gibt eine Meldung aus. Der Text wird wie bei einem ostream
+ *  zusammengesetzt (DFSM_LOG(INFO, "Network", "Gates: " << n)) und nur
+ *  formatiert, wenn die Stufe ausgegeben wird
+ */
+#define DFSM_LOG(level, component, text) \
+	do \
+	{ \
+		if (diag::Log::enabled(diag::LogLevel::level)) \
+		{ \
+			std::ostringstream dfsmLogText_; \
+			dfsmLogText_ << text; \
+			diag::Log::write(diag::LogLevel::level, component, \
+					dfsmLogText_.str()); \
+		} \
+	} while (false)
+
+#define DFSM_LOG_DEBUG(component, text) DFSM_LOG(DEBUG, component, text)      /**< Meldung der Stufe DEBUG */
+#define DFSM_LOG_INFO(component, text) DFSM_LOG(INFO, component, text)        /**< Meldung der Stufe INFO */
+#define DFSM_LOG_WARNING(component, text) DFSM_LOG(WARNING, component, text)  /**< Meldung der Stufe WARNING */
+#define DFSM_LOG_ERROR(component, text) DFSM_LOG(ERROR, component, text)      /**< Meldung der Stufe ERROR */
+
+#endif /* DIAG_LOG_H_ */
@@ -0,0 +1,501 @@
+/*! \file Profiler.cpp
+ *  \brief Implementierung der Klasse Profiler
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "Profiler.h"
+
+#include "../gate/GateLogic.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+
+using namespace std;
+
+namespace diag
+{
+
+static const int N_PHASES = static_cast<int>(Phase::COUNT); /**< Anzahl der Phasen */
+static const int MAX_LOGICS = 64; /**< GateLogics je Thread, weitere werden unter "(other)" gezaehlt */
+
+/*! \brief Zaehler, der nur von seinem Thread geschrieben, aber von anderen
+ *  gelesen wird. Relaxed load/store kosten auf x86 nicht mehr als ein
+ *  normaler Zugriff
+ */
+struct Counter
+{
+	atomic<uint64_t> value_; /**< Zaehlerstand */
+
+	Counter() :
+			value_(0)
+	{
+	}
+
+	void add(uint64_t a_n)
+	{
+		value_.store(value_.load(memory_order_relaxed) + a_n,
+				memory_order_relaxed);
+	}
+
+	uint64_t get() const
+	{
+		return value_.load(memory_order_relaxed);
+	}
+};
+
+/*! \brief Zaehler einer GateLogic in einem Thread
+ */
+struct LogicSlot
+{
+	const GateLogic *pLogic_; /**< GateLogic, nullptr = "(other)" */
+	string name_;             /**< Name, beim Anlegen kopiert */
+	Counter ticks_;           /**< Dauer in Ticks */
+	Counter evaluations_;     /**< Aufrufe */
+};
+
+/*! \brief Alle Zaehler eines Threads
+ */
+struct ThreadCounters
+{
+	Counter ticks_[N_PHASES];       /**< Ticks je Phase */
+	Counter calls_[N_PHASES];       /**< Messungen je Phase */
+	Counter events_[N_PHASES];      /**< Elemente je Phase */
+	LogicSlot logics_[MAX_LOGICS];  /**< Zaehler je GateLogic */
+	atomic<int> nLogics_;           /**< Anzahl belegter logics_ */
+	int lastLogic_;                 /**< Index der zuletzt gesuchten GateLogic */
+
+	ThreadCounters() :
+			nLogics_(0), lastLogic_(0)
+	{
+	}
+};
+
+/*! \brief Alle Threads mit Zaehlern und die Summe der beendeten Threads
+ */
+struct Registry
+{
+	mutex mutex_;                   /**< Schuetzt threads_ und finished_ */
+	vector<ThreadCounters*> threads_; /**< Zaehler der laufenden Threads */
+	ThreadCounters finished_;       /**< Summe der beendeten Threads */
+};
+
+/*! \brief Gibt die Registry zurueck. Sie wird nie freigegeben, damit
+ *  Threads und der Bericht am Programmende sie in beliebiger Reihenfolge
+ *  verwenden koennen
+ *  \return Registry
+ */
+static Registry& registry()
+{
+	static Registry *registry = new Registry();
+	return *registry;
+}
+
+/*! \brief Addiert die Zaehler a_from zu a_to
+ *  \param a_to Ziel
+ *  \param a_from Quelle
+ */
+static void addCounters(ThreadCounters &a_to, const ThreadCounters &a_from);
+
+/*! \brief Meldet die Zaehler eines Threads bei der Registry an und beim
+ *  Ende des Threads wieder ab
+ */
+class ThreadSlot
+{
+public:
+	ThreadSlot()
+	{
+		Registry &reg = registry();
+		lock_guard<mutex> lock(reg.mutex_);
+		reg.threads_.push_back(&counters_);
+	}
+
+	~ThreadSlot()
+	{
+		Registry &reg = registry();
+		lock_guard<mutex> lock(reg.mutex_);
+		addCounters(reg.finished_, counters_);
+		reg.threads_.erase(
+				find(reg.threads_.begin(), reg.threads_.end(), &counters_));
+	}
+
+	ThreadCounters counters_; /**< Zaehler des Threads */
+};
+
+/*! \brief Gibt die Zaehler des aufrufenden Threads zurueck
+ *  \return Zaehler
+ */
+static ThreadCounters& local()
+{
+	static thread_local ThreadSlot slot;
+	return slot.counters_;
+}
+
+/*! \brief Sucht oder belegt den Zaehler einer GateLogic
+ *  \param a_counters Zaehler des Threads
+ *  \param a_pLogic GateLogic (nullptr = "(other)")
+ *  \param a_name Name der GateLogic
+ *  \return Zaehler, bei vollem Array der "(other)"-Zaehler
+ */
+static LogicSlot& logicSlot(ThreadCounters &a_counters,
+		const GateLogic *a_pLogic, const string &a_name)
+{
+	int n = a_counters.nLogics_.load(memory_order_relaxed);
+	for (int i = 0; i < n; i++)
+	{
+		if (a_counters.logics_[i].pLogic_ == a_pLogic)
+		{
+			return a_counters.logics_[i];
+		}
+	}
+	// Der letzte Slot bleibt fuer "(other)" reserviert
+	if (n >= MAX_LOGICS - 1 && a_pLogic != nullptr)
+	{
+		return logicSlot(a_counters, nullptr, "(other)");
+	}
+	a_counters.logics_[n].pLogic_ = a_pLogic;
+	a_counters.logics_[n].name_ = a_name;
+	// Erst nach dem Namen freigeben, damit Leser nur fertige Slots sehen
+	a_counters.nLogics_.store(n + 1, memory_order_release);
+	return a_counters.logics_[n];
+}
+
+static void addCounters(ThreadCounters &a_to, const ThreadCounters &a_from)
+{
+	for (int p = 0; p < N_PHASES; p++)
+	{
+		a_to.ticks_[p].add(a_from.ticks_[p].get());
+		a_to.calls_[p].add(a_from.calls_[p].get());
+		a_to.events_[p].add(a_from.events_[p].get());
+	}
+	int n = a_from.nLogics_.load(memory_order_acquire);
+	for (int i = 0; i < n; i++)
+	{
+		const LogicSlot &from = a_from.logics_[i];
+		LogicSlot &to = logicSlot(a_to, from.pLogic_, from.name_);
+		to.ticks_.add(from.ticks_.get());
+		to.evaluations_.add(from.evaluations_.get());
+	}
+}
+
+/*! \brief Setzt alle Zaehler auf 0
+ *  \param a_counters Zaehler
+ */
+static void clearCounters(ThreadCounters &a_counters)
+{
+	for (int p = 0; p < N_PHASES; p++)
+	{
+		a_counters.ticks_[p].value_.store(0, memory_order_relaxed);
+		a_counters.calls_[p].value_.store(0, memory_order_relaxed);
+		a_counters.events_[p].value_.store(0, memory_order_relaxed);
+	}
+	int n = a_counters.nLogics_.load(memory_order_acquire);
+	for (int i = 0; i < n; i++)
+	{
+		a_counters.logics_[i].ticks_.value_.store(0, memory_order_relaxed);
+		a_counters.logics_[i].evaluations_.value_.store(0,
+				memory_order_relaxed);
+	}
+}
+
+/*! \brief Summiert die Zaehler aller Threads
+ *  \param a_sum Ziel (muss 0 sein)
+ */
+static void sumCounters(ThreadCounters &a_sum)
+{
+	Registry &reg = registry();
+	lock_guard<mutex> lock(reg.mutex_);
+	addCounters(a_sum, reg.finished_);
+	for (int t = 0; t < static_cast<int>(reg.threads_.size()); t++)
+	{
+		addCounters(a_sum, *reg.threads_[t]);
+	}
+}
+
+/*! \brief Gibt die Phase zurueck, in der eine Phase enthalten ist
+ *  \param a_phase Phase
+ *  \return Uebergeordnete Phase, Phase::COUNT = keine
+ */
+static Phase parentPhase(Phase a_phase)
+{
+	switch (a_phase)
+	{
+	case Phase::NETWORK_INPUTS:
+	case Phase::NETWORK_PROPAGATION:
+	case Phase::NETWORK_GATES:
+		return Phase::TESTBED_NETWORK;
+	case Phase::GATE_LOGIC:
+	case Phase::GATE_NOISE:
+		return Phase::NETWORK_GATES;
+	default:
+		return Phase::COUNT;
+	}
+}
+
+bool Profiler::enabled()
+{
+#ifdef DFSM_PROFILING
+	return true;
+#else
+	return false;
+#endif
+}
+
+double Profiler::ticksPerSecond()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	static const double perSecond = []()
+	{
+		// Den TSC 20 ms lang gegen die steady_clock messen
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		uint64_t ticks0 = ticks();
+		chrono::steady_clock::time_point t1 = t0;
+		while (t1 - t0 < chrono::milliseconds(20))
+		{
+			t1 = chrono::steady_clock::now();
+		}
+		uint64_t ticks1 = ticks();
+		return (ticks1 - ticks0) / chrono::duration<double>(t1 - t0).count();
+	}();
+	return perSecond;
+#else
+	return 1e9;
+#endif
+}
+
+void Profiler::record(Phase a_phase, std::uint64_t a_ticks,
+		std::uint64_t a_events)
+{
+	ThreadCounters &counters = local();
+	int p = static_cast<int>(a_phase);
+	counters.ticks_[p].add(a_ticks);
+	counters.calls_[p].add(1);
+	counters.events_[p].add(a_events);
+}
+
+void Profiler::recordLogic(const GateLogic *a_pLogic, std::uint64_t a_ticks)
+{
+	ThreadCounters &counters = local();
+	int p = static_cast<int>(Phase::GATE_LOGIC);
+	counters.ticks_[p].add(a_ticks);
+	counters.calls_[p].add(1);
+	counters.events_[p].add(1);
+
+	// Die meisten Networks wechseln nur zwischen wenigen GateLogics
+	int i = counters.lastLogic_;
+	if (i >= counters.nLogics_.load(memory_order_relaxed)
+			|| counters.logics_[i].pLogic_ != a_pLogic)
+	{
+		LogicSlot &slot = logicSlot(counters, a_pLogic, a_pLogic->name());
+		i = static_cast<int>(&slot - counters.logics_);
+		counters.lastLogic_ = i;
+	}
+	counters.logics_[i].ticks_.add(a_ticks);
+	counters.logics_[i].evaluations_.add(1);
+}
+
+void Profiler::reset()
+{
+	Registry &reg = registry();
+	lock_guard<mutex> lock(reg.mutex_);
+	clearCounters(reg.finished_);
+	for (int t = 0; t < static_cast<int>(reg.threads_.size()); t++)
+	{
+		clearCounters(*reg.threads_[t]);
+	}
+}
+
+PhaseStats Profiler::phase(Phase a_phase)
+{
+	ThreadCounters sum;
+	sumCounters(sum);
+	int p = static_cast<int>(a_phase);
+	PhaseStats stats;
+	stats.ticks_ = sum.ticks_[p].get();
+	stats.calls_ = sum.calls_[p].get();
+	stats.events_ = sum.events_[p].get();
+	return stats;
+}
+
+PhaseStats Profiler::threadPhase(Phase a_phase)
+{
+	const ThreadCounters &counters = local();
+	int p = static_cast<int>(a_phase);
+	PhaseStats stats;
+	stats.ticks_ = counters.ticks_[p].get();
+	stats.calls_ = counters.calls_[p].get();
+	stats.events_ = counters.events_[p].get();
+	return stats;
+}
+
+std::vector<LogicStats> Profiler::logics()
+{
+	ThreadCounters sum;
+	sumCounters(sum);
+
+	// Gleichnamige GateLogics (z.B. Kopien) zusammenfassen
+	map<string, LogicStats> byName;
+	int n = sum.nLogics_.load(memory_order_relaxed);
+	for (int i = 0; i < n; i++)
+	{
+		LogicStats &stats = byName[sum.logics_[i].name_];
+		stats.name_ = sum.logics_[i].name_;
+		stats.ticks_ += sum.logics_[i].ticks_.get();
+		stats.evaluations_ += sum.logics_[i].evaluations_.get();
+	}
+	vector<LogicStats> ret;
+	for (map<string, LogicStats>::const_iterator it = byName.begin();
+			it != byName.end(); it++)
+	{
+		if (it->second.evaluations_ > 0)
+		{
+			ret.push_back(it->second);
+		}
+	}
+	stable_sort(ret.begin(), ret.end(),
+			[](const LogicStats &a_a, const LogicStats &a_b)
+			{
+				return a_a.ticks_ > a_b.ticks_;
+			});
+	return ret;
+}
+
+const char* Profiler::phaseName(Phase a_phase)
+{
+	switch (a_phase)
+	{
+	case Phase::TESTBED_OUTPUTS:
+		return "testbed: output sampling";
+	case Phase::TESTBED_SOURCES:
+		return "testbed: sources";
+	case Phase::TESTBED_RECORDING:
+		return "testbed: recording";
+	case Phase::TESTBED_MONITORS:
+		return "testbed: monitors";
+	case Phase::TESTBED_NETWORK:
+		return "testbed: network step";
+	case Phase::NETWORK_INPUTS:
+		return "network: input application";
+	case Phase::NETWORK_PROPAGATION:
+		return "network: propagation";
+	case Phase::NETWORK_GATES:
+		return "network: gate evaluation";
+	case Phase::GATE_LOGIC:
+		return "gate: logic";
+	case Phase::GATE_NOISE:
+		return "gate: noise";
+	case Phase::TESTBED_PLOTTING:
+		return "testbed: plotting";
+	default:
+		return "?";
+	}
+}
+
+void Profiler::report(std::ostream &a_os)
+{
+	if (!enabled())
+	{
+		a_os << "Profiling disabled (build with -DDFSM_PROFILING=ON)." << endl;
+		return;
+	}
+	ThreadCounters sum;
+	sumCounters(sum);
+	const double msPerTick = 1e3 / ticksPerSecond();
+
+	// Prozente beziehen sich auf die Summe der aeussersten gemessenen Phasen
+	uint64_t total = 0;
+	for (int p = 0; p < N_PHASES; p++)
+	{
+		Phase parent = parentPhase(static_cast<Phase>(p));
+		bool outermost = parent == Phase::COUNT
+				|| sum.calls_[static_cast<int>(parent)].get() == 0;
+		if (outermost && sum.calls_[p].get() > 0)
+		{
+			total += sum.ticks_[p].get();
+		}
+	}
+
+	ios_base::fmtflags flags = a_os.flags();
+	streamsize precision = a_os.precision();
+	a_os << fixed << "Profile (" << setprecision(0) << ticksPerSecond()
+			<< " ticks/s)" << endl;
+	a_os << left << setw(32) << "phase" << right << setw(12) << "calls"
+			<< setw(14) << "events" << setw(12) << "ms" << setw(8) << "%"
+			<< setw(14) << "ticks/event" << endl;
+	for (int p = 0; p < N_PHASES; p++)
+	{
+		Phase phase = static_cast<Phase>(p);
+		uint64_t calls = sum.calls_[p].get();
+		if (calls == 0)
+		{
+			continue;
+		}
+		uint64_t ticks = sum.ticks_[p].get();
+		uint64_t events = sum.events_[p].get();
+		string indent;
+		for (Phase parent = parentPhase(phase); parent != Phase::COUNT;
+				parent = parentPhase(parent))
+		{
+			if (sum.calls_[static_cast<int>(parent)].get() > 0)
+			{
+				indent += "  ";
+			}
+		}
+		a_os << left << setw(32) << indent + phaseName(phase) << right
+				<< setw(12) << calls << setw(14) << events << setw(12)
+				<< setprecision(2) << ticks * msPerTick << setw(8)
+				<< setprecision(1) << (total > 0 ? 100.0 * ticks / total : 0.0)
+				<< setw(14) << setprecision(1)
+				<< (events > 0 ? static_cast<double>(ticks) / events : 0.0)
+				<< endl;
+	}
+
+	vector<LogicStats> logicStats = logics();
+	if (!logicStats.empty())
+	{
+		a_os << left << setw(32) << "logic" << right << setw(12) << ""
+				<< setw(14) << "evaluations" << setw(12) << "ms" << setw(8)
+				<< "" << setw(14) << "ticks/eval" << endl;
+		for (int i = 0; i < static_cast<int>(logicStats.size()); i++)
+		{
+			const LogicStats &stats = logicStats[i];
+			a_os << left << setw(32) << stats.name_ << right << setw(12) << ""
+					<< setw(14) << stats.evaluations_ << setw(12)
+					<< setprecision(2) << stats.ticks_ * msPerTick << setw(8)
+					<< "" << setw(14) << setprecision(1)
+					<< static_cast<double>(stats.ticks_) / stats.evaluations_
+					<< endl;
+		}
+	}
+	a_os.flags(flags);
+	a_os.precision(precision);
+}
+
+#ifdef DFSM_PROFILING
+/*! \brief Schreibt am Programmende den Bericht nach std::cerr, falls etwas
+ *  gemessen wurde
+ */
+static struct ExitReport
+{
+	~ExitReport()
+	{
+		ThreadCounters sum;
+		sumCounters(sum);
+		for (int p = 0; p < N_PHASES; p++)
+		{
+			if (sum.calls_[p].get() > 0)
+			{
+				Profiler::report(cerr);
+				return;
+			}
+		}
+	}
+} exitReport;
+#endif
+
+}
@@ -0,0 +1,170 @@
+/*! \file Profiler.h
+ *  \brief Definition der Klasse Profiler (Laufzeitzaehler je Simulationsphase)
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef DIAG_PROFILER_H_
+#define DIAG_PROFILER_H_
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+class GateLogic;
+
+/*! \namespace diag
+ *  \brief Diagnose: Profiling, Logging und Tracing des Simulators
+ */
+namespace diag
+{
+
+/*! \brief Phasen eines Simulationsschritts. Eingerueckte Phasen sind in der
+ *  darueberliegenden enthalten
+ */
+enum class Phase
+{
+	TESTBED_OUTPUTS,     /**< Testbed: Outputs abtasten, Flanken zaehlen */
+	TESTBED_SOURCES,     /**< Testbed: Quellenbloecke erzeugen */
+	TESTBED_RECORDING,   /**< Testbed: Input- und Outputverlauf aufzeichnen */
+	TESTBED_MONITORS,    /**< Testbed: Monitore pruefen */
+	TESTBED_NETWORK,     /**< Testbed: Simulationsschritt des Networks */
+	NETWORK_INPUTS,      /**<   Network: Inputspannungen an die Gates legen */
+	NETWORK_PROPAGATION, /**<   Network: Gate-Outputs an Gate-Inputs weiterschalten */
+	NETWORK_GATES,       /**<   Network: Simulationsschritt aller Gates */
+	GATE_LOGIC,          /**<     Gate: GateLogic::outputsFor(...) */
+	GATE_NOISE,          /**<     Gate: Rauschen auf die Outputs addieren */
+	TESTBED_PLOTTING,    /**< Testbed: Plot nach dem Simulationsschritt */
+	COUNT                /**< Anzahl der Phasen */
+};
+
+/*! \brief Aufsummierte Zaehler einer Phase
+ */
+struct PhaseStats
+{
+	std::uint64_t ticks_;  /**< Dauer in Ticks (siehe Profiler::ticks()) */
+	std::uint64_t calls_;  /**< Anzahl der Messungen */
+	std::uint64_t events_; /**< Anzahl der bearbeiteten Elemente (Pins, Gates, Samples) */
+};
+
+/*! \brief Aufsummierte Zaehler einer GateLogic
+ */
+struct LogicStats
+{
+	std::string name_;          /**< GateLogic::name() */
+	std::uint64_t ticks_;       /**< Dauer von outputsFor(...) in Ticks */
+	std::uint64_t evaluations_; /**< Anzahl der Aufrufe von outputsFor(...) */
+};
+
+/*! \class Profiler
+ *  \brief Zaehlt Ticks und Ereignisse je Phase und je GateLogic. Jeder
+ *  Thread zaehlt in eigene Zaehler, die Abfragen summieren ueber alle
+ *  Threads. Die Messpunkte in Network, CompiledNetwork, Gate und Testbed
+ *  werden nur mit -DDFSM_PROFILING (CMake-Option DFSM_PROFILING) uebersetzt,
+ *  sonst kosten sie nichts und alle Zaehler bleiben 0. In Profiling-Builds
+ *  wird am Programmende ein Bericht nach std::cerr geschrieben
+ */
+class Profiler
+{
+public:
+	/*! \brief Gibt zurueck, ob die Messpunkte uebersetzt wurden
+	 *  \return true mit DFSM_PROFILING
+	 */
+	static bool enabled();
+
+	/*! \brief Aktueller Zaehlerstand der Zeitbasis (x86: Time Stamp Counter,
+	 *  sonst Nanosekunden)
+	 *  \return Ticks
+	 */
+	static std::uint64_t ticks()
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	/*! \brief Ticks pro Sekunde (wird beim ersten Aufruf einmalig gemessen)
+	 *  \return Ticks / s
+	 */
+	static double ticksPerSecond();
+
+	/*! \brief Addiert eine Messung zu einer Phase
+	 *  \param a_phase Phase
+	 *  \param a_ticks Dauer in Ticks
+	 *  \param a_events Anzahl der bearbeiteten Elemente
+	 */
+	static void record(Phase a_phase, std::uint64_t a_ticks,
+			std::uint64_t a_events);
+
+	/*! \brief Addiert einen Aufruf von outputsFor(...) zu einer GateLogic
+	 *  und zur Phase GATE_LOGIC
+	 *  \param a_pLogic GateLogic
+	 *  \param a_ticks Dauer in Ticks
+	 */
+	static void recordLogic(const GateLogic *a_pLogic, std::uint64_t a_ticks);
+
+	/*! \brief Setzt alle Zaehler aller Threads auf 0. Darf nicht waehrend
+	 *  einer Simulation aufgerufen werden
+	 */
+	static void reset();
+
+	/*! \brief Gibt die Zaehler einer Phase zurueck
+	 *  \param a_phase Phase
+	 *  \return Summe ueber alle Threads
+	 */
+	static PhaseStats phase(Phase a_phase);
+
+	/*! \brief Gibt die Zaehler einer Phase nur des aufrufenden Threads
+	 *  zurueck, z.B. um die Differenz vor und nach einem Aufruf zu bilden
+	 *  \param a_phase Phase
+	 *  \return Zaehler des aufrufenden Threads seit seinem Start bzw. reset()
+	 */
+	static PhaseStats threadPhase(Phase a_phase);
+
+	/*! \brief Gibt die Zaehler je GateLogic zurueck
+	 *  \return Summe ueber alle Threads, nach Ticks absteigend sortiert
+	 */
+	static std::vector<LogicStats> logics();
+
+	/*! \brief Gibt den Namen einer Phase zurueck
+	 *  \param a_phase Phase
+	 *  \return z.B. "network: propagation"
+	 */
+	static const char* phaseName(Phase a_phase);
+
+	/*! \brief Schreibt eine Tabelle aller Phasen und GateLogics
+	 *  \param a_os Ausgabe
+	 */
+	static void report(std::ostream &a_os);
+};
+
+}
+
+#ifdef DFSM_PROFILING
+/*! \brief Merkt sich den aktuellen Tick-Zaehlerstand in a_var */
+#define DFSM_PROFILE_TICKS(a_var) \
+	const std::uint64_t a_var = diag::Profiler::ticks()
+/*! \brief Addiert die Zeit seit DFSM_PROFILE_TICKS(a_start) zu einer Phase */
+#define DFSM_PROFILE_RECORD(a_phase, a_start, a_events) \
+	diag::Profiler::record(a_phase, diag::Profiler::ticks() - (a_start), \
+			(a_events))
+/*! \brief Addiert die Zeit seit DFSM_PROFILE_TICKS(a_start) zu einer GateLogic */
+#define DFSM_PROFILE_LOGIC(a_pLogic, a_start) \
+	diag::Profiler::recordLogic(a_pLogic, diag::Profiler::ticks() - (a_start))
+#else
+#define DFSM_PROFILE_TICKS(a_var)
+#define DFSM_PROFILE_RECORD(a_phase, a_start, a_events)
+#define DFSM_PROFILE_LOGIC(a_pLogic, a_start)
+#endif
+
+#endif /* DIAG_PROFILER_H_ */
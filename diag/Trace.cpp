@@ -0,0 +1,335 @@
+/*! \file Trace.cpp
+ *  \brief Implementierung der Klasse Tracer
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "Trace.h"
+#include "Json.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+namespace diag
+{
+
+std::atomic<bool> Tracer::active_(false);
+
+/*! \brief Ringpuffer eines Threads. Nur der eigene Thread schreibt, head_
+ *  wird erst nach dem Eintrag freigegeben
+ */
+struct ThreadBuffer
+{
+	vector<TraceEvent> events_;    /**< Eintraege, Groesse ist eine Zweierpotenz */
+	atomic<uint64_t> head_;        /**< Anzahl aller bisher geschriebenen Eintraege */
+	int id_;                       /**< Thread-Nummer im Export */
+	string name_;                  /**< Thread-Name im Export */
+	bool finished_;                /**< Thread ist beendet */
+
+	ThreadBuffer() :
+			head_(0), id_(0), finished_(false)
+	{
+	}
+};
+
+/*! \brief Alle Puffer und die Einstellungen der Aufzeichnung
+ */
+struct TraceRegistry
+{
+	mutex mutex_;                     /**< Schuetzt alle Felder */
+	vector<ThreadBuffer*> buffers_;   /**< Puffer laufender und beendeter Threads */
+	size_t capacity_;                 /**< Eintraege je neuem Puffer */
+	uint64_t origin_;                 /**< Ticks bei start() */
+	int nextId_;                      /**< Naechste Thread-Nummer */
+
+	TraceRegistry() :
+			capacity_(Tracer::DEFAULT_CAPACITY), origin_(0), nextId_(1)
+	{
+	}
+};
+
+/*! \brief Gibt die Registry zurueck. Sie wird nie freigegeben, damit
+ *  Threads und der Export am Programmende sie in beliebiger Reihenfolge
+ *  verwenden koennen
+ *  \return Registry
+ */
+static TraceRegistry& registry()
+{
+	static TraceRegistry *registry = new TraceRegistry();
+	return *registry;
+}
+
+/*! \brief Puffer und Name eines Threads. Der Puffer wird erst bei der
+ *  ersten Zeitspanne angelegt und bei der Registry angemeldet, beim Ende des
+ *  Threads bleibt er fuer den Export erhalten
+ */
+class TraceThreadSlot
+{
+public:
+	TraceThreadSlot() :
+			pBuffer_(nullptr)
+	{
+	}
+
+	~TraceThreadSlot()
+	{
+		if (pBuffer_ != nullptr)
+		{
+			TraceRegistry &reg = registry();
+			lock_guard<mutex> lock(reg.mutex_);
+			pBuffer_->finished_ = true;
+		}
+	}
+
+	/*! \brief Legt den Puffer an und meldet ihn bei der Registry an
+	 */
+	void attach()
+	{
+		ThreadBuffer *pBuffer = new ThreadBuffer();
+		TraceRegistry &reg = registry();
+		lock_guard<mutex> lock(reg.mutex_);
+		pBuffer->events_.resize(reg.capacity_);
+		pBuffer->id_ = reg.nextId_++;
+		pBuffer->name_ = name_;
+		reg.buffers_.push_back(pBuffer);
+		pBuffer_ = pBuffer;
+	}
+
+	ThreadBuffer *pBuffer_; /**< Puffer des Threads, gehoert der Registry, nullptr = noch keiner */
+	string name_;           /**< Name fuer einen spaeter angelegten Puffer */
+};
+
+/*! \brief Puffer und Name des aufrufenden Threads */
+static thread_local TraceThreadSlot slot;
+
+/*! \brief Gibt den Puffer des aufrufenden Threads zurueck
+ *  \return Puffer
+ */
+static ThreadBuffer& local()
+{
+	if (slot.pBuffer_ == nullptr)
+	{
+		slot.attach();
+	}
+	return *slot.pBuffer_;
+}
+
+/*! \brief Verwirft die Puffer beendeter Threads und leert die uebrigen.
+ *  Die Sperre der Registry muss gehalten werden
+ *  \param a_reg Registry
+ */
+static void clearBuffers(TraceRegistry &a_reg)
+{
+	vector<ThreadBuffer*> running;
+	for (int b = 0; b < static_cast<int>(a_reg.buffers_.size()); b++)
+	{
+		ThreadBuffer *pBuffer = a_reg.buffers_[b];
+		if (pBuffer->finished_)
+		{
+			delete pBuffer;
+			continue;
+		}
+		if (pBuffer->events_.size() != a_reg.capacity_)
+		{
+			vector<TraceEvent>(a_reg.capacity_).swap(pBuffer->events_);
+		}
+		pBuffer->head_.store(0, memory_order_relaxed);
+		running.push_back(pBuffer);
+	}
+	a_reg.buffers_.swap(running);
+}
+
+bool Tracer::enabled()
+{
+#ifdef DFSM_TRACING
+	return true;
+#else
+	return false;
+#endif
+}
+
+void Tracer::start(std::size_t a_capacity)
+{
+	size_t capacity = 1;
+	while (capacity < a_capacity)
+	{
+		capacity <<= 1;
+	}
+	// Einmal vorab messen, damit es nicht waehrend der Aufzeichnung passiert
+	Profiler::ticksPerSecond();
+	TraceRegistry &reg = registry();
+	{
+		lock_guard<mutex> lock(reg.mutex_);
+		reg.capacity_ = capacity;
+		clearBuffers(reg);
+		reg.origin_ = Profiler::ticks();
+	}
+	active_.store(true);
+}
+
+void Tracer::stop()
+{
+	active_.store(false);
+}
+
+void Tracer::clear()
+{
+	TraceRegistry &reg = registry();
+	lock_guard<mutex> lock(reg.mutex_);
+	clearBuffers(reg);
+}
+
+void Tracer::record(const TraceEvent &a_event)
+{
+	ThreadBuffer &buffer = local();
+	uint64_t head = buffer.head_.load(memory_order_relaxed);
+	buffer.events_[head & (buffer.events_.size() - 1)] = a_event;
+	buffer.head_.store(head + 1, memory_order_release);
+}
+
+void Tracer::setThreadName(const std::string &a_name)
+{
+	slot.name_ = a_name;
+	if (slot.pBuffer_ != nullptr)
+	{
+		lock_guard<mutex> lock(registry().mutex_);
+		slot.pBuffer_->name_ = a_name;
+	}
+}
+
+std::size_t Tracer::eventCount()
+{
+	TraceRegistry &reg = registry();
+	lock_guard<mutex> lock(reg.mutex_);
+	size_t count = 0;
+	for (int b = 0; b < static_cast<int>(reg.buffers_.size()); b++)
+	{
+		uint64_t head = reg.buffers_[b]->head_.load(memory_order_acquire);
+		count += min<uint64_t>(head, reg.buffers_[b]->events_.size());
+	}
+	return count;
+}
+
+std::size_t Tracer::droppedCount()
+{
+	TraceRegistry &reg = registry();
+	lock_guard<mutex> lock(reg.mutex_);
+	size_t count = 0;
+	for (int b = 0; b < static_cast<int>(reg.buffers_.size()); b++)
+	{
+		uint64_t head = reg.buffers_[b]->head_.load(memory_order_acquire);
+		uint64_t size = reg.buffers_[b]->events_.size();
+		count += (head > size) ? head - size : 0;
+	}
+	return count;
+}
+
+void Tracer::write(std::ostream &a_os)
+{
+	const double usPerTick = 1e6 / Profiler::ticksPerSecond();
+	TraceRegistry &reg = registry();
+	lock_guard<mutex> lock(reg.mutex_);
+	ios_base::fmtflags flags = a_os.flags();
+	streamsize precision = a_os.precision();
+	a_os << fixed << setprecision(3);
+	a_os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+	bool first = true;
+	for (int b = 0; b < static_cast<int>(reg.buffers_.size()); b++)
+	{
+		const ThreadBuffer &buffer = *reg.buffers_[b];
+		uint64_t head = buffer.head_.load(memory_order_acquire);
+		uint64_t size = buffer.events_.size();
+		if (head == 0)
+		{
+			continue;
+		}
+		a_os << (first ? "\n" : ",\n")
+				<< "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+				<< buffer.id_ << ", \"args\": {\"name\": ";
+		writeJsonString(a_os, buffer.name_.empty() ?
+				"thread " + to_string(buffer.id_) : buffer.name_);
+		a_os << "}}";
+		first = false;
+		for (uint64_t e = (head > size) ? head - size : 0; e < head; e++)
+		{
+			const TraceEvent &event = buffer.events_[e & (size - 1)];
+			// Zeitspannen vor start() (Rest einer frueheren Aufzeichnung) auslassen
+			if (event.begin_ < reg.origin_)
+			{
+				continue;
+			}
+			a_os << ",\n{\"name\": ";
+			writeJsonString(a_os, event.name_ != nullptr ? event.name_ :
+					Profiler::phaseName(static_cast<Phase>(event.phase_)));
+			a_os << ", \"cat\": ";
+			writeJsonString(a_os, event.category_);
+			a_os << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer.id_
+					<< ", \"ts\": " << (event.begin_ - reg.origin_) * usPerTick
+					<< ", \"dur\": " << (event.end_ - event.begin_) * usPerTick
+					<< "}";
+		}
+	}
+	a_os << "\n]}\n";
+	a_os.flags(flags);
+	a_os.precision(precision);
+}
+
+bool Tracer::save(const std::string &a_fileName)
+{
+	ofstream file(a_fileName.c_str());
+	if (!file.is_open())
+	{
+		DFSM_LOG_ERROR("Tracer", "Cannot open trace file \"" << a_fileName << "\".");
+		return false;
+	}
+	write(file);
+	if (!file.good())
+	{
+		return false;
+	}
+	DFSM_LOG_INFO("Tracer", "Trace saved to \"" << a_fileName << "\" ("
+			<< eventCount() << " events, " << droppedCount() << " dropped).");
+	return true;
+}
+
+/*! \brief Zeichnet ab Programmstart auf, falls DFSM_TRACE gesetzt ist, und
+ *  speichert am Programmende in die angegebene Datei
+ */
+class EnvironmentTrace
+{
+public:
+	EnvironmentTrace()
+	{
+		const char *fileName = getenv("DFSM_TRACE");
+		if (fileName != nullptr && fileName[0] != '\0')
+		{
+			fileName_ = fileName;
+			Tracer::start();
+		}
+	}
+
+	~EnvironmentTrace()
+	{
+		if (!fileName_.empty())
+		{
+			Tracer::stop();
+			Tracer::save(fileName_);
+		}
+	}
+
+private:
+	string fileName_; /**< Zieldatei, leer = nicht aufzeichnen */
+};
+
+/*! \brief Wertet DFSM_TRACE aus */
+static EnvironmentTrace environmentTrace;
+
+}
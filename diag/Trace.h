@@ -0,0 +1,190 @@
+/*! \file Trace.h
+ *  \brief Definition der Klassen Tracer und TraceSpan sowie der Makros
+ *  DFSM_TRACE_...: Zeitspannen einzelner Abschnitte (Network kompilieren,
+ *  Datei laden, Simulationsphasen, Plotten) je Thread, exportierbar als
+ *  Chrome-Trace-Event-JSON (chrome://tracing, Perfetto)
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef DIAG_TRACE_H_
+#define DIAG_TRACE_H_
+
+#include "Profiler.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace diag
+{
+
+/*! \brief Eine abgeschlossene Zeitspanne
+ */
+struct TraceEvent
+{
+	const char *name_;      /**< Name (Zeichenkettenliteral), nullptr = Name von phase_ */
+	const char *category_;  /**< Kategorie (Zeichenkettenliteral) */
+	int phase_;             /**< Phase (static_cast<int>(Phase)), falls name_ == nullptr */
+	std::uint64_t begin_;   /**< Beginn in Ticks (siehe Profiler::ticks()) */
+	std::uint64_t end_;     /**< Ende in Ticks */
+};
+
+/*! \class Tracer
+ *  \brief Zeichnet Zeitspannen in einen Ringpuffer je Thread auf. Nur der
+ *  eigene Thread schreibt in seinen Puffer, ohne Sperre; ist er voll, werden
+ *  die aeltesten Eintraege ueberschrieben. Solange nicht aufgezeichnet wird,
+ *  kostet eine Zeitspanne nur einen Vergleich. start(), stop(), clear(),
+ *  write(...) und save(...) duerfen nicht waehrend einer Simulation
+ *  aufgerufen werden. Ist die Umgebungsvariable DFSM_TRACE gesetzt, wird ab
+ *  Programmstart aufgezeichnet und am Programmende in die dort angegebene
+ *  Datei geschrieben
+ */
+class Tracer
+{
+public:
+	static const std::size_t DEFAULT_CAPACITY = 1 << 16; /**< Eintraege je Thread */
+
+	/*! \brief Gibt zurueck, ob die Zeitspannen in Network, CompiledNetwork,
+	 *  FileInput, Testbed und ThreadPool uebersetzt wurden
+	 *  \return true mit DFSM_TRACING (CMake-Option DFSM_TRACING, Standard)
+	 */
+	static bool enabled();
+
+	/*! \brief Gibt zurueck, ob gerade aufgezeichnet wird
+	 *  \return true zwischen start() und stop()
+	 */
+	static bool active()
+	{
+		return active_.load(std::memory_order_relaxed);
+	}
+
+	/*! \brief Verwirft alle bisherigen Eintraege und beginnt die Aufzeichnung
+	 *  \param a_capacity Eintraege je Thread, wird auf eine Zweierpotenz
+	 *  aufgerundet
+	 */
+	static void start(std::size_t a_capacity = DEFAULT_CAPACITY);
+
+	/*! \brief Beendet die Aufzeichnung, die Eintraege bleiben erhalten
+	 */
+	static void stop();
+
+	/*! \brief Verwirft alle Eintraege und die Puffer beendeter Threads
+	 */
+	static void clear();
+
+	/*! \brief Haengt eine Zeitspanne an den Puffer des aufrufenden Threads an
+	 *  \param a_event Zeitspanne
+	 */
+	static void record(const TraceEvent &a_event);
+
+	/*! \brief Setzt den Namen des aufrufenden Threads im Export
+	 *  \param a_name Name, Standard: "thread <n>"
+	 */
+	static void setThreadName(const std::string &a_name);
+
+	/*! \brief Anzahl der aufgezeichneten Eintraege aller Threads
+	 *  \return Eintraege, die noch im Puffer stehen
+	 */
+	static std::size_t eventCount();
+
+	/*! \brief Anzahl der ueberschriebenen Eintraege aller Threads
+	 *  \return Eintraege, die wegen vollem Puffer verloren sind
+	 */
+	static std::size_t droppedCount();
+
+	/*! \brief Schreibt alle Eintraege als Chrome-Trace-Event-JSON
+	 *  (Zeitspannen "ph": "X", Zeiten in us ab start())
+	 *  \param a_os Ausgabe
+	 */
+	static void write(std::ostream &a_os);
+
+	/*! \brief Speichert alle Eintraege als Chrome-Trace-Event-JSON
+	 *  \param a_fileName Dateiname inklusive Pfad und Endung
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	static bool save(const std::string &a_fileName);
+
+private:
+	static std::atomic<bool> active_; /**< Es wird aufgezeichnet */
+};
+
+/*! \class TraceSpan
+ *  \brief Misst die Zeitspanne vom Konstruktor bis end() bzw. zum Destruktor
+ *  und zeichnet sie auf, falls beim Beginn aufgezeichnet wurde
+ */
+class TraceSpan
+{
+public:
+	/*! \brief Konstruktor, beginnt die Zeitspanne
+	 *  \param a_name Name (Zeichenkettenliteral)
+	 *  \param a_category Kategorie (Zeichenkettenliteral)
+	 */
+	TraceSpan(const char *a_name, const char *a_category) :
+			name_(a_name), category_(a_category), phase_(-1), begin_(
+					Tracer::active() ? Profiler::ticks() : 0)
+	{
+	}
+
+	/*! \brief Konstruktor fuer eine Simulationsphase, der Name wird erst beim
+	 *  Export aus Profiler::phaseName(...) bestimmt
+	 *  \param a_phase Phase
+	 */
+	explicit TraceSpan(Phase a_phase) :
+			name_(nullptr), category_("phase"), phase_(
+					static_cast<int>(a_phase)), begin_(
+					Tracer::active() ? Profiler::ticks() : 0)
+	{
+	}
+
+	/*! \brief Destruktor, ruft end() auf
+	 */
+	~TraceSpan()
+	{
+		end();
+	}
+
+	/*! \brief Beendet die Zeitspanne. Weitere Aufrufe tun nichts
+	 */
+	void end()
+	{
+		if (begin_ != 0)
+		{
+			TraceEvent event = { name_, category_, phase_, begin_,
+					Profiler::ticks() };
+			Tracer::record(event);
+			begin_ = 0;
+		}
+	}
+
+private:
+	TraceSpan(const TraceSpan&);
+	TraceSpan& operator=(const TraceSpan&);
+
+	const char *name_;      /**< Name */
+	const char *category_;  /**< Kategorie */
+	int phase_;             /**< Phase oder -1 */
+	std::uint64_t begin_;   /**< Beginn in Ticks, 0 = nicht aufzeichnen */
+};
+
+}
+
+#ifdef DFSM_TRACING
+/*! \brief Beginnt eine Zeitspanne a_var bis zum Ende des Blocks */
+#define DFSM_TRACE_SPAN(a_var, a_name, a_category) \
+	diag::TraceSpan a_var(a_name, a_category)
+/*! \brief Beginnt eine Zeitspanne a_var fuer eine Simulationsphase */
+#define DFSM_TRACE_PHASE(a_var, a_phase) \
+	diag::TraceSpan a_var(a_phase)
+/*! \brief Beendet die Zeitspanne a_var vor dem Ende des Blocks */
+#define DFSM_TRACE_END(a_var) \
+	a_var.end()
+#else
+#define DFSM_TRACE_SPAN(a_var, a_name, a_category)
+#define DFSM_TRACE_PHASE(a_var, a_phase)
+#define DFSM_TRACE_END(a_var)
+#endif
+
+#endif /* DIAG_TRACE_H_ */
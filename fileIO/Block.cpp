@@ -1,22 +1,28 @@
 #include <iostream>
 #include "Block.h"
+#include "../diag/Log.h"
 
 using namespace std;
 
 
 void Block::prettyPrint() const
 {
-	cout << "Block data printout:" << endl;
-	cout << "====================" << endl << endl;
-	printIndented(0);
+	prettyPrint(cout);
+}
+
+void Block::prettyPrint(std::ostream& a_os) const
+{
+	a_os << "Block data printout:" << endl;
+	a_os << "====================" << endl << endl;
+	printIndented(a_os, 0);
 }
 
 void Block::addValue(const std::string& a_value)
 {
 	if(children_.size()>0)
 	{
-		cerr << "Warning: Block should only contain EITHER values OR "
-				"child blocks, not both." << endl;
+		DFSM_LOG_WARNING("Block", "Block should only contain EITHER values OR "
+				"child blocks, not both.");
 	}
 	values_.push_back(a_value);
 	return;
@@ -26,13 +32,13 @@ void Block::addChild(const std::string& a_name, const Block& a_block)
 {
 	if(values_.size() > 0)
 	{
-		cerr << "Warning: Block should only contain EITHER values OR "
-				"child blocks, not both." << endl;
+		DFSM_LOG_WARNING("Block", "Block should only contain EITHER values OR "
+				"child blocks, not both.");
 	}
 	if(children_.count(a_name) > 0)
 	{
-		cerr << "Warning: Child block with name " << a_name
-			 << " already exists!" << endl;
+		DFSM_LOG_WARNING("Block", "Child block with name " << a_name
+			 << " already exists!");
 	}
 	children_[a_name] = a_block;
 	return;
@@ -47,8 +53,8 @@ Block Block::child(const std::string& a_name) const
 {
 	if(!hasChild(a_name))
 	{
-		cerr << "Warning: Child with name " << a_name << " does not exist, use"
-				"addChild(...) first!" << endl;
+		DFSM_LOG_WARNING("Block", "Child with name " << a_name << " does not exist, use"
+				"addChild(...) first!");
 		return children_.end()->second;
 	}
 	return children_.at(a_name);
@@ -58,8 +64,8 @@ Block Block::child(int a_idx) const
 {
 	if(a_idx >= static_cast<int>(children_.size()))
 	{
-		cerr << "Warning: Block has only " << children_.size() << " children "
-				" (tried to access index " << a_idx << ")." << endl;
+		DFSM_LOG_WARNING("Block", "Block has only " << children_.size() << " children "
+				" (tried to access index " << a_idx << ").");
 		return children_.end()->second;
 	}
 	map<string, Block>::const_iterator it = children_.begin();
@@ -67,6 +73,11 @@ Block Block::child(int a_idx) const
 	return it->second;
 }
 
+const std::map<std::string, Block>& Block::children() const
+{
+	return children_;
+}
+
 bool Block::hasChild(const std::string& a_name) const
 {
 	return (children_.count(a_name)>0);
@@ -81,28 +92,28 @@ std::string Block::value(int a_idx) const
 {
 	if(a_idx>=static_cast<int>(values_.size()))
 	{
-		cerr << "Warning: Block has only " << values_.size() << " values "
-				" (tried to access index " << a_idx << ")." << endl;
+		DFSM_LOG_WARNING("Block", "Block has only " << values_.size() << " values "
+				" (tried to access index " << a_idx << ").");
 		return "";
 	}
 	return values_.at(a_idx);
 }
 
-void Block::printIndented(int a_indent) const
+void Block::printIndented(std::ostream& a_os, int a_indent) const
 {
-	cout << string(a_indent, ' ') << "{" << endl;
+	a_os << string(a_indent, ' ') << "{" << endl;
 	for(int i=0; i<static_cast<int>(values_.size()); i++)
 	{
-		cout << string(a_indent, ' ') << "  " << values_[i] << endl;
+		a_os << string(a_indent, ' ') << "  " << values_[i] << endl;
 	}
 	for(map<string, Block>::const_iterator
 			it  = children_.begin();
 			it != children_.end();
 			it++)
 	{
-		cout << string(a_indent, ' ') << "  " << it->first << ":" << endl;
-		it->second.printIndented(a_indent+2);
+		a_os << string(a_indent, ' ') << "  " << it->first << ":" << endl;
+		it->second.printIndented(a_os, a_indent+2);
 	}
-	cout << string(a_indent, ' ') << "}" << endl;
+	a_os << string(a_indent, ' ') << "}" << endl;
 	return;
 }
@@ -7,6 +7,7 @@
 #ifndef FILEIO_BLOCK_H_
 #define FILEIO_BLOCK_H_
 
+#include <iosfwd>
 #include <string>
 #include <vector>
 #include <map>
@@ -71,20 +72,33 @@ public:
 	 */
 	Block child(int a_idx) const;
 
+	/*! \brief Gibt alle untergeordneten Bloecke zurueck. Zum Durchlaufen
+	 *  aller Bloecke besser geeignet als child(int), da der Zugriff per
+	 *  Index linear in a_idx ist
+	 *  \return Die untergeordneten Bloecke, sortiert nach Namen
+	 */
+	const std::map<std::string, Block>& children() const;
+
 	/*! \brief Gibt den Inhalt des Blocks in gut lesbarer Form auf der Konsole
 	 *  aus
 	 */
 	void prettyPrint() const;
 
+	/*! \brief Wie prettyPrint(), schreibt aber in den angegebenen Stream
+	 *  \param a_os Ausgabe
+	 */
+	void prettyPrint(std::ostream &a_os) const;
+
 private:
 	std::vector<std::string> values_;  			/**< Werte */
 	std::map<std::string, Block> children_;		/**< Untergeordnete Bloecke */
 
 	/*! \brief Gibt den Inhalt des Blocks in gut lesbarer Form mit der
-	 *  angegebenen Einrueckungstiefe auf der Konsole aus
+	 *  angegebenen Einrueckungstiefe aus
+	 *  \param a_os Ausgabe
 	 *  \param a_indent Einrueckungstiefe / Leerzeichen
 	 */
-	void printIndented(int a_indent) const;
+	void printIndented(std::ostream &a_os, int a_indent) const;
 };
 
 
@@ -0,0 +1,258 @@
+/*! \file Checkpoint.cpp
+ *  \brief Implementierung der Klasse Checkpoint
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "Checkpoint.h"
+#include "../diag/Log.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+using namespace std;
+
+Checkpoint::Checkpoint() :
+		readPos_(0), ok_(true)
+{
+
+}
+
+Checkpoint::Checkpoint(const std::string &a_data) :
+		data_(a_data), readPos_(0), ok_(true)
+{
+
+}
+
+void Checkpoint::writeInt(std::int32_t a_value)
+{
+	writeRaw(&a_value, sizeof(a_value));
+}
+
+void Checkpoint::writeUInt(std::uint32_t a_value)
+{
+	writeRaw(&a_value, sizeof(a_value));
+}
+
+void Checkpoint::writeInt64(std::int64_t a_value)
+{
+	writeRaw(&a_value, sizeof(a_value));
+}
+
+void Checkpoint::writeDouble(double a_value)
+{
+	writeRaw(&a_value, sizeof(a_value));
+}
+
+void Checkpoint::writeString(const std::string &a_value)
+{
+	writeUInt(static_cast<uint32_t>(a_value.size()));
+	writeRaw(a_value.data(), a_value.size());
+}
+
+void Checkpoint::writeDoubles(const std::vector<double> &a_values)
+{
+	writeUInt(static_cast<uint32_t>(a_values.size()));
+	if (!a_values.empty())
+	{
+		writeRaw(&a_values[0], a_values.size() * sizeof(double));
+	}
+}
+
+void Checkpoint::writeInts(const std::vector<int> &a_values)
+{
+	writeUInt(static_cast<uint32_t>(a_values.size()));
+	for (int i = 0; i < static_cast<int>(a_values.size()); i++)
+	{
+		writeInt(a_values[i]);
+	}
+}
+
+void Checkpoint::writeChars(const std::vector<char> &a_values)
+{
+	writeUInt(static_cast<uint32_t>(a_values.size()));
+	if (!a_values.empty())
+	{
+		writeRaw(&a_values[0], a_values.size());
+	}
+}
+
+void Checkpoint::writeRng(const std::mt19937 &a_gen)
+{
+	// Die Textdarstellung von operator<< wird unveraendert abgelegt, operator>>
+	// derselben Standardbibliothek liest sie wieder ein
+	ostringstream text;
+	text << a_gen;
+	writeString(text.str());
+}
+
+bool Checkpoint::readInt(std::int32_t &a_value)
+{
+	return readRaw(&a_value, sizeof(a_value));
+}
+
+bool Checkpoint::readUInt(std::uint32_t &a_value)
+{
+	return readRaw(&a_value, sizeof(a_value));
+}
+
+bool Checkpoint::readInt64(std::int64_t &a_value)
+{
+	return readRaw(&a_value, sizeof(a_value));
+}
+
+bool Checkpoint::readDouble(double &a_value)
+{
+	return readRaw(&a_value, sizeof(a_value));
+}
+
+bool Checkpoint::readString(std::string &a_value)
+{
+	size_t size = 0;
+	if (!readSize(1, size))
+	{
+		return false;
+	}
+	a_value.assign(data_, readPos_, size);
+	readPos_ += size;
+	return true;
+}
+
+bool Checkpoint::readDoubles(std::vector<double> &a_values)
+{
+	size_t size = 0;
+	if (!readSize(sizeof(double), size))
+	{
+		return false;
+	}
+	a_values.resize(size);
+	return size == 0 || readRaw(&a_values[0], size * sizeof(double));
+}
+
+bool Checkpoint::readInts(std::vector<int> &a_values)
+{
+	size_t size = 0;
+	if (!readSize(sizeof(int32_t), size))
+	{
+		return false;
+	}
+	a_values.resize(size);
+	for (size_t i = 0; i < size; i++)
+	{
+		int32_t value = 0;
+		readInt(value);
+		a_values[i] = value;
+	}
+	return ok_;
+}
+
+bool Checkpoint::readChars(std::vector<char> &a_values)
+{
+	size_t size = 0;
+	if (!readSize(1, size))
+	{
+		return false;
+	}
+	a_values.resize(size);
+	return size == 0 || readRaw(&a_values[0], size);
+}
+
+bool Checkpoint::readRng(std::mt19937 &a_gen)
+{
+	string text;
+	if (!readString(text))
+	{
+		return false;
+	}
+	istringstream words(text);
+	mt19937 gen;
+	words >> gen;
+	if (!words)
+	{
+		ok_ = false;
+		return false;
+	}
+	a_gen = gen;
+	return true;
+}
+
+bool Checkpoint::ok() const
+{
+	return ok_;
+}
+
+bool Checkpoint::atEnd() const
+{
+	return readPos_ == data_.size();
+}
+
+const std::string& Checkpoint::data() const
+{
+	return data_;
+}
+
+bool Checkpoint::save(const std::string &a_fileName) const
+{
+	string path("Checkpoints/");
+	path += a_fileName + ".ckpt";
+	ofstream file(path.c_str(), ios::binary);
+	if (!file.is_open())
+	{
+		DFSM_LOG_ERROR("Checkpoint", "Cannot open checkpoint file at \"" << path << "\".");
+		return false;
+	}
+	file.write(data_.data(), data_.size());
+	return static_cast<bool>(file);
+}
+
+bool Checkpoint::load(const std::string &a_fileName)
+{
+	string path("Checkpoints/");
+	path += a_fileName + ".ckpt";
+	ifstream file(path.c_str(), ios::binary);
+	if (!file.is_open())
+	{
+		DFSM_LOG_ERROR("Checkpoint", "Cannot open checkpoint file at \"" << path << "\".");
+		return false;
+	}
+	data_.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+	readPos_ = 0;
+	ok_ = true;
+	return true;
+}
+
+void Checkpoint::writeRaw(const void *a_bytes, std::size_t a_size)
+{
+	data_.append(static_cast<const char*>(a_bytes), a_size);
+}
+
+bool Checkpoint::readRaw(void *a_bytes, std::size_t a_size)
+{
+	if (!ok_ || data_.size() - readPos_ < a_size)
+	{
+		ok_ = false;
+		return false;
+	}
+	memcpy(a_bytes, data_.data() + readPos_, a_size);
+	readPos_ += a_size;
+	return true;
+}
+
+bool Checkpoint::readSize(std::size_t a_elementSize, std::size_t &a_size)
+{
+	uint32_t size = 0;
+	if (!readUInt(size))
+	{
+		return false;
+	}
+	if (static_cast<size_t>(size) * a_elementSize > data_.size() - readPos_)
+	{
+		ok_ = false;
+		return false;
+	}
+	a_size = size;
+	return true;
+}
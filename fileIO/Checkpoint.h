@@ -0,0 +1,189 @@
+/*! \file Checkpoint.h
+ *  \brief Definition der Klasse Checkpoint
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef FILEIO_CHECKPOINT_H_
+#define FILEIO_CHECKPOINT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/*! \class Checkpoint
+ *  \brief Kompakter Binaerpuffer fuer Simulationszustaende. Werte werden
+ *  der Reihe nach angehaengt und in derselben Reihenfolge wieder gelesen.
+ *  Schlaegt ein Lesevorgang fehl (Puffer zu kurz), liefern alle weiteren
+ *  Lesevorgaenge false
+ */
+class Checkpoint
+{
+public:
+	/*! \brief Konstruktor. Erzeugt einen leeren Checkpoint zum Schreiben
+	 */
+	Checkpoint();
+
+	/*! \brief Konstruktor. Erzeugt einen Checkpoint zum Lesen der
+	 *  uebergebenen Daten
+	 *  \param a_data Binaerdaten, z. B. von data()
+	 */
+	Checkpoint(const std::string &a_data);
+
+	/*! \brief Haengt eine Ganzzahl an
+	 *  \param a_value Wert
+	 */
+	void writeInt(std::int32_t a_value);
+
+	/*! \brief Haengt eine vorzeichenlose Ganzzahl an
+	 *  \param a_value Wert
+	 */
+	void writeUInt(std::uint32_t a_value);
+
+	/*! \brief Haengt eine 64-Bit-Ganzzahl an (z. B. Dateipositionen)
+	 *  \param a_value Wert
+	 */
+	void writeInt64(std::int64_t a_value);
+
+	/*! \brief Haengt eine Gleitkommazahl an
+	 *  \param a_value Wert
+	 */
+	void writeDouble(double a_value);
+
+	/*! \brief Haengt eine Zeichenkette (mit Laenge) an
+	 *  \param a_value Wert
+	 */
+	void writeString(const std::string &a_value);
+
+	/*! \brief Haengt ein Feld von Gleitkommazahlen (mit Laenge) an
+	 *  \param a_values Werte
+	 */
+	void writeDoubles(const std::vector<double> &a_values);
+
+	/*! \brief Haengt ein Feld von Ganzzahlen (mit Laenge) an
+	 *  \param a_values Werte
+	 */
+	void writeInts(const std::vector<int> &a_values);
+
+	/*! \brief Haengt ein Feld von Bytes (mit Laenge) an
+	 *  \param a_values Werte
+	 */
+	void writeChars(const std::vector<char> &a_values);
+
+	/*! \brief Haengt den vollstaendigen Zustand eines Zufallsgenerators an
+	 *  (Textdarstellung von operator<< als Zeichenkette mit Laenge)
+	 *  \param a_gen Zufallsgenerator
+	 */
+	void writeRng(const std::mt19937 &a_gen);
+
+	/*! \brief Liest eine Ganzzahl
+	 *  \param a_value Ziel
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool readInt(std::int32_t &a_value);
+
+	/*! \brief Liest eine vorzeichenlose Ganzzahl
+	 *  \param a_value Ziel
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool readUInt(std::uint32_t &a_value);
+
+	/*! \brief Liest eine 64-Bit-Ganzzahl
+	 *  \param a_value Ziel
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool readInt64(std::int64_t &a_value);
+
+	/*! \brief Liest eine Gleitkommazahl
+	 *  \param a_value Ziel
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool readDouble(double &a_value);
+
+	/*! \brief Liest eine Zeichenkette
+	 *  \param a_value Ziel
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool readString(std::string &a_value);
+
+	/*! \brief Liest ein Feld von Gleitkommazahlen
+	 *  \param a_values Ziel
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool readDoubles(std::vector<double> &a_values);
+
+	/*! \brief Liest ein Feld von Ganzzahlen
+	 *  \param a_values Ziel
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool readInts(std::vector<int> &a_values);
+
+	/*! \brief Liest ein Feld von Bytes
+	 *  \param a_values Ziel
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool readChars(std::vector<char> &a_values);
+
+	/*! \brief Liest den Zustand eines Zufallsgenerators
+	 *  \param a_gen Ziel
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool readRng(std::mt19937 &a_gen);
+
+	/*! \brief Gibt zurueck, ob bisher alle Lesevorgaenge erfolgreich waren
+	 *  \return true, falls kein Lesefehler aufgetreten ist
+	 */
+	bool ok() const;
+
+	/*! \brief Gibt zurueck, ob alle Daten gelesen wurden
+	 *  \return true, falls die Leseposition am Ende steht
+	 */
+	bool atEnd() const;
+
+	/*! \brief Gibt die Binaerdaten zurueck
+	 *  \return Binaerdaten
+	 */
+	const std::string& data() const;
+
+	/*! \brief Speichert die Binaerdaten im Ordner ./Checkpoints
+	 *  \param a_fileName Dateiname OHNE Endung .ckpt
+	 *  \return true, falls das Speichern erfolgreich war, false sonst
+	 */
+	bool save(const std::string &a_fileName) const;
+
+	/*! \brief Laedt Binaerdaten aus dem Ordner ./Checkpoints und setzt die
+	 *  Leseposition auf den Anfang
+	 *  \param a_fileName Dateiname OHNE Endung .ckpt
+	 *  \return true, falls das Laden erfolgreich war, false sonst
+	 */
+	bool load(const std::string &a_fileName);
+
+private:
+	/*! \brief Haengt Rohdaten an
+	 *  \param a_bytes Daten
+	 *  \param a_size Anzahl Bytes
+	 */
+	void writeRaw(const void *a_bytes, std::size_t a_size);
+
+	/*! \brief Liest Rohdaten
+	 *  \param a_bytes Ziel
+	 *  \param a_size Anzahl Bytes
+	 *  \return true, falls genug Daten vorhanden waren, false sonst
+	 */
+	bool readRaw(void *a_bytes, std::size_t a_size);
+
+	/*! \brief Liest eine Feldlaenge und prueft sie gegen die Restdaten
+	 *  \param a_elementSize Groesse eines Elements / Byte
+	 *  \param a_size Ziel
+	 *  \return true, falls die Laenge plausibel ist, false sonst
+	 */
+	bool readSize(std::size_t a_elementSize, std::size_t &a_size);
+
+	std::string data_;      /**< Binaerdaten */
+	std::size_t readPos_;   /**< Aktuelle Leseposition */
+	bool ok_;               /**< Kein Lesefehler aufgetreten */
+};
+
+#endif /* FILEIO_CHECKPOINT_H_ */
@@ -5,24 +5,32 @@
  */
 
 #include "FileInput.h"
+#include "../diag/Log.h"
+#include "../diag/Trace.h"
 
 #include <iostream>
 #include <ios>
 #include <streambuf>
 #include <fstream>
+#include <sstream>
 
 using namespace std;
 
 Network FileInput::load(const std::string &a_fileName)
 {
+	DFSM_TRACE_SPAN(loadSpan, "load", "fileIO");
 	if (!fileContentsToLines(a_fileName))
 	{
 		return Network("", 0);
 	}
 	int lineNumber = 0;
 	Block networkBlock = parse(lineNumber);
-	networkBlock.prettyPrint();
-	cout << endl << endl;
+	if (diag::Log::enabled(diag::LogLevel::DEBUG))
+	{
+		ostringstream text;
+		networkBlock.prettyPrint(text);
+		diag::Log::write(diag::LogLevel::DEBUG, "FileInput", text.str());
+	}
 	return blockToNetwork(networkBlock);
 }
 
@@ -114,16 +122,16 @@ Block FileInput::parse(int &a_lineNumber) const
 		}
 	}
 
-	cerr << "Unexpected end-of-file at line " << a_lineNumber + 1 << endl;
+	DFSM_LOG_ERROR("FileInput", "Unexpected end-of-file at line " << a_lineNumber + 1);
 	return block;
 }
 
 void FileInput::error(ReadState a_state, ReadEvent a_event,
 		int a_lineNumber) const
 {
-	cerr << "Parser error: Line " << a_lineNumber + 1 << ": In state "
+	DFSM_LOG_ERROR("FileInput", "Parser error: Line " << a_lineNumber + 1 << ": In state "
 			<< static_cast<int>(a_state) << ": Unexpected event "
-			<< static_cast<int>(a_event) << "." << endl;
+			<< static_cast<int>(a_event) << ".");
 	return;
 }
 
@@ -131,7 +139,7 @@ FileInput::ReadEvent FileInput::getEvent(const std::string &a_line) const
 {
 	if (a_line.empty())
 	{
-		cerr << "Line may not be empty!" << endl;
+		DFSM_LOG_ERROR("FileInput", "Line may not be empty!");
 		return ReadEvent::VALUE;
 	}
 	if (a_line.at(a_line.size() - 1) == ':')
@@ -156,7 +164,7 @@ std::string FileInput::getBlockName(const std::string &a_line) const
 {
 	if (a_line.empty())
 	{
-		cerr << "Line may not be empty!" << endl;
+		DFSM_LOG_ERROR("FileInput", "Line may not be empty!");
 		return string("");
 	}
 	return a_line.substr(0, a_line.size() - 1);
@@ -167,7 +175,7 @@ Network FileInput::blockToNetwork(const Block &a_networkBlock) const
 	// Lies Network-Name
 	if (!a_networkBlock.hasChild("name"))
 	{
-		cerr << "network: Child \"name\" missing." << endl;
+		DFSM_LOG_ERROR("FileInput", "network: Child \"name\" missing.");
 		return Network("", 0);
 	}
 	string name = a_networkBlock.child("name").value(0);
@@ -175,7 +183,7 @@ Network FileInput::blockToNetwork(const Block &a_networkBlock) const
 	// Lies Network-Gatterlaufzeit
 	if (!a_networkBlock.hasChild("propagationDelay"))
 	{
-		cerr << "network: Child \"propagationDelay\" missing." << endl;
+		DFSM_LOG_ERROR("FileInput", "network: Child \"propagationDelay\" missing.");
 		return Network("", 0);
 	}
 	sgnl::Nanoseconds propagationDelay = toPositiveInteger(
@@ -187,7 +195,7 @@ Network FileInput::blockToNetwork(const Block &a_networkBlock) const
 	// Lies Network-Inputs und fuege sie hinzu
 	if (!a_networkBlock.hasChild("inputs"))
 	{
-		cerr << "network: Child \"inputs\" missing." << endl;
+		DFSM_LOG_ERROR("FileInput", "network: Child \"inputs\" missing.");
 		return ret;
 	}
 	Block inputs = a_networkBlock.child("inputs");
@@ -199,7 +207,7 @@ Network FileInput::blockToNetwork(const Block &a_networkBlock) const
 	// Lies Network-Outputs und fuege sie hinzu
 	if (!a_networkBlock.hasChild("outputs"))
 	{
-		cerr << "network: Child \"outputs\" missing." << endl;
+		DFSM_LOG_ERROR("FileInput", "network: Child \"outputs\" missing.");
 		return ret;
 	}
 	Block outputs = a_networkBlock.child("outputs");
@@ -211,16 +219,17 @@ Network FileInput::blockToNetwork(const Block &a_networkBlock) const
 	// Lies Gates und fuege sie hinzu
 	if (!a_networkBlock.hasChild("gates"))
 	{
-		cerr << "network: Child \"gates\" missing." << endl;
+		DFSM_LOG_ERROR("FileInput", "network: Child \"gates\" missing.");
 		return ret;
 	}
 	Block gates = a_networkBlock.child("gates");
-	for (int i = 0; i < gates.nChildren(); i++)
+	for (map<string, Block>::const_iterator it = gates.children().begin();
+			it != gates.children().end(); it++)
 	{
-		Block gate = gates.child(i);
+		const Block &gate = it->second;
 		if (gate.nValues() < 2)
 		{
-			cerr << "gate: Need name and logic (2 parameters)." << endl;
+			DFSM_LOG_ERROR("FileInput", "gate: Need name and logic (2 parameters).");
 			return ret;
 		}
 		string name = gate.value(0);
@@ -232,26 +241,29 @@ Network FileInput::blockToNetwork(const Block &a_networkBlock) const
 	// Lies Network-Verbindungen und fuege sie hinzu
 	if (!a_networkBlock.hasChild("connections"))
 	{
-		cerr << "network: Child \"connections\" missing." << endl;
+		DFSM_LOG_ERROR("FileInput", "network: Child \"connections\" missing.");
 		return ret;
 	}
 	Block connections = a_networkBlock.child("connections");
-	for (int i = 0; i < connections.nChildren(); i++)
+	int i = 0;
+	for (map<string, Block>::const_iterator it =
+			connections.children().begin(); it != connections.children().end();
+			it++, i++)
 	{
-		Block connection = connections.child(i);
+		const Block &connection = it->second;
 
 		// Lies gemeinsame Quelle (Output) der Verbindungen
 		if (!connection.hasChild("from"))
 		{
-			cerr << "connection " << i << ": Child \"from\" missing." << endl;
+			DFSM_LOG_ERROR("FileInput", "connection " << i << ": Child \"from\" missing.");
 			return ret;
 		}
 		Block from = connection.child("from");
 		if (from.nValues() < 2)
 		{
-			cerr << "connection " << i << ", from: Need type and name "
+			DFSM_LOG_ERROR("FileInput", "connection " << i << ", from: Need type and name "
 					"(2 parameters) or type, name and output pin index "
-					"(3 parameters)." << endl;
+					"(3 parameters).");
 			return ret;
 		}
 		string fromType = from.value(0);
@@ -261,8 +273,8 @@ Network FileInput::blockToNetwork(const Block &a_networkBlock) const
 		{
 			if (from.nValues() < 3)
 			{
-				cerr << "connection " << i << ", from: Type is gate, then "
-						"parameter \"output pin index\" must exist." << endl;
+				DFSM_LOG_ERROR("FileInput", "connection " << i << ", from: Type is gate, then "
+						"parameter \"output pin index\" must exist.");
 				return ret;
 			}
 			int fromPinIndex = FileInput::toPositiveInteger(from.value(2));
@@ -272,18 +284,20 @@ Network FileInput::blockToNetwork(const Block &a_networkBlock) const
 		// Lies Ziele (Inputs) der Verbindungen
 		if (!connection.hasChild("to"))
 		{
-			cerr << "connection " << i << ": Child \"to\" missing." << endl;
+			DFSM_LOG_ERROR("FileInput", "connection " << i << ": Child \"to\" missing.");
 			return ret;
 		}
 		Block tos = connection.child("to");
-		for (int k = 0; k < tos.nChildren(); k++)
+		int k = 0;
+		for (map<string, Block>::const_iterator to_it = tos.children().begin();
+				to_it != tos.children().end(); to_it++, k++)
 		{
-			Block to = tos.child(k);
+			const Block &to = to_it->second;
 			if (to.nValues() < 2)
 			{
-				cerr << "connection " << i << ", to no. " << k << ": Need type "
+				DFSM_LOG_ERROR("FileInput", "connection " << i << ", to no. " << k << ": Need type "
 						"and name (2 parameters) or type, name and input pin "
-						"index (3 parameters)." << endl;
+						"index (3 parameters).");
 				return ret;
 			}
 			string toType = to.value(0);
@@ -293,10 +307,10 @@ Network FileInput::blockToNetwork(const Block &a_networkBlock) const
 			{
 				if (to.nValues() < 3)
 				{
-					cerr << "connection " << i << ", to no. " << k
+					DFSM_LOG_ERROR("FileInput", "connection " << i << ", to no. " << k
 							<< ": Type is "
 									"gate, then parameter \"input pin index\" "
-									"must exist." << endl;
+									"must exist.");
 					return ret;
 				}
 				int toPinIndex = FileInput::toPositiveInteger(to.value(2));
@@ -318,9 +332,9 @@ Network FileInput::blockToNetwork(const Block &a_networkBlock) const
 				}
 				else
 				{
-					cerr << "connection " << i << ", to no. " << k
+					DFSM_LOG_ERROR("FileInput", "connection " << i << ", to no. " << k
 							<< ": Unknown "
-									"to-type: " << toType << endl;
+									"to-type: " << toType);
 					return ret;
 				}
 			}
@@ -332,26 +346,31 @@ Network FileInput::blockToNetwork(const Block &a_networkBlock) const
 				}
 				else if (toType == "network-output")
 				{
-					cerr << "connection " << i << ", to no. " << k
+					DFSM_LOG_ERROR("FileInput", "connection " << i << ", to no. " << k
 							<< ": Invalid connection: Cannot connect network input"
-									" with network output directly." << endl;
+									" with network output directly.");
 				}
 				else
 				{
-					cerr << "connection " << i << ", to no. " << k
-							<< ": Unknown to-type: " << toType << endl;
+					DFSM_LOG_ERROR("FileInput", "connection " << i << ", to no. " << k
+							<< ": Unknown to-type: " << toType);
 					return ret;
 				}
 			}
 			else
 			{
-				cerr << "connection " << i << ", to no. " << k << ": Unknown "
-						"from type: " << fromType << endl;
+				DFSM_LOG_ERROR("FileInput", "connection " << i << ", to no. " << k << ": Unknown "
+						"from type: " << fromType);
 				return ret;
 			}
 		}
 	}
-	ret.prettyPrint();
+	if (diag::Log::enabled(diag::LogLevel::DEBUG))
+	{
+		ostringstream text;
+		ret.prettyPrint(text);
+		diag::Log::write(diag::LogLevel::DEBUG, "FileInput", text.str());
+	}
 	return ret;
 }
 
@@ -365,7 +384,7 @@ bool FileInput::fileContentsToLines(const std::string &a_fileName)
 	vector<string> ret;
 	if (!file.is_open())
 	{
-		cerr << "Cannot open load file at \"" << path << "\"." << endl;
+		DFSM_LOG_ERROR("FileInput", "Cannot open load file at \"" << path << "\".");
 		return false;
 	}
 	string line;
@@ -403,11 +422,11 @@ int FileInput::toPositiveInteger(const std::string &a_value) const
 		integer = stoi(a_value);
 	} catch (...)
 	{
-		cerr << a_value << " is not an integer." << endl;
+		DFSM_LOG_ERROR("FileInput", a_value << " is not an integer.");
 	}
 	if (integer < 0)
 	{
-		cerr << "Must be positive (have " << integer << ")." << endl;
+		DFSM_LOG_ERROR("FileInput", "Must be positive (have " << integer << ").");
 	}
 	return integer;
 }
@@ -426,6 +445,6 @@ const GateLogic& FileInput::logicFromString(const std::string &a_str) const
 		return pgl::or2;
 	if (a_str == "NOT1")
 		return pgl::not1;
-	cerr << "Unknown GateLogic: " << a_str << ", defaulting to BUF1." << endl;
+	DFSM_LOG_WARNING("FileInput", "Unknown GateLogic: " << a_str << ", defaulting to BUF1.");
 	return pgl::buf1;
 }
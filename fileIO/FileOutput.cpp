@@ -5,6 +5,7 @@
  */
 
 #include "FileOutput.h"
+#include "../diag/Log.h"
 
 #include <iostream>
 #include <fstream>
@@ -20,7 +21,7 @@ bool FileOutput::save(const Network &a_network, const std::string &a_fileName)
 	file.open(path.c_str());
 	if (!file.is_open())
 	{
-		cerr << "Cannot open save file at \"" << path << "\"." << endl;
+		DFSM_LOG_ERROR("FileOutput", "Cannot open save file at \"" << path << "\".");
 		return false;
 	}
 
@@ -6,6 +6,9 @@
 
 #include "Gate.h"
 
+#include "../diag/AllocTracker.h"
+#include "../diag/Profiler.h"
+
 using namespace sgnl;
 using namespace std;
 
@@ -56,19 +59,26 @@ void Gate::setInput(int a_idx, sgnl::Volt a_voltage)
 
 void Gate::simulationStep()
 {
+	DFSM_ALLOC_SCOPE(allocScope, diag::AllocSubsystem::GATE);
 	vector<bool> inputs_logical
 		= voltageToLogical(inputs_, prevInputs_logical_);
 
+	DFSM_PROFILE_TICKS(logicStart);
+	DFSM_ALLOC_SCOPE(logicAllocScope, diag::AllocSubsystem::GATE_LOGIC);
 	vector<bool> outputs_logical
 		= pLogic_->outputsFor(
 			inputs_logical,
 			prevInputs_logical_,
 			prevOutputs_logical_);
+	DFSM_ALLOC_SCOPE_END(logicAllocScope);
+	DFSM_PROFILE_LOGIC(pLogic_, logicStart);
 
 	outputs_ = logicalToVolt(outputs_logical);
 
 	outputs_ = applyPropagationDelay(outputs_);
+	DFSM_PROFILE_TICKS(noiseStart);
 	outputs_ = applyNoise(outputs_);
+	DFSM_PROFILE_RECORD(diag::Phase::GATE_NOISE, noiseStart, outputs_.size());
 
 	prevOutputs_logical_ = outputs_logical;
 	prevInputs_logical_ = inputs_logical;
@@ -98,6 +108,11 @@ std::string Gate::logicName() const
 	return pLogic_->name();
 }
 
+const GateLogic* Gate::logic() const
+{
+	return pLogic_;
+}
+
 std::vector<sgnl::Volt> Gate::applyPropagationDelay(
 		std::vector<sgnl::Volt> a_outputs)
 {
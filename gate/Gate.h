@@ -83,7 +83,15 @@ public:
 	 */
 	std::string logicName() const;
 
+	/*! \brief Gibt die vom Gate verwendete Gatelogik zurueck
+	 *  \return Pointer auf das vordefinierte Gatelogik-Objekt
+	 */
+	const GateLogic* logic() const;
+
 private:
+	friend class GateBenchmark;  /**< Microbenchmark (bench/GateLogicBenchmark.cpp)
+		misst applyPropagationDelay(...) */
+
 	const GateLogic* pLogic_;  /**< Pointer auf ein vordefiniertes
 		Gatelogik-Objekt. Dieses bestimmt, welche Logikfunktion dieses Gate
 		erfuellt */
@@ -5,6 +5,7 @@
  */
 
 #include "GateLogic.h"
+#include "../diag/Log.h"
 
 #include <iostream>
 
@@ -49,20 +50,20 @@ bool GateLogic::assertDimensionsMatch(
 {
 	if(nInputs_ != static_cast<int>(a_inputs.size()))
 	{
-		cerr << "GateLogic: Number of inputs must be " << nInputs_
-			 << " (have " << a_inputs.size() << ")." << endl;
+		DFSM_LOG_ERROR("GateLogic", "Number of inputs must be " << nInputs_
+			 << " (have " << a_inputs.size() << ").");
 		return false;
 	}
 	if(nInputs_ != static_cast<int>(a_prevInputs.size()))
 	{
-		cerr << "GateLogic: Number of previous inputs must be " << nInputs_
-			 << " (have " << a_prevInputs.size() << ")." << endl;
+		DFSM_LOG_ERROR("GateLogic", "Number of previous inputs must be " << nInputs_
+			 << " (have " << a_prevInputs.size() << ").");
 		return false;
 	}
 	if(nOutputs_ != static_cast<int>(a_prevOutputs.size()))
 	{
-		cerr << "GateLogic: Number of previous outputs must be " << nOutputs_
-			 << " (have " << a_prevOutputs.size() << ")." << endl;
+		DFSM_LOG_ERROR("GateLogic", "Number of previous outputs must be " << nOutputs_
+			 << " (have " << a_prevOutputs.size() << ").");
 		return false;
 	}
 	return true;
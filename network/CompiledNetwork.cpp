@@ -0,0 +1,369 @@
+/*! \file CompiledNetwork.cpp
+ *  \brief Implementierung der Klassen CompiledNetwork und NetworkState
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "CompiledNetwork.h"
+
+#include "../diag/AllocTracker.h"
+#include "../diag/Profiler.h"
+#include "../diag/Trace.h"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+using namespace sgnl;
+
+NetworkState::NetworkState()
+{
+
+}
+
+void NetworkState::seed(unsigned int a_seed)
+{
+	gen_.seed(a_seed);
+}
+
+void NetworkState::saveState(Checkpoint &a_checkpoint) const
+{
+	a_checkpoint.writeDoubles(inputs_);
+	a_checkpoint.writeChars(prevInputsLogical_);
+	a_checkpoint.writeDoubles(outputs_);
+	a_checkpoint.writeChars(prevOutputsLogical_);
+	a_checkpoint.writeInts(outputToggles_);
+	a_checkpoint.writeRng(gen_);
+}
+
+bool NetworkState::restoreState(Checkpoint &a_checkpoint)
+{
+	vector<Volt> inputs;
+	vector<char> prevInputsLogical;
+	vector<Volt> outputs;
+	vector<char> prevOutputsLogical;
+	vector<int> outputToggles;
+	mt19937 gen;
+	if (!a_checkpoint.readDoubles(inputs)
+			|| !a_checkpoint.readChars(prevInputsLogical)
+			|| !a_checkpoint.readDoubles(outputs)
+			|| !a_checkpoint.readChars(prevOutputsLogical)
+			|| !a_checkpoint.readInts(outputToggles)
+			|| !a_checkpoint.readRng(gen))
+	{
+		return false;
+	}
+	if (inputs.size() != inputs_.size()
+			|| prevInputsLogical.size() != prevInputsLogical_.size()
+			|| outputs.size() != outputs_.size()
+			|| prevOutputsLogical.size() != prevOutputsLogical_.size()
+			|| outputToggles.size() != outputToggles_.size())
+	{
+		return false;
+	}
+	inputs_.swap(inputs);
+	prevInputsLogical_.swap(prevInputsLogical);
+	outputs_.swap(outputs);
+	prevOutputsLogical_.swap(prevOutputsLogical);
+	outputToggles_.swap(outputToggles);
+	gen_ = gen;
+	return true;
+}
+
+CompiledNetwork::CompiledNetwork(const Network &a_network) :
+		name_(a_network.name()), propagationDelay_(
+				a_network.getPropagationDelay_()), valid_(
+				a_network.consistent()), inputNames_(a_network.inputNames()), outputNames_(
+				a_network.outputNames()), nInputPins_(0), nOutputPins_(0)
+{
+	DFSM_TRACE_SPAN(compileSpan, "compile", "network");
+	// Gates in derselben Reihenfolge wie Network::simulationStep(...)
+	map<string, Gate> gates = a_network.getGates_();
+	map<string, int> gateIdx;
+	for (map<string, Gate>::const_iterator it = gates.begin();
+			it != gates.end(); it++)
+	{
+		if (it->second.logic() == nullptr)
+		{
+			continue;
+		}
+		CompiledGate gate;
+		gate.pLogic_ = it->second.logic();
+		gate.firstInput_ = nInputPins_;
+		gate.nInputs_ = it->second.nInputs();
+		gate.firstOutput_ = nOutputPins_;
+		gate.nOutputs_ = it->second.nOutputs();
+		nInputPins_ += gate.nInputs_;
+		nOutputPins_ += gate.nOutputs_;
+		gateIdx[it->first] = static_cast<int>(gates_.size());
+		gates_.push_back(gate);
+		gateNames_.push_back(it->first);
+	}
+
+	map<string, vector<Pin> > inputConnections =
+			a_network.getInputConnections_();
+	inputFanoutBegin_.push_back(0);
+	for (map<string, vector<Pin> >::const_iterator it =
+			inputConnections.begin(); it != inputConnections.end(); it++)
+	{
+		for (int i = 0; i < static_cast<int>(it->second.size()); i++)
+		{
+			const CompiledGate &gate = gates_[gateIdx.at(
+					it->second[i].gateName())];
+			inputFanout_.push_back(gate.firstInput_ + it->second[i].idx());
+		}
+		inputFanoutBegin_.push_back(static_cast<int>(inputFanout_.size()));
+	}
+
+	map<Pin, vector<Pin> > gate2GateConnections =
+			a_network.getGate2GateConnections_();
+	netFanoutBegin_.push_back(0);
+	outputPinFanout_.assign(nOutputPins_, 0);
+	for (map<Pin, vector<Pin> >::const_iterator it =
+			gate2GateConnections.begin(); it != gate2GateConnections.end();
+			it++)
+	{
+		const CompiledGate &outGate = gates_[gateIdx.at(it->first.gateName())];
+		netSource_.push_back(outGate.firstOutput_ + it->first.idx());
+		for (int i = 0; i < static_cast<int>(it->second.size()); i++)
+		{
+			const CompiledGate &inGate = gates_[gateIdx.at(
+					it->second[i].gateName())];
+			netFanout_.push_back(inGate.firstInput_ + it->second[i].idx());
+		}
+		outputPinFanout_[netSource_.back()] = static_cast<int>(it->second.size());
+		netFanoutBegin_.push_back(static_cast<int>(netFanout_.size()));
+	}
+
+	map<string, Pin> outputConnections = a_network.getOutputConnections_();
+	for (map<string, Pin>::const_iterator it = outputConnections.begin();
+			it != outputConnections.end(); it++)
+	{
+		if (it->second.empty())
+		{
+			outputPins_.push_back(-1);
+			continue;
+		}
+		const CompiledGate &gate = gates_[gateIdx.at(it->second.gateName())];
+		outputPins_.push_back(gate.firstOutput_ + it->second.idx());
+	}
+}
+
+bool CompiledNetwork::valid() const
+{
+	return valid_;
+}
+
+std::string CompiledNetwork::name() const
+{
+	return name_;
+}
+
+int CompiledNetwork::nInputs() const
+{
+	return static_cast<int>(inputNames_.size());
+}
+
+int CompiledNetwork::nOutputs() const
+{
+	return static_cast<int>(outputNames_.size());
+}
+
+int CompiledNetwork::nGates() const
+{
+	return static_cast<int>(gates_.size());
+}
+
+const std::vector<std::string>& CompiledNetwork::inputNames() const
+{
+	return inputNames_;
+}
+
+const std::vector<std::string>& CompiledNetwork::outputNames() const
+{
+	return outputNames_;
+}
+
+int CompiledNetwork::nOutputPins() const
+{
+	return nOutputPins_;
+}
+
+std::string CompiledNetwork::outputPinName(int a_pin) const
+{
+	// Die Output-Pins sind in Gate-Reihenfolge vergeben: letztes Gate mit
+	// firstOutput_ <= a_pin suchen
+	int g = 0;
+	int last = nGates() - 1;
+	while (g < last)
+	{
+		int mid = (g + last + 1) / 2;
+		if (gates_[mid].firstOutput_ <= a_pin)
+		{
+			g = mid;
+		}
+		else
+		{
+			last = mid - 1;
+		}
+	}
+	return gateNames_[g] + ":" + to_string(a_pin - gates_[g].firstOutput_);
+}
+
+int CompiledNetwork::outputPinFanout(int a_pin) const
+{
+	return outputPinFanout_[a_pin];
+}
+
+int CompiledNetwork::inputFanout(int a_idx) const
+{
+	return inputFanoutBegin_[a_idx + 1] - inputFanoutBegin_[a_idx];
+}
+
+int CompiledNetwork::outputToggles(const NetworkState &a_state, int a_pin) const
+{
+	return a_state.outputToggles_[a_pin];
+}
+
+int CompiledNetwork::inputIndex(const std::string &a_name) const
+{
+	vector<string>::const_iterator it = lower_bound(inputNames_.begin(),
+			inputNames_.end(), a_name);
+	if (it == inputNames_.end() || *it != a_name)
+	{
+		return -1;
+	}
+	return static_cast<int>(it - inputNames_.begin());
+}
+
+int CompiledNetwork::outputIndex(const std::string &a_name) const
+{
+	vector<string>::const_iterator it = lower_bound(outputNames_.begin(),
+			outputNames_.end(), a_name);
+	if (it == outputNames_.end() || *it != a_name)
+	{
+		return -1;
+	}
+	return static_cast<int>(it - outputNames_.begin());
+}
+
+NetworkState CompiledNetwork::createState(unsigned int a_seed) const
+{
+	NetworkState state;
+	state.inputs_.assign(nInputPins_, LOW_LEVEL_VOLT);
+	state.prevInputsLogical_.assign(nInputPins_, 0);
+	state.outputs_.assign(nOutputPins_, LOW_LEVEL_VOLT);
+	state.prevOutputsLogical_.assign(nOutputPins_, 0);
+	state.outputToggles_.assign(nOutputPins_, 0);
+	state.seed(a_seed);
+	return state;
+}
+
+void CompiledNetwork::simulationStep(NetworkState &a_state,
+		const sgnl::Volt *a_inputs) const
+{
+	// Anforderungen der Gate-Logiken zaehlen hier mit (kein AllocScope je Gate)
+	DFSM_ALLOC_SCOPE(allocScope, diag::AllocSubsystem::NETWORK);
+	// Network-Inputspannungen auf die verbundenen Gate-Input-Pins legen
+	DFSM_PROFILE_TICKS(inputsStart);
+	DFSM_TRACE_PHASE(inputsSpan, diag::Phase::NETWORK_INPUTS);
+	for (int i = 0; i < nInputs(); i++)
+	{
+		for (int k = inputFanoutBegin_[i]; k < inputFanoutBegin_[i + 1]; k++)
+		{
+			a_state.inputs_[inputFanout_[k]] = a_inputs[i];
+		}
+	}
+	DFSM_PROFILE_RECORD(diag::Phase::NETWORK_INPUTS, inputsStart, nInputs());
+	DFSM_TRACE_END(inputsSpan);
+
+	// Gate-Outputspannungen des vorherigen Schritts weiterschalten
+	DFSM_PROFILE_TICKS(propagationStart);
+	DFSM_TRACE_PHASE(propagationSpan, diag::Phase::NETWORK_PROPAGATION);
+	for (int n = 0; n < static_cast<int>(netSource_.size()); n++)
+	{
+		Volt outVoltage = a_state.outputs_[netSource_[n]];
+		for (int k = netFanoutBegin_[n]; k < netFanoutBegin_[n + 1]; k++)
+		{
+			a_state.inputs_[netFanout_[k]] = outVoltage;
+		}
+	}
+	DFSM_PROFILE_RECORD(diag::Phase::NETWORK_PROPAGATION, propagationStart,
+			netSource_.size());
+	DFSM_TRACE_END(propagationSpan);
+
+	// Alle Gates einen Simulationsschritt ausfuehren lassen
+	const Volt upperThresh = HIGH_THRESH_VOLT + DEADBAND_VOLT / 2;
+	const Volt lowerThresh = HIGH_THRESH_VOLT - DEADBAND_VOLT / 2;
+	const double k = (propagationDelay_ == 0) ? 1.0 : 1.0 / propagationDelay_;
+	DFSM_PROFILE_TICKS(gatesStart);
+	DFSM_TRACE_PHASE(gatesSpan, diag::Phase::NETWORK_GATES);
+	for (int g = 0; g < static_cast<int>(gates_.size()); g++)
+	{
+		const CompiledGate &gate = gates_[g];
+		vector<bool> &in = a_state.inScratch_;
+		vector<bool> &prevIn = a_state.prevInScratch_;
+		vector<bool> &prevOut = a_state.prevOutScratch_;
+		in.resize(gate.nInputs_);
+		prevIn.resize(gate.nInputs_);
+		prevOut.resize(gate.nOutputs_);
+		for (int i = 0; i < gate.nInputs_; i++)
+		{
+			Volt v = a_state.inputs_[gate.firstInput_ + i];
+			bool prev = a_state.prevInputsLogical_[gate.firstInput_ + i] != 0;
+			prevIn[i] = prev;
+			if (v >= upperThresh)
+			{
+				in[i] = true;
+			}
+			else if (v > lowerThresh)
+			{
+				in[i] = prev;
+			}
+			else
+			{
+				in[i] = false;
+			}
+		}
+		for (int o = 0; o < gate.nOutputs_; o++)
+		{
+			prevOut[o] = a_state.prevOutputsLogical_[gate.firstOutput_ + o] != 0;
+		}
+
+		DFSM_PROFILE_TICKS(logicStart);
+		vector<bool> out = gate.pLogic_->outputsFor(in, prevIn, prevOut);
+		DFSM_PROFILE_LOGIC(gate.pLogic_, logicStart);
+
+		for (int o = 0; o < gate.nOutputs_; o++)
+		{
+			int pin = gate.firstOutput_ + o;
+			Volt v = out[o] ? HIGH_LEVEL_VOLT : LOW_LEVEL_VOLT;
+			if (propagationDelay_ != 0)
+			{
+				v = k * (v + (propagationDelay_ - 1) * a_state.outputs_[pin]);
+			}
+			DFSM_PROFILE_TICKS(noiseStart);
+			a_state.outputs_[pin] = applyNoise(v, a_state.gen_);
+			DFSM_PROFILE_RECORD(diag::Phase::GATE_NOISE, noiseStart, 1);
+			a_state.outputToggles_[pin] += (a_state.prevOutputsLogical_[pin]
+					!= static_cast<char>(out[o]));
+			a_state.prevOutputsLogical_[pin] = out[o];
+		}
+		for (int i = 0; i < gate.nInputs_; i++)
+		{
+			a_state.prevInputsLogical_[gate.firstInput_ + i] = in[i];
+		}
+	}
+	DFSM_PROFILE_RECORD(diag::Phase::NETWORK_GATES, gatesStart, gates_.size());
+	DFSM_TRACE_END(gatesSpan);
+}
+
+sgnl::Volt CompiledNetwork::output(const NetworkState &a_state, int a_idx) const
+{
+	int pin = outputPins_[a_idx];
+	if (pin < 0)
+	{
+		return LOW_LEVEL_VOLT;
+	}
+	return a_state.outputs_[pin];
+}
@@ -0,0 +1,232 @@
+/*! \file CompiledNetwork.h
+ *  \brief Definition der Klassen CompiledNetwork und NetworkState
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef NETWORK_COMPILEDNETWORK_H_
+#define NETWORK_COMPILEDNETWORK_H_
+
+#include "Network.h"
+#include "../fileIO/Checkpoint.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+class CompiledNetwork;
+
+/*! \class NetworkState
+ *  \brief Veraenderlicher Simulationszustand eines CompiledNetwork: Spannungen
+ *  und Logiklevel aller Gate-Pins sowie ein eigener Zufallsgenerator fuer das
+ *  Rauschen. Mehrere Zustaende koennen sich dasselbe CompiledNetwork teilen
+ */
+class NetworkState
+{
+public:
+	/*! \brief Parameterloser Konstruktor. Erzeugt einen leeren Zustand, der
+	 *  erst per CompiledNetwork::createState(...) verwendbar wird
+	 */
+	NetworkState();
+
+	/*! \brief Setzt den Startwert des Zufallsgenerators fuer das Rauschen
+	 *  \param a_seed Startwert
+	 */
+	void seed(unsigned int a_seed);
+
+	/*! \brief Haengt den vollstaendigen Zustand (Pin-Spannungen,
+	 *  Logiklevel, Schaltzaehler, Position des Zufallsgenerators) an einen
+	 *  Checkpoint an
+	 *  \param a_checkpoint Checkpoint
+	 */
+	void saveState(Checkpoint &a_checkpoint) const;
+
+	/*! \brief Stellt den mit saveState(...) gespeicherten Zustand wieder her.
+	 *  Die Anzahl der Pins muss mit dem bisherigen Zustand uebereinstimmen
+	 *  \param a_checkpoint Checkpoint
+	 *  \return true, falls erfolgreich, false sonst (Zustand unveraendert)
+	 */
+	bool restoreState(Checkpoint &a_checkpoint);
+
+private:
+	friend class CompiledNetwork;
+
+	std::vector<sgnl::Volt> inputs_;       /**< Eingangsspannungen aller
+		Gate-Input-Pins im aktuellen Simulationsschritt */
+	std::vector<char> prevInputsLogical_;  /**< Eingangs-Logiklevel aller
+		Gate-Input-Pins im vorherigen Simulationsschritt */
+	std::vector<sgnl::Volt> outputs_;      /**< Ausgangsspannungen aller
+		Gate-Output-Pins */
+	std::vector<char> prevOutputsLogical_; /**< Ausgangs-Logiklevel aller
+		Gate-Output-Pins im vorherigen Simulationsschritt */
+	std::vector<int> outputToggles_;       /**< Anzahl der
+		Logiklevel-Wechsel je Gate-Output-Pin */
+	std::mt19937 gen_;  /**< Zufallsgenerator fuer das Rauschen */
+
+	std::vector<bool> inScratch_;       /**< Arbeitspuffer Input-Logiklevel */
+	std::vector<bool> prevInScratch_;   /**< Arbeitspuffer vorherige
+		Input-Logiklevel */
+	std::vector<bool> prevOutScratch_;  /**< Arbeitspuffer vorherige
+		Output-Logiklevel */
+};
+
+/*! \class CompiledNetwork
+ *  \brief Unveraenderliche, indexbasierte Form eines Networks. Beim Erzeugen
+ *  wird das Network einmal auf Konsistenz geprueft und alle Verbindungen
+ *  werden von Namen auf Pin-Indizes aufgeloest. Ein Simulationsschritt
+ *  arbeitet danach nur noch auf Arrays eines NetworkState. Da das
+ *  CompiledNetwork selbst nicht veraendert wird, kann es von beliebig vielen
+ *  Testbeds und Threads gleichzeitig verwendet werden
+ */
+class CompiledNetwork
+{
+public:
+	/*! \brief Konstruktor. Uebersetzt das uebergebene Network
+	 *  \param a_network Zu uebersetzendes Network
+	 */
+	CompiledNetwork(const Network &a_network);
+
+	/*! \brief Gibt zurueck, ob das uebersetzte Network konsistent ist
+	 *  \return true, falls konsistent, false sonst
+	 */
+	bool valid() const;
+
+	/*! \brief Gibt den Namen des Networks zurueck
+	 *  \return Name des Networks
+	 */
+	std::string name() const;
+
+	/*! \brief Gibt die Anzahl der Network-Inputs zurueck
+	 *  \return Anzahl der Network-Inputs
+	 */
+	int nInputs() const;
+
+	/*! \brief Gibt die Anzahl der Network-Outputs zurueck
+	 *  \return Anzahl der Network-Outputs
+	 */
+	int nOutputs() const;
+
+	/*! \brief Gibt die Anzahl der Gates zurueck
+	 *  \return Anzahl der Gates
+	 */
+	int nGates() const;
+
+	/*! \brief Gibt die Namen der Network-Inputs zurueck, der Index entspricht
+	 *  dem Index in simulationStep(...)
+	 *  \return Namen der Network-Inputs
+	 */
+	const std::vector<std::string>& inputNames() const;
+
+	/*! \brief Gibt die Namen der Network-Outputs zurueck, der Index entspricht
+	 *  dem Index in output(...)
+	 *  \return Namen der Network-Outputs
+	 */
+	const std::vector<std::string>& outputNames() const;
+
+	/*! \brief Gibt die Anzahl aller Gate-Output-Pins zurueck
+	 *  \return Anzahl der Gate-Output-Pins
+	 */
+	int nOutputPins() const;
+
+	/*! \brief Gibt den Namen eines Gate-Output-Pins zurueck
+	 *  \param a_pin Index des Gate-Output-Pins (0 bis nOutputPins()-1)
+	 *  \return "<Gatename>:<Output-Index>"
+	 */
+	std::string outputPinName(int a_pin) const;
+
+	/*! \brief Gibt die Anzahl der von einem Gate-Output-Pin getriebenen
+	 *  Gate-Inputs zurueck
+	 *  \param a_pin Index des Gate-Output-Pins
+	 *  \return Fanout
+	 */
+	int outputPinFanout(int a_pin) const;
+
+	/*! \brief Gibt die Anzahl der von einem Network-Input getriebenen
+	 *  Gate-Inputs zurueck
+	 *  \param a_idx Index des Network-Inputs
+	 *  \return Fanout
+	 */
+	int inputFanout(int a_idx) const;
+
+	/*! \brief Gibt zurueck, wie oft das Logiklevel eines Gate-Output-Pins
+	 *  seit createState(...) gewechselt hat
+	 *  \param a_state Simulationszustand
+	 *  \param a_pin Index des Gate-Output-Pins
+	 *  \return Anzahl der Wechsel
+	 */
+	int outputToggles(const NetworkState &a_state, int a_pin) const;
+
+	/*! \brief Gibt den Index des Network-Inputs mit dem angegebenen Namen
+	 *  zurueck
+	 *  \param a_name Name des Network-Inputs
+	 *  \return Index oder -1, falls kein solcher Input existiert
+	 */
+	int inputIndex(const std::string &a_name) const;
+
+	/*! \brief Gibt den Index des Network-Outputs mit dem angegebenen Namen
+	 *  zurueck
+	 *  \param a_name Name des Network-Outputs
+	 *  \return Index oder -1, falls kein solcher Output existiert
+	 */
+	int outputIndex(const std::string &a_name) const;
+
+	/*! \brief Erzeugt einen neuen Simulationszustand (alle Pins auf
+	 *  LOW_LEVEL_VOLT bzw. false)
+	 *  \param a_seed Startwert des Zufallsgenerators fuer das Rauschen
+	 *  \return Neuer Simulationszustand
+	 */
+	NetworkState createState(unsigned int a_seed) const;
+
+	/*! \brief Fuehrt einen Simulationsschritt auf dem uebergebenen Zustand
+	 *  durch. Ablauf wie Network::simulationStep(...)
+	 *  \param a_state Zu verwendender Simulationszustand
+	 *  \param a_inputs Inputspannungen, nInputs() Werte
+	 */
+	void simulationStep(NetworkState &a_state, const sgnl::Volt *a_inputs) const;
+
+	/*! \brief Gibt die aktuelle Spannung am Network-Output mit dem
+	 *  angegebenen Index zurueck
+	 *  \param a_state Simulationszustand
+	 *  \param a_idx Index des Network-Outputs
+	 *  \return Outputspannung
+	 */
+	sgnl::Volt output(const NetworkState &a_state, int a_idx) const;
+
+private:
+	/*! \brief Indexbasierte Beschreibung eines Gates
+	 */
+	struct CompiledGate
+	{
+		const GateLogic *pLogic_;  /**< Gatelogik */
+		int firstInput_;   /**< Index des ersten Input-Pins im NetworkState */
+		int nInputs_;      /**< Anzahl der Inputs */
+		int firstOutput_;  /**< Index des ersten Output-Pins im NetworkState */
+		int nOutputs_;     /**< Anzahl der Outputs */
+	};
+
+	std::string name_;                      /**< Name des Networks */
+	sgnl::Nanoseconds propagationDelay_;    /**< Gatterlaufzeit */
+	bool valid_;                            /**< Network konsistent */
+	std::vector<std::string> inputNames_;   /**< Namen der Network-Inputs */
+	std::vector<std::string> outputNames_;  /**< Namen der Network-Outputs */
+	std::vector<CompiledGate> gates_;       /**< Gates in Simulationsreihenfolge */
+	std::vector<std::string> gateNames_;    /**< Namen der Gates, Index wie gates_ */
+	int nInputPins_;   /**< Anzahl aller Gate-Input-Pins */
+	int nOutputPins_;  /**< Anzahl aller Gate-Output-Pins */
+
+	std::vector<int> inputFanoutBegin_;  /**< Je Network-Input: Beginn in
+		inputFanout_ (nInputs()+1 Eintraege) */
+	std::vector<int> inputFanout_;       /**< Gate-Input-Pins der
+		Network-Inputs */
+	std::vector<int> netSource_;         /**< Je Gate-zu-Gate-Verbindung:
+		treibender Gate-Output-Pin */
+	std::vector<int> netFanoutBegin_;    /**< Je Gate-zu-Gate-Verbindung:
+		Beginn in netFanout_ */
+	std::vector<int> netFanout_;         /**< Getriebene Gate-Input-Pins */
+	std::vector<int> outputPins_;        /**< Je Network-Output: treibender
+		Gate-Output-Pin */
+	std::vector<int> outputPinFanout_;   /**< Je Gate-Output-Pin: Anzahl
+		getriebener Gate-Input-Pins */
+};
+
+#endif /* NETWORK_COMPILEDNETWORK_H_ */
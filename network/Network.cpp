@@ -5,9 +5,16 @@
  */
 
 #include "Network.h"
+#include "../diag/Log.h"
+
+#include "../diag/AllocTracker.h"
+#include "../diag/Profiler.h"
+#include "../diag/Trace.h"
 
 #include <iostream>
 #include <utility>
+#include <iterator>
+#include <set>
 
 using namespace sgnl;
 using namespace std;
@@ -17,7 +24,7 @@ Network::Network(std::string a_name, sgnl::Nanoseconds a_propagationDelay) :
 {
 	if (a_propagationDelay < 0)
 	{
-		cerr << "Network: Propagation delay must be >= 0." << endl;
+		DFSM_LOG_WARNING("Network", "Propagation delay must be >= 0.");
 		propagationDelay_ = 0;
 	}
 }
@@ -51,13 +58,16 @@ std::vector<std::string> Network::inputNames() const
 
 void Network::simulationStep(const std::map<std::string, sgnl::Volt> &a_inputs)
 {
+	DFSM_ALLOC_SCOPE(allocScope, diag::AllocSubsystem::NETWORK);
+	DFSM_PROFILE_TICKS(inputsStart);
+	DFSM_TRACE_PHASE(inputsSpan, diag::Phase::NETWORK_INPUTS);
 
 	for (map<string, vector<Pin> >::const_iterator it = inputConnections_.begin();
 			it != inputConnections_.end(); it++)
 	{
 		if (a_inputs.count(it->first) == 0)
 		{
-			cerr << "Network: Input " << it->first << " not supplied." << endl;
+			DFSM_LOG_ERROR("Network", "Input " << it->first << " not supplied.");
 			return;
 		}
 	}
@@ -74,7 +84,12 @@ void Network::simulationStep(const std::map<std::string, sgnl::Volt> &a_inputs)
 			gates_[inGateName].setInput(inGateIdx, inVoltage);
 		}
 	}
+	DFSM_PROFILE_RECORD(diag::Phase::NETWORK_INPUTS, inputsStart,
+			inputConnections_.size());
+	DFSM_TRACE_END(inputsSpan);
 
+	DFSM_PROFILE_TICKS(propagationStart);
+	DFSM_TRACE_PHASE(propagationSpan, diag::Phase::NETWORK_PROPAGATION);
 	for (map<Pin, vector<Pin> >::iterator it = gate2GateConnections_.begin();
 			it != gate2GateConnections_.end(); it++)
 	{
@@ -90,12 +105,96 @@ void Network::simulationStep(const std::map<std::string, sgnl::Volt> &a_inputs)
 			gates_[inGateName].setInput(inGateIdx, outVoltage);
 		}
 	}
+	DFSM_PROFILE_RECORD(diag::Phase::NETWORK_PROPAGATION, propagationStart,
+			gate2GateConnections_.size());
+	DFSM_TRACE_END(propagationSpan);
 
+	DFSM_PROFILE_TICKS(gatesStart);
+	DFSM_TRACE_PHASE(gatesSpan, diag::Phase::NETWORK_GATES);
 	for (map<string, Gate>::iterator it = gates_.begin(); it != gates_.end();
 			it++)
 	{
 		it->second.simulationStep();
 	}
+	DFSM_PROFILE_RECORD(diag::Phase::NETWORK_GATES, gatesStart, gates_.size());
+	DFSM_TRACE_END(gatesSpan);
+}
+
+void Network::simulationStep(const std::vector<sgnl::Volt> &a_inputs)
+{
+	DFSM_ALLOC_SCOPE(allocScope, diag::AllocSubsystem::NETWORK);
+	if (a_inputs.size() != inputConnections_.size())
+	{
+		DFSM_LOG_ERROR("Network", "Expected " << inputConnections_.size()
+				<< " input voltages (have " << a_inputs.size() << ").");
+		return;
+	}
+
+	DFSM_PROFILE_TICKS(inputsStart);
+	DFSM_TRACE_PHASE(inputsSpan, diag::Phase::NETWORK_INPUTS);
+	int inIdx = 0;
+	for (map<string, vector<Pin> >::const_iterator it = inputConnections_.begin();
+			it != inputConnections_.end(); it++, inIdx++)
+	{
+		Volt inVoltage = a_inputs[inIdx];
+		for (int i = 0; i < static_cast<int>(it->second.size()); i++)
+		{
+			gates_[it->second[i].gateName()].setInput(it->second[i].idx(),
+					inVoltage);
+		}
+	}
+	DFSM_PROFILE_RECORD(diag::Phase::NETWORK_INPUTS, inputsStart,
+			inputConnections_.size());
+	DFSM_TRACE_END(inputsSpan);
+
+	DFSM_PROFILE_TICKS(propagationStart);
+	DFSM_TRACE_PHASE(propagationSpan, diag::Phase::NETWORK_PROPAGATION);
+	for (map<Pin, vector<Pin> >::iterator it = gate2GateConnections_.begin();
+			it != gate2GateConnections_.end(); it++)
+	{
+		Volt outVoltage =
+				gates_[it->first.gateName()].outputs()[it->first.idx()];
+		for (int i = 0; i < static_cast<int>(it->second.size()); i++)
+		{
+			gates_[it->second[i].gateName()].setInput(it->second[i].idx(),
+					outVoltage);
+		}
+	}
+	DFSM_PROFILE_RECORD(diag::Phase::NETWORK_PROPAGATION, propagationStart,
+			gate2GateConnections_.size());
+	DFSM_TRACE_END(propagationSpan);
+
+	DFSM_PROFILE_TICKS(gatesStart);
+	DFSM_TRACE_PHASE(gatesSpan, diag::Phase::NETWORK_GATES);
+	for (map<string, Gate>::iterator it = gates_.begin(); it != gates_.end();
+			it++)
+	{
+		it->second.simulationStep();
+	}
+	DFSM_PROFILE_RECORD(diag::Phase::NETWORK_GATES, gatesStart, gates_.size());
+	DFSM_TRACE_END(gatesSpan);
+}
+
+std::vector<sgnl::Volt> Network::outputVoltages() const
+{
+	vector<Volt> ret;
+	ret.reserve(outputConnections_.size());
+	for (map<string, Pin>::const_iterator it = outputConnections_.begin();
+			it != outputConnections_.end(); it++)
+	{
+		ret.push_back(gates_.at(it->second.gateName()).outputs()[it->second.idx()]);
+	}
+	return ret;
+}
+
+int Network::inputIndex(const std::string &a_name) const
+{
+	map<string, vector<Pin> >::const_iterator it = inputConnections_.find(a_name);
+	if (it == inputConnections_.end())
+	{
+		return -1;
+	}
+	return static_cast<int>(distance(inputConnections_.begin(), it));
 }
 
 std::map<std::string, sgnl::Volt> Network::outputs() const
@@ -115,32 +214,38 @@ std::map<std::string, sgnl::Volt> Network::outputs() const
 
 void Network::prettyPrint() const
 {
-	cout << "Network definition" << endl;
-	cout << "==================" << endl;
-	cout << endl;
+	prettyPrint(cout);
+	return;
+}
+
+void Network::prettyPrint(std::ostream &a_os) const
+{
+	a_os << "Network definition" << endl;
+	a_os << "==================" << endl;
+	a_os << endl;
 
-	cout << "Name: " << name_ << endl;
-	cout << "Propagation delay: " << propagationDelay_ << " nsec" << endl
+	a_os << "Name: " << name_ << endl;
+	a_os << "Propagation delay: " << propagationDelay_ << " nsec" << endl
 			<< endl;
 
-	cout << "Inputs" << endl;
+	a_os << "Inputs" << endl;
 	for (map<string, vector<Pin> >::const_iterator it = inputConnections_.begin();
 			it != inputConnections_.end(); it++)
 	{
 		string inName = it->first;
-		cout << "    " << inName << endl;
+		a_os << "    " << inName << endl;
 		for (int i = 0; i < static_cast<int>(it->second.size()); i++)
 		{
 			string gateName = it->second[i].gateName();
 			string typeName = gates_.at(gateName).logicName();
 			int idx = it->second[i].idx();
-			cout << "     => " << gateName << " (" << typeName << ") I" << idx
+			a_os << "     => " << gateName << " (" << typeName << ") I" << idx
 					<< endl;
 		}
 	}
-	cout << endl;
+	a_os << endl;
 
-	cout << "Outputs" << endl;
+	a_os << "Outputs" << endl;
 	for (map<string, Pin>::const_iterator it = outputConnections_.begin();
 			it != outputConnections_.end(); it++)
 	{
@@ -148,12 +253,12 @@ void Network::prettyPrint() const
 		string gateName = it->second.gateName();
 		string typeName = gates_.at(gateName).logicName();
 		int idx = it->second.idx();
-		cout << "    " << gateName << " (" << typeName << ") O" << idx << " => "
+		a_os << "    " << gateName << " (" << typeName << ") O" << idx << " => "
 				<< outName << endl;
 	}
-	cout << endl;
+	a_os << endl;
 
-	cout << "Gate-to-gate connections" << endl;
+	a_os << "Gate-to-gate connections" << endl;
 	for (map<Pin, vector<Pin> >::const_iterator it = gate2GateConnections_.begin();
 			it != gate2GateConnections_.end(); it++)
 	{
@@ -165,12 +270,12 @@ void Network::prettyPrint() const
 			string inGateName = it->second[i].gateName();
 			string inTypeName = gates_.at(inGateName).logicName();
 			int inIdx = it->second[i].idx();
-			cout << "    " << outGateName << " (" << outTypeName << ") O"
+			a_os << "    " << outGateName << " (" << outTypeName << ") O"
 					<< outIdx << " => " << inGateName << " (" << inTypeName
 					<< ") I" << inIdx << endl;
 		}
 	}
-	cout << endl;
+	a_os << endl;
 	return;
 }
 
@@ -179,17 +284,17 @@ bool Network::consistent() const
 	bool ret = true;
 	if (inputConnections_.empty())
 	{
-		cerr << "Network: Network needs at least one input." << endl;
+		DFSM_LOG_ERROR("Network", "Network needs at least one input.");
 		ret = false;
 	}
 	if (outputConnections_.empty())
 	{
-		cerr << "Network: Network needs at least one output." << endl;
+		DFSM_LOG_ERROR("Network", "Network needs at least one output.");
 		ret = false;
 	}
 	if (gates_.empty())
 	{
-		cerr << "Network: Network needs at least one gate." << endl;
+		DFSM_LOG_ERROR("Network", "Network needs at least one gate.");
 		ret = false;
 	}
 
@@ -198,8 +303,7 @@ bool Network::consistent() const
 	{
 		if (it->second.size() < 1)
 		{
-			cerr << "Network: Input " << it->first << " is not connected."
-					<< endl;
+			DFSM_LOG_ERROR("Network", "Input " << it->first << " is not connected.");
 			ret = false;
 		}
 	}
@@ -209,12 +313,32 @@ bool Network::consistent() const
 	{
 		if (it->second.gateName() == "")
 		{
-			cerr << "Network: Output " << it->first << " is not connected."
-					<< endl;
+			DFSM_LOG_ERROR("Network", "Output " << it->first << " is not connected.");
 			ret = false;
 		}
 	}
 
+	// Verbindungen je Gate-Input-Pin einmal zaehlen statt fuer jeden Pin alle
+	// Verbindungen zu durchsuchen
+	map<Pin, int> nOccurrences;
+	for (map<Pin, vector<Pin> >::const_iterator c_it =
+			gate2GateConnections_.begin(); c_it != gate2GateConnections_.end();
+			c_it++)
+	{
+		for (int k = 0; k < static_cast<int>(c_it->second.size()); k++)
+		{
+			nOccurrences[c_it->second[k]]++;
+		}
+	}
+	for (map<string, vector<Pin> >::const_iterator i_it =
+			inputConnections_.begin(); i_it != inputConnections_.end(); i_it++)
+	{
+		for (int k = 0; k < static_cast<int>(i_it->second.size()); k++)
+		{
+			nOccurrences[i_it->second[k]]++;
+		}
+	}
+
 	for (map<string, Gate>::const_iterator g_it = gates_.begin();
 			g_it != gates_.end(); g_it++)
 	{
@@ -222,48 +346,30 @@ bool Network::consistent() const
 		int nGateInputs = g_it->second.nInputs();
 		for (int i = 0; i < nGateInputs; i++)
 		{
-			Pin pinToCheck(gateName, i);
-			int nOccurrences = 0;
-			for (map<Pin, vector<Pin> >::const_iterator c_it =
-					gate2GateConnections_.begin();
-					c_it != gate2GateConnections_.end(); c_it++)
-			{
-				for (int k = 0; k < static_cast<int>(c_it->second.size()); k++)
-				{
-					if (c_it->second[k] == pinToCheck)
-					{
-						nOccurrences++;
-					}
-				}
-			}
-			for (map<string, vector<Pin> >::const_iterator i_it =
-					inputConnections_.begin(); i_it != inputConnections_.end();
-					i_it++)
-			{
-				for (int k = 0; k < static_cast<int>(i_it->second.size()); k++)
-				{
-					if (i_it->second[k] == pinToCheck)
-					{
-						nOccurrences++;
-					}
-				}
-			}
-			if (nOccurrences != 1)
+			map<Pin, int>::const_iterator o_it = nOccurrences.find(
+					Pin(gateName, i));
+			int nPinOccurrences = (o_it == nOccurrences.end()) ? 0 : o_it->second;
+			if (nPinOccurrences != 1)
 			{
-				cerr << "Network: Gate " << gateName << ", input " << i
+				DFSM_LOG_ERROR("Network", "Gate " << gateName << ", input " << i
 						<< " must be connected exactly once (have "
-						<< nOccurrences << ")." << endl;
+						<< nPinOccurrences << ").");
 				ret = false;
 			}
 		}
 	}
 
+	set<Pin> outputPins;
+	for (map<string, Pin>::const_iterator o_it = outputConnections_.begin();
+			o_it != outputConnections_.end(); o_it++)
+	{
+		outputPins.insert(o_it->second);
+	}
 	for (map<string, Gate>::const_iterator g_it = gates_.begin();
 			g_it != gates_.end(); g_it++)
 	{
 		string gateName = g_it->first;
 		int nGateOutputs = g_it->second.nOutputs();
-		bool breakOuterLoop = false;
 		for (int i = 0; i < nGateOutputs; i++)
 		{
 			Pin pinToCheck(gateName, i);
@@ -271,32 +377,23 @@ bool Network::consistent() const
 			{
 				break;
 			}
-			for (map<string, Pin>::const_iterator o_it = outputConnections_.begin();
-					o_it != outputConnections_.end(); o_it++)
-			{
-				if (o_it->second == pinToCheck)
-				{
-					breakOuterLoop = true;
-					break;
-				}
-			}
-			if (breakOuterLoop)
+			if (outputPins.count(pinToCheck) > 0)
 			{
 				break;
 			}
-			cerr << "Network: Gate " << gateName << ", output " << i
-					<< " must be connected at least once." << endl;
+			DFSM_LOG_ERROR("Network", "Gate " << gateName << ", output " << i
+					<< " must be connected at least once.");
 			ret = false;
 		}
 	}
 
 	if (ret == true)
 	{
-		cout << "Network: Consistency check: OK." << endl;
+		DFSM_LOG_INFO("Network", "Consistency check: OK.");
 	}
 	else
 	{
-		cerr << "Network: Consistency check: Erroneous Network, s. a." << endl;
+		DFSM_LOG_ERROR("Network", "Consistency check: Erroneous Network, s. a.");
 	}
 
 	return ret;
@@ -307,27 +404,27 @@ bool Network::connectOutput(std::string a_outputName, std::string a_outGateName,
 {
 	if (outputConnections_.count(a_outputName) == 0)
 	{
-		cerr << "Network: outputName: Output with name " << a_outputName
-				<< " does not exist." << endl;
+		DFSM_LOG_ERROR("Network", "outputName: Output with name " << a_outputName
+				<< " does not exist.");
 		return false;
 	}
 	if (!(outputConnections_[a_outputName].empty()))
 	{
-		cerr << "Network: outputName: Output with name " << a_outputName
-				<< " has already been connected." << endl;
+		DFSM_LOG_ERROR("Network", "outputName: Output with name " << a_outputName
+				<< " has already been connected.");
 		return false;
 	}
 	if (gates_.count(a_outGateName) == 0)
 	{
-		cerr << "Network: outGateName: Gate with name " << a_outGateName
-				<< " does not exist." << endl;
+		DFSM_LOG_ERROR("Network", "outGateName: Gate with name " << a_outGateName
+				<< " does not exist.");
 		return false;
 	}
 	if (gates_[a_outGateName].nOutputs() <= a_outPinIdx)
 	{
-		cerr << "Network: outGateIdx: Gate with name " << a_outGateName
+		DFSM_LOG_ERROR("Network", "outGateIdx: Gate with name " << a_outGateName
 				<< " has only " << gates_[a_outGateName].nOutputs()
-				<< " outputs (idx " << a_outPinIdx << " requested)." << endl;
+				<< " outputs (idx " << a_outPinIdx << " requested).");
 		return false;
 	}
 
@@ -341,29 +438,29 @@ bool Network::connectInput(std::string a_inputName, std::string a_inGateName,
 {
 	if (inputConnections_.count(a_inputName) == 0)
 	{
-		cerr << "Network: inputName: Input with name " << a_inputName
-				<< " does not exist." << endl;
+		DFSM_LOG_ERROR("Network", "inputName: Input with name " << a_inputName
+				<< " does not exist.");
 		return false;
 	}
 	if (gates_.count(a_inGateName) == 0)
 	{
-		cerr << "Network: inGateName: Gate with name " << a_inGateName
-				<< " does not exist." << endl;
+		DFSM_LOG_ERROR("Network", "inGateName: Gate with name " << a_inGateName
+				<< " does not exist.");
 		return false;
 	}
 	if (gates_[a_inGateName].nInputs() <= a_inPinIdx)
 	{
-		cerr << "Network: inGateIdx: Gate with name " << a_inGateName
+		DFSM_LOG_ERROR("Network", "inGateIdx: Gate with name " << a_inGateName
 				<< " has only " << gates_[a_inGateName].nInputs()
-				<< " inputs (idx " << a_inPinIdx << " requested)." << endl;
+				<< " inputs (idx " << a_inPinIdx << " requested).");
 		return false;
 	}
 
 	Pin inPin(a_inGateName, a_inPinIdx);
 	if (inPinAlreadyConnected(inPin))
 	{
-		cerr << "Network: Gate " << a_inGateName << ", input " << a_inPinIdx
-				<< " has already been connected." << endl;
+		DFSM_LOG_ERROR("Network", "Gate " << a_inGateName << ", input " << a_inPinIdx
+				<< " has already been connected.");
 		return false;
 	}
 
@@ -373,6 +470,7 @@ bool Network::connectInput(std::string a_inputName, std::string a_inGateName,
 				pair<string, vector<Pin> >(a_inputName, vector<Pin>()));
 	}
 	inputConnections_[a_inputName].push_back(inPin);
+	connectedInPins_.insert(inPin);
 	return true;
 }
 
@@ -381,36 +479,36 @@ bool Network::connectGates(std::string a_outGateName, int a_outPinIdx,
 {
 	if (gates_.count(a_outGateName) == 0)
 	{
-		cerr << "Network: outGateName: Gate with name " << a_outGateName
-				<< " does not exist." << endl;
+		DFSM_LOG_ERROR("Network", "outGateName: Gate with name " << a_outGateName
+				<< " does not exist.");
 		return false;
 	}
 	if (gates_[a_outGateName].nOutputs() <= a_outPinIdx)
 	{
-		cerr << "Network: outGateIdx: Gate with name " << a_outGateName
+		DFSM_LOG_ERROR("Network", "outGateIdx: Gate with name " << a_outGateName
 				<< " has only " << gates_[a_outGateName].nOutputs()
-				<< " outputs (idx " << a_outPinIdx << " requested)." << endl;
+				<< " outputs (idx " << a_outPinIdx << " requested).");
 		return false;
 	}
 	if (gates_.count(a_inGateName) == 0)
 	{
-		cerr << "Network: inGateName: Gate with name " << a_inGateName
-				<< " does not exist." << endl;
+		DFSM_LOG_ERROR("Network", "inGateName: Gate with name " << a_inGateName
+				<< " does not exist.");
 		return false;
 	}
 	if (gates_[a_inGateName].nInputs() <= a_inPinIdx)
 	{
-		cerr << "Network: inGateIdx: Gate with name " << a_inGateName
+		DFSM_LOG_ERROR("Network", "inGateIdx: Gate with name " << a_inGateName
 				<< " has only " << gates_[a_inGateName].nInputs()
-				<< " inputs (idx " << a_inPinIdx << " requested)." << endl;
+				<< " inputs (idx " << a_inPinIdx << " requested).");
 		return false;
 	}
 
 	Pin inPin(a_inGateName, a_inPinIdx);
 	if (inPinAlreadyConnected(inPin))
 	{
-		cerr << "Network: Gate " << a_inGateName << ", input " << a_inPinIdx
-				<< " has already been connected." << endl;
+		DFSM_LOG_ERROR("Network", "Gate " << a_inGateName << ", input " << a_inPinIdx
+				<< " has already been connected.");
 		return false;
 	}
 
@@ -421,6 +519,7 @@ bool Network::connectGates(std::string a_outGateName, int a_outPinIdx,
 				pair<Pin, vector<Pin> >(outPin, vector<Pin>()));
 	}
 	gate2GateConnections_[outPin].push_back(inPin);
+	connectedInPins_.insert(inPin);
 	return true;
 }
 
@@ -429,29 +528,7 @@ bool Network::connectGates(std::string a_outGateName, int a_outPinIdx,
 
 bool Network::inPinAlreadyConnected(Pin a_inPin) const
 {
-	for (map<Pin, vector<Pin> >::const_iterator it = gate2GateConnections_.begin();
-			it != gate2GateConnections_.end(); it++)
-	{
-		for (int i = 0; i < static_cast<int>(it->second.size()); i++)
-		{
-			if (a_inPin == it->second[i])
-			{
-				return true;
-			}
-		}
-	}
-	for (map<string, vector<Pin> >::const_iterator it = inputConnections_.begin();
-			it != inputConnections_.end(); it++)
-	{
-		for (int i = 0; i < static_cast<int>(it->second.size()); i++)
-		{
-			if (a_inPin == it->second[i])
-			{
-				return true;
-			}
-		}
-	}
-	return false;
+	return connectedInPins_.count(a_inPin) > 0;
 }
 
 bool Network::addOutput(const std::string &a_name)
@@ -488,25 +565,22 @@ bool Network::assert_NameValid(std::string a_name) const
 {
 	if (a_name.empty())
 	{
-		cerr << "Network: Name may not be empty." << endl;
+		DFSM_LOG_ERROR("Network", "Name may not be empty.");
 		return false;
 	}
 	if (gates_.count(a_name) > 0)
 	{
-		cerr << "Network: A gate with name " << a_name << " already exists."
-				<< endl;
+		DFSM_LOG_ERROR("Network", "A gate with name " << a_name << " already exists.");
 		return false;
 	}
 	if (inputConnections_.count(a_name) > 0)
 	{
-		cerr << "Network: An input with name " << a_name << " already exists."
-				<< endl;
+		DFSM_LOG_ERROR("Network", "An input with name " << a_name << " already exists.");
 		return false;
 	}
 	if (outputConnections_.count(a_name) > 0)
 	{
-		cerr << "Network: An output with name " << a_name << " already exists."
-				<< endl;
+		DFSM_LOG_ERROR("Network", "An output with name " << a_name << " already exists.");
 		return false;
 	}
 	return true;
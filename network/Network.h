@@ -7,10 +7,12 @@
 
 #ifndef GATE_NETWORK_H_
 #define GATE_NETWORK_H_
+#include <iosfwd>
 #include <string>
 #include "../signal/Signal.h"
 #include "../gate/Gate.h"
 #include <map>
+#include <set>
 #include "../gate/Pin.h"
 using namespace sgnl;
 class Network
@@ -20,6 +22,7 @@ private:
 	std::map<std::string, std::vector<Pin> > inputConnections_;/**<die Verbindungen zwischen den Network-Inputs und den Gate-Input-Pins*/
 	std::map<std::string, Pin> outputConnections_;/**<die Verbindungen zwischen den Gate-Output-Pins und den Network-Outputs*/
 	std::map<Pin, std::vector<Pin> > gate2GateConnections_; /**<die Verbindungen zwischen den Gates*/
+	std::set<Pin> connectedInPins_; /**<alle bereits verbundenen Gate-Input-Pins, fuer inPinAlreadyConnected(...)*/
 	std::string name_; /**< Name des Networks */
 	sgnl::Nanoseconds propagationDelay_; /**< Gatterlaufzeit des Networks*/
 
@@ -106,6 +109,13 @@ public:
 	 */
 
 	void simulationStep(const std::map<std::string, sgnl::Volt> &a_inputs);
+	/*! \brief Simulationsschritt wie simulationStep(std::map), die
+	 * Inputspannungen werden jedoch per Index statt per Name uebergeben. Die
+	 * Reihenfolge entspricht inputNames(). Damit entfaellt die Suche nach
+	 * den Input-Namen in jedem Schritt
+	 * \param a_inputs Inputspannungen, ein Wert pro Network-Input
+	 */
+	void simulationStep(const std::vector<sgnl::Volt> &a_inputs);
 	/*! \brief Das Network muss auf Konsistenz geprueft werden koennen
 	 * - Pruepft :ob ein Gate-Input Pin mit mehr als einem Output verbunden?
 	 * - Ob kein Output oder kein einziges Gate hatte
@@ -119,11 +129,26 @@ public:
 	 * geschieht der Zugriff auf die Spannungen per Angabe des Network-Output-Namens.
 	 */
 	std::map<std::string, sgnl::Volt> outputs() const;
+	/*! \brief Gibt die aktuellen Spannungen an den Network-Outputs per Index
+	 * zurueck. Die Reihenfolge entspricht outputNames()
+	 * \return Outputspannungen, ein Wert pro Network-Output
+	 */
+	std::vector<sgnl::Volt> outputVoltages() const;
+	/*! \brief Gibt den Index des Network-Inputs mit dem angegebenen Namen
+	 * zurueck (Reihenfolge wie inputNames())
+	 * \param a_name Name des Network-Inputs
+	 * \return Index des Inputs oder -1, falls kein solcher Input existiert
+	 */
+	int inputIndex(const std::string &a_name) const;
 	/*! \brief sollen alle Attribute des Networks und der enthaltenen Gates gut lesbar auf der Konsole
 	 * ausgegeben werden.
 	 * \return void
 	 */
 	void prettyPrint() const;
+	/*! \brief Wie prettyPrint(), schreibt aber in den angegebenen Stream
+	 * \param a_os Ausgabe
+	 */
+	void prettyPrint(std::ostream &a_os) const;
 	/*! \brief Gibt den Name des Networks aus
 	 * \return std::string Name des Networks
 	 */
@@ -5,11 +5,18 @@
  */
 
 #include "BMPPlot.h"
+#include "BmpBackend.h"
+#include "GlyphAtlas.h"
+#include "../util/ThreadPool.h"
+#include "../diag/Log.h"
 
 #include <iostream>
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
 
 using namespace std;
@@ -17,41 +24,185 @@ using namespace sgnl;
 
 
 BMPPlot::BMPPlot(const std::string& a_title) :
-	plot_(1280, 800),
-	nSignals_(0)
+	BMPPlot(a_title, 1280, 800)
 {
-	if(font_.load("./myCode/plot/font/font.bmp") != 0)
-	{
-		cerr << "BMPPlot: Failed to load font.bmp in folder myCode/plot/font/font.bmp"
-			 << endl;
-	}
-	fontSizeX_ = font_.getWidth()/69;
-	fontSizeY_ = font_.getHeight();
+
+}
+
+BMPPlot::BMPPlot(const std::string& a_title, int a_width, int a_height) :
+	plot_(std::max(a_width, 200), std::max(a_height, 200)),
+	nSignals_(0),
+	direct_(true),
+	logic_(false),
+	axis_(plot_.getWidth()-101),
+	backend_(new BmpBackend()),
+	sceneTraces_(false)
+{
+	// Schwarzer Hintergrund, SimpleBMP initialisiert die Pixel nicht
+	std::fill(plot_.getPixels(),
+		plot_.getPixels() + plot_.getWidth()*plot_.getHeight()*3, 0);
+	// Der Zeichensatz wird nur beim ersten Plot des Prozesses geladen
+	const GlyphAtlas& atlas = GlyphAtlas::instance();
+	fontSizeX_ = atlas.glyphWidth();
+	fontSizeY_ = atlas.glyphHeight();
+	scene_.width_ = plot_.getWidth();
+	scene_.height_ = plot_.getHeight();
+	scene_.glyphWidth_ = fontSizeX_;
+	scene_.glyphHeight_ = fontSizeY_;
 	plotText(Coordinate{fontSizeX_, fontSizeY_}, a_title);
 }
 
+int BMPPlot::heightFor(int a_nSignals)
+{
+	// Titel, Zeitachse und je Signal vier Zeilen des 16 Pixel hohen
+	// Zeichensatzes plus Rand
+	return 16*(8 + 4*std::max(a_nSignals, 1));
+}
+
 void BMPPlot::add(
 	const std::string& a_signalName,
 	const std::vector<sgnl::Volt>& a_signal)
 {
+	if(logic_)
+	{
+		addLogic(a_signalName, LogicTrace(a_signal));
+		return;
+	}
+	addSignal(a_signalName, a_signal, envelopeFor(a_signal));
+	return;
+}
+
+void BMPPlot::add(
+	const std::vector<std::string>& a_signalNames,
+	const std::vector<const std::vector<sgnl::Volt>*>& a_signals,
+	int a_nThreads)
+{
+	if(logic_)
+	{
+		for(int s=0; s<static_cast<int>(a_signals.size()); s++)
+		{
+			addLogic(a_signalNames[s], LogicTrace(*a_signals[s]));
+		}
+		return;
+	}
+	// Nur die Huellkurven werden parallel berechnet, geplottet wird der Reihe
+	// nach
+	vector<Envelope> envelopes(a_signals.size());
+	ThreadPool::forEach(static_cast<int>(a_signals.size()), a_nThreads,
+		[this, &a_signals, &envelopes](int a_s)
+		{
+			envelopes[a_s] = envelopeFor(*a_signals[a_s]);
+		});
+	for(int s=0; s<static_cast<int>(a_signals.size()); s++)
+	{
+		addSignal(a_signalNames[s], *a_signals[s], envelopes[s]);
+	}
+	return;
+}
+
+void BMPPlot::add(
+	const std::string& a_signalName,
+	const WaveformPyramid& a_pyramid)
+{
+	if(logic_)
+	{
+		addLogic(a_signalName, LogicTrace(a_pyramid.values()));
+		return;
+	}
+	Nanoseconds begin = 0;
+	Nanoseconds end = 0;
+	int nColumns = axis_.envelopeColumns(a_pyramid.length(), begin, end);
+	addSignal(a_signalName, a_pyramid.values(), nColumns > 0
+		? a_pyramid.envelope(begin, end, nColumns) : Envelope());
+	return;
+}
+
+void BMPPlot::addLogic(
+	const std::string& a_signalName,
+	const LogicTrace& a_trace)
+{
+	Nanoseconds begin = 0;
+	Nanoseconds end = 0;
+	axis_.window(a_trace.length(), begin, end);
+	Nanoseconds length = axis_.length(a_trace.length());
 	plotSignalName(a_signalName);
-	plotAxes(a_signal.size());
-	plotSignalValues(a_signal);
+	plotAxes(axis_.columns(length));
+	if(end > begin)
+	{
+		plotLogic(a_trace, begin, end, length);
+	}
+	nSignals_++;
+	return;
+}
+
+void BMPPlot::addBus(
+	const std::string& a_busName,
+	const std::vector<const LogicTrace*>& a_bits)
+{
+	Nanoseconds traceLength = 0;
+	for(int b=0; b<static_cast<int>(a_bits.size()); b++)
+	{
+		traceLength = std::max(traceLength, a_bits[b]->length());
+	}
+	Nanoseconds begin = 0;
+	Nanoseconds end = 0;
+	axis_.window(traceLength, begin, end);
+	Nanoseconds length = axis_.length(traceLength);
+	plotSignalName(a_busName);
+	plotAxes(axis_.columns(length));
+	if(end > begin && !a_bits.empty())
+	{
+		plotBus(a_bits, begin, end, length);
+	}
 	nSignals_++;
 	return;
 }
 
+void BMPPlot::setLogicLevels(bool a_logic)
+{
+	logic_ = a_logic;
+	return;
+}
+
+void BMPPlot::setTimeRange(sgnl::Nanoseconds a_begin, sgnl::Nanoseconds a_end)
+{
+	axis_.setRange(a_begin, a_end);
+	return;
+}
+
 void BMPPlot::setTimeTicks(sgnl::Nanoseconds a_spacing)
 {
 	plotText(
 		Coordinate{2*fontSizeX_, fontSizeY_*3 + (fontSizeY_*(1+nSignals_*4))},
 		"t/ns");
-	for(int x=100; x<1280; x+=a_spacing)
+	if(a_spacing <= 0)
 	{
-		plotPixels(
-			bresenhamLine(
+		return;
+	}
+	if(axis_.hasRange())
+	{
+		// Zeitfenster gesetzt: Skalenstriche auf die Pixelspalten abbilden
+		Nanoseconds begin = axis_.begin();
+		Nanoseconds length = axis_.length(0);
+		vector<Nanoseconds> ticks = TimeAxis::ticks(a_spacing, length);
+		for(int k=0; k<static_cast<int>(ticks.size()); k++)
+		{
+			int x = 100 + axis_.column(begin+ticks[k], begin, length);
+			drawLine(
 				Coordinate{x, fontSizeY_*3 + (fontSizeY_*(1+nSignals_*4))},
-				Coordinate{x, 799}),
+				Coordinate{x, plot_.getHeight()-1},
+				Color{50, 50, 50});
+			plotText(
+				Coordinate{x+1, fontSizeY_*3 + (fontSizeY_*(1+nSignals_*4))},
+				std::to_string(begin+ticks[k]));
+		}
+		return;
+	}
+	for(int x=100; x<plot_.getWidth(); x+=a_spacing)
+	{
+		drawLine(
+			Coordinate{x, fontSizeY_*3 + (fontSizeY_*(1+nSignals_*4))},
+			Coordinate{x, plot_.getHeight()-1},
 			Color{50, 50, 50});
 		plotText(
 			Coordinate{x+1, fontSizeY_*3 + (fontSizeY_*(1+nSignals_*4))},
@@ -60,21 +211,50 @@ void BMPPlot::setTimeTicks(sgnl::Nanoseconds a_spacing)
 	return;
 }
 
+void BMPPlot::setDirectRendering(bool a_direct)
+{
+	direct_ = a_direct;
+	return;
+}
+
+void BMPPlot::setBackend(const std::shared_ptr<const PlotBackend>& a_backend)
+{
+	if(a_backend)
+	{
+		backend_ = a_backend;
+		sceneTraces_ = backend_->needsScene();
+	}
+	return;
+}
+
+const PlotScene& BMPPlot::scene() const
+{
+	return scene_;
+}
+
+const SimpleBMP& BMPPlot::bitmap() const
+{
+	return plot_;
+}
+
 bool BMPPlot::save() const
 {
-	time_t tim = time(nullptr);
-	struct tm stim = *localtime(&tim);
-	stringstream ss;
-	ss << std::put_time(&stim, "%d-%m-%Y_%H-%M-%S");
-	string filename = "./Plots/";
-	filename += ss.str();
-	filename += ".bmp";
-	if(plot_.save(filename.c_str()) != 0)
+	return save(uniqueName(""));
+}
+
+bool BMPPlot::save(const std::string& a_fileName) const
+{
+	return saveAs("./Plots/" + a_fileName + backend_->extension());
+}
+
+bool BMPPlot::saveAs(const std::string& a_path) const
+{
+	if(!backend_->write(plot_, scene_, a_path))
 	{
-		cerr << "Failed to save bitmap image " << filename << "." << endl;
+		DFSM_LOG_ERROR("BMPPlot", "Failed to save plot " << a_path << ".");
 		return false;
 	}
-	cout << "Bitmap image " << filename << " saved." << endl;
+	DFSM_LOG_INFO("BMPPlot", "Plot " << a_path << " saved.");
 	return true;
 }
 
@@ -94,79 +274,201 @@ void BMPPlot::plotPixels(
 	return;
 }
 
-void BMPPlot::plotText(
-	Coordinate a_where,
-	const std::string& a_text)
+void BMPPlot::drawLine(Coordinate a_start, Coordinate a_end, Color a_color)
 {
-	unsigned char r=0;
-	unsigned char g=0;
-	unsigned char b=0;
+	PlotScene::Line line = {
+		PlotScene::Point{a_start.x_, a_start.y_},
+		PlotScene::Point{a_end.x_, a_end.y_},
+		PlotScene::Color{a_color.r_, a_color.g_, a_color.b_}};
+	scene_.lines_.push_back(line);
+	if(direct_)
+	{
+		rasterLine(a_start, a_end, nullptr, a_color);
+	}
+	else
+	{
+		plotPixels(bresenhamLine(a_start, a_end), a_color);
+	}
+	return;
+}
 
-	for(int c=0; c<static_cast<int>(a_text.size()); c++)
+void BMPPlot::rasterLine(
+	Coordinate a_start,
+	Coordinate a_end,
+	const Color* a_colorByY,
+	Color a_color)
+{
+	// Wie bresenhamLine(...), aber ohne Pixelvektor
+	unsigned char* pixels = plot_.getPixels();
+	const int width = plot_.getWidth();
+	const int height = plot_.getHeight();
+	int x1 = a_start.x_;
+	int y1 = a_start.y_;
+	int x2 = a_end.x_;
+	int y2 = a_end.y_;
+	int dx =  abs(x2-x1);
+	int sx = x1<x2 ? 1 : -1;
+	int dy = -abs(y2-y1);
+	int sy = y1<y2 ? 1 : -1;
+	int err = dx+dy;
+	int e2 = 0;
+	while(true)
 	{
-		int xf = 0;
-		char ch = a_text[c];
-		if(ch>='a' && ch<='z')
-		{
-			xf = fontSizeX_*(ch-'a');
-		}
-		else if(ch>='A' && ch<='Z')
+		if(x1>=0 && x1<width && y1>=0 && y1<height)
 		{
-			xf = 26*fontSizeX_ + (fontSizeX_*(ch-'A'));
+			const Color& color = a_colorByY ? a_colorByY[y1] : a_color;
+			unsigned char* p = pixels + ((height-y1-1)*width + x1)*3;
+			p[0] = color.b_;
+			p[1] = color.g_;
+			p[2] = color.r_;
 		}
-		else if(ch>='0' && ch<='9')
+		if (x1==x2 && y1==y2)
 		{
-			xf = 59*fontSizeX_ + (fontSizeX_*(ch-'0'));
+			break;
 		}
-		else if(ch == ' ')
+		e2 = 2*err;
+		if (e2 > dy)
 		{
-			xf = 52*fontSizeX_;
+			err += dy;
+			x1 += sx;
 		}
-		else if(ch == ',')
+		if (e2 < dx)
 		{
-			xf = 53*fontSizeX_;
+			err += dx;
+			y1 += sy;
 		}
-		else if(ch == '.')
+	}
+	return;
+}
+
+void BMPPlot::rasterSpan(
+	int a_x,
+	int a_yTop,
+	int a_yBottom,
+	const Color* a_colorByY)
+{
+	const int width = plot_.getWidth();
+	const int height = plot_.getHeight();
+	if(a_x<0 || a_x>=width)
+	{
+		return;
+	}
+	a_yTop = std::max(a_yTop, 0);
+	a_yBottom = std::min(a_yBottom, height-1);
+	// Bildzeilen liegen im Bitmap von unten nach oben
+	unsigned char* p = plot_.getPixels() + ((height-a_yTop-1)*width + a_x)*3;
+	for(int y=a_yTop; y<=a_yBottom; y++)
+	{
+		p[0] = a_colorByY[y].b_;
+		p[1] = a_colorByY[y].g_;
+		p[2] = a_colorByY[y].r_;
+		p -= width*3;
+	}
+	return;
+}
+
+PlotScene::Trace BMPPlot::sceneTrace(int a_offsY, double a_scale) const
+{
+	PlotScene::Trace trace;
+	trace.highY_ = -1;
+	trace.deadbandY_ = -1;
+	trace.high_ = PlotScene::Color{75, 255, 75};
+	trace.deadband_ = PlotScene::Color{255, 255, 75};
+	trace.low_ = PlotScene::Color{255, 75, 75};
+	for(int y=0; y<plot_.getHeight(); y++)
+	{
+		Volt interpValue = (a_offsY-y)/a_scale;
+		if(interpValue >= HIGH_THRESH_VOLT+DEADBAND_VOLT/2)
 		{
-			xf = 54*fontSizeX_;
+			trace.highY_ = y;
+			trace.deadbandY_ = y;
 		}
-		else if(ch == ':')
+		else if(interpValue > HIGH_THRESH_VOLT-DEADBAND_VOLT/2)
 		{
-			xf = 55*fontSizeX_;
+			trace.deadbandY_ = y;
 		}
-		else if(ch == '/')
+	}
+	return trace;
+}
+
+void BMPPlot::addScenePoint(PlotScene::Trace& a_trace, int a_x, int a_y)
+{
+	std::vector<PlotScene::Point>& points = a_trace.points_;
+	const int n = static_cast<int>(points.size());
+	if(n >= 2 && points[n-1].y_ == a_y && points[n-2].y_ == a_y)
+	{
+		points[n-1].x_ = a_x;
+		return;
+	}
+	points.push_back(PlotScene::Point{a_x, a_y});
+	return;
+}
+
+void BMPPlot::colorTable(
+	int a_offsY,
+	double a_scale,
+	std::vector<Color>& a_colorByY) const
+{
+	a_colorByY.resize(plot_.getHeight());
+	for(int y=0; y<static_cast<int>(a_colorByY.size()); y++)
+	{
+		Volt interpValue = (a_offsY-y)/a_scale;
+		if(interpValue >= HIGH_THRESH_VOLT+DEADBAND_VOLT/2)
 		{
-			xf = 56*fontSizeX_;
+			a_colorByY[y] = Color{75, 255, 75};
 		}
-		else if(ch == '_')
+		else if(interpValue > HIGH_THRESH_VOLT-DEADBAND_VOLT/2)
 		{
-			xf = 57*fontSizeX_;
+			a_colorByY[y] = Color{255, 255, 75};
 		}
-		else if(ch == '-')
+		else
 		{
-			xf = 58*fontSizeX_;
+			a_colorByY[y] = Color{255, 75, 75};
 		}
-		else
+	}
+	return;
+}
+
+void BMPPlot::plotText(
+	Coordinate a_where,
+	const std::string& a_text)
+{
+	scene_.texts_.push_back(
+		PlotScene::Text{PlotScene::Point{a_where.x_, a_where.y_}, a_text});
+	const GlyphAtlas& atlas = GlyphAtlas::instance();
+	const int width = plot_.getWidth();
+	const int height = plot_.getHeight();
+	unsigned char* pixels = plot_.getPixels();
+
+	for(int c=0; c<static_cast<int>(a_text.size()); c++)
+	{
+		int glyph = atlas.glyph(a_text[c]);
+		int x0 = a_where.x_ + c*fontSizeX_;
+		int xBegin = std::max(0, -x0);
+		int xEnd = std::min(fontSizeX_, width-x0);
+		if(xBegin >= xEnd)
 		{
-			xf = 52*fontSizeX_;
+			continue;
 		}
+		size_t bytes = static_cast<size_t>(xEnd-xBegin)*3;
 		for(int y=0; y<fontSizeY_; y++)
 		{
-			for(int x=0; x<fontSizeX_; x++)
+			int py = a_where.y_ + y;
+			if(py < 0 || py >= height)
 			{
-				// Copy over pixel data from font bitmap to plot
-				font_.getPixel(
-					xf+x,
-					y,
-					&r,
-					&g,
-					&b);
-				plot_.setPixel(
-					a_where.x_+x+c*fontSizeX_,
-					a_where.y_+y,
-					r,
-					g,
-					b);
+				continue;
+			}
+			// Zeichen sind deckend: leere Zeilen werden schwarz gefuellt,
+			// alle anderen als ganze Zeile kopiert
+			unsigned char* dst = pixels
+				+ (static_cast<size_t>(height-1-py)*width + x0 + xBegin)*3;
+			if(atlas.blankRow(glyph, y))
+			{
+				memset(dst, 0, bytes);
+			}
+			else
+			{
+				memcpy(dst, atlas.row(glyph, y) + xBegin*3, bytes);
 			}
 		}
 	}
@@ -181,9 +483,12 @@ void BMPPlot::plotSignalName(const std::string& a_signalName)
 	return;
 }
 
-void BMPPlot::plotSignalValues(const std::vector<sgnl::Volt>& a_values)
+void BMPPlot::plotSignalValues(
+	const std::vector<sgnl::Volt>& a_values,
+	sgnl::Nanoseconds a_begin,
+	sgnl::Nanoseconds a_end)
 {
-	if(a_values.size()<2)
+	if(a_end-a_begin<2)
 		return;
 	int offs_y = fontSizeY_*6 + (fontSizeY_*(1+nSignals_*4)) + 2*fontSizeY_;
 	double scale = 3*fontSizeY_/HIGH_LEVEL_VOLT;
@@ -195,20 +500,49 @@ void BMPPlot::plotSignalValues(const std::vector<sgnl::Volt>& a_values)
 
 	for(int y=y_deadband_upper; y<=y_deadband_lower; y++)
 	{
-		plotPixels(bresenhamLine(
-				Coordinate{100, y},
-				Coordinate{100+static_cast<int>(a_values.size()), y}),
+		drawLine(
+			Coordinate{100, y},
+			Coordinate{100+a_end-a_begin, y},
 			Color{75, 75, 75});
 	}
 
+	if(sceneTraces_)
+	{
+		PlotScene::Trace trace = sceneTrace(offs_y, scale);
+		for(int i=0; i<a_end-a_begin; i++)
+		{
+			addScenePoint(trace, 100+i,
+				offs_y-static_cast<int>(a_values[a_begin+i]*scale));
+		}
+		scene_.traces_.push_back(trace);
+	}
+
+	if(direct_)
+	{
+		vector<Color> colorByY;
+		colorTable(offs_y, scale, colorByY);
+		for(int i=1; i<a_end-a_begin; i++)
+		{
+			rasterLine(
+				Coordinate{100+i-1,
+					offs_y-static_cast<int>(a_values[a_begin+i-1]*scale)},
+				Coordinate{100+i,
+					offs_y-static_cast<int>(a_values[a_begin+i]*scale)},
+				&colorByY[0],
+				Color{0, 0, 0});
+		}
+		return;
+	}
+
 	unsigned char r = 0;
 	unsigned char g = 0;
 	unsigned char b = 0;
-	for(int i=1; i<static_cast<int>(a_values.size()); i++)
+	for(int i=1; i<a_end-a_begin; i++)
 	{
 		vector<Coordinate> linePixels = bresenhamLine(
-			Coordinate{100+i-1, offs_y-static_cast<int>(a_values[i-1]*scale)},
-			Coordinate{100+i, offs_y-static_cast<int>(a_values[i]*scale)});
+			Coordinate{100+i-1,
+				offs_y-static_cast<int>(a_values[a_begin+i-1]*scale)},
+			Coordinate{100+i, offs_y-static_cast<int>(a_values[a_begin+i]*scale)});
 		for(int k=0; k<static_cast<int>(linePixels.size()); k++)
 		{
 			Volt interpValue = (offs_y-linePixels[k].y_)/scale;
@@ -237,18 +571,301 @@ void BMPPlot::plotSignalValues(const std::vector<sgnl::Volt>& a_values)
 	return;
 }
 
+void BMPPlot::plotLogic(
+	const LogicTrace& a_trace,
+	sgnl::Nanoseconds a_begin,
+	sgnl::Nanoseconds a_end,
+	sgnl::Nanoseconds a_length)
+{
+	int y_high = fontSizeY_*6 + (fontSizeY_*(1+nSignals_*4));
+	int y_low = y_high + 2*fontSizeY_ - 2;
+	int y_axis = y_high + 2*fontSizeY_;
+	const vector<Nanoseconds>& edges = a_trace.edges();
+	bool level = a_trace.levelAt(a_begin);
+	int i = a_trace.firstEdgeAfter(a_begin);
+	int n = a_trace.firstEdgeAfter(a_end-1);
+	int xStart = 100;
+
+	// Je Pixelspalte mit Flanken: Level-Linie bis zur Spalte, dann eine
+	// senkrechte Linie. Alle Flanken einer Spalte werden per Binaersuche
+	// uebersprungen
+	while(i < n)
+	{
+		int x = timeToX(edges[i], a_begin, a_length);
+		int j = static_cast<int>(std::lower_bound(
+			edges.begin()+i, edges.begin()+n,
+			xToTime(x+1, a_begin, a_length)) - edges.begin());
+		drawLine(
+			Coordinate{xStart, level ? y_high : y_low},
+			Coordinate{x, level ? y_high : y_low},
+			level ? Color{75, 255, 75} : Color{255, 75, 75});
+		if(j-i == 1)
+		{
+			drawLine(Coordinate{x, y_high}, Coordinate{x, y_low},
+				Color{255, 255, 255});
+			drawLine(Coordinate{x, y_axis+1}, Coordinate{x, y_axis+3},
+				level ? Color{255, 75, 75} : Color{75, 255, 75});
+		}
+		else
+		{
+			drawLine(Coordinate{x, y_high}, Coordinate{x, y_low},
+				Color{255, 255, 75});
+		}
+		if((j-i) % 2 == 1)
+		{
+			level = !level;
+		}
+		xStart = x;
+		i = j;
+	}
+	int xEnd = timeToX(a_end-1, a_begin, a_length);
+	drawLine(
+		Coordinate{xStart, level ? y_high : y_low},
+		Coordinate{xEnd, level ? y_high : y_low},
+		level ? Color{75, 255, 75} : Color{255, 75, 75});
+	return;
+}
+
+void BMPPlot::plotBus(
+	const std::vector<const LogicTrace*>& a_bits,
+	sgnl::Nanoseconds a_begin,
+	sgnl::Nanoseconds a_end,
+	sgnl::Nanoseconds a_length)
+{
+	int y_high = fontSizeY_*6 + (fontSizeY_*(1+nSignals_*4));
+	int y_low = y_high + 2*fontSizeY_ - 2;
+	const Color busColor = Color{75, 175, 255};
+	const int nBits = std::min(static_cast<int>(a_bits.size()), 64);
+	const int nDigits = (nBits+3)/4;
+
+	// Flanken aller Bits im Zeitfenster, nach Zeit sortiert
+	vector<pair<Nanoseconds, int> > changes;
+	unsigned long long value = 0;
+	for(int b=0; b<nBits; b++)
+	{
+		const vector<Nanoseconds>& edges = a_bits[b]->edges();
+		int n = a_bits[b]->firstEdgeAfter(a_end-1);
+		for(int i=a_bits[b]->firstEdgeAfter(a_begin); i<n; i++)
+		{
+			changes.push_back(pair<Nanoseconds, int>(edges[i], b));
+		}
+		if(a_bits[b]->levelAt(a_begin))
+		{
+			value |= 1ULL << b;
+		}
+	}
+	std::sort(changes.begin(), changes.end());
+
+	int xStart = 100;
+	int k = 0;
+	while(k < static_cast<int>(changes.size()))
+	{
+		int x = timeToX(changes[k].first, a_begin, a_length);
+		Nanoseconds next = xToTime(x+1, a_begin, a_length);
+		unsigned long long previous = value;
+		bool single = true;
+		int m = k;
+		for(; m<static_cast<int>(changes.size()) && changes[m].first<next; m++)
+		{
+			value ^= 1ULL << changes[m].second;
+			single = single && (changes[m].first == changes[k].first);
+		}
+		k = m;
+		drawLine(Coordinate{xStart, y_high}, Coordinate{x, y_high}, busColor);
+		drawLine(Coordinate{xStart, y_low}, Coordinate{x, y_low}, busColor);
+		plotBusValue(xStart, x, y_high, previous, nDigits);
+		drawLine(Coordinate{x, y_high}, Coordinate{x, y_low},
+			single ? Color{255, 255, 255} : Color{255, 255, 75});
+		xStart = x;
+	}
+	int xEnd = timeToX(a_end-1, a_begin, a_length);
+	drawLine(Coordinate{xStart, y_high}, Coordinate{xEnd, y_high}, busColor);
+	drawLine(Coordinate{xStart, y_low}, Coordinate{xEnd, y_low}, busColor);
+	plotBusValue(xStart, xEnd, y_high, value, nDigits);
+	return;
+}
+
+void BMPPlot::plotBusValue(
+	int a_xStart,
+	int a_xEnd,
+	int a_yHigh,
+	unsigned long long a_value,
+	int a_nDigits)
+{
+	if(a_xEnd-a_xStart-3 < a_nDigits*fontSizeX_)
+	{
+		return;
+	}
+	stringstream ss;
+	ss << uppercase << hex << setw(a_nDigits) << setfill('0') << a_value;
+	plotText(
+		Coordinate{a_xStart+2, a_yHigh + (2*fontSizeY_-2-fontSizeY_)/2 + 1},
+		ss.str());
+	return;
+}
+
+int BMPPlot::timeToX(
+	sgnl::Nanoseconds a_time,
+	sgnl::Nanoseconds a_begin,
+	sgnl::Nanoseconds a_length) const
+{
+	return 100 + axis_.column(a_time, a_begin, a_length);
+}
+
+sgnl::Nanoseconds BMPPlot::xToTime(
+	int a_x,
+	sgnl::Nanoseconds a_begin,
+	sgnl::Nanoseconds a_length) const
+{
+	return axis_.time(a_x-100, a_begin, a_length);
+}
+
+void BMPPlot::plotEnvelope(const Envelope& a_envelope)
+{
+	if(a_envelope.nColumns()<1)
+		return;
+	int offs_y = fontSizeY_*6 + (fontSizeY_*(1+nSignals_*4)) + 2*fontSizeY_;
+	double scale = 3*fontSizeY_/HIGH_LEVEL_VOLT;
+
+	int y_deadband_upper
+		= offs_y-static_cast<int>((HIGH_THRESH_VOLT+DEADBAND_VOLT/2)*scale);
+	int y_deadband_lower
+		= offs_y-static_cast<int>((HIGH_THRESH_VOLT-DEADBAND_VOLT/2)*scale);
+	for(int y=y_deadband_upper; y<=y_deadband_lower; y++)
+	{
+		drawLine(
+			Coordinate{100, y},
+			Coordinate{100+a_envelope.nColumns(), y},
+			Color{75, 75, 75});
+	}
+
+	vector<Color> colorByY;
+	if(direct_)
+	{
+		colorTable(offs_y, scale, colorByY);
+	}
+	PlotScene::Trace trace;
+	if(sceneTraces_)
+	{
+		trace = sceneTrace(offs_y, scale);
+	}
+
+	// Eine senkrechte Linie je Spalte vom kleinsten bis zum groessten Wert,
+	// verlaengert bis zum letzten Wert der vorherigen Spalte, damit Flanken
+	// zwischen zwei Spalten sichtbar bleiben
+	for(int c=0; c<a_envelope.nColumns(); c++)
+	{
+		Volt lo = a_envelope.min(c);
+		Volt hi = a_envelope.max(c);
+		if(c>0)
+		{
+			lo = std::min(lo, a_envelope.last(c-1));
+			hi = std::max(hi, a_envelope.last(c-1));
+		}
+		int yTop = offs_y-static_cast<int>(hi*scale);
+		int yBottom = offs_y-static_cast<int>(lo*scale);
+		if(sceneTraces_)
+		{
+			// Senkrechte Spalte vom naeheren Ende aus durchlaufen
+			int yPrev = trace.points_.empty() ? yTop : trace.points_.back().y_;
+			bool downwards = abs(yPrev-yTop) <= abs(yPrev-yBottom);
+			addScenePoint(trace, 100+c, downwards ? yTop : yBottom);
+			if(yTop != yBottom)
+			{
+				addScenePoint(trace, 100+c, downwards ? yBottom : yTop);
+			}
+		}
+		if(direct_)
+		{
+			rasterSpan(100+c, yTop, yBottom, &colorByY[0]);
+			continue;
+		}
+		for(int y=yTop; y<=yBottom; y++)
+		{
+			Volt interpValue = (offs_y-y)/scale;
+			Color color = Color{255, 75, 75};
+			if(interpValue >= HIGH_THRESH_VOLT+DEADBAND_VOLT/2)
+			{
+				color = Color{75, 255, 75};
+			}
+			else if(interpValue > HIGH_THRESH_VOLT-DEADBAND_VOLT/2)
+			{
+				color = Color{255, 255, 75};
+			}
+			plot_.setPixel(100+c, y, color.r_, color.g_, color.b_);
+		}
+	}
+	if(sceneTraces_)
+	{
+		scene_.traces_.push_back(trace);
+	}
+	return;
+}
+
+Envelope BMPPlot::envelopeFor(const std::vector<sgnl::Volt>& a_signal) const
+{
+	Nanoseconds begin = 0;
+	Nanoseconds end = 0;
+	int nColumns = axis_.envelopeColumns(a_signal.size(), begin, end);
+	if(nColumns == 0)
+	{
+		return Envelope();
+	}
+	return Envelope(a_signal, begin, end, nColumns);
+}
+
+void BMPPlot::addSignal(
+	const std::string& a_signalName,
+	const std::vector<sgnl::Volt>& a_signal,
+	const Envelope& a_envelope)
+{
+	Nanoseconds begin = 0;
+	Nanoseconds end = 0;
+	axis_.window(a_signal.size(), begin, end);
+	Nanoseconds length = axis_.length(a_signal.size());
+	plotSignalName(a_signalName);
+	plotAxes(axis_.columns(length));
+	if(a_envelope.nColumns() > 0)
+	{
+		plotEnvelope(a_envelope);
+	}
+	else
+	{
+		plotSignalValues(a_signal, begin, end);
+	}
+	nSignals_++;
+	return;
+}
+
+std::string BMPPlot::uniqueName(const std::string& a_prefix)
+{
+	// localtime(...) ist nicht threadsicher, der Zaehler wird gleich mit
+	// geschuetzt
+	static mutex nameMutex;
+	static unsigned int counter = 0;
+	lock_guard<mutex> lock(nameMutex);
+	time_t tim = time(nullptr);
+	struct tm stim = *localtime(&tim);
+	stringstream ss;
+	if(!a_prefix.empty())
+	{
+		ss << a_prefix << "_";
+	}
+	ss << std::put_time(&stim, "%d-%m-%Y_%H-%M-%S") << "_"
+	   << setw(4) << setfill('0') << counter++;
+	return ss.str();
+}
+
 void BMPPlot::plotAxes(sgnl::Nanoseconds a_length)
 {
 	int offs_y = fontSizeY_*6 + (fontSizeY_*(1+nSignals_*4));
-	plotPixels(
-		bresenhamLine(
-			Coordinate{100, offs_y-1*fontSizeY_},
-			Coordinate{100, offs_y+2*fontSizeY_}),
+	drawLine(
+		Coordinate{100, offs_y-1*fontSizeY_},
+		Coordinate{100, offs_y+2*fontSizeY_},
 		Color{255, 255, 255});
-	plotPixels(
-		bresenhamLine(
-			Coordinate{100, offs_y+2*fontSizeY_},
-			Coordinate{100+a_length, offs_y+2*fontSizeY_}),
+	drawLine(
+		Coordinate{100, offs_y+2*fontSizeY_},
+		Coordinate{100+a_length, offs_y+2*fontSizeY_},
 		Color{255, 255, 255});
 	return;
 }
@@ -9,7 +9,14 @@
 
 #include "simplebmp/simplebmp.h"
 #include "../signal/Signal.h"
+#include "Envelope.h"
+#include "WaveformPyramid.h"
+#include "LogicTrace.h"
+#include "TimeAxis.h"
+#include "PlotBackend.h"
+#include "PlotScene.h"
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <utility>
@@ -22,12 +29,29 @@
 class BMPPlot
 {
 public:
-	/*! \brief Konstruktor. Initialisiert ein Plot-Bitmap der Groesse 1280x800,
-	 *  laedt das Zeichensatz-Bitmap und plottet den uebergebenen Titel
+	/*! \brief Konstruktor. Initialisiert ein Plot-Bitmap der Groesse 1280x800
+	 *  und plottet den uebergebenen Titel
 	 *  \param a_title Plot-Titel
 	 */
 	BMPPlot(const std::string& a_title);
 
+	/*! \brief Konstruktor. Initialisiert ein Plot-Bitmap der angegebenen
+	 *  Groesse (mindestens 200x200) und plottet
+	 *  den uebergebenen Titel. Benoetigte Hoehe fuer n Signale: siehe
+	 *  heightFor(...)
+	 *  \param a_title Plot-Titel
+	 *  \param a_width Breite / Pixel
+	 *  \param a_height Hoehe / Pixel
+	 */
+	BMPPlot(const std::string& a_title, int a_width, int a_height);
+
+	/*! \brief Gibt die Bildhoehe zurueck, die fuer die angegebene Anzahl
+	 *  untereinander geplotteter Signale benoetigt wird
+	 *  \param a_nSignals Anzahl der Signale
+	 *  \return Hoehe / Pixel
+	 */
+	static int heightFor(int a_nSignals);
+
 	/*! \brief Plottet das uebergebene Signal unter das zuvor geplottete Signal.
 	 *  \param a_signalName Name des Signals
 	 *  \param a_signal Signal-Spannungswerte; Es wird davon ausgegangen, dass
@@ -37,16 +61,131 @@ public:
 		const std::string& a_signalName,
 		const std::vector<sgnl::Volt>& a_signal);
 
+	/*! \brief Plottet mehrere Signale untereinander. Muessen die Signale
+	 *  dezimiert werden, werden ihre Huellkurven parallel berechnet
+	 *  \param a_signalNames Namen der Signale
+	 *  \param a_signals Signal-Spannungswerte im 1-Nanosekunden-Raster
+	 *  \param a_nThreads Anzahl der Threads, 0 = Anzahl der Prozessorkerne
+	 */
+	void add(
+		const std::vector<std::string>& a_signalNames,
+		const std::vector<const std::vector<sgnl::Volt>*>& a_signals,
+		int a_nThreads = 0);
+
+	/*! \brief Plottet ein Signal aus seiner Min/Max-Pyramide unter das zuvor
+	 *  geplottete Signal. Muss das Zeitfenster gestaucht werden, haengt der
+	 *  Aufwand nur von der Breite des Plots ab, nicht von der Laenge des
+	 *  Zeitfensters. Das Bild ist identisch mit add(a_signalName,
+	 *  a_pyramid.values())
+	 *  \param a_signalName Name des Signals
+	 *  \param a_pyramid Min/Max-Pyramide des Signals
+	 */
+	void add(
+		const std::string& a_signalName,
+		const WaveformPyramid& a_pyramid);
+
+	/*! \brief Plottet den Logiklevel-Verlauf eines Signals als HIGH/LOW-Linie
+	 *  mit markierten Flanken (Strich unter der Zeitachse: gruen steigend,
+	 *  rot fallend). Mehrere Flanken in einer Pixelspalte werden als gelbe
+	 *  Spalte dargestellt. Der Aufwand haengt nur von der Anzahl der Flanken
+	 *  im Zeitfenster ab, hoechstens von der Breite des Plots
+	 *  \param a_signalName Name des Signals
+	 *  \param a_trace Logiklevel-Verlauf
+	 */
+	void addLogic(
+		const std::string& a_signalName,
+		const LogicTrace& a_trace);
+
+	/*! \brief Plottet mehrere Signale als Bus in einer Zeile. Jeder Abschnitt
+	 *  mit gleichem Wert wird als Band mit hexadezimalem Wert beschriftet,
+	 *  sofern er breit genug ist; Wertwechsel werden als senkrechte Linie
+	 *  markiert
+	 *  \param a_busName Name des Busses, z. B. "Q3:0"
+	 *  \param a_bits Logiklevel-Verlaeufe, niederwertigstes Bit zuerst
+	 *  (hoechstens 64)
+	 */
+	void addBus(
+		const std::string& a_busName,
+		const std::vector<const LogicTrace*>& a_bits);
+
+	/*! \brief Waehlt die Darstellung fuer add(...). Mit Logikleveln wird
+	 *  jedes Signal in einen LogicTrace umgewandelt und wie mit
+	 *  addLogic(...) geplottet, sonst als Spannungsverlauf (Standard)
+	 *  \param a_logic true = Logiklevel darstellen
+	 */
+	void setLogicLevels(bool a_logic);
+
+	/*! \brief Legt das darzustellende Zeitfenster fest. Ohne Aufruf wird jedes
+	 *  Signal vollstaendig dargestellt. Passt das Fenster nicht in die Breite
+	 *  des Plots, wird es auf die verfuegbaren Pixelspalten gestaucht
+	 *  (Min/Max je Spalte); die Skalenstriche werden entsprechend skaliert.
+	 *  Muss vor setTimeTicks(...) und add(...) aufgerufen werden
+	 *  \param a_begin Beginn des Zeitfensters / ns
+	 *  \param a_end Ende des Zeitfensters / ns (exklusiv)
+	 */
+	void setTimeRange(sgnl::Nanoseconds a_begin, sgnl::Nanoseconds a_end);
+
 	/*! \brief Plottet die Skalenstriche auf der Zeitachse im angegebenen Abstand
 	 *  \param a_spacing Abstand zwischen den Skalenstrichen
 	 */
 	void setTimeTicks(sgnl::Nanoseconds a_spacing);
 
-	/*! \brief Speichert den Plot als Bitmap-Bild. Dateiname ist ein Zeitstempel
+	/*! \brief Waehlt das Zeichenverfahren. Direkt (Standard) schreibt Linien
+	 *  ohne Zwischenspeicher in das Plot-Bitmap und bestimmt die Farben ueber
+	 *  eine Tabelle je Bildzeile. Das bisherige Verfahren (Pixelvektor je
+	 *  Linie, Farbe je Pixel) bleibt zum Vergleich erhalten, beide liefern
+	 *  dasselbe Bild. Muss vor add(...) aufgerufen werden
+	 *  \param a_direct true = direkt zeichnen
+	 */
+	void setDirectRendering(bool a_direct);
+
+	/*! \brief Legt das Ausgabeformat fuer save(...) fest (Standard:
+	 *  BmpBackend). Muss vor add(...) aufgerufen werden, damit die
+	 *  Signalverlaeufe fuer Vektorformate mit aufgezeichnet werden
+	 *  \param a_backend Ausgabeformat, z. B. PngBackend oder SvgBackend
+	 */
+	void setBackend(const std::shared_ptr<const PlotBackend>& a_backend);
+
+	/*! \brief Gibt die Vektorbeschreibung des Plots zurueck. Linien und
+	 *  Texte werden immer aufgezeichnet, Signalverlaeufe nur, falls das
+	 *  Backend sie benoetigt
+	 *  \return Vektorbeschreibung
+	 */
+	const PlotScene& scene() const;
+
+	/*! \brief Gibt das Plot-Bitmap zurueck
+	 *  \return Plot-Bitmap
+	 */
+	const SimpleBMP& bitmap() const;
+
+	/*! \brief Speichert den Plot im Ordner ./Plots im Format des Backends.
+	 *  Dateiname ist uniqueName("")
 	 *  \return true, falls das Bild erfolgreich gespeichert wurde, false sonst
 	 */
 	bool save() const;
 
+	/*! \brief Speichert den Plot im Ordner ./Plots im Format des Backends
+	 *  \param a_fileName Dateiname OHNE Endung
+	 *  \return true, falls das Bild erfolgreich gespeichert wurde, false sonst
+	 */
+	bool save(const std::string& a_fileName) const;
+
+	/*! \brief Speichert den Plot im Format des Backends unter dem
+	 *  angegebenen Pfad
+	 *  \param a_path Pfad MIT Endung (siehe PlotBackend::extension())
+	 *  \return true, falls das Bild erfolgreich gespeichert wurde, false sonst
+	 */
+	bool saveAs(const std::string& a_path) const;
+
+	/*! \brief Erzeugt einen im Prozess eindeutigen Dateinamen
+	 *  <a_prefix>_<Zeitstempel>_<Zaehler>. Der Zaehler wird bei jedem Aufruf
+	 *  erhoeht, so dass auch in derselben Sekunde und aus mehreren Threads
+	 *  gespeicherte Plots sich nicht ueberschreiben. Threadsicher
+	 *  \param a_prefix Praefix, leer = nur Zeitstempel und Zaehler
+	 *  \return Dateiname OHNE Endung
+	 */
+	static std::string uniqueName(const std::string& a_prefix);
+
 private:
 	/*! \brief Pixelkoordinaten
 	 */
@@ -73,7 +212,64 @@ private:
 		const std::vector<Coordinate>& a_pixels,
 		Color a_color);
 
-	/*! \brief Plottet den uebergebenen Text
+	/*! \brief Zeichnet eine einfarbige Linie mit dem eingestellten
+	 *  Zeichenverfahren
+	 *  \param a_start Startkoordinaten der Linie
+	 *  \param a_end Endkoordinaten der Linie
+	 *  \param a_color Farbe
+	 */
+	void drawLine(Coordinate a_start, Coordinate a_end, Color a_color);
+
+	/*! \brief Zeichnet eine Bresenham-Linie direkt in das Plot-Bitmap.
+	 *  Pixel ausserhalb des Bitmaps werden verworfen
+	 *  \param a_start Startkoordinaten der Linie
+	 *  \param a_end Endkoordinaten der Linie
+	 *  \param a_colorByY Farbe je Bildzeile oder nullptr
+	 *  \param a_color Farbe, falls a_colorByY nullptr ist
+	 */
+	void rasterLine(
+		Coordinate a_start,
+		Coordinate a_end,
+		const Color* a_colorByY,
+		Color a_color);
+
+	/*! \brief Zeichnet eine senkrechte Linie direkt in das Plot-Bitmap
+	 *  \param a_x X-Koordinate
+	 *  \param a_yTop Obere Y-Koordinate
+	 *  \param a_yBottom Untere Y-Koordinate (einschliesslich)
+	 *  \param a_colorByY Farbe je Bildzeile
+	 */
+	void rasterSpan(int a_x, int a_yTop, int a_yBottom, const Color* a_colorByY);
+
+	/*! \brief Erzeugt einen leeren Signalverlauf fuer die PlotScene mit den
+	 *  Farbgrenzen wie in colorTable(...)
+	 *  \param a_offsY Y-Koordinate von 0 V
+	 *  \param a_scale Pixel je Volt
+	 *  \return Signalverlauf ohne Eckpunkte
+	 */
+	PlotScene::Trace sceneTrace(int a_offsY, double a_scale) const;
+
+	/*! \brief Haengt einen Punkt an einen Signalverlauf der PlotScene an.
+	 *  Punkte innerhalb waagrechter Abschnitte werden zusammengefasst
+	 *  \param a_trace Signalverlauf
+	 *  \param a_x X-Koordinate
+	 *  \param a_y Y-Koordinate
+	 */
+	static void addScenePoint(PlotScene::Trace& a_trace, int a_x, int a_y);
+
+	/*! \brief Berechnet die Signalfarbe (Logiklevel bzw. Totband) fuer jede
+	 *  Bildzeile eines Signals
+	 *  \param a_offsY Y-Koordinate von 0 V
+	 *  \param a_scale Pixel je Volt
+	 *  \param a_colorByY Farbtabelle, wird auf die Bildhoehe gesetzt
+	 */
+	void colorTable(
+		int a_offsY,
+		double a_scale,
+		std::vector<Color>& a_colorByY) const;
+
+	/*! \brief Plottet den uebergebenen Text. Die Zeichen werden zeilenweise
+	 *  aus dem GlyphAtlas kopiert und am Bildrand abgeschnitten
 	 *  \param a_where Koordinaten der oberen linken Ecke des ersten Zeichens
 	 *  \param a_text Zu plottender Text
 	 */
@@ -84,10 +280,100 @@ private:
 	 */
 	void plotSignalName(const std::string& a_signalName);
 
-	/*! \brief Plottet die uebergebenen Signal-Spannungswerte
+	/*! \brief Plottet die uebergebenen Signal-Spannungswerte, ein Pixel je
+	 *  Nanosekunde
 	 *  \param a_values Signal-Spannungswerte
+	 *  \param a_begin Erster zu plottender Wert
+	 *  \param a_end Erster nicht mehr zu plottender Wert
 	 */
-	void plotSignalValues(const std::vector<sgnl::Volt>& a_values);
+	void plotSignalValues(
+		const std::vector<sgnl::Volt>& a_values,
+		sgnl::Nanoseconds a_begin,
+		sgnl::Nanoseconds a_end);
+
+	/*! \brief Plottet das Zeitfenster eines Logiklevel-Verlaufs
+	 *  \param a_trace Logiklevel-Verlauf
+	 *  \param a_begin Erster zu plottender Zeitpunkt
+	 *  \param a_end Erster nicht mehr zu plottender Zeitpunkt
+	 *  \param a_length Laenge des Zeitfensters der Zeitachse
+	 */
+	void plotLogic(
+		const LogicTrace& a_trace,
+		sgnl::Nanoseconds a_begin,
+		sgnl::Nanoseconds a_end,
+		sgnl::Nanoseconds a_length);
+
+	/*! \brief Plottet das Zeitfenster eines Busses
+	 *  \param a_bits Logiklevel-Verlaeufe, niederwertigstes Bit zuerst
+	 *  \param a_begin Erster zu plottender Zeitpunkt
+	 *  \param a_end Erster nicht mehr zu plottender Zeitpunkt
+	 *  \param a_length Laenge des Zeitfensters der Zeitachse
+	 */
+	void plotBus(
+		const std::vector<const LogicTrace*>& a_bits,
+		sgnl::Nanoseconds a_begin,
+		sgnl::Nanoseconds a_end,
+		sgnl::Nanoseconds a_length);
+
+	/*! \brief Beschriftet einen Busabschnitt mit seinem Wert, falls er breit
+	 *  genug ist
+	 *  \param a_xStart Erste Pixelspalte des Abschnitts
+	 *  \param a_xEnd Letzte Pixelspalte des Abschnitts
+	 *  \param a_yHigh Y-Koordinate der oberen Linie
+	 *  \param a_value Wert
+	 *  \param a_nDigits Anzahl der Hexadezimalstellen
+	 */
+	void plotBusValue(
+		int a_xStart,
+		int a_xEnd,
+		int a_yHigh,
+		unsigned long long a_value,
+		int a_nDigits);
+
+	/*! \brief Gibt die Pixelspalte eines Zeitpunkts im Zeitfenster zurueck
+	 *  \param a_time Zeitpunkt
+	 *  \param a_begin Beginn des Zeitfensters
+	 *  \param a_length Laenge des Zeitfensters der Zeitachse
+	 *  \return X-Koordinate
+	 */
+	int timeToX(
+		sgnl::Nanoseconds a_time,
+		sgnl::Nanoseconds a_begin,
+		sgnl::Nanoseconds a_length) const;
+
+	/*! \brief Gibt den ersten Zeitpunkt einer Pixelspalte zurueck (Umkehrung
+	 *  von timeToX(...))
+	 *  \param a_x X-Koordinate
+	 *  \param a_begin Beginn des Zeitfensters
+	 *  \param a_length Laenge des Zeitfensters der Zeitachse
+	 *  \return Zeitpunkt
+	 */
+	sgnl::Nanoseconds xToTime(
+		int a_x,
+		sgnl::Nanoseconds a_begin,
+		sgnl::Nanoseconds a_length) const;
+
+	/*! \brief Plottet eine Huellkurve als eine senkrechte Linie je Pixelspalte
+	 *  \param a_envelope Huellkurve
+	 */
+	void plotEnvelope(const Envelope& a_envelope);
+
+	/*! \brief Berechnet die Huellkurve eines Signals, falls es fuer die
+	 *  Darstellung dezimiert werden muss
+	 *  \param a_signal Signal-Spannungswerte
+	 *  \return Huellkurve, leer falls ein Pixel je Nanosekunde moeglich ist
+	 */
+	Envelope envelopeFor(const std::vector<sgnl::Volt>& a_signal) const;
+
+	/*! \brief Plottet Name, Achsen und Werte eines Signals
+	 *  \param a_signalName Name des Signals
+	 *  \param a_signal Signal-Spannungswerte
+	 *  \param a_envelope Huellkurve von envelopeFor(...)
+	 */
+	void addSignal(
+		const std::string& a_signalName,
+		const std::vector<sgnl::Volt>& a_signal,
+		const Envelope& a_envelope);
 
 	/*! \brief Plottet das t/U-Koordinatensystem fuer die uebergebene Laenge des
 	 *  Signals. Ein Pixel entspricht einer Nanosekunde
@@ -106,10 +392,15 @@ private:
 		Coordinate a_end) const;
 
 	SimpleBMP plot_;	/**< Plot-Bitmap */
-	SimpleBMP font_;	/**< Zeichensatz-Bitmap */
 	int fontSizeX_;		/**< Breite eines Zeichens */
 	int fontSizeY_;		/**< Hoehe eines Zeichens */
 	int nSignals_;		/**< Anzahl bisher geplotteter Signale */
+	bool direct_;		/**< Direktes Zeichenverfahren verwenden */
+	bool logic_;		/**< add(...) stellt Logiklevel dar */
+	TimeAxis axis_;		/**< Zeitfenster und Abbildung auf Pixelspalten */
+	std::shared_ptr<const PlotBackend> backend_;	/**< Ausgabeformat */
+	PlotScene scene_;	/**< Vektorbeschreibung des Plots */
+	bool sceneTraces_;	/**< Signalverlaeufe in scene_ aufzeichnen */
 
 };
 
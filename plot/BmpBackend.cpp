@@ -0,0 +1,21 @@
+/*! \file BmpBackend.cpp
+ *  \brief Implementierung der Klasse BmpBackend
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "BmpBackend.h"
+
+
+std::string BmpBackend::extension() const
+{
+	return ".bmp";
+}
+
+bool BmpBackend::write(
+	const SimpleBMP& a_raster,
+	const PlotScene& /*a_scene*/,
+	const std::string& a_path) const
+{
+	return a_raster.save(a_path.c_str()) == SIMPLEBMP_NO_ERROR;
+}
@@ -0,0 +1,35 @@
+/*! \file BmpBackend.h
+ *  \brief Definition der Klasse BmpBackend
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef BMPBACKEND_H_
+#define BMPBACKEND_H_
+
+#include "PlotBackend.h"
+
+/*! \class BmpBackend
+ *  \brief Schreibt den Plot als unkomprimiertes 24-Bit-Bitmap (Standard)
+ */
+class BmpBackend : public PlotBackend
+{
+public:
+	/*! \brief Gibt die Dateiendung zurueck
+	 *  \return ".bmp"
+	 */
+	std::string extension() const;
+
+	/*! \brief Schreibt das Pixelbild als Bitmap
+	 *  \param a_raster Pixelbild des Plots
+	 *  \param a_scene Nicht verwendet
+	 *  \param a_path Pfad der Datei
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool write(
+		const SimpleBMP& a_raster,
+		const PlotScene& a_scene,
+		const std::string& a_path) const;
+};
+
+#endif /* BMPBACKEND_H_ */
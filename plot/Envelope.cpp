@@ -0,0 +1,87 @@
+/*! \file Envelope.cpp
+ *  \brief Implementierung der Klasse Envelope
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "Envelope.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+using namespace sgnl;
+
+
+Envelope::Envelope()
+{
+
+}
+
+Envelope::Envelope(
+	const std::vector<sgnl::Volt>& a_values,
+	sgnl::Nanoseconds a_begin,
+	sgnl::Nanoseconds a_end,
+	int a_columns)
+{
+	a_begin = std::max(0, a_begin);
+	a_end = std::min(a_end, static_cast<Nanoseconds>(a_values.size()));
+	long long length = a_end - a_begin;
+	if(length <= 0 || a_columns <= 0)
+	{
+		return;
+	}
+	a_columns = static_cast<int>(std::min<long long>(a_columns, length));
+	min_.resize(a_columns);
+	max_.resize(a_columns);
+	last_.resize(a_columns);
+
+	// Spalte c umfasst die Werte [c*length/a_columns, (c+1)*length/a_columns)
+	const Volt *values = &a_values[a_begin];
+	long long i = 0;
+	for(int c=0; c<a_columns; c++)
+	{
+		long long columnEnd = (c+1)*length/a_columns;
+		Volt lo = values[i];
+		Volt hi = values[i];
+		for(i++; i<columnEnd; i++)
+		{
+			lo = std::min(lo, values[i]);
+			hi = std::max(hi, values[i]);
+		}
+		min_[c] = lo;
+		max_[c] = hi;
+		last_[c] = values[columnEnd-1];
+	}
+}
+
+Envelope::Envelope(
+	std::vector<sgnl::Volt> a_min,
+	std::vector<sgnl::Volt> a_max,
+	std::vector<sgnl::Volt> a_last) :
+	min_(std::move(a_min)),
+	max_(std::move(a_max)),
+	last_(std::move(a_last))
+{
+
+}
+
+int Envelope::nColumns() const
+{
+	return static_cast<int>(min_.size());
+}
+
+sgnl::Volt Envelope::min(int a_column) const
+{
+	return min_[a_column];
+}
+
+sgnl::Volt Envelope::max(int a_column) const
+{
+	return max_[a_column];
+}
+
+sgnl::Volt Envelope::last(int a_column) const
+{
+	return last_[a_column];
+}
@@ -0,0 +1,81 @@
+/*! \file Envelope.h
+ *  \brief Definition der Klasse Envelope
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef ENVELOPE_H_
+#define ENVELOPE_H_
+
+#include "../signal/Signal.h"
+
+#include <vector>
+
+/*! \class Envelope
+ *  \brief Min/Max-Huellkurve eines Signals fuer die Darstellung mit weniger
+ *  Pixelspalten als Werten. Ein Zeitfenster wird gleichmaessig auf die
+ *  Spalten verteilt; je Spalte werden kleinster, groesster und letzter Wert
+ *  in einem einzigen Durchlauf bestimmt
+ */
+class Envelope
+{
+public:
+	/*! \brief Parameterloser Konstruktor. Erzeugt eine leere Huellkurve
+	 */
+	Envelope();
+
+	/*! \brief Konstruktor. Berechnet die Huellkurve
+	 *  \param a_values Signal-Spannungswerte im 1-Nanosekunden-Raster
+	 *  \param a_begin Erster Wert des Zeitfensters
+	 *  \param a_end Erster Wert nach dem Zeitfenster (wird auf die Laenge
+	 *  des Signals begrenzt)
+	 *  \param a_columns Anzahl der Spalten (>= 1)
+	 */
+	Envelope(
+		const std::vector<sgnl::Volt>& a_values,
+		sgnl::Nanoseconds a_begin,
+		sgnl::Nanoseconds a_end,
+		int a_columns);
+
+	/*! \brief Konstruktor. Uebernimmt bereits berechnete Spalten, z. B. aus
+	 *  einer WaveformPyramid
+	 *  \param a_min kleinster Wert je Spalte
+	 *  \param a_max groesster Wert je Spalte
+	 *  \param a_last letzter Wert je Spalte
+	 */
+	Envelope(
+		std::vector<sgnl::Volt> a_min,
+		std::vector<sgnl::Volt> a_max,
+		std::vector<sgnl::Volt> a_last);
+
+	/*! \brief Gibt die Anzahl der Spalten zurueck
+	 *  \return Anzahl der Spalten
+	 */
+	int nColumns() const;
+
+	/*! \brief Gibt den kleinsten Wert einer Spalte zurueck
+	 *  \param a_column Spalte
+	 *  \return kleinster Wert
+	 */
+	sgnl::Volt min(int a_column) const;
+
+	/*! \brief Gibt den groessten Wert einer Spalte zurueck
+	 *  \param a_column Spalte
+	 *  \return groesster Wert
+	 */
+	sgnl::Volt max(int a_column) const;
+
+	/*! \brief Gibt den letzten Wert einer Spalte zurueck (fuer den
+	 *  luekenlosen Anschluss an die naechste Spalte)
+	 *  \param a_column Spalte
+	 *  \return letzter Wert
+	 */
+	sgnl::Volt last(int a_column) const;
+
+private:
+	std::vector<sgnl::Volt> min_;   /**< Kleinster Wert je Spalte */
+	std::vector<sgnl::Volt> max_;   /**< Groesster Wert je Spalte */
+	std::vector<sgnl::Volt> last_;  /**< Letzter Wert je Spalte */
+};
+
+#endif /* ENVELOPE_H_ */
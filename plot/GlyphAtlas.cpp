@@ -0,0 +1,138 @@
+/*! \file GlyphAtlas.cpp
+ *  \brief Implementierung der Klasse GlyphAtlas
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "GlyphAtlas.h"
+#include "simplebmp/simplebmp.h"
+#include "../diag/Log.h"
+
+#include <cstring>
+#include <iostream>
+#include <mutex>
+
+using namespace std;
+
+const int GlyphAtlas::N_GLYPHS;
+
+const GlyphAtlas& GlyphAtlas::instance()
+{
+	static once_flag flag;
+	static GlyphAtlas* pAtlas = nullptr;
+	call_once(flag, []()
+	{
+		pAtlas = new GlyphAtlas("./myCode/plot/font/font.bmp");
+	});
+	return *pAtlas;
+}
+
+GlyphAtlas::GlyphAtlas(const std::string& a_fileName) :
+	valid_(false),
+	glyphWidth_(0),
+	glyphHeight_(0),
+	maskWords_(0)
+{
+	// Anordnung in font.bmp: a-z, A-Z, " ,.:/_-", 0-9
+	for(int c=0; c<256; c++)
+	{
+		index_[c] = 52;
+	}
+	for(int c=0; c<26; c++)
+	{
+		index_['a'+c] = c;
+		index_['A'+c] = 26 + c;
+	}
+	for(int c=0; c<10; c++)
+	{
+		index_['0'+c] = 59 + c;
+	}
+	const char* punctuation = " ,.:/_-";
+	for(int c=0; punctuation[c] != '\0'; c++)
+	{
+		index_[static_cast<unsigned char>(punctuation[c])] = 52 + c;
+	}
+
+	SimpleBMP font;
+	if(font.load(a_fileName.c_str()) != 0)
+	{
+		DFSM_LOG_ERROR("BMPPlot", "Failed to load font.bmp in folder myCode/plot/font/font.bmp");
+		return;
+	}
+	glyphWidth_ = font.getWidth()/N_GLYPHS;
+	glyphHeight_ = font.getHeight();
+	maskWords_ = (glyphWidth_ + 63)/64;
+	const size_t rowBytes = static_cast<size_t>(glyphWidth_)*3;
+	pixels_.resize(rowBytes*glyphHeight_*N_GLYPHS);
+	masks_.assign(static_cast<size_t>(maskWords_)*glyphHeight_*N_GLYPHS, 0);
+	for(int g=0; g<N_GLYPHS; g++)
+	{
+		for(int y=0; y<glyphHeight_; y++)
+		{
+			// SimpleBMP speichert die Zeilen von unten nach oben
+			const unsigned char* src = font.getPixels()
+				+ static_cast<size_t>(glyphHeight_-1-y)*font.getWidth()*3
+				+ static_cast<size_t>(g)*rowBytes;
+			const size_t line = static_cast<size_t>(g)*glyphHeight_ + y;
+			memcpy(&pixels_[line*rowBytes], src, rowBytes);
+			for(int x=0; x<glyphWidth_; x++)
+			{
+				if(src[3*x] != 0 || src[3*x+1] != 0 || src[3*x+2] != 0)
+				{
+					masks_[line*maskWords_ + x/64] |= std::uint64_t(1) << (x%64);
+				}
+			}
+		}
+	}
+	valid_ = true;
+}
+
+bool GlyphAtlas::valid() const
+{
+	return valid_;
+}
+
+int GlyphAtlas::glyphWidth() const
+{
+	return glyphWidth_;
+}
+
+int GlyphAtlas::glyphHeight() const
+{
+	return glyphHeight_;
+}
+
+int GlyphAtlas::glyph(char a_ch) const
+{
+	return index_[static_cast<unsigned char>(a_ch)];
+}
+
+const unsigned char* GlyphAtlas::row(int a_glyph, int a_y) const
+{
+	return &pixels_[(static_cast<size_t>(a_glyph)*glyphHeight_ + a_y)
+		*glyphWidth_*3];
+}
+
+const std::uint64_t* GlyphAtlas::mask(int a_glyph, int a_y) const
+{
+	return &masks_[(static_cast<size_t>(a_glyph)*glyphHeight_ + a_y)
+		*maskWords_];
+}
+
+int GlyphAtlas::maskWords() const
+{
+	return maskWords_;
+}
+
+bool GlyphAtlas::blankRow(int a_glyph, int a_y) const
+{
+	const std::uint64_t* words = mask(a_glyph, a_y);
+	for(int w=0; w<maskWords_; w++)
+	{
+		if(words[w] != 0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,102 @@
+/*! \file GlyphAtlas.h
+ *  \brief Definition der Klasse GlyphAtlas
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef GLYPHATLAS_H_
+#define GLYPHATLAS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*! \class GlyphAtlas
+ *  \brief Prozessweit einmal dekodierter Zeichensatz fuer BMPPlot. Jedes
+ *  Zeichen liegt als zusammenhaengende BGR-Zeilen (von oben nach unten) vor,
+ *  dazu je Zeile eine Bitmaske der nicht schwarzen Pixel. Texte koennen so
+ *  zeilenweise kopiert werden, ohne den Zeichensatz pixelweise zu lesen
+ */
+class GlyphAtlas
+{
+public:
+	/*! \brief Gibt den Zeichensatz zurueck. Beim ersten Aufruf wird
+	 *  myCode/plot/font/font.bmp geladen (threadsicher, nur einmal je
+	 *  Prozess)
+	 *  \return Zeichensatz
+	 */
+	static const GlyphAtlas& instance();
+
+	/*! \brief Gibt zurueck, ob der Zeichensatz geladen werden konnte
+	 *  \return true, falls geladen, false sonst
+	 */
+	bool valid() const;
+
+	/*! \brief Gibt die Breite eines Zeichens zurueck
+	 *  \return Breite / Pixel, 0 falls nicht geladen
+	 */
+	int glyphWidth() const;
+
+	/*! \brief Gibt die Hoehe eines Zeichens zurueck
+	 *  \return Hoehe / Pixel, 0 falls nicht geladen
+	 */
+	int glyphHeight() const;
+
+	/*! \brief Gibt den Index des Zeichens im Zeichensatz zurueck. Nicht
+	 *  enthaltene Zeichen werden als Leerzeichen dargestellt
+	 *  \param a_ch Zeichen
+	 *  \return Index
+	 */
+	int glyph(char a_ch) const;
+
+	/*! \brief Gibt eine Pixelzeile eines Zeichens zurueck
+	 *  \param a_glyph Index des Zeichens
+	 *  \param a_y Zeile, 0 = oben
+	 *  \return glyphWidth() Pixel, je 3 Byte BGR
+	 */
+	const unsigned char* row(int a_glyph, int a_y) const;
+
+	/*! \brief Gibt die Bitmaske einer Pixelzeile zurueck, Bit x von Wort x/64
+	 *  ist gesetzt, falls Pixel x nicht schwarz ist
+	 *  \param a_glyph Index des Zeichens
+	 *  \param a_y Zeile, 0 = oben
+	 *  \return maskWords() Woerter
+	 */
+	const std::uint64_t* mask(int a_glyph, int a_y) const;
+
+	/*! \brief Gibt die Anzahl der 64-Bit-Woerter je Zeilenmaske zurueck
+	 *  \return Anzahl der Woerter
+	 */
+	int maskWords() const;
+
+	/*! \brief Gibt zurueck, ob eine Pixelzeile eines Zeichens nur schwarze
+	 *  Pixel enthaelt
+	 *  \param a_glyph Index des Zeichens
+	 *  \param a_y Zeile, 0 = oben
+	 *  \return true, falls die Zeile leer ist
+	 */
+	bool blankRow(int a_glyph, int a_y) const;
+
+	static const int N_GLYPHS = 69;  /**< Anzahl der Zeichen in font.bmp */
+
+private:
+	/*! \brief Konstruktor. Laedt und dekodiert das Zeichensatz-Bitmap
+	 *  \param a_fileName Pfad des Zeichensatz-Bitmaps
+	 */
+	GlyphAtlas(const std::string& a_fileName);
+
+	GlyphAtlas(const GlyphAtlas&) = delete;
+	GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+	bool valid_;        /**< Zeichensatz geladen */
+	int glyphWidth_;    /**< Breite eines Zeichens / Pixel */
+	int glyphHeight_;   /**< Hoehe eines Zeichens / Pixel */
+	int maskWords_;     /**< 64-Bit-Woerter je Zeilenmaske */
+	std::vector<unsigned char> pixels_;  /**< Je Zeichen glyphHeight_ Zeilen
+		mit glyphWidth_ BGR-Pixeln */
+	std::vector<std::uint64_t> masks_;   /**< Je Zeichen und Zeile
+		maskWords_ Woerter */
+	int index_[256];    /**< Zeichen -> Index im Zeichensatz */
+};
+
+#endif /* GLYPHATLAS_H_ */
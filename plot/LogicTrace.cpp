@@ -0,0 +1,91 @@
+/*! \file LogicTrace.cpp
+ *  \brief Implementierung der Klasse LogicTrace
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "LogicTrace.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace sgnl;
+
+
+LogicTrace::LogicTrace() :
+	initial_(false),
+	last_(false),
+	length_(0)
+{
+
+}
+
+LogicTrace::LogicTrace(const std::vector<sgnl::Volt>& a_values, bool a_initial) :
+	initial_(a_initial),
+	last_(a_initial),
+	length_(0)
+{
+	// Schwellen wie in sgnl::voltageToLogical(...), das vorherige Level ist
+	// das des vorherigen Werts
+	for(int i=0; i<static_cast<int>(a_values.size()); i++)
+	{
+		bool level = last_;
+		if(a_values[i] >= HIGH_THRESH_VOLT+DEADBAND_VOLT/2)
+		{
+			level = true;
+		}
+		else if(a_values[i] <= HIGH_THRESH_VOLT-DEADBAND_VOLT/2)
+		{
+			level = false;
+		}
+		append(level);
+	}
+}
+
+LogicTrace::LogicTrace(const std::vector<bool>& a_levels) :
+	initial_(false),
+	last_(false),
+	length_(0)
+{
+	for(int i=0; i<static_cast<int>(a_levels.size()); i++)
+	{
+		append(a_levels[i]);
+	}
+}
+
+void LogicTrace::append(bool a_level)
+{
+	if(length_ == 0)
+	{
+		initial_ = a_level;
+	}
+	else if(a_level != last_)
+	{
+		edges_.push_back(length_);
+	}
+	last_ = a_level;
+	length_++;
+	return;
+}
+
+sgnl::Nanoseconds LogicTrace::length() const
+{
+	return length_;
+}
+
+const std::vector<sgnl::Nanoseconds>& LogicTrace::edges() const
+{
+	return edges_;
+}
+
+bool LogicTrace::levelAt(sgnl::Nanoseconds a_time) const
+{
+	// Jede Flanke bis einschliesslich a_time kehrt das Level um
+	return initial_ != (firstEdgeAfter(a_time) % 2 == 1);
+}
+
+int LogicTrace::firstEdgeAfter(sgnl::Nanoseconds a_time) const
+{
+	return static_cast<int>(
+		std::upper_bound(edges_.begin(), edges_.end(), a_time) - edges_.begin());
+}
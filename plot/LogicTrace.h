@@ -0,0 +1,77 @@
+/*! \file LogicTrace.h
+ *  \brief Definition der Klasse LogicTrace
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef LOGICTRACE_H_
+#define LOGICTRACE_H_
+
+#include "../signal/Signal.h"
+
+#include <vector>
+
+/*! \class LogicTrace
+ *  \brief Logiklevel-Verlauf eines Signals als Liste der Flanken. Aus
+ *  Spannungswerten wird der Verlauf wie in sgnl::voltageToLogical(...)
+ *  bestimmt: innerhalb der Totzone bleibt das vorherige Logiklevel erhalten.
+ *  Der Speicherbedarf und der Aufwand fuer das Zeichnen eines Zeitfensters
+ *  haengen nur von der Anzahl der Flanken ab
+ */
+class LogicTrace
+{
+public:
+	/*! \brief Parameterloser Konstruktor. Erzeugt einen leeren Verlauf mit
+	 *  Logiklevel false
+	 */
+	LogicTrace();
+
+	/*! \brief Konstruktor. Bestimmt die Logiklevel aus Spannungswerten
+	 *  \param a_values Signal-Spannungswerte im 1-Nanosekunden-Raster
+	 *  \param a_initial Logiklevel vor dem ersten Wert (fuer Werte in der
+	 *  Totzone)
+	 */
+	LogicTrace(const std::vector<sgnl::Volt>& a_values, bool a_initial = false);
+
+	/*! \brief Konstruktor. Uebernimmt Logiklevel
+	 *  \param a_levels Logiklevel im 1-Nanosekunden-Raster
+	 */
+	LogicTrace(const std::vector<bool>& a_levels);
+
+	/*! \brief Haengt das Logiklevel der naechsten Nanosekunde an
+	 *  \param a_level Logiklevel
+	 */
+	void append(bool a_level);
+
+	/*! \brief Gibt die Laenge des Verlaufs zurueck
+	 *  \return Anzahl der Nanosekunden
+	 */
+	sgnl::Nanoseconds length() const;
+
+	/*! \brief Gibt die Zeitpunkte aller Flanken zurueck. Eine Flanke zum
+	 *  Zeitpunkt t bedeutet, dass sich das Logiklevel von t-1 nach t aendert
+	 *  \return Aufsteigend sortierte Zeitpunkte / ns
+	 */
+	const std::vector<sgnl::Nanoseconds>& edges() const;
+
+	/*! \brief Gibt das Logiklevel zu einem Zeitpunkt zurueck. Nach dem Ende
+	 *  des Verlaufs gilt das letzte Logiklevel
+	 *  \param a_time Zeitpunkt / ns
+	 *  \return Logiklevel
+	 */
+	bool levelAt(sgnl::Nanoseconds a_time) const;
+
+	/*! \brief Gibt den Index der ersten Flanke nach einem Zeitpunkt zurueck
+	 *  \param a_time Zeitpunkt / ns
+	 *  \return Index in edges(), edges().size() falls keine mehr folgt
+	 */
+	int firstEdgeAfter(sgnl::Nanoseconds a_time) const;
+
+private:
+	bool initial_;       /**< Logiklevel zum Zeitpunkt 0 */
+	bool last_;          /**< Logiklevel zum letzten Zeitpunkt */
+	sgnl::Nanoseconds length_;  /**< Anzahl der Nanosekunden */
+	std::vector<sgnl::Nanoseconds> edges_;  /**< Zeitpunkte der Flanken */
+};
+
+#endif /* LOGICTRACE_H_ */
@@ -0,0 +1,18 @@
+/*! \file PlotBackend.cpp
+ *  \brief Implementierung der Klasse PlotBackend
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "PlotBackend.h"
+
+
+PlotBackend::~PlotBackend()
+{
+
+}
+
+bool PlotBackend::needsScene() const
+{
+	return false;
+}
@@ -0,0 +1,51 @@
+/*! \file PlotBackend.h
+ *  \brief Definition der Klasse PlotBackend
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef PLOTBACKEND_H_
+#define PLOTBACKEND_H_
+
+#include "PlotScene.h"
+#include "simplebmp/simplebmp.h"
+
+#include <string>
+
+/*! \class PlotBackend
+ *  \brief Abstrakte Basisklasse fuer die Ausgabeformate von BMPPlot. Ein
+ *  Backend schreibt den fertigen Plot entweder aus dem Pixelbild (BMP, PNG)
+ *  oder aus der Vektorbeschreibung PlotScene (SVG) in eine Datei
+ */
+class PlotBackend
+{
+public:
+	/*! \brief Virtueller Destruktor
+	 */
+	virtual ~PlotBackend();
+
+	/*! \brief Gibt die Dateiendung des Formats zurueck
+	 *  \return Dateiendung mit Punkt, z. B. ".bmp"
+	 */
+	virtual std::string extension() const = 0;
+
+	/*! \brief Gibt zurueck, ob das Backend die Vektorbeschreibung benoetigt.
+	 *  Nur dann zeichnet BMPPlot sie beim Plotten mit auf
+	 *  \return true, falls PlotScene benoetigt wird
+	 */
+	virtual bool needsScene() const;
+
+	/*! \brief Schreibt den Plot in eine Datei
+	 *  \param a_raster Pixelbild des Plots
+	 *  \param a_scene Vektorbeschreibung des Plots (leer, falls
+	 *  needsScene() false liefert)
+	 *  \param a_path Pfad der Datei MIT Endung
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	virtual bool write(
+		const SimpleBMP& a_raster,
+		const PlotScene& a_scene,
+		const std::string& a_path) const = 0;
+};
+
+#endif /* PLOTBACKEND_H_ */
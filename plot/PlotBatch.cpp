@@ -0,0 +1,131 @@
+/*! \file PlotBatch.cpp
+ *  \brief Implementierung der Klasse PlotBatch
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "PlotBatch.h"
+#include "BMPPlot.h"
+#include "../util/ThreadPool.h"
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+using namespace std;
+using namespace sgnl;
+
+
+PlotBatch::PlotBatch(const std::string& a_directory, int a_nThreads) :
+	directory_(a_directory),
+	nThreads_(a_nThreads)
+{
+
+}
+
+void PlotBatch::setDirectory(const std::string& a_directory)
+{
+	directory_ = a_directory;
+	return;
+}
+
+void PlotBatch::setBackend(const std::shared_ptr<const PlotBackend>& a_backend)
+{
+	backend_ = a_backend;
+	return;
+}
+
+void PlotBatch::add(
+	const std::string& a_id,
+	const std::string& a_title,
+	const std::vector<std::string>& a_names,
+	std::vector<std::vector<sgnl::Volt> > a_signals,
+	sgnl::Nanoseconds a_begin,
+	sgnl::Nanoseconds a_end)
+{
+	Job job;
+	job.id_ = a_id;
+	for(int c=0; c<static_cast<int>(job.id_.size()); c++)
+	{
+		unsigned char ch = static_cast<unsigned char>(job.id_[c]);
+		if(!isalnum(ch) && ch != '-' && ch != '_' && ch != '.')
+		{
+			job.id_[c] = '_';
+		}
+	}
+	job.title_ = a_title;
+	job.names_ = a_names;
+	job.signals_ = std::move(a_signals);
+	job.begin_ = a_begin;
+	job.end_ = a_end;
+	jobs_.push_back(std::move(job));
+	return;
+}
+
+int PlotBatch::size() const
+{
+	return static_cast<int>(jobs_.size());
+}
+
+std::vector<std::string> PlotBatch::run()
+{
+	// Namen der Reihe nach vergeben, erst dann parallel zeichnen
+	vector<string> paths(jobs_.size());
+	string directory = directory_;
+	if(!directory.empty() && directory[directory.size()-1] != '/')
+	{
+		directory += '/';
+	}
+	for(int j=0; j<static_cast<int>(jobs_.size()); j++)
+	{
+		paths[j] = directory + BMPPlot::uniqueName(jobs_[j].id_)
+			+ (backend_ ? backend_->extension() : ".bmp");
+	}
+	{
+		ThreadPool pool(nThreads_);
+		for(int j=0; j<static_cast<int>(jobs_.size()); j++)
+		{
+			pool.submit([this, j, &paths]()
+			{
+				if(!render(jobs_[j], paths[j]))
+				{
+					paths[j].clear();
+				}
+			});
+		}
+		pool.wait();
+	}
+	jobs_.clear();
+	return paths;
+}
+
+bool PlotBatch::render(const Job& a_job, const std::string& a_path) const
+{
+	int nSignals = static_cast<int>(a_job.signals_.size());
+	Nanoseconds end = a_job.end_;
+	if(end < 0)
+	{
+		end = 0;
+		for(int s=0; s<nSignals; s++)
+		{
+			end = std::max(end, static_cast<Nanoseconds>(a_job.signals_[s].size()));
+		}
+	}
+	Nanoseconds begin = std::min(std::max(a_job.begin_, 0), end);
+
+	BMPPlot plot(a_job.title_, 1280,
+		std::max(800, BMPPlot::heightFor(nSignals)));
+	plot.setBackend(backend_);
+	if(end > begin)
+	{
+		plot.setTimeRange(begin, end);
+		plot.setTimeTicks(std::max(1, (end - begin)/10));
+	}
+	for(int s=0; s<nSignals; s++)
+	{
+		string name = (s < static_cast<int>(a_job.names_.size()))
+			? a_job.names_[s] : "";
+		plot.add(name, a_job.signals_[s]);
+	}
+	return plot.saveAs(a_path);
+}
@@ -0,0 +1,102 @@
+/*! \file PlotBatch.h
+ *  \brief Definition der Klasse PlotBatch
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef PLOTBATCH_H_
+#define PLOTBATCH_H_
+
+#include "PlotBackend.h"
+#include "../signal/Signal.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*! \class PlotBatch
+ *  \brief Zeichnet viele Plots parallel auf einem Thread-Pool und speichert
+ *  sie unter eindeutigen Dateinamen <id>_<Zeitstempel>_<Zaehler> (Endung je nach Backend) im
+ *  eingestellten Ordner. Die Namen werden vor dem Zeichnen in der
+ *  Reihenfolge der hinzugefuegten Plots vergeben und haengen daher nicht
+ *  von der Reihenfolge ab, in der die Threads fertig werden
+ */
+class PlotBatch
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_directory Ausgabeordner (muss existieren)
+	 *  \param a_nThreads Anzahl der Threads, 0 = Anzahl der Prozessorkerne
+	 */
+	PlotBatch(const std::string& a_directory = "./Plots", int a_nThreads = 0);
+
+	/*! \brief Legt den Ausgabeordner fest
+	 *  \param a_directory Ausgabeordner (muss existieren)
+	 */
+	void setDirectory(const std::string& a_directory);
+
+	/*! \brief Legt das Ausgabeformat aller Plots fest (Standard: BMP). Das
+	 *  Backend wird von allen Threads gleichzeitig verwendet
+	 *  \param a_backend Ausgabeformat
+	 */
+	void setBackend(const std::shared_ptr<const PlotBackend>& a_backend);
+
+	/*! \brief Fuegt einen Plot hinzu. Die Signale werden uebernommen (bei
+	 *  Uebergabe per std::move ohne Kopie)
+	 *  \param a_id Bezeichnung, z. B. Szenario-Id; Zeichen ausser
+	 *  Buchstaben, Ziffern, '-', '_' und '.' werden durch '_' ersetzt
+	 *  \param a_title Plot-Titel
+	 *  \param a_names Namen der Signale
+	 *  \param a_signals Signal-Spannungswerte im 1-Nanosekunden-Raster
+	 *  \param a_begin Beginn des Zeitfensters / ns
+	 *  \param a_end Ende des Zeitfensters / ns (exklusiv), -1 = Ende des
+	 *  laengsten Signals
+	 */
+	void add(
+		const std::string& a_id,
+		const std::string& a_title,
+		const std::vector<std::string>& a_names,
+		std::vector<std::vector<sgnl::Volt> > a_signals,
+		sgnl::Nanoseconds a_begin = 0,
+		sgnl::Nanoseconds a_end = -1);
+
+	/*! \brief Gibt die Anzahl der hinzugefuegten Plots zurueck
+	 *  \return Anzahl der Plots
+	 */
+	int size() const;
+
+	/*! \brief Zeichnet und speichert alle hinzugefuegten Plots und leert
+	 *  danach die Liste
+	 *  \return Pfade der gespeicherten Dateien in der Reihenfolge der
+	 *  hinzugefuegten Plots, leerer String bei Fehler
+	 */
+	std::vector<std::string> run();
+
+private:
+	/*! \brief Ein zu zeichnender Plot
+	 */
+	struct Job
+	{
+		std::string id_;                    /**< Bezeichnung */
+		std::string title_;                 /**< Plot-Titel */
+		std::vector<std::string> names_;    /**< Namen der Signale */
+		std::vector<std::vector<sgnl::Volt> > signals_;  /**< Signale */
+		sgnl::Nanoseconds begin_;           /**< Beginn des Zeitfensters */
+		sgnl::Nanoseconds end_;             /**< Ende des Zeitfensters */
+	};
+
+	/*! \brief Zeichnet einen Plot und speichert ihn
+	 *  \param a_job Plot
+	 *  \param a_path Pfad der Datei
+	 *  \return true, falls gespeichert, false sonst
+	 */
+	bool render(const Job& a_job, const std::string& a_path) const;
+
+	std::string directory_;  /**< Ausgabeordner */
+	int nThreads_;           /**< Anzahl der Threads */
+	std::shared_ptr<const PlotBackend> backend_;  /**< Ausgabeformat, leer =
+		BMP */
+	std::vector<Job> jobs_;  /**< Zu zeichnende Plots */
+};
+
+#endif /* PLOTBATCH_H_ */
@@ -0,0 +1,77 @@
+/*! \file PlotScene.h
+ *  \brief Definition der Struktur PlotScene
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef PLOTSCENE_H_
+#define PLOTSCENE_H_
+
+#include <string>
+#include <vector>
+
+/*! \brief Vektorbeschreibung eines BMPPlot in Pixelkoordinaten (Ursprung
+ *  oben links): Linien, Texte und die Signalverlaeufe als Polylinien, die
+ *  nur die Eckpunkte (Flanken und Enden waagrechter Abschnitte) enthalten.
+ *  Wird von Backends verwendet, die keine Pixel schreiben (siehe SvgBackend)
+ */
+struct PlotScene
+{
+	/*! \brief Farbe
+	 */
+	struct Color
+	{
+		unsigned char r_;  /**< Rot-Anteil, 0-255 */
+		unsigned char g_;  /**< Gruen-Anteil, 0-255 */
+		unsigned char b_;  /**< Blau-Anteil, 0-255 */
+	};
+
+	/*! \brief Pixelkoordinaten
+	 */
+	struct Point
+	{
+		int x_;  /**< X-Koordinate */
+		int y_;  /**< Y-Koordinate */
+	};
+
+	/*! \brief Einfarbige Linie (Achsen, Skalenstriche, Totband)
+	 */
+	struct Line
+	{
+		Point start_;   /**< Startpunkt */
+		Point end_;     /**< Endpunkt */
+		Color color_;   /**< Farbe */
+	};
+
+	/*! \brief Textzeile
+	 */
+	struct Text
+	{
+		Point where_;       /**< Obere linke Ecke des ersten Zeichens */
+		std::string text_;  /**< Text */
+	};
+
+	/*! \brief Signalverlauf. Die Farbe haengt wie im Bitmap von der
+	 *  Bildzeile ab: bis einschliesslich highY_ Logiklevel HIGH, bis
+	 *  einschliesslich deadbandY_ Totband, darunter LOW
+	 */
+	struct Trace
+	{
+		std::vector<Point> points_;  /**< Eckpunkte der Polylinie */
+		int highY_;                  /**< Letzte Bildzeile mit HIGH-Farbe */
+		int deadbandY_;              /**< Letzte Bildzeile mit Totband-Farbe */
+		Color high_;                 /**< Farbe HIGH */
+		Color deadband_;             /**< Farbe Totband */
+		Color low_;                  /**< Farbe LOW */
+	};
+
+	int width_;                 /**< Breite / Pixel */
+	int height_;                /**< Hoehe / Pixel */
+	int glyphWidth_;            /**< Breite eines Zeichens / Pixel */
+	int glyphHeight_;           /**< Hoehe eines Zeichens / Pixel */
+	std::vector<Line> lines_;   /**< Linien */
+	std::vector<Text> texts_;   /**< Texte */
+	std::vector<Trace> traces_; /**< Signalverlaeufe */
+};
+
+#endif /* PLOTSCENE_H_ */
@@ -0,0 +1,178 @@
+/*! \file PngBackend.cpp
+ *  \brief Implementierung der Klasse PngBackend
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "PngBackend.h"
+#include "../util/Deflate.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+using namespace std;
+
+
+PngBackend::PngBackend(int a_effort) :
+	effort_(a_effort)
+{
+
+}
+
+std::string PngBackend::extension() const
+{
+	return ".png";
+}
+
+bool PngBackend::write(
+	const SimpleBMP& a_raster,
+	const PlotScene& /*a_scene*/,
+	const std::string& a_path) const
+{
+	vector<unsigned char> png = encode(a_raster);
+	ofstream file(a_path.c_str(), ios::binary);
+	if(!file)
+	{
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(png.data()), png.size());
+	file.close();
+	return !file.fail();
+}
+
+std::vector<unsigned char> PngBackend::encode(const SimpleBMP& a_raster) const
+{
+	const int width = a_raster.getWidth();
+	const int height = a_raster.getHeight();
+	const size_t rowBytes = static_cast<size_t>(width)*3;
+
+	// Gefilterte Bildzeilen von oben nach unten, je ein Filterbyte davor
+	vector<unsigned char> filtered((rowBytes + 1)*height);
+	vector<unsigned char> row(rowBytes);
+	vector<unsigned char> prior(rowBytes, 0);
+	vector<unsigned char> candidate(rowBytes);
+	for(int y=0; y<height; y++)
+	{
+		// SimpleBMP: Zeilen von unten nach oben, Pixel als BGR
+		const unsigned char* src = a_raster.getPixels()
+			+ static_cast<size_t>(height-1-y)*rowBytes;
+		for(int x=0; x<width; x++)
+		{
+			row[3*x] = src[3*x+2];
+			row[3*x+1] = src[3*x+1];
+			row[3*x+2] = src[3*x];
+		}
+
+		unsigned char* out = &filtered[(rowBytes + 1)*y];
+		long long bestSum = -1;
+		for(int filter=0; filter<5; filter++)
+		{
+			long long sum = 0;
+			for(size_t i=0; i<rowBytes; i++)
+			{
+				int a = (i >= 3) ? row[i-3] : 0;
+				int b = prior[i];
+				int c = (i >= 3) ? prior[i-3] : 0;
+				int predictor = 0;
+				if(filter == 1)
+				{
+					predictor = a;
+				}
+				else if(filter == 2)
+				{
+					predictor = b;
+				}
+				else if(filter == 3)
+				{
+					predictor = (a + b)/2;
+				}
+				else if(filter == 4)
+				{
+					int p = a + b - c;
+					int pa = abs(p - a);
+					int pb = abs(p - b);
+					int pc = abs(p - c);
+					predictor = (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+				}
+				candidate[i] = static_cast<unsigned char>(row[i] - predictor);
+				sum += (candidate[i] < 128) ? candidate[i] : 256 - candidate[i];
+			}
+			if(bestSum < 0 || sum < bestSum)
+			{
+				bestSum = sum;
+				out[0] = static_cast<unsigned char>(filter);
+				std::copy(candidate.begin(), candidate.end(), out + 1);
+			}
+		}
+		prior.swap(row);
+	}
+
+	const unsigned char signature[8] = {137, 'P', 'N', 'G', '\r', '\n', 26, '\n'};
+	vector<unsigned char> png(signature, signature + 8);
+
+	vector<unsigned char> header(13, 0);
+	for(int k=0; k<4; k++)
+	{
+		header[k] = static_cast<unsigned char>(width >> (24 - 8*k));
+		header[4 + k] = static_cast<unsigned char>(height >> (24 - 8*k));
+	}
+	header[8] = 8;  // Bit je Farbkanal
+	header[9] = 2;  // RGB
+	appendChunk("IHDR", header, png);
+	appendChunk("IDAT",
+		Deflate::zlibCompress(filtered.data(), filtered.size(), effort_), png);
+	appendChunk("IEND", vector<unsigned char>(), png);
+	return png;
+}
+
+std::uint32_t PngBackend::crc32(
+	const unsigned char* a_data,
+	std::size_t a_size,
+	std::uint32_t a_crc)
+{
+	// Threadsicher einmalig initialisiert
+	static const vector<uint32_t> table = crcTable();
+	uint32_t crc = a_crc ^ 0xFFFFFFFFu;
+	for(size_t i=0; i<a_size; i++)
+	{
+		crc = table[(crc ^ a_data[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return crc ^ 0xFFFFFFFFu;
+}
+
+std::vector<std::uint32_t> PngBackend::crcTable()
+{
+	vector<uint32_t> table(256);
+	for(uint32_t n=0; n<256; n++)
+	{
+		uint32_t c = n;
+		for(int k=0; k<8; k++)
+		{
+			c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+		}
+		table[n] = c;
+	}
+	return table;
+}
+
+void PngBackend::appendChunk(
+	const char* a_type,
+	const std::vector<unsigned char>& a_data,
+	std::vector<unsigned char>& a_png)
+{
+	const uint32_t length = static_cast<uint32_t>(a_data.size());
+	for(int k=0; k<4; k++)
+	{
+		a_png.push_back(static_cast<unsigned char>(length >> (24 - 8*k)));
+	}
+	size_t typeStart = a_png.size();
+	a_png.insert(a_png.end(), a_type, a_type + 4);
+	a_png.insert(a_png.end(), a_data.begin(), a_data.end());
+	uint32_t crc = crc32(&a_png[typeStart], a_png.size() - typeStart);
+	for(int k=0; k<4; k++)
+	{
+		a_png.push_back(static_cast<unsigned char>(crc >> (24 - 8*k)));
+	}
+	return;
+}
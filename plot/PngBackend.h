@@ -0,0 +1,83 @@
+/*! \file PngBackend.h
+ *  \brief Definition der Klasse PngBackend
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef PNGBACKEND_H_
+#define PNGBACKEND_H_
+
+#include "PlotBackend.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*! \class PngBackend
+ *  \brief Schreibt den Plot als PNG (24 Bit RGB). Je Bildzeile wird der
+ *  PNG-Filter mit der kleinsten Summe der Absolutwerte gewaehlt, komprimiert
+ *  wird mit dem eigenen Deflate-Kompressor; es wird keine externe Bibliothek
+ *  benoetigt
+ */
+class PngBackend : public PlotBackend
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_effort Suchtiefe des Kompressors (Positionen je Hash-Kette),
+	 *  groesser = kleinere Dateien, langsamer
+	 */
+	PngBackend(int a_effort = 32);
+
+	/*! \brief Gibt die Dateiendung zurueck
+	 *  \return ".png"
+	 */
+	std::string extension() const;
+
+	/*! \brief Schreibt das Pixelbild als PNG
+	 *  \param a_raster Pixelbild des Plots
+	 *  \param a_scene Nicht verwendet
+	 *  \param a_path Pfad der Datei
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool write(
+		const SimpleBMP& a_raster,
+		const PlotScene& a_scene,
+		const std::string& a_path) const;
+
+	/*! \brief Kodiert ein Pixelbild als PNG
+	 *  \param a_raster Pixelbild
+	 *  \return Inhalt der PNG-Datei
+	 */
+	std::vector<unsigned char> encode(const SimpleBMP& a_raster) const;
+
+	/*! \brief Berechnet die CRC-32-Pruefsumme (ISO 3309) wie fuer PNG-Chunks
+	 *  \param a_data Daten
+	 *  \param a_size Anzahl Bytes
+	 *  \param a_crc Bisherige Pruefsumme zum Fortsetzen, 0 = neu
+	 *  \return Pruefsumme
+	 */
+	static std::uint32_t crc32(
+		const unsigned char* a_data,
+		std::size_t a_size,
+		std::uint32_t a_crc = 0);
+
+private:
+	/*! \brief Berechnet die Tabelle fuer crc32(...)
+	 *  \return CRC-32 je Bytewert
+	 */
+	static std::vector<std::uint32_t> crcTable();
+
+	/*! \brief Haengt einen PNG-Chunk (Laenge, Typ, Daten, CRC) an
+	 *  \param a_type Chunk-Typ, 4 Zeichen
+	 *  \param a_data Daten
+	 *  \param a_png Ausgabe
+	 */
+	static void appendChunk(
+		const char* a_type,
+		const std::vector<unsigned char>& a_data,
+		std::vector<unsigned char>& a_png);
+
+	int effort_;  /**< Suchtiefe des Kompressors */
+};
+
+#endif /* PNGBACKEND_H_ */
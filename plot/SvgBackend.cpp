@@ -0,0 +1,159 @@
+/*! \file SvgBackend.cpp
+ *  \brief Implementierung der Klasse SvgBackend
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "SvgBackend.h"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+
+using namespace std;
+
+
+std::string SvgBackend::extension() const
+{
+	return ".svg";
+}
+
+bool SvgBackend::needsScene() const
+{
+	return true;
+}
+
+bool SvgBackend::write(
+	const SimpleBMP& /*a_raster*/,
+	const PlotScene& a_scene,
+	const std::string& a_path) const
+{
+	ofstream file(a_path.c_str());
+	if(!file)
+	{
+		return false;
+	}
+	writeSvg(a_scene, file);
+	file.close();
+	return !file.fail();
+}
+
+void SvgBackend::writeSvg(const PlotScene& a_scene, std::ostream& a_out) const
+{
+	a_out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+		  << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << a_scene.width_
+		  << "\" height=\"" << a_scene.height_ << "\" viewBox=\"0 0 "
+		  << a_scene.width_ << " " << a_scene.height_
+		  << "\" shape-rendering=\"crispEdges\">\n"
+		  << "<rect width=\"100%\" height=\"100%\" fill=\"#000000\"/>\n";
+
+	// Linien gleicher Farbe in einem Pfad, Pixelmitten bei +0.5
+	map<string, vector<const PlotScene::Line*> > linesByColor;
+	for(int l=0; l<static_cast<int>(a_scene.lines_.size()); l++)
+	{
+		linesByColor[hex(a_scene.lines_[l].color_)].push_back(&a_scene.lines_[l]);
+	}
+	for(map<string, vector<const PlotScene::Line*> >::const_iterator it
+		= linesByColor.begin(); it != linesByColor.end(); it++)
+	{
+		a_out << "<path fill=\"none\" stroke=\"" << it->first << "\" d=\"";
+		for(int l=0; l<static_cast<int>(it->second.size()); l++)
+		{
+			const PlotScene::Line& line = *it->second[l];
+			a_out << "M" << center(line.start_.x_) << " " << center(line.start_.y_)
+				  << "L" << center(line.end_.x_) << " " << center(line.end_.y_);
+		}
+		a_out << "\"/>\n";
+	}
+
+	for(int t=0; t<static_cast<int>(a_scene.traces_.size()); t++)
+	{
+		const PlotScene::Trace& trace = a_scene.traces_[t];
+		if(trace.points_.empty())
+		{
+			continue;
+		}
+		// Bildzeile y (Mitte y+0.5) ist HIGH fuer y <= highY_, Totband fuer
+		// y <= deadbandY_; ein Verlauf der Hoehe 0 ist in SVG nicht erlaubt
+		double y1 = trace.highY_ + 1;
+		double y2 = (trace.deadbandY_ > trace.highY_) ? trace.deadbandY_ + 1
+			: y1 + 0.01;
+		a_out << "<linearGradient id=\"trace" << t
+			  << "\" gradientUnits=\"userSpaceOnUse\" x1=\"0\" y1=\"" << y1
+			  << "\" x2=\"0\" y2=\"" << y2 << "\">"
+			  << "<stop offset=\"0\" stop-color=\"" << hex(trace.high_) << "\"/>"
+			  << "<stop offset=\"0\" stop-color=\"" << hex(trace.deadband_) << "\"/>"
+			  << "<stop offset=\"1\" stop-color=\"" << hex(trace.deadband_) << "\"/>"
+			  << "<stop offset=\"1\" stop-color=\"" << hex(trace.low_) << "\"/>"
+			  << "</linearGradient>\n";
+		a_out << "<polyline fill=\"none\" stroke=\"url(#trace" << t
+			  << ")\" points=\"";
+		for(int p=0; p<static_cast<int>(trace.points_.size()); p++)
+		{
+			a_out << (p > 0 ? " " : "") << center(trace.points_[p].x_) << ","
+				  << center(trace.points_[p].y_);
+		}
+		a_out << "\"/>\n";
+	}
+
+	if(!a_scene.texts_.empty())
+	{
+		a_out << "<g font-family=\"monospace\" font-size=\"" << a_scene.glyphHeight_
+			  << "\" fill=\"#ffffff\">\n";
+	}
+	for(int t=0; t<static_cast<int>(a_scene.texts_.size()); t++)
+	{
+		const PlotScene::Text& text = a_scene.texts_[t];
+		// Grundlinie bei etwa 80 % der Zeichenhoehe
+		a_out << "<text x=\"" << text.where_.x_ << "\" y=\""
+			  << text.where_.y_ + a_scene.glyphHeight_*4/5 << "\" textLength=\""
+			  << a_scene.glyphWidth_*static_cast<int>(text.text_.size())
+			  << "\" lengthAdjust=\"spacingAndGlyphs\">";
+		for(int c=0; c<static_cast<int>(text.text_.size()); c++)
+		{
+			char ch = text.text_[c];
+			if(ch == '<')
+			{
+				a_out << "&lt;";
+			}
+			else if(ch == '>')
+			{
+				a_out << "&gt;";
+			}
+			else if(ch == '&')
+			{
+				a_out << "&amp;";
+			}
+			else
+			{
+				a_out << ch;
+			}
+		}
+		a_out << "</text>\n";
+	}
+	if(!a_scene.texts_.empty())
+	{
+		a_out << "</g>\n";
+	}
+	a_out << "</svg>\n";
+	return;
+}
+
+std::string SvgBackend::hex(PlotScene::Color a_color)
+{
+	char buffer[8];
+	snprintf(buffer, sizeof(buffer), "#%02x%02x%02x", a_color.r_, a_color.g_,
+		a_color.b_);
+	return buffer;
+}
+
+std::string SvgBackend::center(int a_pixel)
+{
+	// Ganzzahlig ausgeben, Gleitkomma-Formatierung wuerde bei grossen
+	// Koordinaten runden
+	if(a_pixel >= 0)
+	{
+		return to_string(a_pixel) + ".5";
+	}
+	return "-" + to_string(-(a_pixel + 1)) + ".5";
+}
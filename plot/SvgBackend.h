@@ -0,0 +1,65 @@
+/*! \file SvgBackend.h
+ *  \brief Definition der Klasse SvgBackend
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef SVGBACKEND_H_
+#define SVGBACKEND_H_
+
+#include "PlotBackend.h"
+
+#include <ostream>
+
+/*! \class SvgBackend
+ *  \brief Schreibt den Plot als Vektorgrafik (SVG) aus der PlotScene. Jeder
+ *  Signalverlauf wird als eine Polylinie aus seinen Eckpunkten geschrieben,
+ *  die Logiklevel-Farben liefert ein Farbverlauf mit harten Uebergaengen an
+ *  den Totband-Grenzen. Die Dateigroesse haengt damit von der Anzahl der
+ *  Flanken ab, nicht von der Bildgroesse
+ */
+class SvgBackend : public PlotBackend
+{
+public:
+	/*! \brief Gibt die Dateiendung zurueck
+	 *  \return ".svg"
+	 */
+	std::string extension() const;
+
+	/*! \brief Gibt zurueck, dass die Vektorbeschreibung benoetigt wird
+	 *  \return true
+	 */
+	bool needsScene() const;
+
+	/*! \brief Schreibt die Vektorbeschreibung als SVG
+	 *  \param a_raster Nicht verwendet
+	 *  \param a_scene Vektorbeschreibung des Plots
+	 *  \param a_path Pfad der Datei
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	bool write(
+		const SimpleBMP& a_raster,
+		const PlotScene& a_scene,
+		const std::string& a_path) const;
+
+	/*! \brief Schreibt die Vektorbeschreibung als SVG in einen Stream
+	 *  \param a_scene Vektorbeschreibung des Plots
+	 *  \param a_out Ausgabe
+	 */
+	void writeSvg(const PlotScene& a_scene, std::ostream& a_out) const;
+
+private:
+	/*! \brief Gibt eine Farbe als #rrggbb zurueck
+	 *  \param a_color Farbe
+	 *  \return Farbe als Text
+	 */
+	static std::string hex(PlotScene::Color a_color);
+
+	/*! \brief Gibt die Mitte eines Pixels als Koordinate zurueck
+	 *  \param a_pixel Pixelkoordinate
+	 *  \return a_pixel + 0.5 als Text
+	 */
+	static std::string center(int a_pixel);
+};
+
+#endif /* SVGBACKEND_H_ */
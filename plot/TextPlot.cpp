@@ -0,0 +1,374 @@
+/*! \file TextPlot.cpp
+ *  \brief Implementierung der Klasse TextPlot
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "TextPlot.h"
+#include "../util/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+using namespace std;
+using namespace sgnl;
+
+
+const TextPlot::Glyphs TextPlot::ASCII_GLYPHS = {
+	"_", "-", "/", "\\", "#", "X", "=",
+	{ " ", ".", "_", ",", "-", "~", "=", "*", "#" }
+};
+
+const TextPlot::Glyphs TextPlot::UNICODE_GLYPHS = {
+	"▁", "▔", "╱", "╲", "▒", "╳", "═",
+	{ " ", "▁", "▂", "▃", "▄", "▅", "▆",
+		"▇", "█" }
+};
+
+TextPlot::TextPlot(
+	const std::string& a_title,
+	int a_columns,
+	int a_nameWidth) :
+	title_(a_title),
+	nameWidth_(std::max(a_nameWidth, 1)),
+	axis_(std::max(a_columns, 1)),
+	unicode_(false),
+	logic_(true),
+	tickSpacing_(0),
+	maxLength_(0)
+{
+
+}
+
+void TextPlot::setUnicode(bool a_unicode)
+{
+	unicode_ = a_unicode;
+	return;
+}
+
+void TextPlot::setLogicLevels(bool a_logic)
+{
+	logic_ = a_logic;
+	return;
+}
+
+void TextPlot::setTimeRange(sgnl::Nanoseconds a_begin, sgnl::Nanoseconds a_end)
+{
+	axis_.setRange(a_begin, a_end);
+	return;
+}
+
+void TextPlot::setTimeTicks(sgnl::Nanoseconds a_spacing)
+{
+	tickSpacing_ = a_spacing;
+	return;
+}
+
+void TextPlot::add(
+	const std::string& a_signalName,
+	const std::vector<sgnl::Volt>& a_signal)
+{
+	addRow(a_signalName, signalRow(a_signal), a_signal.size());
+	return;
+}
+
+void TextPlot::add(
+	const std::vector<std::string>& a_signalNames,
+	const std::vector<const std::vector<sgnl::Volt>*>& a_signals,
+	int a_nThreads)
+{
+	// Zeilen parallel berechnen, der Reihe nach uebernehmen
+	vector<string> rows(a_signals.size());
+	ThreadPool::forEach(static_cast<int>(a_signals.size()), a_nThreads,
+		[this, &a_signals, &rows](int a_s)
+		{
+			rows[a_s] = signalRow(*a_signals[a_s]);
+		});
+	for(int s=0; s<static_cast<int>(a_signals.size()); s++)
+	{
+		addRow(a_signalNames[s], rows[s], a_signals[s]->size());
+	}
+	return;
+}
+
+void TextPlot::add(
+	const std::string& a_signalName,
+	const WaveformPyramid& a_pyramid)
+{
+	if(logic_)
+	{
+		addLogic(a_signalName, LogicTrace(a_pyramid.values()));
+		return;
+	}
+	Nanoseconds begin = 0;
+	Nanoseconds end = 0;
+	int nColumns = axis_.envelopeColumns(a_pyramid.length(), begin, end);
+	addRow(a_signalName,
+		analogRow(a_pyramid.values(), nColumns > 0
+			? a_pyramid.envelope(begin, end, nColumns) : Envelope(), begin, end),
+		a_pyramid.length());
+	return;
+}
+
+void TextPlot::addLogic(
+	const std::string& a_signalName,
+	const LogicTrace& a_trace)
+{
+	addRow(a_signalName, logicRow(a_trace), a_trace.length());
+	return;
+}
+
+void TextPlot::addBus(
+	const std::string& a_busName,
+	const std::vector<const LogicTrace*>& a_bits)
+{
+	Nanoseconds length = 0;
+	for(int b=0; b<static_cast<int>(a_bits.size()); b++)
+	{
+		length = std::max(length, a_bits[b]->length());
+	}
+	addRow(a_busName, busRow(a_bits), length);
+	return;
+}
+
+int TextPlot::nSignals() const
+{
+	return static_cast<int>(rows_.size());
+}
+
+void TextPlot::write(std::ostream& a_out) const
+{
+	a_out << title_ << "\n\n";
+
+	// Zeitachse: Beschriftung und Skalenstriche ueber allen Zeilen
+	Nanoseconds length = axis_.hasRange() ? axis_.length(0) : maxLength_;
+	int nColumns = axis_.columns(length);
+	if(tickSpacing_ > 0 && nColumns > 0)
+	{
+		vector<Nanoseconds> ticks = TimeAxis::ticks(tickSpacing_, length);
+		string labels;
+		string ruler;
+		int rulerColumns = 0;
+		for(int k=0; k<static_cast<int>(ticks.size()); k++)
+		{
+			int column = axis_.column(axis_.begin()+ticks[k], axis_.begin(),
+				length);
+			// Ueberlappende Beschriftungen weglassen
+			if(column >= static_cast<int>(labels.size()))
+			{
+				labels.append(column-labels.size(), ' ');
+				labels += to_string(axis_.begin()+ticks[k]) + " ";
+			}
+			fill(ruler, unicode_ ? "─" : "-", column-rulerColumns);
+			ruler += unicode_ ? "┬" : "+";
+			rulerColumns = column+1;
+		}
+		fill(ruler, unicode_ ? "─" : "-", nColumns-rulerColumns);
+		a_out << nameColumn("t/ns") << labels << "\n"
+			<< string(nameWidth_, ' ') << ruler << "\n";
+	}
+	for(int r=0; r<static_cast<int>(rows_.size()); r++)
+	{
+		a_out << names_[r] << rows_[r] << "\n";
+	}
+	a_out.flush();
+	return;
+}
+
+const TextPlot::Glyphs& TextPlot::glyphs() const
+{
+	return unicode_ ? UNICODE_GLYPHS : ASCII_GLYPHS;
+}
+
+void TextPlot::fill(std::string& a_row, const char* a_glyph, int a_count)
+{
+	for(int i=0; i<a_count; i++)
+	{
+		a_row += a_glyph;
+	}
+	return;
+}
+
+std::string TextPlot::signalRow(const std::vector<sgnl::Volt>& a_signal) const
+{
+	if(logic_)
+	{
+		return logicRow(LogicTrace(a_signal));
+	}
+	Nanoseconds begin = 0;
+	Nanoseconds end = 0;
+	int nColumns = axis_.envelopeColumns(a_signal.size(), begin, end);
+	return analogRow(a_signal, nColumns > 0
+		? Envelope(a_signal, begin, end, nColumns) : Envelope(), begin, end);
+}
+
+std::string TextPlot::analogRow(
+	const std::vector<sgnl::Volt>& a_signal,
+	const Envelope& a_envelope,
+	sgnl::Nanoseconds a_begin,
+	sgnl::Nanoseconds a_end) const
+{
+	const Glyphs& g = glyphs();
+	string row;
+	int nColumns = (a_envelope.nColumns() > 0)
+		? a_envelope.nColumns() : std::max(0, a_end-a_begin);
+	for(int c=0; c<nColumns; c++)
+	{
+		Volt value = (a_envelope.nColumns() > 0)
+			? a_envelope.max(c) : a_signal[a_begin+c];
+		int level = static_cast<int>(std::lround(value/HIGH_LEVEL_VOLT*8));
+		row += g.levels_[std::min(std::max(level, 0), 8)];
+	}
+	return row;
+}
+
+std::string TextPlot::logicRow(const LogicTrace& a_trace) const
+{
+	const Glyphs& g = glyphs();
+	string row;
+	Nanoseconds begin = 0;
+	Nanoseconds end = 0;
+	axis_.window(a_trace.length(), begin, end);
+	Nanoseconds length = axis_.length(a_trace.length());
+	if(end <= begin)
+	{
+		return row;
+	}
+	const vector<Nanoseconds>& edges = a_trace.edges();
+	bool level = a_trace.levelAt(begin);
+	int i = a_trace.firstEdgeAfter(begin);
+	int n = a_trace.firstEdgeAfter(end-1);
+	int column = 0;
+
+	// Wie BMPPlot::plotLogic(...): alle Flanken einer Spalte werden per
+	// Binaersuche uebersprungen
+	while(i < n)
+	{
+		int c = axis_.column(edges[i], begin, length);
+		int j = static_cast<int>(std::lower_bound(
+			edges.begin()+i, edges.begin()+n,
+			axis_.time(c+1, begin, length)) - edges.begin());
+		fill(row, level ? g.high_ : g.low_, c-column);
+		if(j-i == 1)
+		{
+			row += level ? g.falling_ : g.rising_;
+		}
+		else
+		{
+			row += g.busy_;
+		}
+		if((j-i) % 2 == 1)
+		{
+			level = !level;
+		}
+		column = c+1;
+		i = j;
+	}
+	fill(row, level ? g.high_ : g.low_,
+		axis_.column(end-1, begin, length)+1-column);
+	return row;
+}
+
+std::string TextPlot::busRow(const std::vector<const LogicTrace*>& a_bits) const
+{
+	const Glyphs& g = glyphs();
+	string row;
+	Nanoseconds traceLength = 0;
+	for(int b=0; b<static_cast<int>(a_bits.size()); b++)
+	{
+		traceLength = std::max(traceLength, a_bits[b]->length());
+	}
+	Nanoseconds begin = 0;
+	Nanoseconds end = 0;
+	axis_.window(traceLength, begin, end);
+	Nanoseconds length = axis_.length(traceLength);
+	if(end <= begin || a_bits.empty())
+	{
+		return row;
+	}
+	const int nBits = std::min(static_cast<int>(a_bits.size()), 64);
+	const int nDigits = (nBits+3)/4;
+
+	// Wie BMPPlot::plotBus(...)
+	vector<pair<Nanoseconds, int> > changes;
+	unsigned long long value = 0;
+	for(int b=0; b<nBits; b++)
+	{
+		const vector<Nanoseconds>& edges = a_bits[b]->edges();
+		int n = a_bits[b]->firstEdgeAfter(end-1);
+		for(int i=a_bits[b]->firstEdgeAfter(begin); i<n; i++)
+		{
+			changes.push_back(pair<Nanoseconds, int>(edges[i], b));
+		}
+		if(a_bits[b]->levelAt(begin))
+		{
+			value |= 1ULL << b;
+		}
+	}
+	std::sort(changes.begin(), changes.end());
+
+	int column = 0;
+	int k = 0;
+	while(k < static_cast<int>(changes.size()))
+	{
+		int c = axis_.column(changes[k].first, begin, length);
+		Nanoseconds next = axis_.time(c+1, begin, length);
+		busSegment(row, c-column, value, nDigits);
+		bool single = true;
+		int m = k;
+		for(; m<static_cast<int>(changes.size()) && changes[m].first<next; m++)
+		{
+			value ^= 1ULL << changes[m].second;
+			single = single && (changes[m].first == changes[k].first);
+		}
+		row += single ? g.change_ : g.busy_;
+		column = c+1;
+		k = m;
+	}
+	busSegment(row, axis_.column(end-1, begin, length)+1-column, value, nDigits);
+	return row;
+}
+
+void TextPlot::busSegment(
+	std::string& a_row,
+	int a_width,
+	unsigned long long a_value,
+	int a_nDigits) const
+{
+	if(a_width <= 0)
+	{
+		return;
+	}
+	int nFill = a_width;
+	if(a_nDigits <= a_width)
+	{
+		stringstream ss;
+		ss << uppercase << hex << setw(a_nDigits) << setfill('0') << a_value;
+		a_row += ss.str();
+		nFill -= a_nDigits;
+	}
+	fill(a_row, glyphs().fill_, nFill);
+	return;
+}
+
+void TextPlot::addRow(
+	const std::string& a_signalName,
+	const std::string& a_row,
+	sgnl::Nanoseconds a_length)
+{
+	names_.push_back(nameColumn(a_signalName));
+	rows_.push_back(a_row);
+	maxLength_ = std::max(maxLength_, a_length);
+	return;
+}
+
+std::string TextPlot::nameColumn(const std::string& a_name) const
+{
+	// Mindestens ein Leerzeichen Abstand zum Verlauf
+	string name = a_name.substr(0, nameWidth_-1);
+	name.append(nameWidth_-name.size(), ' ');
+	return name;
+}
@@ -0,0 +1,228 @@
+/*! \file TextPlot.h
+ *  \brief Definition der Klasse TextPlot
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef TEXTPLOT_H_
+#define TEXTPLOT_H_
+
+#include "Envelope.h"
+#include "LogicTrace.h"
+#include "TimeAxis.h"
+#include "WaveformPyramid.h"
+#include "../signal/Signal.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*! \class TextPlot
+ *  \brief Gibt Signalverlaeufe als Text aus, z. B. auf der Konsole von
+ *  Rechnern ohne Bildschirm. Aufbau wie bei BMPPlot: Titel, Zeitachse mit
+ *  Skalenstrichen (setTimeTicks(...)), darunter je Signal eine Zeile mit
+ *  Namen und Verlauf, ein Zeichen je Spalte. Zeitfenster und Stauchung
+ *  langer Signale wie bei BMPPlot (siehe TimeAxis). Standardmaessig werden
+ *  Logiklevel dargestellt, der Aufwand haengt dann nur von der Anzahl der
+ *  Flanken bzw. der Spalten ab
+ */
+class TextPlot
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_title Plot-Titel
+	 *  \param a_columns Anzahl der Zeichen fuer den Verlauf
+	 *  \param a_nameWidth Anzahl der Zeichen fuer den Namen (laengere Namen
+	 *  werden abgeschnitten)
+	 */
+	TextPlot(
+		const std::string& a_title,
+		int a_columns = 100,
+		int a_nameWidth = 12);
+
+	/*! \brief Waehlt den Zeichensatz. Unicode (UTF-8) verwendet Block- und
+	 *  Linienzeichen, sonst nur ASCII (Standard). Muss vor add(...)
+	 *  aufgerufen werden
+	 *  \param a_unicode true = Unicode
+	 */
+	void setUnicode(bool a_unicode);
+
+	/*! \brief Waehlt die Darstellung fuer add(...). Mit Logikleveln
+	 *  (Standard) wird jedes Signal wie mit addLogic(...) dargestellt, sonst
+	 *  der groesste Spannungswert je Spalte als Balken in 9 Stufen. Muss vor
+	 *  add(...) aufgerufen werden
+	 *  \param a_logic true = Logiklevel darstellen
+	 */
+	void setLogicLevels(bool a_logic);
+
+	/*! \brief Legt das darzustellende Zeitfenster fest (siehe
+	 *  BMPPlot::setTimeRange(...)). Muss vor add(...) aufgerufen werden
+	 *  \param a_begin Beginn des Zeitfensters / ns
+	 *  \param a_end Ende des Zeitfensters / ns (exklusiv)
+	 */
+	void setTimeRange(sgnl::Nanoseconds a_begin, sgnl::Nanoseconds a_end);
+
+	/*! \brief Legt den Abstand der Skalenstriche auf der Zeitachse fest
+	 *  \param a_spacing Abstand zwischen den Skalenstrichen / ns, 0 = keine
+	 */
+	void setTimeTicks(sgnl::Nanoseconds a_spacing);
+
+	/*! \brief Fuegt ein Signal hinzu
+	 *  \param a_signalName Name des Signals
+	 *  \param a_signal Signal-Spannungswerte im 1-Nanosekunden-Raster
+	 */
+	void add(
+		const std::string& a_signalName,
+		const std::vector<sgnl::Volt>& a_signal);
+
+	/*! \brief Fuegt mehrere Signale hinzu. Die Zeilen werden parallel
+	 *  berechnet
+	 *  \param a_signalNames Namen der Signale
+	 *  \param a_signals Signal-Spannungswerte im 1-Nanosekunden-Raster
+	 *  \param a_nThreads Anzahl der Threads, 0 = Anzahl der Prozessorkerne
+	 */
+	void add(
+		const std::vector<std::string>& a_signalNames,
+		const std::vector<const std::vector<sgnl::Volt>*>& a_signals,
+		int a_nThreads = 0);
+
+	/*! \brief Fuegt ein Signal aus seiner Min/Max-Pyramide hinzu
+	 *  \param a_signalName Name des Signals
+	 *  \param a_pyramid Min/Max-Pyramide des Signals
+	 */
+	void add(
+		const std::string& a_signalName,
+		const WaveformPyramid& a_pyramid);
+
+	/*! \brief Fuegt einen Logiklevel-Verlauf hinzu. Flanken werden als / und
+	 *  \\ dargestellt, mehrere Flanken in einer Spalte als #
+	 *  \param a_signalName Name des Signals
+	 *  \param a_trace Logiklevel-Verlauf
+	 */
+	void addLogic(
+		const std::string& a_signalName,
+		const LogicTrace& a_trace);
+
+	/*! \brief Fuegt mehrere Signale als Bus in einer Zeile hinzu (siehe
+	 *  BMPPlot::addBus(...)). Wertwechsel werden als X dargestellt, jeder
+	 *  Abschnitt beginnt mit seinem hexadezimalen Wert, sofern er passt
+	 *  \param a_busName Name des Busses
+	 *  \param a_bits Logiklevel-Verlaeufe, niederwertigstes Bit zuerst
+	 *  (hoechstens 64)
+	 */
+	void addBus(
+		const std::string& a_busName,
+		const std::vector<const LogicTrace*>& a_bits);
+
+	/*! \brief Gibt die Anzahl der hinzugefuegten Signale zurueck
+	 *  \return Anzahl der Zeilen
+	 */
+	int nSignals() const;
+
+	/*! \brief Schreibt den Plot in einen Stream
+	 *  \param a_out Ausgabe, z. B. std::cout
+	 */
+	void write(std::ostream& a_out) const;
+
+private:
+	/*! \brief Zeichen fuer die Darstellung
+	 */
+	struct Glyphs
+	{
+		const char* low_;      /**< Logiklevel false */
+		const char* high_;     /**< Logiklevel true */
+		const char* rising_;   /**< Steigende Flanke */
+		const char* falling_;  /**< Fallende Flanke */
+		const char* busy_;     /**< Mehrere Flanken in einer Spalte */
+		const char* change_;   /**< Wertwechsel eines Busses */
+		const char* fill_;     /**< Busabschnitt */
+		const char* levels_[9];  /**< Balken von 0 V bis HIGH_LEVEL_VOLT */
+	};
+
+	/*! \brief Gibt die Zeichen des eingestellten Zeichensatzes zurueck
+	 *  \return Zeichen
+	 */
+	const Glyphs& glyphs() const;
+
+	/*! \brief Haengt ein Zeichen mehrfach an
+	 *  \param a_row Zeile
+	 *  \param a_glyph Zeichen
+	 *  \param a_count Anzahl, <= 0 = keine
+	 */
+	static void fill(std::string& a_row, const char* a_glyph, int a_count);
+
+	/*! \brief Berechnet die Zeile eines Signals im eingestellten Modus
+	 *  \param a_signal Signal-Spannungswerte
+	 *  \return Verlauf
+	 */
+	std::string signalRow(const std::vector<sgnl::Volt>& a_signal) const;
+
+	/*! \brief Berechnet die Zeile eines Spannungsverlaufs
+	 *  \param a_signal Signal-Spannungswerte
+	 *  \param a_envelope Huellkurve, leer falls ein Zeichen je Nanosekunde
+	 *  \param a_begin Erster darzustellender Wert
+	 *  \param a_end Erster nicht mehr darzustellender Wert
+	 *  \return Verlauf
+	 */
+	std::string analogRow(
+		const std::vector<sgnl::Volt>& a_signal,
+		const Envelope& a_envelope,
+		sgnl::Nanoseconds a_begin,
+		sgnl::Nanoseconds a_end) const;
+
+	/*! \brief Berechnet die Zeile eines Logiklevel-Verlaufs
+	 *  \param a_trace Logiklevel-Verlauf
+	 *  \return Verlauf
+	 */
+	std::string logicRow(const LogicTrace& a_trace) const;
+
+	/*! \brief Berechnet die Zeile eines Busses
+	 *  \param a_bits Logiklevel-Verlaeufe, niederwertigstes Bit zuerst
+	 *  \return Verlauf
+	 */
+	std::string busRow(const std::vector<const LogicTrace*>& a_bits) const;
+
+	/*! \brief Haengt einen Busabschnitt an
+	 *  \param a_row Zeile
+	 *  \param a_width Breite / Zeichen
+	 *  \param a_value Wert
+	 *  \param a_nDigits Anzahl der Hexadezimalstellen
+	 */
+	void busSegment(
+		std::string& a_row,
+		int a_width,
+		unsigned long long a_value,
+		int a_nDigits) const;
+
+	/*! \brief Fuegt eine berechnete Zeile hinzu
+	 *  \param a_signalName Name des Signals
+	 *  \param a_row Verlauf
+	 *  \param a_length Laenge des Signals / ns
+	 */
+	void addRow(
+		const std::string& a_signalName,
+		const std::string& a_row,
+		sgnl::Nanoseconds a_length);
+
+	/*! \brief Gibt einen Namen auf die Breite der Namensspalte gebracht
+	 *  zurueck
+	 *  \param a_name Name
+	 *  \return Name, abgeschnitten oder mit Leerzeichen aufgefuellt
+	 */
+	std::string nameColumn(const std::string& a_name) const;
+
+	static const Glyphs ASCII_GLYPHS;    /**< Nur ASCII-Zeichen */
+	static const Glyphs UNICODE_GLYPHS;  /**< Block- und Linienzeichen */
+
+	std::string title_;     /**< Plot-Titel */
+	int nameWidth_;         /**< Breite der Namensspalte / Zeichen */
+	TimeAxis axis_;         /**< Zeitfenster und Abbildung auf Spalten */
+	bool unicode_;          /**< Unicode-Zeichen verwenden */
+	bool logic_;            /**< add(...) stellt Logiklevel dar */
+	sgnl::Nanoseconds tickSpacing_;  /**< Abstand der Skalenstriche */
+	sgnl::Nanoseconds maxLength_;    /**< Laengstes Signal / ns */
+	std::vector<std::string> names_;  /**< Namensspalte je Zeile */
+	std::vector<std::string> rows_;   /**< Verlauf je Zeile */
+};
+
+#endif /* TEXTPLOT_H_ */
@@ -0,0 +1,224 @@
+/*! \file TiledPlot.cpp
+ *  \brief Implementierung der Klasse TiledPlot
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "TiledPlot.h"
+#include "BMPPlot.h"
+#include "simplebmp/simplebmp.h"
+#include "../diag/Log.h"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+using namespace sgnl;
+
+TiledPlot::TiledPlot(
+	const std::string& a_title,
+	int a_signalsPerPage,
+	sgnl::Nanoseconds a_nsPerPage,
+	int a_pageWidth) :
+	title_(a_title),
+	signalsPerPage_(std::max(a_signalsPerPage, 1)),
+	nsPerPage_(std::max(a_nsPerPage, 0)),
+	pageWidth_(a_pageWidth),
+	timeBegin_(0),
+	timeEnd_(-1)
+{
+
+}
+
+void TiledPlot::add(
+	const std::string& a_signalName,
+	const std::vector<sgnl::Volt>& a_signal)
+{
+	names_.push_back(a_signalName);
+	signals_.push_back(&a_signal);
+	return;
+}
+
+void TiledPlot::setBackend(const std::shared_ptr<const PlotBackend>& a_backend)
+{
+	backend_ = a_backend;
+	return;
+}
+
+void TiledPlot::setTimeRange(sgnl::Nanoseconds a_begin, sgnl::Nanoseconds a_end)
+{
+	timeBegin_ = std::max(a_begin, 0);
+	timeEnd_ = std::max(a_end, timeBegin_);
+	return;
+}
+
+int TiledPlot::nSignalPages() const
+{
+	return (static_cast<int>(signals_.size()) + signalsPerPage_ - 1)
+		/ signalsPerPage_;
+}
+
+int TiledPlot::nTimePages() const
+{
+	Nanoseconds begin = 0;
+	Nanoseconds end = 0;
+	range(begin, end);
+	if(nsPerPage_ == 0 || end <= begin)
+	{
+		return 1;
+	}
+	return (end - begin + nsPerPage_ - 1)/nsPerPage_;
+}
+
+void TiledPlot::signalPage(int a_page, int& a_first, int& a_last) const
+{
+	a_first = a_page*signalsPerPage_;
+	a_last = std::min(a_first + signalsPerPage_,
+		static_cast<int>(signals_.size()));
+	return;
+}
+
+void TiledPlot::timePage(int a_page, sgnl::Nanoseconds& a_begin,
+	sgnl::Nanoseconds& a_end) const
+{
+	Nanoseconds begin = 0;
+	Nanoseconds end = 0;
+	range(begin, end);
+	const Nanoseconds pageLength = (nsPerPage_ == 0) ? end - begin : nsPerPage_;
+	a_begin = begin + a_page*pageLength;
+	a_end = std::min(a_begin + pageLength, end);
+	return;
+}
+
+bool TiledPlot::save(const std::string& a_baseName) const
+{
+	const int nSignal = nSignalPages();
+	const int nTime = nTimePages();
+	bool ok = true;
+	for(int sp=0; sp<nSignal; sp++)
+	{
+		int first = 0;
+		int last = 0;
+		signalPage(sp, first, last);
+		for(int tp=0; tp<nTime; tp++)
+		{
+			Nanoseconds pageBegin = 0;
+			Nanoseconds pageEnd = 0;
+			timePage(tp, pageBegin, pageEnd);
+			stringstream title;
+			title << title_ << " (" << sp+1 << "/" << nSignal
+				  << ", " << tp+1 << "/" << nTime << ")";
+			BMPPlot page(title.str(), pageWidth_,
+				BMPPlot::heightFor(last - first));
+			page.setBackend(backend_);
+			page.setTimeRange(pageBegin, pageEnd);
+			page.setTimeTicks(tickSpacing(pageEnd - pageBegin));
+			for(int s=first; s<last; s++)
+			{
+				page.add(names_[s], *signals_[s]);
+			}
+			stringstream fileName;
+			fileName << a_baseName << "_" << sp << "_" << tp;
+			if(!page.save(fileName.str()))
+			{
+				ok = false;
+			}
+		}
+	}
+	return ok;
+}
+
+bool TiledPlot::saveSingle(const std::string& a_baseName) const
+{
+	Nanoseconds begin = 0;
+	Nanoseconds end = 0;
+	range(begin, end);
+	int width = pageWidth_;
+	if(nsPerPage_ > 0)
+	{
+		// Gleicher Massstab wie eine Kachel, Plotbereich beginnt bei x=100
+		long long columns = static_cast<long long>(end - begin)
+			*(pageWidth_ - 101)/nsPerPage_ + 1;
+		width = static_cast<int>(std::min(100 + columns, 100LL + (end - begin) + 1));
+	}
+	const int nSignal = nSignalPages();
+	int height = 0;
+	for(int sp=0; sp<nSignal; sp++)
+	{
+		int first = 0;
+		int last = 0;
+		signalPage(sp, first, last);
+		height += BMPPlot::heightFor(last - first);
+	}
+
+	string fileName = "./Plots/" + a_baseName + ".bmp";
+	SimpleBMPWriter writer;
+	if(writer.open(fileName.c_str(), width, height) != SIMPLEBMP_NO_ERROR)
+	{
+		DFSM_LOG_ERROR("TiledPlot", "Failed to save bitmap image " << fileName << ".");
+		return false;
+	}
+	for(int sp=0; sp<nSignal; sp++)
+	{
+		int first = 0;
+		int last = 0;
+		signalPage(sp, first, last);
+		stringstream title;
+		title << title_ << " (" << sp+1 << "/" << nSignal << ")";
+		BMPPlot band(title.str(), width, BMPPlot::heightFor(last - first));
+		band.setTimeRange(begin, end);
+		// Etwa zehn Skalenstriche je Kachelbreite
+		band.setTimeTicks(tickSpacing(static_cast<Nanoseconds>(
+			static_cast<long long>(end - begin)*(pageWidth_ - 101)
+			/std::max(width - 101, 1))));
+		for(int s=first; s<last; s++)
+		{
+			band.add(names_[s], *signals_[s]);
+		}
+		writer.writeBand(band.bitmap());
+	}
+	if(writer.close() != SIMPLEBMP_NO_ERROR)
+	{
+		DFSM_LOG_ERROR("TiledPlot", "Failed to save bitmap image " << fileName << ".");
+		return false;
+	}
+	DFSM_LOG_INFO("TiledPlot", "Bitmap image " << fileName << " saved.");
+	return true;
+}
+
+void TiledPlot::range(sgnl::Nanoseconds& a_begin, sgnl::Nanoseconds& a_end) const
+{
+	a_begin = timeBegin_;
+	a_end = timeEnd_;
+	if(a_end < 0)
+	{
+		a_end = 0;
+		for(int s=0; s<static_cast<int>(signals_.size()); s++)
+		{
+			a_end = std::max(a_end, static_cast<int>(signals_[s]->size()));
+		}
+	}
+	return;
+}
+
+sgnl::Nanoseconds TiledPlot::tickSpacing(sgnl::Nanoseconds a_length)
+{
+	long long spacing = 1;
+	while(true)
+	{
+		if(spacing*10 >= a_length)
+		{
+			return static_cast<Nanoseconds>(spacing);
+		}
+		if(spacing*20 >= a_length)
+		{
+			return static_cast<Nanoseconds>(spacing*2);
+		}
+		if(spacing*50 >= a_length)
+		{
+			return static_cast<Nanoseconds>(spacing*5);
+		}
+		spacing *= 10;
+	}
+}
@@ -0,0 +1,134 @@
+/*! \file TiledPlot.h
+ *  \brief Definition der Klasse TiledPlot
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef TILEDPLOT_H_
+#define TILEDPLOT_H_
+
+#include "PlotBackend.h"
+#include "../signal/Signal.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*! \class TiledPlot
+ *  \brief Verteilt beliebig viele Signale und beliebig lange Zeitbereiche auf
+ *  mehrere Bitmap-Bilder (Kacheln). Jede Kachel ist ein BMPPlot mit hoechstens
+ *  signalsPerPage Signalen und hoechstens nsPerPage Nanosekunden; die
+ *  Zeitachse jeder Kachel ist mit absoluten Zeiten beschriftet
+ */
+class TiledPlot
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_title Plot-Titel, wird auf jeder Kachel um die Kachelnummer
+	 *  ergaenzt
+	 *  \param a_signalsPerPage Maximale Anzahl Signale je Kachel
+	 *  \param a_nsPerPage Maximale Zeitspanne je Kachel / ns, 0 = gesamtes
+	 *  Zeitfenster auf einer Kachel (wird auf die Breite gestaucht)
+	 *  \param a_pageWidth Breite einer Kachel / Pixel
+	 */
+	TiledPlot(
+		const std::string& a_title,
+		int a_signalsPerPage = 8,
+		sgnl::Nanoseconds a_nsPerPage = 0,
+		int a_pageWidth = 1280);
+
+	/*! \brief Fuegt ein Signal hinzu. Es wird nur ein Verweis gespeichert, das
+	 *  Signal muss bis zum Aufruf von save(...) gueltig bleiben
+	 *  \param a_signalName Name des Signals
+	 *  \param a_signal Signal-Spannungswerte im 1-Nanosekunden-Raster
+	 */
+	void add(
+		const std::string& a_signalName,
+		const std::vector<sgnl::Volt>& a_signal);
+
+	/*! \brief Legt das darzustellende Zeitfenster fest. Ohne Aufruf wird von
+	 *  0 bis zum Ende des laengsten Signals dargestellt
+	 *  \param a_begin Beginn des Zeitfensters / ns
+	 *  \param a_end Ende des Zeitfensters / ns (exklusiv)
+	 */
+	void setTimeRange(sgnl::Nanoseconds a_begin, sgnl::Nanoseconds a_end);
+
+	/*! \brief Legt das Ausgabeformat der Kacheln fest (Standard: BMP).
+	 *  saveSingle(...) schreibt immer BMP
+	 *  \param a_backend Ausgabeformat
+	 */
+	void setBackend(const std::shared_ptr<const PlotBackend>& a_backend);
+
+	/*! \brief Gibt die Anzahl der Kacheln in Signalrichtung zurueck
+	 *  \return Anzahl der Kacheln
+	 */
+	int nSignalPages() const;
+
+	/*! \brief Gibt die Anzahl der Kacheln in Zeitrichtung zurueck
+	 *  \return Anzahl der Kacheln
+	 */
+	int nTimePages() const;
+
+	/*! \brief Gibt die Signale einer Signalkachel zurueck
+	 *  \param a_page Index der Signalkachel, 0 bis nSignalPages()-1
+	 *  \param a_first Index des ersten Signals (Reihenfolge von add(...))
+	 *  \param a_last Index hinter dem letzten Signal
+	 */
+	void signalPage(int a_page, int& a_first, int& a_last) const;
+
+	/*! \brief Gibt das Zeitfenster einer Zeitkachel zurueck. Die Kacheln
+	 *  schliessen lueckenlos aneinander an
+	 *  \param a_page Index der Zeitkachel, 0 bis nTimePages()-1
+	 *  \param a_begin Beginn / ns
+	 *  \param a_end Ende / ns (exklusiv)
+	 */
+	void timePage(int a_page, sgnl::Nanoseconds& a_begin,
+		sgnl::Nanoseconds& a_end) const;
+
+	/*! \brief Zeichnet alle Kacheln nacheinander und speichert sie im Ordner
+	 *  ./Plots als <a_baseName>_<Signalkachel>_<Zeitkachel> mit der Endung
+	 *  des Backends. Es wird
+	 *  immer nur eine Kachel im Speicher gehalten
+	 *  \param a_baseName Dateiname OHNE Endung
+	 *  \return true, falls alle Kacheln gespeichert wurden, false sonst
+	 */
+	bool save(const std::string& a_baseName) const;
+
+	/*! \brief Zeichnet alle Signale in ein einziges Bild und speichert es im
+	 *  Ordner ./Plots als <a_baseName>.bmp. Das Zeitfenster wird nicht
+	 *  aufgeteilt, sondern im Massstab von nsPerPage je Kachelbreite in die
+	 *  Breite gezogen (bei nsPerPage 0: Kachelbreite). Die Signalkacheln
+	 *  werden nacheinander als Baender gezeichnet und sofort in die Datei
+	 *  geschrieben, im Speicher liegt immer nur ein Band
+	 *  \param a_baseName Dateiname OHNE Endung
+	 *  \return true, falls das Bild gespeichert wurde, false sonst
+	 */
+	bool saveSingle(const std::string& a_baseName) const;
+
+private:
+	/*! \brief Gibt das tatsaechliche Zeitfenster zurueck
+	 *  \param a_begin Beginn / ns
+	 *  \param a_end Ende / ns (exklusiv)
+	 */
+	void range(sgnl::Nanoseconds& a_begin, sgnl::Nanoseconds& a_end) const;
+
+	/*! \brief Waehlt einen runden Abstand der Skalenstriche (1, 2 oder 5 mal
+	 *  einer Zehnerpotenz), so dass etwa zehn Striche angezeigt werden
+	 *  \param a_length Laenge des Zeitfensters / ns
+	 *  \return Abstand / ns
+	 */
+	static sgnl::Nanoseconds tickSpacing(sgnl::Nanoseconds a_length);
+
+	std::string title_;                /**< Plot-Titel */
+	int signalsPerPage_;               /**< Signale je Kachel */
+	sgnl::Nanoseconds nsPerPage_;      /**< Zeitspanne je Kachel, 0 = alles */
+	int pageWidth_;                    /**< Breite einer Kachel / Pixel */
+	std::shared_ptr<const PlotBackend> backend_;  /**< Ausgabeformat, leer =
+		BMP */
+	sgnl::Nanoseconds timeBegin_;      /**< Beginn des Zeitfensters / ns */
+	sgnl::Nanoseconds timeEnd_;        /**< Ende des Zeitfensters, -1 = auto */
+	std::vector<std::string> names_;   /**< Namen der Signale */
+	std::vector<const std::vector<sgnl::Volt>*> signals_;  /**< Signale */
+};
+
+#endif /* TILEDPLOT_H_ */
@@ -0,0 +1,117 @@
+/*! \file TimeAxis.cpp
+ *  \brief Implementierung der Klasse TimeAxis
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "TimeAxis.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace sgnl;
+
+
+TimeAxis::TimeAxis(int a_maxColumns) :
+	maxColumns_(std::max(a_maxColumns, 0)),
+	begin_(0),
+	end_(-1)
+{
+
+}
+
+void TimeAxis::setRange(sgnl::Nanoseconds a_begin, sgnl::Nanoseconds a_end)
+{
+	begin_ = std::max(0, a_begin);
+	end_ = std::max(begin_, a_end);
+	return;
+}
+
+bool TimeAxis::hasRange() const
+{
+	return end_ >= 0;
+}
+
+sgnl::Nanoseconds TimeAxis::begin() const
+{
+	return begin_;
+}
+
+sgnl::Nanoseconds TimeAxis::length(sgnl::Nanoseconds a_signalLength) const
+{
+	return (end_ < 0) ? a_signalLength : end_-begin_;
+}
+
+void TimeAxis::window(
+	sgnl::Nanoseconds a_signalLength,
+	sgnl::Nanoseconds& a_begin,
+	sgnl::Nanoseconds& a_end) const
+{
+	if(end_ < 0)
+	{
+		a_begin = 0;
+		a_end = a_signalLength;
+		return;
+	}
+	a_begin = std::min(begin_, a_signalLength);
+	a_end = std::min(end_, a_signalLength);
+	return;
+}
+
+int TimeAxis::columns(sgnl::Nanoseconds a_length) const
+{
+	return std::max(0, std::min(a_length, maxColumns_));
+}
+
+int TimeAxis::envelopeColumns(
+	sgnl::Nanoseconds a_signalLength,
+	sgnl::Nanoseconds& a_begin,
+	sgnl::Nanoseconds& a_end) const
+{
+	window(a_signalLength, a_begin, a_end);
+	Nanoseconds axisLength = length(a_signalLength);
+	int nColumns = columns(axisLength);
+	if(nColumns == axisLength || a_end <= a_begin)
+	{
+		return 0;
+	}
+	// Ein kuerzeres Signal belegt nur den entsprechenden Teil der Spalten
+	return std::max(1, static_cast<int>(
+		static_cast<long long>(a_end-a_begin)*nColumns/axisLength));
+}
+
+int TimeAxis::column(
+	sgnl::Nanoseconds a_time,
+	sgnl::Nanoseconds a_begin,
+	sgnl::Nanoseconds a_length) const
+{
+	long long nColumns = columns(a_length);
+	return static_cast<int>((a_time-a_begin)*nColumns/a_length);
+}
+
+sgnl::Nanoseconds TimeAxis::time(
+	int a_column,
+	sgnl::Nanoseconds a_begin,
+	sgnl::Nanoseconds a_length) const
+{
+	// Kleinstes t mit column(t) >= a_column
+	long long nColumns = columns(a_length);
+	return a_begin + static_cast<Nanoseconds>(
+		(a_column*static_cast<long long>(a_length) + nColumns-1)/nColumns);
+}
+
+std::vector<sgnl::Nanoseconds> TimeAxis::ticks(
+	sgnl::Nanoseconds a_spacing,
+	sgnl::Nanoseconds a_length)
+{
+	vector<Nanoseconds> ticks;
+	if(a_spacing <= 0)
+	{
+		return ticks;
+	}
+	for(long long t=0; t<a_length; t+=a_spacing)
+	{
+		ticks.push_back(static_cast<Nanoseconds>(t));
+	}
+	return ticks;
+}
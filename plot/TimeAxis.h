@@ -0,0 +1,122 @@
+/*! \file TimeAxis.h
+ *  \brief Definition der Klasse TimeAxis
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef TIMEAXIS_H_
+#define TIMEAXIS_H_
+
+#include "../signal/Signal.h"
+
+#include <vector>
+
+/*! \class TimeAxis
+ *  \brief Abbildung der Zeit auf Spalten eines Plots (Pixel bei BMPPlot,
+ *  Zeichen bei TextPlot). Ohne Zeitfenster wird jedes Signal vollstaendig
+ *  dargestellt. Passt das Zeitfenster nicht in die verfuegbaren Spalten,
+ *  wird es gleichmaessig gestaucht, sonst entspricht eine Spalte einer
+ *  Nanosekunde
+ */
+class TimeAxis
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_maxColumns Anzahl der verfuegbaren Spalten
+	 */
+	TimeAxis(int a_maxColumns);
+
+	/*! \brief Legt das darzustellende Zeitfenster fest
+	 *  \param a_begin Beginn des Zeitfensters / ns
+	 *  \param a_end Ende des Zeitfensters / ns (exklusiv)
+	 */
+	void setRange(sgnl::Nanoseconds a_begin, sgnl::Nanoseconds a_end);
+
+	/*! \brief Gibt zurueck, ob ein Zeitfenster festgelegt wurde
+	 *  \return true, falls setRange(...) aufgerufen wurde
+	 */
+	bool hasRange() const;
+
+	/*! \brief Gibt den Beginn des Zeitfensters zurueck
+	 *  \return Beginn / ns, 0 ohne Zeitfenster
+	 */
+	sgnl::Nanoseconds begin() const;
+
+	/*! \brief Gibt die Laenge der Zeitachse fuer ein Signal zurueck
+	 *  \param a_signalLength Laenge des Signals
+	 *  \return Laenge des Zeitfensters, ohne Zeitfenster a_signalLength
+	 */
+	sgnl::Nanoseconds length(sgnl::Nanoseconds a_signalLength) const;
+
+	/*! \brief Bestimmt den darstellbaren Teil eines Signals
+	 *  \param a_signalLength Laenge des Signals
+	 *  \param a_begin Beginn des Zeitfensters
+	 *  \param a_end Ende des Zeitfensters (exklusiv), hoechstens
+	 *  a_signalLength
+	 */
+	void window(
+		sgnl::Nanoseconds a_signalLength,
+		sgnl::Nanoseconds& a_begin,
+		sgnl::Nanoseconds& a_end) const;
+
+	/*! \brief Gibt die Anzahl der Spalten zurueck, die eine Zeitachse der
+	 *  uebergebenen Laenge belegt
+	 *  \param a_length Laenge der Zeitachse
+	 *  \return Anzahl der Spalten
+	 */
+	int columns(sgnl::Nanoseconds a_length) const;
+
+	/*! \brief Bestimmt den darstellbaren Teil eines Signals und die Anzahl
+	 *  der Spalten seiner Huellkurve
+	 *  \param a_signalLength Laenge des Signals
+	 *  \param a_begin Beginn des Zeitfensters
+	 *  \param a_end Ende des Zeitfensters (exklusiv)
+	 *  \return Anzahl der Spalten, 0 falls eine Spalte je Nanosekunde
+	 *  moeglich ist
+	 */
+	int envelopeColumns(
+		sgnl::Nanoseconds a_signalLength,
+		sgnl::Nanoseconds& a_begin,
+		sgnl::Nanoseconds& a_end) const;
+
+	/*! \brief Gibt die Spalte eines Zeitpunkts zurueck
+	 *  \param a_time Zeitpunkt
+	 *  \param a_begin Beginn des Zeitfensters
+	 *  \param a_length Laenge der Zeitachse
+	 *  \return Spalte ab 0
+	 */
+	int column(
+		sgnl::Nanoseconds a_time,
+		sgnl::Nanoseconds a_begin,
+		sgnl::Nanoseconds a_length) const;
+
+	/*! \brief Gibt den ersten Zeitpunkt einer Spalte zurueck (Umkehrung von
+	 *  column(...))
+	 *  \param a_column Spalte ab 0
+	 *  \param a_begin Beginn des Zeitfensters
+	 *  \param a_length Laenge der Zeitachse
+	 *  \return Zeitpunkt
+	 */
+	sgnl::Nanoseconds time(
+		int a_column,
+		sgnl::Nanoseconds a_begin,
+		sgnl::Nanoseconds a_length) const;
+
+	/*! \brief Gibt die Zeitpunkte der Skalenstriche relativ zum Beginn der
+	 *  Zeitachse zurueck
+	 *  \param a_spacing Abstand zwischen den Skalenstrichen (> 0)
+	 *  \param a_length Laenge der Zeitachse
+	 *  \return 0, a_spacing, 2*a_spacing, ... < a_length
+	 */
+	static std::vector<sgnl::Nanoseconds> ticks(
+		sgnl::Nanoseconds a_spacing,
+		sgnl::Nanoseconds a_length);
+
+private:
+	int maxColumns_;           /**< Anzahl der verfuegbaren Spalten */
+	sgnl::Nanoseconds begin_;  /**< Beginn des Zeitfensters */
+	sgnl::Nanoseconds end_;    /**< Ende des Zeitfensters, -1 = ganzes
+		Signal */
+};
+
+#endif /* TIMEAXIS_H_ */
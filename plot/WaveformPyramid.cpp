@@ -0,0 +1,297 @@
+/*! \file WaveformPyramid.cpp
+ *  \brief Implementierung der Klasse WaveformPyramid
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "WaveformPyramid.h"
+#include "../fileIO/Checkpoint.h"
+#include "../util/Deflate.h"
+#include "../diag/Log.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+using namespace std;
+using namespace sgnl;
+
+
+const char* const WaveformPyramid::MAGIC = "DFSM waveform pyramid";
+const int WaveformPyramid::BLOCK_SIZE;
+const int WaveformPyramid::SAMPLED_BLOCKS;
+
+WaveformPyramid::WaveformPyramid()
+{
+
+}
+
+WaveformPyramid::WaveformPyramid(std::vector<sgnl::Volt> a_values) :
+	values_(std::move(a_values))
+{
+	build();
+}
+
+sgnl::Nanoseconds WaveformPyramid::length() const
+{
+	return static_cast<Nanoseconds>(values_.size());
+}
+
+int WaveformPyramid::nLevels() const
+{
+	return values_.empty() ? 0 : 1 + static_cast<int>(min_.size());
+}
+
+const std::vector<sgnl::Volt>& WaveformPyramid::values() const
+{
+	return values_;
+}
+
+void WaveformPyramid::range(
+	sgnl::Nanoseconds a_begin,
+	sgnl::Nanoseconds a_end,
+	sgnl::Volt& a_min,
+	sgnl::Volt& a_max) const
+{
+	a_min = values_[a_begin];
+	a_max = values_[a_begin];
+	// Vollstaendig enthaltene Bloecke der untersten gespeicherten Stufe,
+	// Werte davor und danach direkt
+	long long left = (static_cast<long long>(a_begin) + BLOCK_SIZE - 1)/BLOCK_SIZE;
+	long long right = a_end/BLOCK_SIZE;
+	if(left >= right)
+	{
+		scan(a_begin, a_end, a_min, a_max);
+		return;
+	}
+	scan(a_begin, left*BLOCK_SIZE, a_min, a_max);
+	scan(right*BLOCK_SIZE, a_end, a_min, a_max);
+	// Von unten nach oben: ragt ein Rand nur halb in einen Eintrag der
+	// naechsten Stufe, wird der Randeintrag dieser Stufe genommen
+	for(int k=0; left<right; k++)
+	{
+		if(left & 1)
+		{
+			a_min = std::min(a_min, min_[k][left]);
+			a_max = std::max(a_max, max_[k][left]);
+			left++;
+		}
+		if(right & 1)
+		{
+			right--;
+			a_min = std::min(a_min, min_[k][right]);
+			a_max = std::max(a_max, max_[k][right]);
+		}
+		left >>= 1;
+		right >>= 1;
+	}
+	return;
+}
+
+Envelope WaveformPyramid::envelope(
+	sgnl::Nanoseconds a_begin,
+	sgnl::Nanoseconds a_end,
+	int a_columns) const
+{
+	// Dieselbe Spaltenaufteilung wie im Konstruktor von Envelope
+	a_begin = std::max(0, a_begin);
+	a_end = std::min(a_end, length());
+	long long length = a_end - a_begin;
+	if(length <= 0 || a_columns <= 0)
+	{
+		return Envelope();
+	}
+	a_columns = static_cast<int>(std::min<long long>(a_columns, length));
+	vector<Volt> lo(a_columns);
+	vector<Volt> hi(a_columns);
+	vector<Volt> last(a_columns);
+	long long columnBegin = 0;
+	for(int c=0; c<a_columns; c++)
+	{
+		long long columnEnd = (c+1)*length/a_columns;
+		range(
+			static_cast<Nanoseconds>(a_begin+columnBegin),
+			static_cast<Nanoseconds>(a_begin+columnEnd),
+			lo[c], hi[c]);
+		last[c] = values_[a_begin+columnEnd-1];
+		columnBegin = columnEnd;
+	}
+	return Envelope(std::move(lo), std::move(hi), std::move(last));
+}
+
+std::string WaveformPyramid::pathFor(const std::string& a_tracePath)
+{
+	return a_tracePath + ".pyr";
+}
+
+bool WaveformPyramid::save(const std::string& a_tracePath) const
+{
+	Checkpoint data;
+	data.writeString(MAGIC);
+	data.writeInt(VERSION);
+	data.writeInt(length());
+	data.writeUInt(fingerprint(values_));
+	data.writeInt(static_cast<int>(min_.size()));
+	for(int k=0; k<static_cast<int>(min_.size()); k++)
+	{
+		data.writeDoubles(min_[k]);
+		data.writeDoubles(max_[k]);
+	}
+	string path = pathFor(a_tracePath);
+	ofstream file(path.c_str(), ios::binary);
+	if(!file.is_open())
+	{
+		DFSM_LOG_ERROR("WaveformPyramid", "Cannot open pyramid file at \"" << path << "\".");
+		return false;
+	}
+	file.write(data.data().data(), data.data().size());
+	return static_cast<bool>(file);
+}
+
+bool WaveformPyramid::load(
+	const std::string& a_tracePath,
+	std::vector<sgnl::Volt> a_values)
+{
+	string path = pathFor(a_tracePath);
+	ifstream file(path.c_str(), ios::binary);
+	if(!file.is_open())
+	{
+		return false;
+	}
+	file.seekg(0, ios::end);
+	string bytes(static_cast<size_t>(std::max<streamoff>(0, file.tellg())), '\0');
+	file.seekg(0, ios::beg);
+	file.read(&bytes[0], bytes.size());
+	Checkpoint data(bytes);
+	string magic;
+	int version = 0;
+	int storedLength = 0;
+	unsigned int storedFingerprint = 0;
+	int nStored = 0;
+	data.readString(magic);
+	data.readInt(version);
+	data.readInt(storedLength);
+	data.readUInt(storedFingerprint);
+	data.readInt(nStored);
+	if(!data.ok() || magic != MAGIC || version != VERSION)
+	{
+		DFSM_LOG_ERROR("WaveformPyramid", "Invalid pyramid file at \"" << path << "\".");
+		return false;
+	}
+	if(storedLength != static_cast<int>(a_values.size())
+		|| storedFingerprint != fingerprint(a_values))
+	{
+		// Signaldatei wurde seit dem Speichern der Pyramide veraendert
+		return false;
+	}
+	vector<vector<Volt> > lo(std::max(0, nStored));
+	vector<vector<Volt> > hi(std::max(0, nStored));
+	long long expected = storedLength;
+	for(int k=0; k<nStored; k++)
+	{
+		expected = (k == 0) ? (expected + BLOCK_SIZE - 1)/BLOCK_SIZE
+			: (expected+1)/2;
+		if(!data.readDoubles(lo[k]) || !data.readDoubles(hi[k])
+			|| static_cast<long long>(lo[k].size()) != expected
+			|| static_cast<long long>(hi[k].size()) != expected)
+		{
+			DFSM_LOG_ERROR("WaveformPyramid", "Invalid pyramid file at \"" << path << "\".");
+			return false;
+		}
+	}
+	if(expected > 1 || !data.atEnd())
+	{
+		DFSM_LOG_ERROR("WaveformPyramid", "Invalid pyramid file at \"" << path << "\".");
+		return false;
+	}
+	values_ = std::move(a_values);
+	min_ = std::move(lo);
+	max_ = std::move(hi);
+	return true;
+}
+
+void WaveformPyramid::build()
+{
+	min_.clear();
+	max_.clear();
+	if(values_.empty())
+	{
+		return;
+	}
+	// Unterste Stufe aus Bloecken von BLOCK_SIZE Werten, danach je Stufe
+	// paarweise aus der vorherigen
+	size_t size = (values_.size() + BLOCK_SIZE - 1)/BLOCK_SIZE;
+	vector<Volt> blockMin(size);
+	vector<Volt> blockMax(size);
+	for(size_t b=0; b<size; b++)
+	{
+		size_t first = b*BLOCK_SIZE;
+		blockMin[b] = values_[first];
+		blockMax[b] = values_[first];
+		scan(first+1, std::min(values_.size(), first+BLOCK_SIZE),
+			blockMin[b], blockMax[b]);
+	}
+	min_.push_back(std::move(blockMin));
+	max_.push_back(std::move(blockMax));
+	while(size > 1)
+	{
+		const vector<Volt>& lo = min_.back();
+		const vector<Volt>& hi = max_.back();
+		size_t half = (size+1)/2;
+		vector<Volt> levelMin(half);
+		vector<Volt> levelMax(half);
+		for(size_t i=0; i<size/2; i++)
+		{
+			levelMin[i] = std::min(lo[2*i], lo[2*i+1]);
+			levelMax[i] = std::max(hi[2*i], hi[2*i+1]);
+		}
+		if(size & 1)
+		{
+			levelMin[half-1] = lo[size-1];
+			levelMax[half-1] = hi[size-1];
+		}
+		min_.push_back(std::move(levelMin));
+		max_.push_back(std::move(levelMax));
+		size = half;
+	}
+	return;
+}
+
+void WaveformPyramid::scan(
+	long long a_begin,
+	long long a_end,
+	sgnl::Volt& a_min,
+	sgnl::Volt& a_max) const
+{
+	for(long long i=a_begin; i<a_end; i++)
+	{
+		a_min = std::min(a_min, values_[i]);
+		a_max = std::max(a_max, values_[i]);
+	}
+	return;
+}
+
+unsigned int WaveformPyramid::fingerprint(const std::vector<sgnl::Volt>& a_values)
+{
+	// Sehr kurze Signale vollstaendig, sonst SAMPLED_BLOCKS Bloecke mit
+	// gleichem Abstand vom Anfang bis zum Ende
+	size_t blocks = (a_values.size() + BLOCK_SIZE - 1)/BLOCK_SIZE;
+	size_t sampled = std::min<size_t>(blocks, SAMPLED_BLOCKS);
+	vector<Volt> sample;
+	sample.reserve(sampled*BLOCK_SIZE);
+	for(size_t s=0; s<sampled; s++)
+	{
+		size_t block = (sampled > 1) ? s*(blocks-1)/(sampled-1) : 0;
+		size_t first = block*BLOCK_SIZE;
+		size_t last = std::min(a_values.size(), first+BLOCK_SIZE);
+		sample.insert(sample.end(), a_values.begin()+first, a_values.begin()+last);
+	}
+	if(sample.empty())
+	{
+		return Deflate::adler32(nullptr, 0);
+	}
+	return Deflate::adler32(
+		reinterpret_cast<const unsigned char*>(&sample[0]),
+		sample.size()*sizeof(Volt));
+}
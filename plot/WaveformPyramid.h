@@ -0,0 +1,143 @@
+/*! \file WaveformPyramid.h
+ *  \brief Definition der Klasse WaveformPyramid
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef WAVEFORMPYRAMID_H_
+#define WAVEFORMPYRAMID_H_
+
+#include "Envelope.h"
+#include "../signal/Signal.h"
+
+#include <string>
+#include <vector>
+
+/*! \class WaveformPyramid
+ *  \brief Vorberechnete Min/Max-Pyramide eines aufgezeichneten Signals fuer
+ *  das Zoomen in sehr lange Signalverlaeufe. Stufe 0 sind die Werte selbst,
+ *  Stufe 1 fasst je BLOCK_SIZE Werte zusammen, jede weitere Stufe zwei
+ *  Eintraege der vorherigen (halbe Zeitaufloesung). Kleinster und groesster
+ *  Wert eines beliebigen Zeitfensters werden aus hoechstens zwei Eintraegen
+ *  je Stufe und den Werten an den Raendern bestimmt, eine Huellkurve mit n
+ *  Spalten kostet daher O(n log(Fenster/n)) statt O(Fenster). Die Stufen ab 1
+ *  belegen ein Viertel des Speichers der Werte und koennen neben der
+ *  Signaldatei gespeichert werden (siehe pathFor(...))
+ */
+class WaveformPyramid
+{
+public:
+	/*! \brief Parameterloser Konstruktor. Erzeugt eine leere Pyramide
+	 */
+	WaveformPyramid();
+
+	/*! \brief Konstruktor. Berechnet die Pyramide
+	 *  \param a_values Signal-Spannungswerte im 1-Nanosekunden-Raster
+	 */
+	explicit WaveformPyramid(std::vector<sgnl::Volt> a_values);
+
+	/*! \brief Gibt die Laenge des Signals zurueck
+	 *  \return Anzahl der Werte
+	 */
+	sgnl::Nanoseconds length() const;
+
+	/*! \brief Gibt die Anzahl der Stufen einschliesslich Stufe 0 zurueck
+	 *  \return Anzahl der Stufen
+	 */
+	int nLevels() const;
+
+	/*! \brief Gibt die Signal-Spannungswerte (Stufe 0) zurueck
+	 *  \return Signal-Spannungswerte
+	 */
+	const std::vector<sgnl::Volt>& values() const;
+
+	/*! \brief Bestimmt kleinsten und groessten Wert eines Zeitfensters
+	 *  \param a_begin Erster Wert des Zeitfensters
+	 *  \param a_end Erster Wert nach dem Zeitfenster, a_begin < a_end <=
+	 *  length()
+	 *  \param a_min kleinster Wert
+	 *  \param a_max groesster Wert
+	 */
+	void range(
+		sgnl::Nanoseconds a_begin,
+		sgnl::Nanoseconds a_end,
+		sgnl::Volt& a_min,
+		sgnl::Volt& a_max) const;
+
+	/*! \brief Berechnet die Huellkurve eines Zeitfensters aus der Pyramide.
+	 *  Das Ergebnis ist identisch mit Envelope(values(), a_begin, a_end,
+	 *  a_columns)
+	 *  \param a_begin Erster Wert des Zeitfensters
+	 *  \param a_end Erster Wert nach dem Zeitfenster (wird auf die Laenge
+	 *  des Signals begrenzt)
+	 *  \param a_columns Anzahl der Spalten (>= 1)
+	 *  \return Huellkurve
+	 */
+	Envelope envelope(
+		sgnl::Nanoseconds a_begin,
+		sgnl::Nanoseconds a_end,
+		int a_columns) const;
+
+	/*! \brief Gibt den Pfad der Pyramidendatei zu einer Signaldatei zurueck
+	 *  \param a_tracePath Pfad der Signaldatei
+	 *  \return a_tracePath mit angehaengter Endung .pyr
+	 */
+	static std::string pathFor(const std::string& a_tracePath);
+
+	/*! \brief Speichert die Stufen ab 1 neben der Signaldatei (siehe
+	 *  pathFor(...)). Die Werte selbst werden nicht gespeichert
+	 *  \param a_tracePath Pfad der Signaldatei
+	 *  \return true, falls das Speichern erfolgreich war, false sonst
+	 */
+	bool save(const std::string& a_tracePath) const;
+
+	/*! \brief Laedt die Pyramide zu einer Signaldatei. Laenge und
+	 *  Stichprobe (siehe fingerprint(...)) der uebergebenen Werte muessen zur
+	 *  gespeicherten Pyramide passen, sonst bleibt die Pyramide unveraendert.
+	 *  Aenderungen ausserhalb der Stichprobe werden nicht erkannt
+	 *  \param a_tracePath Pfad der Signaldatei
+	 *  \param a_values Signal-Spannungswerte der Signaldatei
+	 *  \return true, falls das Laden erfolgreich war, false sonst
+	 */
+	bool load(const std::string& a_tracePath, std::vector<sgnl::Volt> a_values);
+
+private:
+	/*! \brief Berechnet die Stufen ab 1 aus values_
+	 */
+	void build();
+
+	/*! \brief Erweitert kleinsten und groessten Wert um die Werte
+	 *  [a_begin, a_end) der Stufe 0
+	 *  \param a_begin Erster Wert
+	 *  \param a_end Erster Wert danach
+	 *  \param a_min kleinster Wert
+	 *  \param a_max groesster Wert
+	 */
+	void scan(
+		long long a_begin,
+		long long a_end,
+		sgnl::Volt& a_min,
+		sgnl::Volt& a_max) const;
+
+	/*! \brief Berechnet eine Pruefsumme ueber eine Stichprobe der Werte fuer
+	 *  die Pyramidendatei: SAMPLED_BLOCKS gleichmaessig verteilte Bloecke von
+	 *  BLOCK_SIZE Werten einschliesslich des ersten und letzten. Der Aufwand
+	 *  haengt nicht von der Laenge des Signals ab
+	 *  \param a_values Signal-Spannungswerte
+	 *  \return Adler-32-Pruefsumme der Binaerdarstellung der Stichprobe
+	 */
+	static unsigned int fingerprint(const std::vector<sgnl::Volt>& a_values);
+
+	static const char* const MAGIC;  /**< Kennung der Pyramidendatei */
+	static const int VERSION = 2;    /**< Formatversion der Pyramidendatei */
+	static const int BLOCK_SIZE = 16;  /**< Werte je Eintrag der Stufe 1 */
+	static const int SAMPLED_BLOCKS = 64;  /**< Bloecke in fingerprint(...) */
+
+	std::vector<sgnl::Volt> values_;               /**< Stufe 0 */
+	std::vector<std::vector<sgnl::Volt> > min_;    /**< Kleinster Wert je
+		Eintrag, Stufe k an Index k-1 */
+	std::vector<std::vector<sgnl::Volt> > max_;    /**< Groesster Wert je
+		Eintrag, Stufe k an Index k-1 */
+};
+
+#endif /* WAVEFORMPYRAMID_H_ */
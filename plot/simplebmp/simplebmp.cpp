@@ -32,13 +32,17 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include <fstream>
 #include <cstring>
+#include <vector>
 
-int SimpleBMP::save(const int width, const int height, const unsigned char *pixels, const char *path)
+static void simplebmp_header(const int width, const int height, unsigned char *header)
 {
 	unsigned char bmp_file_header[14] = { 'B', 'M', 0, 0, 0, 0, 0, 0, 0, 0, 54, 0, 0, 0, };
 	unsigned char bmp_info_header[40] = { 40, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 24, 0, };
-	unsigned char bmp_pad[3] = { 0, 0, 0, };
-	const int size = 54 + width * height * 3;
+	const int abs_height = (height < 0) ? -height : height;
+	const unsigned long long row_size = (static_cast<unsigned long long>(width) * 3 + 3) / 4 * 4;
+	const unsigned long long file_size = 54 + row_size * abs_height;
+	// The size field is 32 bit; readers ignore it, so 0 is used if it does not fit
+	const unsigned int size = (file_size > 0xFFFFFFFFull) ? 0 : static_cast<unsigned int>(file_size);
 	bmp_file_header[2] = static_cast<unsigned char>(size);
 	bmp_file_header[3] = static_cast<unsigned char>(size >> 8);
 	bmp_file_header[4] = static_cast<unsigned char>(size >> 16);
@@ -51,19 +55,47 @@ int SimpleBMP::save(const int width, const int height, const unsigned char *pixe
 	bmp_info_header[9] = static_cast<unsigned char>(height >> 8);
 	bmp_info_header[10] = static_cast<unsigned char>(height >> 16);
 	bmp_info_header[11] = static_cast<unsigned char>(height >> 24);
+	memcpy(header, bmp_file_header, 14);
+	memcpy(header + 14, bmp_info_header, 40);
+}
+
+int SimpleBMP::save(const int width, const int height, const unsigned char *pixels, const char *path)
+{
+	unsigned char header[54];
+	simplebmp_header(width, height, header);
 	FILE *file = fopen(path, "wb");
 	if (file)
 	{
-		fwrite(bmp_file_header, 1, 14, file);
-		fwrite(bmp_info_header, 1, 40, file);
-		for (int i = 0; i < height; i++)
-		// for (int i = (height - 1); i >= 0; i--)
+		const size_t row_size = static_cast<size_t>(width) * 3;
+		const size_t pad = (4 - row_size % 4) % 4;
+		bool ok = (fwrite(header, 1, 54, file) == 54);
+		if (pad == 0)
 		{
-			fwrite(pixels + (width * i * 3), 3, width, file);
-			fwrite(bmp_pad, 1, ((4 - (width * 3) % 4) % 4), file);
+			// Rows are contiguous in memory and in the file: one write
+			const size_t size = row_size * height;
+			ok = ok && (fwrite(pixels, 1, size, file) == size);
 		}
-		fclose(file);
-		return SIMPLEBMP_NO_ERROR;
+		else
+		{
+			// Copy padded rows into a buffer of about 1 MiB and write it in one go
+			const int rows_per_chunk = static_cast<int>((1 << 20) / (row_size + pad)) + 1;
+			std::vector<unsigned char> chunk((row_size + pad) * rows_per_chunk, 0);
+			for (int first = 0; (first < height) && ok; first += rows_per_chunk)
+			{
+				const int count = (height - first < rows_per_chunk) ? (height - first) : rows_per_chunk;
+				for (int i = 0; i < count; i++)
+				{
+					memcpy(&chunk[(row_size + pad) * i], pixels + row_size * (first + i), row_size);
+				}
+				const size_t size = (row_size + pad) * count;
+				ok = (fwrite(chunk.data(), 1, size, file) == size);
+			}
+		}
+		if (fclose(file) != 0)
+		{
+			ok = false;
+		}
+		return ok ? SIMPLEBMP_NO_ERROR : SIMPLEBMP_WRITE_ERROR;
 	}
 	return SIMPLEBMP_FOPEN_ERROR;
 }
@@ -73,9 +105,8 @@ int SimpleBMP::load(int *width, int *height, unsigned char **pixels, const char
 	FILE *file = fopen(path, "rb");
 	if (file)
 	{
-		unsigned char bmp_file_header[14] = { 'B', 'M', 0, 0, 0, 0, 0, 0, 0, 0, 54, 0, 0, 0, };
-		unsigned char bmp_info_header[40] = { 40, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 24, 0, };
-		unsigned char bmp_pad[3] = { 0, 0, 0, };
+		unsigned char bmp_file_header[14];
+		unsigned char bmp_info_header[40];
 		memset(bmp_file_header, 0, sizeof(bmp_file_header));
 		memset(bmp_info_header, 0, sizeof(bmp_info_header));
 		fread(bmp_file_header, sizeof(bmp_file_header), 1, file);
@@ -90,19 +121,63 @@ int SimpleBMP::load(int *width, int *height, unsigned char **pixels, const char
 			fclose(file);
 			return SIMPLEBMP_INVALID_BITS_PER_PIXEL;
 		}
+		const int bytes_per_pixel = bmp_info_header[14] / 8;
+		const int offset = (bmp_file_header[10] + (bmp_file_header[11] << 8) + (bmp_file_header[12] << 16) + (bmp_file_header[13] << 24));
 		int w = (bmp_info_header[4] + (bmp_info_header[5] << 8) + (bmp_info_header[6] << 16) + (bmp_info_header[7] << 24));
 		int h = (bmp_info_header[8] + (bmp_info_header[9] << 8) + (bmp_info_header[10] << 16) + (bmp_info_header[11] << 24));
-		unsigned char *p = new unsigned char[w * h * 3];
-		for (int i = 0; i < h; i++)
-		// for (int i = (h - 1); i >= 0; i--)
+		const bool top_down = (h < 0);
+		if (top_down)
+		{
+			h = -h;
+		}
+		if ((w <= 0) || (h <= 0) || (fseek(file, offset, SEEK_SET) != 0))
+		{
+			fclose(file);
+			return SIMPLEBMP_READ_ERROR;
+		}
+
+		// The whole pixel array is read with one fread
+		const size_t file_row = (static_cast<size_t>(w) * bytes_per_pixel + 3) / 4 * 4;
+		const size_t row_size = static_cast<size_t>(w) * 3;
+		unsigned char *p = new unsigned char[row_size * h];
+		bool ok = true;
+		if ((bytes_per_pixel == 3) && (file_row == row_size) && !top_down)
+		{
+			ok = (fread(p, 1, row_size * h, file) == row_size * h);
+		}
+		else
+		{
+			std::vector<unsigned char> data(file_row * h);
+			ok = (fread(data.data(), 1, data.size(), file) == data.size());
+			for (int i = 0; ok && (i < h); i++)
+			{
+				// Rows in memory are bottom-up as in a standard BMP
+				const unsigned char *from = data.data() + file_row * (top_down ? (h - 1 - i) : i);
+				unsigned char *to = p + row_size * i;
+				if (bytes_per_pixel == 3)
+				{
+					memcpy(to, from, row_size);
+				}
+				else
+				{
+					for (int x = 0; x < w; x++)
+					{
+						to[x * 3 + 0] = from[x * 4 + 0];
+						to[x * 3 + 1] = from[x * 4 + 1];
+						to[x * 3 + 2] = from[x * 4 + 2];
+					}
+				}
+			}
+		}
+		fclose(file);
+		if (!ok)
 		{
-			fread(p + (w * i * 3), 3, w, file);
-			fread(bmp_pad, 1, (4 - (w * 3) % 4) % 4, file);
+			delete[] p;
+			return SIMPLEBMP_READ_ERROR;
 		}
 		(*width) = w;
 		(*height) = h;
 		(*pixels) = p;
-		fclose(file);
 		return SIMPLEBMP_NO_ERROR;
 	}
 	return SIMPLEBMP_FOPEN_ERROR;
@@ -152,7 +227,7 @@ SimpleBMP::SimpleBMP(const int a_width, const int a_height, unsigned char *a_pPi
 {
 	if (a_pPixels)
 	{
-		this->setPixels(a_width, a_height, pixels);
+		this->setPixels(a_width, a_height, a_pPixels);
 	}
 	else
 	{
@@ -185,10 +260,7 @@ int SimpleBMP::getRGB(const int x, const int y) const { return SimpleBMP::getRGB
 
 void SimpleBMP::setPixels(unsigned char *a_pPixels)
 {
-	for (int i = (this->width * this->height * 3 - 1); i >= 0; i--)
-	{
-		this->pixels[i] = a_pPixels[i];
-	}
+	memcpy(this->pixels, a_pPixels, static_cast<size_t>(this->width) * this->height * 3);
 }
 
 void SimpleBMP::setPixels(const int a_width, const int a_height, unsigned char *a_pPixels)
@@ -242,3 +314,131 @@ bool SimpleBMP::isValid(const int x, const int y) const
 int SimpleBMP::getWidth(void) const { return this->width; }
 int SimpleBMP::getHeight(void) const { return this->height; }
 unsigned char* SimpleBMP::getPixels(void) const { return this->pixels; }
+
+SimpleBMPWriter::~SimpleBMPWriter(void)
+{
+	if (this->file)
+	{
+		this->close();
+	}
+}
+
+int SimpleBMPWriter::open(const char *path, const int a_width, const int a_height, const int bufferSize)
+{
+	if (this->file)
+	{
+		this->close();
+	}
+	this->file = fopen(path, "wb");
+	if (!this->file)
+	{
+		return SIMPLEBMP_FOPEN_ERROR;
+	}
+	this->width = a_width;
+	this->height = a_height;
+	this->rows_written = 0;
+	this->failed = false;
+	this->buffer.resize((bufferSize > 4096) ? bufferSize : 4096);
+	this->buffer_used = 0;
+
+	// Negative height: rows are stored from top to bottom
+	unsigned char header[54];
+	simplebmp_header(a_width, -a_height, header);
+	this->append(header, 54);
+	return this->failed ? SIMPLEBMP_WRITE_ERROR : SIMPLEBMP_NO_ERROR;
+}
+
+int SimpleBMPWriter::writeRows(const unsigned char *rows, const int count)
+{
+	if (!this->file)
+	{
+		return SIMPLEBMP_WRITE_ERROR;
+	}
+	const unsigned char bmp_pad[3] = { 0, 0, 0, };
+	const size_t row_size = static_cast<size_t>(this->width) * 3;
+	const size_t pad = (4 - row_size % 4) % 4;
+	for (int i = 0; (i < count) && (this->rows_written < this->height); i++)
+	{
+		this->append(rows + row_size * i, row_size);
+		this->append(bmp_pad, pad);
+		this->rows_written++;
+	}
+	return this->failed ? SIMPLEBMP_WRITE_ERROR : SIMPLEBMP_NO_ERROR;
+}
+
+int SimpleBMPWriter::writeBand(const SimpleBMP &band)
+{
+	if (!this->file || (band.getWidth() != this->width))
+	{
+		this->failed = true;
+		return SIMPLEBMP_WRITE_ERROR;
+	}
+	const size_t row_size = static_cast<size_t>(this->width) * 3;
+	for (int i = (band.getHeight() - 1); i >= 0; i--)
+	{
+		this->writeRows(band.getPixels() + row_size * i, 1);
+	}
+	return this->failed ? SIMPLEBMP_WRITE_ERROR : SIMPLEBMP_NO_ERROR;
+}
+
+int SimpleBMPWriter::close(void)
+{
+	if (!this->file)
+	{
+		return SIMPLEBMP_WRITE_ERROR;
+	}
+	const bool complete = (this->rows_written == this->height);
+	if (!complete)
+	{
+		std::vector<unsigned char> black(static_cast<size_t>(this->width) * 3, 0);
+		while (this->rows_written < this->height)
+		{
+			this->writeRows(black.data(), 1);
+		}
+	}
+	this->flush();
+	if (fclose(this->file) != 0)
+	{
+		this->failed = true;
+	}
+	this->file = nullptr;
+	this->buffer.clear();
+	this->buffer.shrink_to_fit();
+	return (complete && !this->failed) ? SIMPLEBMP_NO_ERROR : SIMPLEBMP_WRITE_ERROR;
+}
+
+bool SimpleBMPWriter::isOpen(void) const { return this->file != nullptr; }
+int SimpleBMPWriter::getRowsWritten(void) const { return this->rows_written; }
+
+void SimpleBMPWriter::flush(void)
+{
+	if (this->buffer_used > 0)
+	{
+		if (fwrite(this->buffer.data(), 1, this->buffer_used, this->file) != this->buffer_used)
+		{
+			this->failed = true;
+		}
+		this->buffer_used = 0;
+	}
+}
+
+void SimpleBMPWriter::append(const unsigned char *data, const size_t size)
+{
+	if (this->buffer_used + size > this->buffer.size())
+	{
+		this->flush();
+	}
+	if (size > this->buffer.size())
+	{
+		// Larger than the whole buffer: write directly
+		if (fwrite(data, 1, size, this->file) != size)
+		{
+			this->failed = true;
+		}
+	}
+	else
+	{
+		memcpy(&this->buffer[this->buffer_used], data, size);
+		this->buffer_used += size;
+	}
+}
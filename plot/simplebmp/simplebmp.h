@@ -35,6 +35,11 @@
 
 #define SIMPLEBMP_INVALID_SIGNATURE 2
 #define SIMPLEBMP_INVALID_BITS_PER_PIXEL 3
+#define SIMPLEBMP_WRITE_ERROR 4
+#define SIMPLEBMP_READ_ERROR 5
+
+#include <cstdio>
+#include <vector>
 
 class SimpleBMP
 {
@@ -88,4 +93,51 @@ public:
 	unsigned char* getPixels(void) const;
 };
 
+// Writes a 24 bit BMP row by row from top to bottom (stored as a top-down
+// bitmap), so an image can be rendered and written in bands without holding
+// the whole bitmap in memory. Output is collected in a large buffer and
+// written with few fwrite calls.
+//
+// Example:
+//
+// SimpleBMPWriter writer;
+// writer.open("big.bmp", width, height);
+// for (each band) { render band; writer.writeBand(band); }
+// writer.close();
+class SimpleBMPWriter
+{
+public:
+	SimpleBMPWriter(void) {}
+	~SimpleBMPWriter(void);
+
+	SimpleBMPWriter(const SimpleBMPWriter&) = delete;
+	SimpleBMPWriter& operator=(const SimpleBMPWriter&) = delete;
+
+	int open(const char *path, const int width, const int height, const int bufferSize = (1 << 20));
+
+	// Appends rows in top-down order, BGR, 3 bytes per pixel, no padding.
+	int writeRows(const unsigned char *rows, const int count);
+
+	// Appends all rows of the bitmap (stored bottom-up like any SimpleBMP)
+	// from top to bottom. The bitmap must have the width given to open().
+	int writeBand(const SimpleBMP &band);
+
+	// Missing rows are written black. Returns SIMPLEBMP_WRITE_ERROR if a
+	// write failed or not all rows were supplied.
+	int close(void);
+
+	bool isOpen(void) const;
+	int getRowsWritten(void) const;
+
+private:
+	void flush(void);
+	void append(const unsigned char *data, const size_t size);
+
+	FILE *file = nullptr;
+	int width = 0, height = 0, rows_written = 0;
+	bool failed = false;
+	std::vector<unsigned char> buffer;
+	size_t buffer_used = 0;
+};
+
 #endif
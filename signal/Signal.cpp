@@ -5,6 +5,7 @@
  */
 
 #include "Signal.h"
+#include "../diag/AllocTracker.h"
 
 
 namespace sgnl
@@ -23,9 +24,17 @@ namespace sgnl
 								/(1000.0/NOISE_ABS_MAX_VOLT);
 	}
 
+	sgnl::Volt applyNoise(sgnl::Volt a_voltage, std::mt19937 &a_gen)
+	{
+		std::uniform_int_distribution<> distr(-999, 999);
+		return a_voltage + static_cast<double>(distr(a_gen))
+								/(1000.0/NOISE_ABS_MAX_VOLT);
+	}
+
 	std::vector<sgnl::Volt> applyNoise(
 		std::vector<sgnl::Volt> a_voltages)
 	{
+		DFSM_ALLOC_SCOPE(allocScope, diag::AllocSubsystem::SIGNAL);
 		vector<Volt> ret;
 		ret.resize(a_voltages.size());
 		for(int i=0; i<static_cast<int>(a_voltages.size()); i++)
@@ -38,6 +47,7 @@ namespace sgnl
 	std::vector<sgnl::Volt> logicalToVolt(
 		std::vector<bool> a_logicLevels)
 	{
+		DFSM_ALLOC_SCOPE(allocScope, diag::AllocSubsystem::SIGNAL);
 		vector<Volt> ret;
 		ret.resize(a_logicLevels.size());
 		for(int i=0; i<static_cast<int>(a_logicLevels.size()); i++)
@@ -58,6 +68,7 @@ namespace sgnl
 		std::vector<sgnl::Volt> a_voltages,
 		std::vector<bool> a_prevLogicLevels)
 	{
+		DFSM_ALLOC_SCOPE(allocScope, diag::AllocSubsystem::SIGNAL);
 		vector<bool> ret;
 		ret.resize(a_voltages.size());
 		for(int i=0; i<static_cast<int>(a_voltages.size()); i++)
@@ -41,6 +41,15 @@ namespace sgnl
 	 */
 	Volt applyNoise(sgnl::Volt a_voltage);
 
+	/*! \brief Beaufschlagt den uebergebenen Spannungswert mit einer Stoerung,
+	 *  die aus dem uebergebenen Zufallsgenerator statt aus gen_ gezogen wird.
+	 *  Damit koennen mehrere Simulationen parallel und reproduzierbar laufen
+	 *  \param a_voltage Spannungswert
+	 *  \param a_gen Zu verwendender Zufallsgenerator
+	 *  \return Gestoerter Spannungswert
+	 */
+	Volt applyNoise(sgnl::Volt a_voltage, std::mt19937 &a_gen);
+
 	/*! \brief Beaufschlagt die uebergebenen Spannungswerte mit einer Stoerung
 	 *  und gibt sie anschliessend zurueck
 	 *  \param a_voltages Spannungswerte
@@ -0,0 +1,49 @@
+/*! \file Clock.cpp
+ *  \brief Implementierung der Klasse Clock
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "Clock.h"
+#include "../diag/Log.h"
+
+#include <iostream>
+
+using namespace std;
+using namespace sgnl;
+
+Clock::Clock(sgnl::Nanoseconds a_period, sgnl::Nanoseconds a_phase) :
+		period_(a_period), phase_(a_phase)
+{
+	if (a_period < 2)
+	{
+		DFSM_LOG_WARNING("Clock", "Period must be >= 2.");
+		period_ = 2;
+	}
+}
+
+Source* Clock::clone() const
+{
+	return new Clock(*this);
+}
+
+const char* Clock::typeName() const
+{
+	return "Clock";
+}
+
+void Clock::generateBlock(sgnl::Nanoseconds a_start, sgnl::Volt *a_block,
+		int a_length)
+{
+	Nanoseconds halfPeriod = period_ / 2;
+	Nanoseconds pos = ((a_start - phase_) % period_ + period_) % period_;
+	for (int i = 0; i < a_length; i++)
+	{
+		a_block[i] = (pos < halfPeriod) ? LOW_LEVEL_VOLT : HIGH_LEVEL_VOLT;
+		pos++;
+		if (pos == period_)
+		{
+			pos = 0;
+		}
+	}
+}
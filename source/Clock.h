@@ -0,0 +1,41 @@
+/*! \file Clock.h
+ *  \brief Definition der Klasse Clock
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef SOURCE_CLOCK_H_
+#define SOURCE_CLOCK_H_
+
+#include "Source.h"
+
+/*! \class Clock
+ *  \brief Rechteckquelle. In der ersten Haelfte jeder Periode liegt
+ *  LOW_LEVEL_VOLT an, in der zweiten Haelfte HIGH_LEVEL_VOLT. Die Phase
+ *  verschiebt das Signal nach hinten
+ */
+class Clock: public Source
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_period Periode der Rechteckquelle (>= 2 ns)
+	 *  \param a_phase Phase (Verschiebung) der Rechteckquelle
+	 */
+	Clock(sgnl::Nanoseconds a_period, sgnl::Nanoseconds a_phase);
+
+	Source* clone() const;
+
+	const char* typeName() const;
+
+protected:
+	void generateBlock(
+		sgnl::Nanoseconds a_start,
+		sgnl::Volt *a_block,
+		int a_length);
+
+private:
+	sgnl::Nanoseconds period_;  /**< Periode */
+	sgnl::Nanoseconds phase_;   /**< Phase */
+};
+
+#endif /* SOURCE_CLOCK_H_ */
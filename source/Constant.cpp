@@ -0,0 +1,33 @@
+/*! \file Constant.cpp
+ *  \brief Implementierung der Klasse Constant
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "Constant.h"
+
+#include <algorithm>
+
+using namespace sgnl;
+
+Constant::Constant(sgnl::Volt a_voltage) :
+		voltage_(a_voltage)
+{
+
+}
+
+Source* Constant::clone() const
+{
+	return new Constant(*this);
+}
+
+const char* Constant::typeName() const
+{
+	return "Constant";
+}
+
+void Constant::generateBlock(sgnl::Nanoseconds, sgnl::Volt *a_block,
+		int a_length)
+{
+	std::fill(a_block, a_block + a_length, voltage_);
+}
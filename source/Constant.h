@@ -0,0 +1,37 @@
+/*! \file Constant.h
+ *  \brief Definition der Klasse Constant
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef SOURCE_CONSTANT_H_
+#define SOURCE_CONSTANT_H_
+
+#include "Source.h"
+
+/*! \class Constant
+ *  \brief Konstantquelle. Liefert zu jedem Zeitpunkt dieselbe Spannung
+ */
+class Constant: public Source
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_voltage Spannung der Konstantquelle
+	 */
+	Constant(sgnl::Volt a_voltage);
+
+	Source* clone() const;
+
+	const char* typeName() const;
+
+protected:
+	void generateBlock(
+		sgnl::Nanoseconds a_start,
+		sgnl::Volt *a_block,
+		int a_length);
+
+private:
+	sgnl::Volt voltage_;  /**< Spannung */
+};
+
+#endif /* SOURCE_CONSTANT_H_ */
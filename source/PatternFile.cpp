@@ -0,0 +1,175 @@
+/*! \file PatternFile.cpp
+ *  \brief Implementierung der Klasse PatternFile
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "PatternFile.h"
+#include "../diag/Log.h"
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+
+using namespace std;
+using namespace sgnl;
+
+PatternFile::PatternFile(const std::string &a_fileName, bool a_repeat) :
+		path_("Patterns/" + a_fileName + ".pat"), repeat_(a_repeat), position_(
+				0), remaining_(0), voltage_(LOW_LEVEL_VOLT), exhausted_(false), lineNumber_(
+				0)
+{
+
+}
+
+PatternFile::PatternFile(const PatternFile &a_other) :
+		Source(a_other), path_(a_other.path_), repeat_(a_other.repeat_), position_(
+				a_other.position_), remaining_(a_other.remaining_), voltage_(
+				a_other.voltage_), exhausted_(a_other.exhausted_), lineNumber_(
+				a_other.lineNumber_)
+{
+
+}
+
+Source* PatternFile::clone() const
+{
+	return new PatternFile(*this);
+}
+
+const char* PatternFile::typeName() const
+{
+	return "PatternFile";
+}
+
+void PatternFile::generateBlock(sgnl::Nanoseconds, sgnl::Volt *a_block,
+		int a_length)
+{
+	int i = 0;
+	while (i < a_length)
+	{
+		if (remaining_ == 0 && !exhausted_ && !readSegment())
+		{
+			exhausted_ = true;
+		}
+		if (exhausted_)
+		{
+			fill(a_block + i, a_block + a_length, voltage_);
+			return;
+		}
+		int run = min(remaining_, a_length - i);
+		fill(a_block + i, a_block + i + run, voltage_);
+		i += run;
+		remaining_ -= run;
+	}
+}
+
+void PatternFile::resetState()
+{
+	file_.reset();
+	position_ = 0;
+	remaining_ = 0;
+	voltage_ = LOW_LEVEL_VOLT;
+	exhausted_ = false;
+	lineNumber_ = 0;
+}
+
+void PatternFile::writeState(Checkpoint &a_checkpoint) const
+{
+	a_checkpoint.writeInt64(static_cast<int64_t>(position_));
+	a_checkpoint.writeInt(remaining_);
+	a_checkpoint.writeDouble(voltage_);
+	a_checkpoint.writeInt(exhausted_ ? 1 : 0);
+	a_checkpoint.writeInt(lineNumber_);
+}
+
+bool PatternFile::readState(Checkpoint &a_checkpoint)
+{
+	int64_t position = 0;
+	int32_t remaining = 0;
+	double voltage = 0;
+	int32_t exhausted = 0;
+	int32_t lineNumber = 0;
+	if (!a_checkpoint.readInt64(position) || !a_checkpoint.readInt(remaining)
+			|| !a_checkpoint.readDouble(voltage)
+			|| !a_checkpoint.readInt(exhausted)
+			|| !a_checkpoint.readInt(lineNumber))
+	{
+		return false;
+	}
+	// Die Datei wird beim naechsten Lesen an der gespeicherten Position
+	// wieder geoeffnet
+	file_.reset();
+	position_ = static_cast<streamoff>(position);
+	remaining_ = remaining;
+	voltage_ = voltage;
+	exhausted_ = exhausted != 0;
+	lineNumber_ = lineNumber;
+	return true;
+}
+
+bool PatternFile::openFile()
+{
+	file_.reset(new ifstream(path_.c_str()));
+	if (!file_->is_open())
+	{
+		DFSM_LOG_ERROR("PatternFile", "Cannot open pattern file at \"" << path_ << "\".");
+		return false;
+	}
+	file_->seekg(position_);
+	return true;
+}
+
+bool PatternFile::readSegment()
+{
+	if (!file_ && !openFile())
+	{
+		return false;
+	}
+	string line;
+	bool rewound = false;
+	while (true)
+	{
+		if (!getline(*file_, line))
+		{
+			// Dateiende: ggf. einmal von vorn beginnen
+			if (!repeat_ || rewound)
+			{
+				return false;
+			}
+			rewound = true;
+			file_->clear();
+			file_->seekg(0);
+			lineNumber_ = 0;
+			continue;
+		}
+		lineNumber_++;
+		size_t begin = line.find_first_not_of(" \t\r");
+		if (begin == string::npos || line[begin] == '#')
+		{
+			continue;
+		}
+		istringstream segment(line);
+		Nanoseconds duration = 0;
+		Volt voltage = 0;
+		if (!(segment >> duration >> voltage) || duration < 0)
+		{
+			DFSM_LOG_ERROR("PatternFile", path_ << ", line " << lineNumber_
+					<< ": Expected \"<duration> <voltage>\".");
+			return false;
+		}
+		if (duration == 0)
+		{
+			continue;
+		}
+		if (file_->eof())
+		{
+			// Letzte Zeile ohne Zeilenumbruch: tellg() waere ungueltig
+			file_->clear();
+			file_->seekg(0, ios::end);
+		}
+		position_ = file_->tellg();
+		remaining_ = duration;
+		voltage_ = voltage;
+		return true;
+	}
+}
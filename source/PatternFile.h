@@ -0,0 +1,81 @@
+/*! \file PatternFile.h
+ *  \brief Definition der Klasse PatternFile
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef SOURCE_PATTERNFILE_H_
+#define SOURCE_PATTERNFILE_H_
+
+#include "Source.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+/*! \class PatternFile
+ *  \brief Spielt ein Spannungsmuster aus einer Datei ab. Die Datei wird
+ *  waehrend der Simulation stueckweise gelesen (streaming), sie muss also
+ *  nicht vollstaendig in den Speicher passen.
+ *  \details Dateiformat: Jede Zeile enthaelt ein Segment
+ *  "<Dauer/ns> <Spannung/V>". Leerzeilen und Zeilen, die mit # beginnen,
+ *  werden uebersprungen. Am Dateiende wird entweder die letzte Spannung
+ *  gehalten oder das Muster von vorn wiederholt
+ */
+class PatternFile: public Source
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_fileName Dateiname des Musters, OHNE Endung .pat und OHNE
+	 *  Angabe des Ordners: Es wird davon ausgegangen, dass die Datei im
+	 *  Ordner Patterns/ liegt
+	 *  \param a_repeat true, falls das Muster am Dateiende wiederholt werden
+	 *  soll, false, falls die letzte Spannung gehalten werden soll
+	 */
+	PatternFile(const std::string &a_fileName, bool a_repeat = false);
+
+	/*! \brief Kopierkonstruktor. Die Kopie oeffnet die Datei selbst und setzt
+	 *  an derselben Stelle fort
+	 *  \param a_other Zu kopierende Quelle
+	 */
+	PatternFile(const PatternFile &a_other);
+
+	Source* clone() const;
+
+	const char* typeName() const;
+
+protected:
+	void generateBlock(
+		sgnl::Nanoseconds a_start,
+		sgnl::Volt *a_block,
+		int a_length);
+
+	void resetState();
+
+	void writeState(Checkpoint &a_checkpoint) const;
+
+	bool readState(Checkpoint &a_checkpoint);
+
+private:
+	/*! \brief Liest das naechste Segment aus der Datei
+	 *  \return true, falls ein Segment gelesen wurde, false am Dateiende
+	 *  oder bei einem Fehler
+	 */
+	bool readSegment();
+
+	/*! \brief Oeffnet die Datei und springt an die gemerkte Position
+	 *  \return true, falls die Datei geoeffnet werden konnte, false sonst
+	 */
+	bool openFile();
+
+	std::string path_;                     /**< Pfad der Musterdatei */
+	bool repeat_;                          /**< Muster wiederholen */
+	std::unique_ptr<std::ifstream> file_;  /**< Geoeffnete Musterdatei */
+	std::streampos position_;  /**< Dateiposition nach dem letzten Segment */
+	sgnl::Nanoseconds remaining_;  /**< Restdauer des aktuellen Segments */
+	sgnl::Volt voltage_;       /**< Spannung des aktuellen Segments */
+	bool exhausted_;           /**< Dateiende erreicht bzw. Fehler */
+	int lineNumber_;           /**< Zeilennummer fuer Fehlermeldungen */
+};
+
+#endif /* SOURCE_PATTERNFILE_H_ */
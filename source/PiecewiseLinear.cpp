@@ -0,0 +1,87 @@
+/*! \file PiecewiseLinear.cpp
+ *  \brief Implementierung der Klasse PiecewiseLinear
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "PiecewiseLinear.h"
+#include "../diag/Log.h"
+
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+using namespace sgnl;
+
+PiecewiseLinear::PiecewiseLinear(
+		const std::vector<std::pair<sgnl::Nanoseconds, sgnl::Volt> > &a_points) :
+		points_(a_points), segment_(0)
+{
+	if (points_.empty())
+	{
+		DFSM_LOG_WARNING("PiecewiseLinear", "Need at least one point, using "
+				<< LOW_LEVEL_VOLT << " V.");
+		points_.push_back(pair<Nanoseconds, Volt>(0, LOW_LEVEL_VOLT));
+	}
+	if (!is_sorted(points_.begin(), points_.end()))
+	{
+		DFSM_LOG_WARNING("PiecewiseLinear", "Points must be sorted by time, sorting.");
+		stable_sort(points_.begin(), points_.end());
+	}
+}
+
+Source* PiecewiseLinear::clone() const
+{
+	return new PiecewiseLinear(*this);
+}
+
+const char* PiecewiseLinear::typeName() const
+{
+	return "PiecewiseLinear";
+}
+
+void PiecewiseLinear::generateBlock(sgnl::Nanoseconds a_start,
+		sgnl::Volt *a_block, int a_length)
+{
+	int last = static_cast<int>(points_.size()) - 1;
+	for (int i = 0; i < a_length; i++)
+	{
+		Nanoseconds t = a_start + i;
+		while (segment_ < last && points_[segment_ + 1].first <= t)
+		{
+			segment_++;
+		}
+		if (t <= points_[segment_].first || segment_ == last)
+		{
+			a_block[i] = points_[segment_].second;
+			continue;
+		}
+		const pair<Nanoseconds, Volt> &p0 = points_[segment_];
+		const pair<Nanoseconds, Volt> &p1 = points_[segment_ + 1];
+		a_block[i] = p0.second
+				+ (p1.second - p0.second) * (t - p0.first)
+						/ static_cast<double>(p1.first - p0.first);
+	}
+}
+
+void PiecewiseLinear::resetState()
+{
+	segment_ = 0;
+}
+
+void PiecewiseLinear::writeState(Checkpoint &a_checkpoint) const
+{
+	a_checkpoint.writeInt(segment_);
+}
+
+bool PiecewiseLinear::readState(Checkpoint &a_checkpoint)
+{
+	int32_t segment = 0;
+	if (!a_checkpoint.readInt(segment) || segment < 0
+			|| segment >= max(1, static_cast<int>(points_.size())))
+	{
+		return false;
+	}
+	segment_ = segment;
+	return true;
+}
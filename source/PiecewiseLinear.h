@@ -0,0 +1,54 @@
+/*! \file PiecewiseLinear.h
+ *  \brief Definition der Klasse PiecewiseLinear
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef SOURCE_PIECEWISELINEAR_H_
+#define SOURCE_PIECEWISELINEAR_H_
+
+#include "Source.h"
+
+#include <utility>
+#include <vector>
+
+/*! \class PiecewiseLinear
+ *  \brief Stueckweise lineare Spannungsquelle (z. B. Spannungsrampen).
+ *  Zwischen den Stuetzstellen wird linear interpoliert, vor der ersten
+ *  Stuetzstelle gilt deren Spannung, nach der letzten Stuetzstelle wird
+ *  deren Spannung gehalten
+ */
+class PiecewiseLinear: public Source
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_points Stuetzstellen (Zeitpunkt / ns, Spannung / V), nach
+	 *  Zeit aufsteigend sortiert
+	 */
+	PiecewiseLinear(
+		const std::vector<std::pair<sgnl::Nanoseconds, sgnl::Volt> > &a_points);
+
+	Source* clone() const;
+
+	const char* typeName() const;
+
+protected:
+	void generateBlock(
+		sgnl::Nanoseconds a_start,
+		sgnl::Volt *a_block,
+		int a_length);
+
+	void resetState();
+
+	void writeState(Checkpoint &a_checkpoint) const;
+
+	bool readState(Checkpoint &a_checkpoint);
+
+private:
+	std::vector<std::pair<sgnl::Nanoseconds, sgnl::Volt> > points_;  /**<
+		Stuetzstellen */
+	int segment_;  /**< Index der Stuetzstelle, mit der das aktuelle
+		Segment beginnt */
+};
+
+#endif /* SOURCE_PIECEWISELINEAR_H_ */
@@ -0,0 +1,122 @@
+/*! \file Prbs.cpp
+ *  \brief Implementierung der Klasse Prbs
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "Prbs.h"
+#include "../diag/Log.h"
+
+#include <iostream>
+
+using namespace std;
+using namespace sgnl;
+
+Prbs::Prbs(PrbsOrder a_order, sgnl::Nanoseconds a_bitPeriod,
+		std::uint32_t a_seed) :
+		order_(static_cast<int>(a_order)), tap_(0), mask_(0), seed_(a_seed),
+		register_(0), bitPeriod_(a_bitPeriod), bitPos_(0), level_(
+				LOW_LEVEL_VOLT)
+{
+	switch (a_order)
+	{
+	case PrbsOrder::PRBS7:
+		tap_ = 6;
+		break;
+	case PrbsOrder::PRBS15:
+		tap_ = 14;
+		break;
+	case PrbsOrder::PRBS31:
+		tap_ = 28;
+		break;
+	}
+	mask_ = (1u << order_) - 1u;
+	seed_ &= mask_;
+	if (seed_ == 0)
+	{
+		DFSM_LOG_WARNING("Prbs", "Seed must not be 0, using 1.");
+		seed_ = 1;
+	}
+	if (bitPeriod_ < 1)
+	{
+		DFSM_LOG_WARNING("Prbs", "Bit period must be >= 1.");
+		bitPeriod_ = 1;
+	}
+	resetState();
+}
+
+Source* Prbs::clone() const
+{
+	return new Prbs(*this);
+}
+
+const char* Prbs::typeName() const
+{
+	return "Prbs";
+}
+
+void Prbs::generateBlock(sgnl::Nanoseconds, sgnl::Volt *a_block,
+		int a_length)
+{
+	int i = 0;
+	while (i < a_length)
+	{
+		if (bitPos_ == 0)
+		{
+			level_ = nextBit() ? HIGH_LEVEL_VOLT : LOW_LEVEL_VOLT;
+		}
+		int run = bitPeriod_ - bitPos_;
+		if (run > a_length - i)
+		{
+			run = a_length - i;
+		}
+		for (int k = 0; k < run; k++)
+		{
+			a_block[i + k] = level_;
+		}
+		i += run;
+		bitPos_ += run;
+		if (bitPos_ == bitPeriod_)
+		{
+			bitPos_ = 0;
+		}
+	}
+}
+
+void Prbs::resetState()
+{
+	register_ = seed_;
+	bitPos_ = 0;
+	level_ = LOW_LEVEL_VOLT;
+}
+
+void Prbs::writeState(Checkpoint &a_checkpoint) const
+{
+	a_checkpoint.writeUInt(register_);
+	a_checkpoint.writeInt(bitPos_);
+	a_checkpoint.writeDouble(level_);
+}
+
+bool Prbs::readState(Checkpoint &a_checkpoint)
+{
+	uint32_t reg = 0;
+	int32_t bitPos = 0;
+	double level = 0;
+	if (!a_checkpoint.readUInt(reg) || !a_checkpoint.readInt(bitPos)
+			|| !a_checkpoint.readDouble(level))
+	{
+		return false;
+	}
+	register_ = reg & mask_;
+	bitPos_ = bitPos;
+	level_ = level;
+	return true;
+}
+
+bool Prbs::nextBit()
+{
+	std::uint32_t bit = ((register_ >> (order_ - 1)) ^ (register_ >> (tap_ - 1)))
+			& 1u;
+	register_ = ((register_ << 1) | bit) & mask_;
+	return bit != 0;
+}
@@ -0,0 +1,71 @@
+/*! \file Prbs.h
+ *  \brief Definition der Klasse Prbs
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef SOURCE_PRBS_H_
+#define SOURCE_PRBS_H_
+
+#include "Source.h"
+
+#include <cstdint>
+
+/*! \brief Unterstuetzte Pseudozufallsfolgen (Grad des erzeugenden Polynoms)
+ */
+enum class PrbsOrder
+{
+	PRBS7 = 7,    /**< x^7 + x^6 + 1, Periode 127 Bit */
+	PRBS15 = 15,  /**< x^15 + x^14 + 1, Periode 32767 Bit */
+	PRBS31 = 31   /**< x^31 + x^28 + 1, Periode 2^31-1 Bit */
+};
+
+/*! \class Prbs
+ *  \brief Pseudozufalls-Bitfolge (PRBS), erzeugt durch ein
+ *  Fibonacci-LFSR. Jedes Bit liegt a_bitPeriod Nanosekunden lang als
+ *  HIGH_LEVEL_VOLT bzw. LOW_LEVEL_VOLT an
+ */
+class Prbs: public Source
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_order Grad der Pseudozufallsfolge
+	 *  \param a_bitPeriod Dauer eines Bits / ns (>= 1)
+	 *  \param a_seed Startwert des LFSR-Registers, 0 wird durch 1 ersetzt
+	 */
+	Prbs(PrbsOrder a_order, sgnl::Nanoseconds a_bitPeriod,
+			std::uint32_t a_seed = 1);
+
+	Source* clone() const;
+
+	const char* typeName() const;
+
+protected:
+	void generateBlock(
+		sgnl::Nanoseconds a_start,
+		sgnl::Volt *a_block,
+		int a_length);
+
+	void resetState();
+
+	void writeState(Checkpoint &a_checkpoint) const;
+
+	bool readState(Checkpoint &a_checkpoint);
+
+private:
+	/*! \brief Schaltet das LFSR-Register um ein Bit weiter
+	 *  \return Das neu erzeugte Bit
+	 */
+	bool nextBit();
+
+	int order_;                  /**< Grad des Polynoms */
+	int tap_;                    /**< Zweiter Abgriff des Polynoms */
+	std::uint32_t mask_;         /**< Bitmaske der Registerbreite */
+	std::uint32_t seed_;         /**< Startwert des Registers */
+	std::uint32_t register_;     /**< Aktueller Registerinhalt */
+	sgnl::Nanoseconds bitPeriod_;  /**< Dauer eines Bits / ns */
+	sgnl::Nanoseconds bitPos_;   /**< Position innerhalb des aktuellen Bits */
+	sgnl::Volt level_;           /**< Spannung des aktuellen Bits */
+};
+
+#endif /* SOURCE_PRBS_H_ */
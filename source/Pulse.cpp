@@ -0,0 +1,53 @@
+/*! \file Pulse.cpp
+ *  \brief Implementierung der Klasse Pulse
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "Pulse.h"
+#include "../diag/Log.h"
+
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+using namespace sgnl;
+
+Pulse::Pulse(sgnl::Nanoseconds a_start, sgnl::Nanoseconds a_width,
+		sgnl::Volt a_pulseVoltage, sgnl::Volt a_idleVoltage) :
+		start_(a_start), width_(a_width), pulseVoltage_(a_pulseVoltage), idleVoltage_(
+				a_idleVoltage)
+{
+	if (a_width < 0)
+	{
+		DFSM_LOG_WARNING("Pulse", "Width must be >= 0.");
+		width_ = 0;
+	}
+}
+
+Source* Pulse::clone() const
+{
+	return new Pulse(*this);
+}
+
+const char* Pulse::typeName() const
+{
+	return "Pulse";
+}
+
+void Pulse::generateBlock(sgnl::Nanoseconds a_start, sgnl::Volt *a_block,
+		int a_length)
+{
+	Nanoseconds end = a_start + a_length;
+	Nanoseconds pulseBegin = max(start_, a_start);
+	Nanoseconds pulseEnd = min(start_ + width_, end);
+	if (pulseBegin >= pulseEnd)
+	{
+		fill(a_block, a_block + a_length, idleVoltage_);
+		return;
+	}
+	fill(a_block, a_block + (pulseBegin - a_start), idleVoltage_);
+	fill(a_block + (pulseBegin - a_start), a_block + (pulseEnd - a_start),
+			pulseVoltage_);
+	fill(a_block + (pulseEnd - a_start), a_block + a_length, idleVoltage_);
+}
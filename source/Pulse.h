@@ -0,0 +1,46 @@
+/*! \file Pulse.h
+ *  \brief Definition der Klasse Pulse
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef SOURCE_PULSE_H_
+#define SOURCE_PULSE_H_
+
+#include "Source.h"
+
+/*! \class Pulse
+ *  \brief Einzelimpuls (One-Shot). Im Intervall [a_start, a_start+a_width)
+ *  liegt die Impulsspannung an, sonst die Ruhespannung
+ */
+class Pulse: public Source
+{
+public:
+	/*! \brief Konstruktor
+	 *  \param a_start Beginn des Impulses / ns
+	 *  \param a_width Dauer des Impulses / ns
+	 *  \param a_pulseVoltage Spannung waehrend des Impulses
+	 *  \param a_idleVoltage Spannung ausserhalb des Impulses
+	 */
+	Pulse(sgnl::Nanoseconds a_start, sgnl::Nanoseconds a_width,
+			sgnl::Volt a_pulseVoltage = HIGH_LEVEL_VOLT,
+			sgnl::Volt a_idleVoltage = LOW_LEVEL_VOLT);
+
+	Source* clone() const;
+
+	const char* typeName() const;
+
+protected:
+	void generateBlock(
+		sgnl::Nanoseconds a_start,
+		sgnl::Volt *a_block,
+		int a_length);
+
+private:
+	sgnl::Nanoseconds start_;  /**< Beginn des Impulses */
+	sgnl::Nanoseconds width_;  /**< Dauer des Impulses */
+	sgnl::Volt pulseVoltage_;  /**< Spannung waehrend des Impulses */
+	sgnl::Volt idleVoltage_;   /**< Spannung ausserhalb des Impulses */
+};
+
+#endif /* SOURCE_PULSE_H_ */
@@ -0,0 +1,93 @@
+/*! \file Source.cpp
+ *  \brief Implementierung der Klasse Source
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "Source.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sgnl;
+
+Source::Source() :
+		time_(0)
+{
+
+}
+
+Source::~Source()
+{
+
+}
+
+void Source::generate(sgnl::Volt *a_block, int a_length)
+{
+	if (a_length <= 0)
+	{
+		return;
+	}
+	generateBlock(time_, a_block, a_length);
+	time_ += a_length;
+}
+
+void Source::reset()
+{
+	time_ = 0;
+	resetState();
+}
+
+void Source::skip(sgnl::Nanoseconds a_duration)
+{
+	const int chunk = 1024;
+	vector<Volt> scratch(min(chunk, max(0, a_duration)));
+	while (a_duration > 0)
+	{
+		int length = min(chunk, a_duration);
+		generate(&scratch[0], length);
+		a_duration -= length;
+	}
+}
+
+void Source::saveState(Checkpoint &a_checkpoint) const
+{
+	a_checkpoint.writeString(typeName());
+	a_checkpoint.writeInt(time_);
+	writeState(a_checkpoint);
+}
+
+bool Source::restoreState(Checkpoint &a_checkpoint)
+{
+	string type;
+	int32_t time = 0;
+	if (!a_checkpoint.readString(type) || type != typeName()
+			|| !a_checkpoint.readInt(time) || !readState(a_checkpoint))
+	{
+		return false;
+	}
+	time_ = time;
+	return true;
+}
+
+sgnl::Nanoseconds Source::time() const
+{
+	return time_;
+}
+
+void Source::resetState()
+{
+
+}
+
+void Source::writeState(Checkpoint&) const
+{
+
+}
+
+bool Source::readState(Checkpoint&)
+{
+	return true;
+}
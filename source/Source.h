@@ -0,0 +1,112 @@
+/*! \file Source.h
+ *  \brief Definition der Klasse Source
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef SOURCE_SOURCE_H_
+#define SOURCE_SOURCE_H_
+
+#include "../signal/Signal.h"
+#include "../fileIO/Checkpoint.h"
+
+/*! \class Source
+ *  \brief Basisklasse aller Signalquellen des Testbed. Eine Signalquelle
+ *  erzeugt ihre Spannungswerte blockweise (ein virtueller Aufruf pro Block,
+ *  nicht pro Nanosekunde) und merkt sich dabei die aktuelle Simulationszeit
+ */
+class Source
+{
+public:
+	/*! \brief Konstruktor. Die Simulationszeit beginnt bei 0 ns
+	 */
+	Source();
+
+	/*! \brief Destruktor
+	 */
+	virtual ~Source();
+
+	/*! \brief Schreibt die Spannungswerte der naechsten a_length Nanosekunden
+	 *  in den uebergebenen Block und schaltet die Simulationszeit entsprechend
+	 *  weiter
+	 *  \param a_block Zielpuffer, mindestens a_length Werte gross
+	 *  \param a_length Anzahl der zu erzeugenden Werte (1 Wert pro ns)
+	 */
+	void generate(sgnl::Volt *a_block, int a_length);
+
+	/*! \brief Setzt die Quelle auf die Simulationszeit 0 ns zurueck
+	 */
+	void reset();
+
+	/*! \brief Ueberspringt die Spannungswerte der naechsten a_duration
+	 *  Nanosekunden (die Werte werden erzeugt und verworfen)
+	 *  \param a_duration Zu ueberspringende Dauer / ns
+	 */
+	void skip(sgnl::Nanoseconds a_duration);
+
+	/*! \brief Haengt den Zustand der Quelle (Typ, Simulationszeit und
+	 *  interner Zustand) an einen Checkpoint an
+	 *  \param a_checkpoint Checkpoint
+	 */
+	void saveState(Checkpoint &a_checkpoint) const;
+
+	/*! \brief Stellt den mit saveState(...) gespeicherten Zustand wieder
+	 *  her. Die Quelle muss mit denselben Parametern erzeugt worden sein
+	 *  \param a_checkpoint Checkpoint
+	 *  \return true, falls erfolgreich, false sonst (auch, falls der
+	 *  Checkpoint von einer Quelle anderen Typs stammt)
+	 */
+	bool restoreState(Checkpoint &a_checkpoint);
+
+	/*! \brief Gibt die aktuelle Simulationszeit der Quelle zurueck
+	 *  \return Zeitpunkt des naechsten zu erzeugenden Werts
+	 */
+	sgnl::Nanoseconds time() const;
+
+	/*! \brief Erzeugt eine Kopie der Quelle inklusive ihres aktuellen
+	 *  Zustands. Der Aufrufer uebernimmt den Besitz
+	 *  \return Kopie der Quelle
+	 */
+	virtual Source* clone() const = 0;
+
+	/*! \brief Gibt den Typ der Quelle zurueck. saveState(...) legt ihn im
+	 *  Checkpoint ab, restoreState(...) lehnt einen abweichenden Typ ab
+	 *  \return Klassenname, z. B. "Prbs"
+	 */
+	virtual const char* typeName() const = 0;
+
+protected:
+	/*! \brief Erzeugt die Spannungswerte ab dem uebergebenen Zeitpunkt.
+	 *  Diese Methode ist durch die konkreten Quellen zu implementieren
+	 *  \param a_start Zeitpunkt des ersten zu erzeugenden Werts
+	 *  \param a_block Zielpuffer
+	 *  \param a_length Anzahl der zu erzeugenden Werte
+	 */
+	virtual void generateBlock(
+		sgnl::Nanoseconds a_start,
+		sgnl::Volt *a_block,
+		int a_length) = 0;
+
+	/*! \brief Setzt den internen Zustand zurueck (z. B. LFSR-Register,
+	 *  Dateiposition). Standardmaessig ohne Wirkung
+	 */
+	virtual void resetState();
+
+	/*! \brief Haengt den internen Zustand an einen Checkpoint an.
+	 *  Standardmaessig ohne Wirkung (zustandslose Quellen)
+	 *  \param a_checkpoint Checkpoint
+	 */
+	virtual void writeState(Checkpoint &a_checkpoint) const;
+
+	/*! \brief Liest den mit writeState(...) gespeicherten internen Zustand.
+	 *  Standardmaessig ohne Wirkung
+	 *  \param a_checkpoint Checkpoint
+	 *  \return true, falls erfolgreich, false sonst
+	 */
+	virtual bool readState(Checkpoint &a_checkpoint);
+
+private:
+	sgnl::Nanoseconds time_;  /**< Aktuelle Simulationszeit */
+};
+
+#endif /* SOURCE_SOURCE_H_ */
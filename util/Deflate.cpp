@@ -0,0 +1,515 @@
+/*! \file Deflate.cpp
+ *  \brief Implementierung der Klasse Deflate
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "Deflate.h"
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+using namespace std;
+
+const int Deflate::LENGTH_BASE[29] =
+{ 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67,
+		83, 99, 115, 131, 163, 195, 227, 258 };
+const int Deflate::LENGTH_EXTRA[29] =
+{ 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5,
+		5, 5, 0 };
+const int Deflate::DIST_BASE[30] =
+{ 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513,
+		769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+const int Deflate::DIST_EXTRA[30] =
+{ 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11,
+		11, 12, 12, 13, 13 };
+const int Deflate::CLEN_ORDER[19] =
+{ 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+const int Deflate::WINDOW_SIZE;
+const int Deflate::MIN_MATCH;
+const int Deflate::MAX_MATCH;
+const int Deflate::HASH_BITS;
+const int Deflate::BLOCK_TOKENS;
+const int Deflate::STORED_MAX;
+
+Deflate::BitWriter::BitWriter(std::vector<unsigned char> &a_out) :
+		out_(a_out), buffer_(0), nBits_(0)
+{
+
+}
+
+void Deflate::BitWriter::write(std::uint32_t a_value, int a_nBits)
+{
+	buffer_ |= a_value << nBits_;
+	nBits_ += a_nBits;
+	while (nBits_ >= 8)
+	{
+		out_.push_back(static_cast<unsigned char>(buffer_));
+		buffer_ >>= 8;
+		nBits_ -= 8;
+	}
+}
+
+void Deflate::BitWriter::writeCode(std::uint32_t a_code, int a_length)
+{
+	uint32_t reversed = 0;
+	for (int i = 0; i < a_length; i++)
+	{
+		reversed = (reversed << 1) | ((a_code >> i) & 1);
+	}
+	write(reversed, a_length);
+}
+
+void Deflate::BitWriter::flush()
+{
+	if (nBits_ > 0)
+	{
+		out_.push_back(static_cast<unsigned char>(buffer_));
+	}
+	buffer_ = 0;
+	nBits_ = 0;
+}
+
+std::vector<unsigned char> Deflate::zlibCompress(const unsigned char *a_data,
+		std::size_t a_size, int a_maxChain)
+{
+	vector<unsigned char> out;
+	out.reserve(a_size / 8 + 64);
+	// CMF: Deflate, 32-KiB-Fenster; FLG: Standardkompression, Pruefbits
+	out.push_back(0x78);
+	out.push_back(0x9C);
+	BitWriter bits(out);
+
+	const size_t hashSize = size_t(1) << HASH_BITS;
+	vector<int> head(hashSize, -1);
+	vector<int> prev(WINDOW_SIZE, -1);
+	vector<Token> tokens;
+	tokens.reserve(BLOCK_TOKENS);
+	const long long n = static_cast<long long>(a_size);
+
+	long long i = 0;
+	long long blockStart = 0;
+	while (i < n)
+	{
+		int bestLength = 0;
+		int bestDist = 0;
+		if (i + MIN_MATCH <= n)
+		{
+			size_t h = ((size_t(a_data[i]) << 10) ^ (size_t(a_data[i + 1]) << 5)
+					^ a_data[i + 2]) & (hashSize - 1);
+			int maxLength = static_cast<int>(min<long long>(MAX_MATCH, n - i));
+			long long candidate = head[h];
+			int chain = a_maxChain;
+			while (candidate >= 0 && i - candidate <= WINDOW_SIZE && chain-- > 0)
+			{
+				if (a_data[candidate + bestLength] == a_data[i + bestLength])
+				{
+					int length = 0;
+					while (length < maxLength
+							&& a_data[candidate + length] == a_data[i + length])
+					{
+						length++;
+					}
+					if (length > bestLength)
+					{
+						bestLength = length;
+						bestDist = static_cast<int>(i - candidate);
+						if (length == maxLength)
+						{
+							break;
+						}
+					}
+				}
+				long long next = prev[candidate & (WINDOW_SIZE - 1)];
+				if (next >= candidate)
+				{
+					break;  // Eintrag wurde von einer neueren Position ueberschrieben
+				}
+				candidate = next;
+			}
+		}
+
+		int advance = 1;
+		Token token;
+		if (bestLength >= MIN_MATCH)
+		{
+			token.value_ = static_cast<uint16_t>(bestLength);
+			token.dist_ = static_cast<uint16_t>(bestDist);
+			advance = bestLength;
+		}
+		else
+		{
+			token.value_ = a_data[i];
+			token.dist_ = 0;
+		}
+		tokens.push_back(token);
+
+		// Alle uebersprungenen Positionen in die Hash-Ketten eintragen
+		for (long long k = i; k < i + advance; k++)
+		{
+			if (k + MIN_MATCH <= n)
+			{
+				size_t h = ((size_t(a_data[k]) << 10)
+						^ (size_t(a_data[k + 1]) << 5) ^ a_data[k + 2])
+						& (hashSize - 1);
+				prev[k & (WINDOW_SIZE - 1)] = head[h];
+				head[h] = static_cast<int>(k);
+			}
+		}
+		i += advance;
+
+		if (static_cast<int>(tokens.size()) == BLOCK_TOKENS && i < n)
+		{
+			writeBlock(tokens, a_data + blockStart, i - blockStart, false, bits);
+			tokens.clear();
+			blockStart = i;
+		}
+	}
+	writeBlock(tokens, a_data + blockStart, n - blockStart, true, bits);
+	bits.flush();
+
+	uint32_t adler = adler32(a_data, a_size);
+	out.push_back(static_cast<unsigned char>(adler >> 24));
+	out.push_back(static_cast<unsigned char>(adler >> 16));
+	out.push_back(static_cast<unsigned char>(adler >> 8));
+	out.push_back(static_cast<unsigned char>(adler));
+	return out;
+}
+
+int Deflate::lengthIndex(int a_length)
+{
+	return static_cast<int>(upper_bound(LENGTH_BASE, LENGTH_BASE + 29, a_length)
+			- LENGTH_BASE) - 1;
+}
+
+int Deflate::distIndex(int a_dist)
+{
+	return static_cast<int>(upper_bound(DIST_BASE, DIST_BASE + 30, a_dist)
+			- DIST_BASE) - 1;
+}
+
+std::uint32_t Deflate::adler32(const unsigned char *a_data, std::size_t a_size)
+{
+	uint32_t a = 1;
+	uint32_t b = 0;
+	while (a_size > 0)
+	{
+		// 5552 ist die groesste Anzahl Bytes ohne Ueberlauf vor dem Modulo
+		size_t chunk = min<size_t>(a_size, 5552);
+		for (size_t k = 0; k < chunk; k++)
+		{
+			a += a_data[k];
+			b += a;
+		}
+		a %= 65521;
+		b %= 65521;
+		a_data += chunk;
+		a_size -= chunk;
+	}
+	return (b << 16) | a;
+}
+
+void Deflate::huffmanLengths(const std::vector<std::uint32_t> &a_freqs,
+		int a_maxBits, std::vector<int> &a_lengths)
+{
+	const int nSymbols = static_cast<int>(a_freqs.size());
+	vector<uint32_t> freqs(a_freqs);
+
+	// Mindestens zwei Symbole, sonst lehnen manche Decoder den Code ab
+	int nUsed = 0;
+	for (int s = 0; s < nSymbols; s++)
+	{
+		nUsed += (freqs[s] > 0) ? 1 : 0;
+	}
+	for (int s = 0; s < nSymbols && nUsed < 2; s++)
+	{
+		if (freqs[s] == 0)
+		{
+			freqs[s] = 1;
+			nUsed++;
+		}
+	}
+
+	while (true)
+	{
+		// Knoten 0..nSymbols-1 sind Blaetter, danach innere Knoten
+		typedef pair<uint64_t, int> Node;
+		priority_queue<Node, vector<Node>, greater<Node> > queue;
+		vector<int> parent(2 * nSymbols, -1);
+		for (int s = 0; s < nSymbols; s++)
+		{
+			if (freqs[s] > 0)
+			{
+				queue.push(Node(freqs[s], s));
+			}
+		}
+		int next = nSymbols;
+		while (queue.size() > 1)
+		{
+			Node a = queue.top();
+			queue.pop();
+			Node b = queue.top();
+			queue.pop();
+			parent[a.second] = next;
+			parent[b.second] = next;
+			queue.push(Node(a.first + b.first, next));
+			next++;
+		}
+
+		a_lengths.assign(nSymbols, 0);
+		int maxLength = 0;
+		for (int s = 0; s < nSymbols; s++)
+		{
+			if (freqs[s] == 0)
+			{
+				continue;
+			}
+			int length = 0;
+			for (int p = s; parent[p] >= 0; p = parent[p])
+			{
+				length++;
+			}
+			a_lengths[s] = length;
+			maxLength = max(maxLength, length);
+		}
+		if (maxLength <= a_maxBits)
+		{
+			return;
+		}
+		// Zu lange Codes: Haeufigkeiten angleichen und neu aufbauen
+		for (int s = 0; s < nSymbols; s++)
+		{
+			if (freqs[s] > 0)
+			{
+				freqs[s] = (freqs[s] + 1) / 2;
+			}
+		}
+	}
+}
+
+void Deflate::canonicalCodes(const std::vector<int> &a_lengths,
+		std::vector<std::uint32_t> &a_codes)
+{
+	int count[16] =
+	{ 0 };
+	for (int s = 0; s < static_cast<int>(a_lengths.size()); s++)
+	{
+		count[a_lengths[s]]++;
+	}
+	count[0] = 0;
+	uint32_t nextCode[16] =
+	{ 0 };
+	uint32_t code = 0;
+	for (int bits = 1; bits < 16; bits++)
+	{
+		code = (code + count[bits - 1]) << 1;
+		nextCode[bits] = code;
+	}
+	a_codes.assign(a_lengths.size(), 0);
+	for (int s = 0; s < static_cast<int>(a_lengths.size()); s++)
+	{
+		if (a_lengths[s] != 0)
+		{
+			a_codes[s] = nextCode[a_lengths[s]]++;
+		}
+	}
+}
+
+void Deflate::writeBlock(const std::vector<Token> &a_tokens,
+		const unsigned char *a_raw, std::size_t a_rawSize, bool a_last,
+		BitWriter &a_bits)
+{
+	vector<uint32_t> litFreqs(286, 0);
+	vector<uint32_t> distFreqs(30, 0);
+	for (int t = 0; t < static_cast<int>(a_tokens.size()); t++)
+	{
+		if (a_tokens[t].dist_ == 0)
+		{
+			litFreqs[a_tokens[t].value_]++;
+		}
+		else
+		{
+			litFreqs[257 + lengthIndex(a_tokens[t].value_)]++;
+			distFreqs[distIndex(a_tokens[t].dist_)]++;
+		}
+	}
+	litFreqs[256] = 1;  // Blockende
+
+	vector<int> litLengths;
+	vector<int> distLengths;
+	huffmanLengths(litFreqs, 15, litLengths);
+	huffmanLengths(distFreqs, 15, distLengths);
+	vector<uint32_t> litCodes;
+	vector<uint32_t> distCodes;
+	canonicalCodes(litLengths, litCodes);
+	canonicalCodes(distLengths, distCodes);
+
+	int nLit = 286;
+	while (nLit > 257 && litLengths[nLit - 1] == 0)
+	{
+		nLit--;
+	}
+	int nDist = 30;
+	while (nDist > 1 && distLengths[nDist - 1] == 0)
+	{
+		nDist--;
+	}
+
+	// Codelaengen beider Codes lauflaengenkodiert (Symbole 16, 17, 18)
+	vector<int> lengths(litLengths.begin(), litLengths.begin() + nLit);
+	lengths.insert(lengths.end(), distLengths.begin(),
+			distLengths.begin() + nDist);
+	vector<pair<int, int> > clenSymbols;  // (Symbol, Zusatzbits-Wert)
+	for (int k = 0; k < static_cast<int>(lengths.size());)
+	{
+		int value = lengths[k];
+		int run = 1;
+		while (k + run < static_cast<int>(lengths.size())
+				&& lengths[k + run] == value)
+		{
+			run++;
+		}
+		k += run;
+		if (value == 0)
+		{
+			while (run >= 11)
+			{
+				int r = min(run, 138);
+				clenSymbols.push_back(make_pair(18, r - 11));
+				run -= r;
+			}
+			if (run >= 3)
+			{
+				clenSymbols.push_back(make_pair(17, run - 3));
+				run = 0;
+			}
+		}
+		else
+		{
+			clenSymbols.push_back(make_pair(value, 0));
+			run--;
+			while (run >= 3)
+			{
+				int r = min(run, 6);
+				clenSymbols.push_back(make_pair(16, r - 3));
+				run -= r;
+			}
+		}
+		for (; run > 0; run--)
+		{
+			clenSymbols.push_back(make_pair(value, 0));
+		}
+	}
+
+	vector<uint32_t> clenFreqs(19, 0);
+	for (int k = 0; k < static_cast<int>(clenSymbols.size()); k++)
+	{
+		clenFreqs[clenSymbols[k].first]++;
+	}
+	vector<int> clenLengths;
+	vector<uint32_t> clenCodes;
+	huffmanLengths(clenFreqs, 7, clenLengths);
+	canonicalCodes(clenLengths, clenCodes);
+	int nClen = 19;
+	while (nClen > 4 && clenLengths[CLEN_ORDER[nClen - 1]] == 0)
+	{
+		nClen--;
+	}
+
+	// Laenge des Huffman-Blocks in Bits mit der Laenge unkomprimierter Bloecke
+	// vergleichen (Kopf, bis zu 7 Fuellbits, LEN und NLEN je Block)
+	size_t dynamicBits = 3 + 5 + 5 + 4 + 3 * nClen + litLengths[256];
+	for (int k = 0; k < static_cast<int>(clenSymbols.size()); k++)
+	{
+		int symbol = clenSymbols[k].first;
+		dynamicBits += clenLengths[symbol]
+				+ ((symbol == 16) ? 2 : (symbol == 17) ? 3 : (symbol == 18) ? 7 : 0);
+	}
+	for (int t = 0; t < static_cast<int>(a_tokens.size()); t++)
+	{
+		const Token &token = a_tokens[t];
+		if (token.dist_ == 0)
+		{
+			dynamicBits += litLengths[token.value_];
+			continue;
+		}
+		int l = lengthIndex(token.value_);
+		int d = distIndex(token.dist_);
+		dynamicBits += litLengths[257 + l] + LENGTH_EXTRA[l] + distLengths[d]
+				+ DIST_EXTRA[d];
+	}
+	size_t nStored = max<size_t>(1, (a_rawSize + STORED_MAX - 1) / STORED_MAX);
+	size_t storedBits = nStored * (3 + 7 + 32) + 8 * a_rawSize;
+	if (storedBits < dynamicBits)
+	{
+		writeStored(a_raw, a_rawSize, a_last, a_bits);
+		return;
+	}
+
+	// Blockkopf
+	a_bits.write(a_last ? 1 : 0, 1);
+	a_bits.write(2, 2);
+	a_bits.write(nLit - 257, 5);
+	a_bits.write(nDist - 1, 5);
+	a_bits.write(nClen - 4, 4);
+	for (int k = 0; k < nClen; k++)
+	{
+		a_bits.write(clenLengths[CLEN_ORDER[k]], 3);
+	}
+	for (int k = 0; k < static_cast<int>(clenSymbols.size()); k++)
+	{
+		int symbol = clenSymbols[k].first;
+		a_bits.writeCode(clenCodes[symbol], clenLengths[symbol]);
+		if (symbol == 16)
+		{
+			a_bits.write(clenSymbols[k].second, 2);
+		}
+		else if (symbol == 17)
+		{
+			a_bits.write(clenSymbols[k].second, 3);
+		}
+		else if (symbol == 18)
+		{
+			a_bits.write(clenSymbols[k].second, 7);
+		}
+	}
+
+	// Daten
+	for (int t = 0; t < static_cast<int>(a_tokens.size()); t++)
+	{
+		const Token &token = a_tokens[t];
+		if (token.dist_ == 0)
+		{
+			a_bits.writeCode(litCodes[token.value_], litLengths[token.value_]);
+			continue;
+		}
+		int l = lengthIndex(token.value_);
+		a_bits.writeCode(litCodes[257 + l], litLengths[257 + l]);
+		a_bits.write(token.value_ - LENGTH_BASE[l], LENGTH_EXTRA[l]);
+		int d = distIndex(token.dist_);
+		a_bits.writeCode(distCodes[d], distLengths[d]);
+		a_bits.write(token.dist_ - DIST_BASE[d], DIST_EXTRA[d]);
+	}
+	a_bits.writeCode(litCodes[256], litLengths[256]);
+}
+
+void Deflate::writeStored(const unsigned char *a_raw, std::size_t a_rawSize,
+		bool a_last, BitWriter &a_bits)
+{
+	do
+	{
+		size_t length = min<size_t>(a_rawSize, STORED_MAX);
+		a_rawSize -= length;
+		a_bits.write((a_last && a_rawSize == 0) ? 1 : 0, 1);
+		a_bits.write(0, 2);
+		a_bits.flush();
+		a_bits.write(static_cast<uint32_t>(length), 16);
+		a_bits.write(static_cast<uint32_t>(length ^ 0xFFFF), 16);
+		for (size_t k = 0; k < length; k++)
+		{
+			a_bits.write(a_raw[k], 8);
+		}
+		a_raw += length;
+	} while (a_rawSize > 0);
+}
@@ -0,0 +1,147 @@
+/*! \file Deflate.h
+ *  \brief Definition der Klasse Deflate
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef UTIL_DEFLATE_H_
+#define UTIL_DEFLATE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*! \class Deflate
+ *  \brief Eigenstaendiger Deflate-Kompressor (RFC 1951) mit zlib-Rahmen
+ *  (RFC 1950), z. B. fuer PNG-Dateien. LZ77 mit Hash-Ketten ueber ein
+ *  32-KiB-Fenster, je Block dynamische Huffman-Codes oder, falls das
+ *  kuerzer ist, unkomprimierte Bloecke (nicht komprimierbare Daten wachsen
+ *  so nur um wenige Bytes). Nur Kompression, keine Dekompression
+ */
+class Deflate
+{
+public:
+	/*! \brief Komprimiert die Daten in einen zlib-Datenstrom (Header,
+	 *  Deflate-Bloecke, Adler-32-Pruefsumme)
+	 *  \param a_data Daten
+	 *  \param a_size Anzahl Bytes
+	 *  \param a_maxChain Maximale Anzahl gepruefter Positionen je Hash-Kette,
+	 *  groesser = bessere Kompression, langsamer
+	 *  \return zlib-Datenstrom
+	 */
+	static std::vector<unsigned char> zlibCompress(const unsigned char *a_data,
+			std::size_t a_size, int a_maxChain = 32);
+
+	/*! \brief Berechnet die Adler-32-Pruefsumme
+	 *  \param a_data Daten
+	 *  \param a_size Anzahl Bytes
+	 *  \return Pruefsumme
+	 */
+	static std::uint32_t adler32(const unsigned char *a_data, std::size_t a_size);
+
+private:
+	static const int LENGTH_BASE[29];   /**< Basislaengen der Laengencodes
+		257..285 (RFC 1951, 3.2.5) */
+	static const int LENGTH_EXTRA[29];  /**< Zusatzbits der Laengencodes */
+	static const int DIST_BASE[30];     /**< Basisabstaende der Abstandscodes */
+	static const int DIST_EXTRA[30];    /**< Zusatzbits der Abstandscodes */
+	static const int CLEN_ORDER[19];    /**< Reihenfolge der
+		Codelaengen-Codelaengen im Blockkopf */
+	static const int WINDOW_SIZE = 32768;  /**< LZ77-Fenster / Byte */
+	static const int MIN_MATCH = 3;        /**< Kuerzeste Wiederholung */
+	static const int MAX_MATCH = 258;      /**< Laengste Wiederholung */
+	static const int HASH_BITS = 15;       /**< Hash-Tabelle mit 2^HASH_BITS
+		Eintraegen */
+	static const int BLOCK_TOKENS = 32768; /**< LZ77-Symbole je Block */
+	static const int STORED_MAX = 65535;   /**< Bytes je unkomprimiertem Block */
+
+	/*! \brief Schreibt Bits LSB-zuerst in einen Bytepuffer
+	 */
+	class BitWriter
+	{
+	public:
+		/*! \brief Konstruktor
+		 *  \param a_out Ausgabepuffer
+		 */
+		BitWriter(std::vector<unsigned char> &a_out);
+
+		/*! \brief Schreibt die niederwertigsten Bits eines Werts
+		 *  \param a_value Wert
+		 *  \param a_nBits Anzahl Bits (hoechstens 24)
+		 */
+		void write(std::uint32_t a_value, int a_nBits);
+
+		/*! \brief Schreibt einen Huffman-Code (hoechstwertiges Bit zuerst)
+		 *  \param a_code Code
+		 *  \param a_length Codelaenge
+		 */
+		void writeCode(std::uint32_t a_code, int a_length);
+
+		/*! \brief Fuellt bis zur naechsten Bytegrenze mit Nullbits auf
+		 */
+		void flush();
+
+	private:
+		std::vector<unsigned char> &out_;  /**< Ausgabepuffer */
+		std::uint32_t buffer_;             /**< Noch nicht geschriebene Bits */
+		int nBits_;                        /**< Anzahl Bits in buffer_ */
+	};
+
+	/*! \brief Ein LZ77-Symbol: Literal (dist_ == 0) oder Verweis
+	 */
+	struct Token
+	{
+		std::uint16_t value_;  /**< Literal oder Laenge 3..258 */
+		std::uint16_t dist_;   /**< Abstand 1..32768, 0 = Literal */
+	};
+
+	/*! \brief Gibt den Index des Laengencodes zurueck
+	 *  \param a_length Laenge 3..258
+	 *  \return Index 0..28 (Code 257 + Index)
+	 */
+	static int lengthIndex(int a_length);
+
+	/*! \brief Gibt den Index des Abstandscodes zurueck
+	 *  \param a_dist Abstand 1..32768
+	 *  \return Index 0..29
+	 */
+	static int distIndex(int a_dist);
+
+	/*! \brief Berechnet laengenbegrenzte Huffman-Codelaengen
+	 *  \param a_freqs Haeufigkeit je Symbol
+	 *  \param a_maxBits Maximale Codelaenge
+	 *  \param a_lengths Codelaenge je Symbol, 0 = nicht verwendet
+	 */
+	static void huffmanLengths(const std::vector<std::uint32_t> &a_freqs,
+			int a_maxBits, std::vector<int> &a_lengths);
+
+	/*! \brief Berechnet kanonische Codes aus Codelaengen (RFC 1951, 3.2.2)
+	 *  \param a_lengths Codelaenge je Symbol
+	 *  \param a_codes Code je Symbol
+	 */
+	static void canonicalCodes(const std::vector<int> &a_lengths,
+			std::vector<std::uint32_t> &a_codes);
+
+	/*! \brief Schreibt einen Block mit dynamischen Huffman-Codes oder, falls
+	 *  das weniger Bits braucht, die Originaldaten als unkomprimierte Bloecke
+	 *  \param a_tokens LZ77-Symbole des Blocks
+	 *  \param a_raw Originaldaten, die a_tokens beschreiben
+	 *  \param a_rawSize Anzahl Bytes der Originaldaten
+	 *  \param a_last Letzter Block
+	 *  \param a_bits Ausgabe
+	 */
+	static void writeBlock(const std::vector<Token> &a_tokens,
+			const unsigned char *a_raw, std::size_t a_rawSize, bool a_last,
+			BitWriter &a_bits);
+
+	/*! \brief Schreibt Daten als unkomprimierte Bloecke (RFC 1951, 3.2.4)
+	 *  \param a_raw Daten
+	 *  \param a_rawSize Anzahl Bytes
+	 *  \param a_last Der letzte geschriebene Block ist der letzte des Datenstroms
+	 *  \param a_bits Ausgabe
+	 */
+	static void writeStored(const unsigned char *a_raw, std::size_t a_rawSize,
+			bool a_last, BitWriter &a_bits);
+};
+
+#endif /* UTIL_DEFLATE_H_ */
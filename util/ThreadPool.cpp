@@ -0,0 +1,138 @@
+/*! \file ThreadPool.cpp
+ *  \brief Implementierung der Klasse ThreadPool
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#include "ThreadPool.h"
+#include "../diag/Trace.h"
+
+#include <algorithm>
+
+using namespace std;
+
+/*! \brief Ersetzt 0 (oder weniger) durch die Anzahl der Prozessorkerne
+ *  \param a_nThreads Gewuenschte Anzahl der Threads
+ *  \return Anzahl der Threads, mindestens 1
+ */
+static int resolveThreads(int a_nThreads)
+{
+	if (a_nThreads <= 0)
+	{
+		a_nThreads = static_cast<int>(thread::hardware_concurrency());
+	}
+	return (a_nThreads <= 0) ? 1 : a_nThreads;
+}
+
+ThreadPool::ThreadPool(int a_nThreads) :
+		nBusy_(0), stop_(false)
+{
+	a_nThreads = resolveThreads(a_nThreads);
+	for (int i = 0; i < a_nThreads; i++)
+	{
+		workers_.push_back(thread(&ThreadPool::work, this));
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		stop_ = true;
+	}
+	taskAvailable_.notify_all();
+	for (int i = 0; i < static_cast<int>(workers_.size()); i++)
+	{
+		workers_[i].join();
+	}
+}
+
+void ThreadPool::submit(const std::function<void()> &a_task)
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		tasks_.push_back(a_task);
+	}
+	taskAvailable_.notify_one();
+}
+
+void ThreadPool::wait()
+{
+	unique_lock<mutex> lock(mutex_);
+	while (!tasks_.empty() || nBusy_ > 0)
+	{
+		allDone_.wait(lock);
+	}
+}
+
+int ThreadPool::nThreads() const
+{
+	return static_cast<int>(workers_.size());
+}
+
+int ThreadPool::threadsFor(int a_nThreads, int a_nTasks)
+{
+	if (a_nTasks <= 1)
+	{
+		return 0;
+	}
+	return min(resolveThreads(a_nThreads), a_nTasks);
+}
+
+void ThreadPool::forEach(int a_nTasks, int a_nThreads,
+		const std::function<void(int)> &a_task)
+{
+	int nThreads = threadsFor(a_nThreads, a_nTasks);
+	if (nThreads <= 1)
+	{
+		for (int t = 0; t < a_nTasks; t++)
+		{
+			a_task(t);
+		}
+		return;
+	}
+	ThreadPool pool(nThreads);
+	for (int t = 0; t < a_nTasks; t++)
+	{
+		pool.submit([t, &a_task]()
+		{
+			a_task(t);
+		});
+	}
+	pool.wait();
+}
+
+void ThreadPool::work()
+{
+	diag::Tracer::setThreadName("pool worker");
+	while (true)
+	{
+		function<void()> task;
+		{
+			unique_lock<mutex> lock(mutex_);
+			while (tasks_.empty() && !stop_)
+			{
+				taskAvailable_.wait(lock);
+			}
+			if (tasks_.empty())
+			{
+				return;
+			}
+			task = tasks_.front();
+			tasks_.pop_front();
+			nBusy_++;
+		}
+		{
+			DFSM_TRACE_SPAN(taskSpan, "task", "pool");
+			task();
+		}
+		{
+			lock_guard<mutex> lock(mutex_);
+			nBusy_--;
+			if (tasks_.empty() && nBusy_ == 0)
+			{
+				allDone_.notify_all();
+			}
+		}
+	}
+}
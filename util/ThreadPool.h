@@ -0,0 +1,88 @@
+/*! \file ThreadPool.h
+ *  \brief Definition der Klasse ThreadPool
+ *  \author Thai Nguyen, Dung Tran
+ *  \date 2021
+ */
+
+#ifndef UTIL_THREADPOOL_H_
+#define UTIL_THREADPOOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*! \class ThreadPool
+ *  \brief Einfacher Thread-Pool mit fester Anzahl an Worker-Threads. Auftraege
+ *  werden in der Reihenfolge ihres Eintreffens abgearbeitet
+ */
+class ThreadPool
+{
+public:
+	/*! \brief Konstruktor. Startet die Worker-Threads
+	 *  \param a_nThreads Anzahl der Worker-Threads, 0 = Anzahl der
+	 *  Prozessorkerne
+	 */
+	ThreadPool(int a_nThreads = 0);
+
+	/*! \brief Destruktor. Arbeitet alle noch offenen Auftraege ab und beendet
+	 *  die Worker-Threads
+	 */
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/*! \brief Reiht einen Auftrag ein
+	 *  \param a_task Auszufuehrender Auftrag
+	 */
+	void submit(const std::function<void()> &a_task);
+
+	/*! \brief Wartet, bis alle bisher eingereihten Auftraege abgearbeitet sind
+	 */
+	void wait();
+
+	/*! \brief Gibt die Anzahl der Worker-Threads zurueck
+	 *  \return Anzahl der Worker-Threads
+	 */
+	int nThreads() const;
+
+	/*! \brief Bestimmt die Anzahl der Worker-Threads fuer eine feste Anzahl
+	 *  von Auftraegen: 0 wird zur Anzahl der Prozessorkerne, das Ergebnis
+	 *  wird auf die Anzahl der Auftraege begrenzt
+	 *  \param a_nThreads Gewuenschte Anzahl, 0 = Anzahl der Prozessorkerne
+	 *  \param a_nTasks Anzahl der Auftraege
+	 *  \return Anzahl der Worker-Threads, 0 bei hoechstens einem Auftrag
+	 *  (dann lohnt sich kein Pool)
+	 */
+	static int threadsFor(int a_nThreads, int a_nTasks);
+
+	/*! \brief Fuehrt a_task(0) ... a_task(a_nTasks-1) aus und kehrt erst
+	 *  danach zurueck. Ein Pool mit threadsFor(a_nThreads, a_nTasks) Threads
+	 *  wird nur bei mindestens zwei Auftraegen gestartet, sonst laeuft alles
+	 *  im aufrufenden Thread
+	 *  \param a_nTasks Anzahl der Auftraege
+	 *  \param a_nThreads Gewuenschte Anzahl der Threads, 0 = Anzahl der
+	 *  Prozessorkerne
+	 *  \param a_task Auftrag, erhaelt seinen Index
+	 */
+	static void forEach(int a_nTasks, int a_nThreads,
+			const std::function<void(int)> &a_task);
+
+private:
+	/*! \brief Hauptschleife eines Worker-Threads
+	 */
+	void work();
+
+	std::vector<std::thread> workers_;          /**< Worker-Threads */
+	std::deque<std::function<void()> > tasks_;  /**< Offene Auftraege */
+	std::mutex mutex_;                  /**< Schuetzt tasks_, nBusy_, stop_ */
+	std::condition_variable taskAvailable_;  /**< Neuer Auftrag oder Ende */
+	std::condition_variable allDone_;        /**< Alle Auftraege erledigt */
+	int nBusy_;   /**< Anzahl gerade bearbeiteter Auftraege */
+	bool stop_;   /**< Worker-Threads sollen sich beenden */
+};
+
+#endif /* UTIL_THREADPOOL_H_ */